@@ -0,0 +1,293 @@
+// BrowserView Tests - webview pooling, process stats and the lifecycle policy
+
+import { defineTest, expect } from "../test-framework/types";
+import type { TestContext, TestWindow } from "../test-framework/types";
+import { BrowserView, Session } from "electrobun/main";
+
+// These APIs are Linux only and report null elsewhere. Returns a hidden host
+// window, or null once the skip is logged.
+async function createLinuxHostWindow(
+  { createWindow, log }: TestContext,
+  title: string,
+  supported: () => boolean,
+  url = "views://test-harness/index.html",
+): Promise<TestWindow | null> {
+  if (process.platform !== "linux" || !supported()) {
+    log(`Skipping ${title} on this platform`);
+    return null;
+  }
+  return createWindow({ url, title, hidden: true, activate: false });
+}
+
+async function waitFor(condition: () => boolean, timeoutMs: number, what: string) {
+  const deadline = Date.now() + timeoutMs;
+  while (!condition()) {
+    if (Date.now() > deadline) {
+      throw new Error(`Timed out waiting for ${what}`);
+    }
+    await new Promise((resolve) => setTimeout(resolve, 50));
+  }
+}
+
+// The lifecycle policy and its counters are process-wide, so the tests that
+// turn it on take turns.
+let lifecyclePolicyTurn: Promise<void> = Promise.resolve();
+async function withLifecyclePolicy(
+  policy: Parameters<typeof BrowserView.setLifecyclePolicy>[0],
+  body: () => Promise<void>,
+) {
+  const previous = lifecyclePolicyTurn;
+  let release!: () => void;
+  lifecyclePolicyTurn = new Promise((resolve) => (release = resolve));
+  await previous;
+  try {
+    expect(BrowserView.setLifecyclePolicy(policy)).toBe(true);
+    await body();
+  } finally {
+    BrowserView.setLifecyclePolicy({});
+    release();
+  }
+}
+
+const showTagScript = (hidden: boolean) =>
+  `document.querySelector("electrobun-webview").toggleHidden(${hidden})`;
+
+export const browserViewTests = [
+  defineTest({
+    name: "BrowserView.setPoolSize time to dom-ready",
+    category: "BrowserView",
+    description:
+      "Compare new BrowserView to dom-ready with and without pre-created spare webviews in the partition",
+    timeout: 60000,
+    async run(context) {
+      const { log } = context;
+      expect(typeof BrowserView.setPoolSize).toBe("function");
+      const host = await createLinuxHostWindow(
+        context,
+        "Webview pool",
+        () => BrowserView.getPoolStats() !== null,
+      );
+      if (!host) return;
+      expect(BrowserView.setPoolSize(2, { partition: "temp:pool" })).toBe(false);
+
+      const pooled = "persist:pool-bench";
+      const unpooled = "persist:pool-bench-none";
+      if (!BrowserView.setPoolSize(2, { partition: pooled })) {
+        log("Webview pooling is unavailable with this renderer");
+        return;
+      }
+      // Both partitions get their context up front, so only the view differs.
+      await Session.prewarm([pooled, unpooled]);
+
+      const waitForSpares = async (count: number) => {
+        const deadline = Date.now() + 5000;
+        while ((BrowserView.getPoolStats()?.idle ?? 0) < count && Date.now() < deadline) {
+          await new Promise((resolve) => setTimeout(resolve, 20));
+        }
+      };
+      const views: BrowserView<any>[] = [];
+      const timeToDomReady = (partition: string) =>
+        new Promise<number>((resolve, reject) => {
+          const start = performance.now();
+          const view = new BrowserView({
+            windowId: host.id,
+            partition,
+            url: "views://test-harness/index.html",
+            frame: { x: 0, y: 0, width: 320, height: 240 },
+          });
+          views.push(view);
+          const timer = setTimeout(() => reject(new Error("dom-ready timed out")), 10000);
+          view.on("dom-ready", () => {
+            clearTimeout(timer);
+            resolve(performance.now() - start);
+          });
+        });
+
+      try {
+        const rounds = 3;
+        let coldMs = 0;
+        let pooledMs = 0;
+        for (let index = 0; index < rounds; index++) {
+          coldMs += await timeToDomReady(unpooled);
+          await waitForSpares(2);
+          pooledMs += await timeToDomReady(pooled);
+        }
+        coldMs /= rounds;
+        pooledMs /= rounds;
+
+        // Removed views:// webviews refill the pool from their web process.
+        for (const view of views.splice(0)) {
+          view.remove();
+        }
+        await new Promise((resolve) => setTimeout(resolve, 500));
+        const stats = BrowserView.getPoolStats()!;
+        expect(stats.hits).toBeGreaterThan(0);
+        log(
+          `New BrowserView to dom-ready: ${coldMs.toFixed(1)} ms without a pool, ` +
+            `${pooledMs.toFixed(1)} ms from the pool (${(coldMs - pooledMs).toFixed(1)} ms saved); ` +
+            `hits=${stats.hits} misses=${stats.misses} precreated=${stats.precreated} ` +
+            `recycled=${stats.recycled} idle=${stats.idle}`,
+        );
+      } finally {
+        for (const view of views) {
+          view.remove();
+        }
+        BrowserView.setPoolSize(0, { partition: pooled });
+      }
+    },
+  }),
+
+  defineTest({
+    name: "BrowserView.getProcessStats per-webview accounting",
+    category: "BrowserView",
+    description:
+      "Report memory and CPU for each webview and the engine's shared processes without a main thread round-trip",
+    timeout: 20000,
+    async run(context) {
+      const { log } = context;
+      expect(typeof BrowserView.getProcessStats).toBe("function");
+      const win = await createLinuxHostWindow(
+        context,
+        "Process stats",
+        () => BrowserView.getProcessStats() !== null,
+      );
+      if (!win) return;
+      await new Promise((resolve) => setTimeout(resolve, 1500));
+
+      const start = performance.now();
+      const stats = BrowserView.getProcessStats()!;
+      const elapsedMs = performance.now() - start;
+
+      const own = stats.filter((record) => record.webviewId === win.webview.id);
+      expect(own.length).toBe(1);
+      const browser = stats.find((record) => record.kind === "browser");
+      expect(browser?.pid).toBe(process.pid);
+      expect(browser!.rssBytes).toBeGreaterThan(0);
+      expect(browser!.threads).toBeGreaterThan(0);
+
+      const mb = (bytes: number) => (bytes / (1024 * 1024)).toFixed(1);
+      const shared = stats.filter((record) => record.webviewId === null);
+      log(
+        `Sampled ${stats.length} records in ${elapsedMs.toFixed(2)} ms; ` +
+          `webview ${win.webview.id}: pid=${own[0]!.pid ?? "unknown"} ` +
+          `rss=${mb(own[0]!.rssBytes)} MB pss=${mb(own[0]!.pssBytes)} MB; ` +
+          shared
+            .map((record) => `${record.kind}:${record.pid} ${mb(record.rssBytes)} MB`)
+            .join(", "),
+      );
+    },
+  }),
+
+  defineTest({
+    name: "BrowserView.setLifecyclePolicy leaves visible webviews alone",
+    category: "BrowserView",
+    description:
+      "Turn on the background lifecycle policy and check visible webviews stay active while its counters are reported",
+    timeout: 20000,
+    async run(context) {
+      const { log } = context;
+      expect(typeof BrowserView.setLifecyclePolicy).toBe("function");
+      const win = await createLinuxHostWindow(
+        context,
+        "Lifecycle policy",
+        () => BrowserView.getLifecycleStats() !== null,
+      );
+      if (!win) return;
+
+      await withLifecyclePolicy(
+        { throttleAfterMs: 100, freezeAfterMs: 200, discardAfterMs: 300 },
+        async () => {
+          const before = BrowserView.getLifecycleStats()!;
+          // The policy ticks once a second; only views hidden through the
+          // webview tag are wound down.
+          await new Promise((resolve) => setTimeout(resolve, 2500));
+          expect(win.webview.getLifecycleState()).toBe("active");
+
+          const stats = BrowserView.getLifecycleStats()!;
+          expect(stats.throttled).toBe(before.throttled);
+          expect(stats.frozen).toBe(before.frozen);
+          expect(stats.discarded).toBe(before.discarded);
+          log(
+            `throttled=${stats.throttled} frozen=${stats.frozen} discarded=${stats.discarded} ` +
+              `restored=${stats.restored} reclaimed=${(stats.bytesReclaimed / (1024 * 1024)).toFixed(1)} MB ` +
+              `lastRestore=${(stats.lastRestoreUs / 1000).toFixed(1)} ms ` +
+              `maxRestore=${(stats.maxRestoreUs / 1000).toFixed(1)} ms`,
+          );
+        },
+      );
+    },
+  }),
+
+  defineTest({
+    name: "BrowserView.setLifecyclePolicy discards hidden webview tags and restores them",
+    category: "BrowserView",
+    description:
+      "Hide an electrobun-webview past discardAfterMs, then show it and check its page reloads and the restore is counted",
+    timeout: 30000,
+    async run(context) {
+      const { log } = context;
+      // Other tests may create tags at the same time; keep them all and pick
+      // ours by window once it exists.
+      const navigations = new Map<BrowserView<any>, string[]>();
+      const removeCreatedListener = BrowserView.on("created", (view) => {
+        const urls: string[] = [];
+        navigations.set(view, urls);
+        view.on("did-navigate", (e: any) => urls.push(e.data?.detail || e.detail || ""));
+      });
+
+      try {
+        const host = await createLinuxHostWindow(
+          context,
+          "Lifecycle discard",
+          () => BrowserView.getLifecycleStats() !== null,
+          "views://test-oopif/index.html",
+        );
+        if (!host) return;
+
+        let tag: BrowserView<any> | undefined;
+        let tagUrls: string[] = [];
+        await waitFor(
+          () => {
+            for (const [view, urls] of navigations) {
+              if (view.windowId === host.id && urls.length > 0) {
+                tag = view;
+                tagUrls = urls;
+              }
+            }
+            return tag !== undefined;
+          },
+          10000,
+          "the webview tag to load",
+        );
+        const tagUrl = tagUrls[tagUrls.length - 1]!;
+
+        await withLifecyclePolicy({ discardAfterMs: 200 }, async () => {
+          host.webview.executeJavascript(showTagScript(true));
+          await waitFor(() => tag!.getLifecycleState() === "discarded", 5000, "the discard");
+
+          const before = BrowserView.getLifecycleStats()!;
+          const navigatedBeforeShow = tagUrls.length;
+          host.webview.executeJavascript(showTagScript(false));
+          await waitFor(
+            () => BrowserView.getLifecycleStats()!.restored > before.restored,
+            10000,
+            "the restore",
+          );
+
+          const stats = BrowserView.getLifecycleStats()!;
+          expect(stats.restored).toBe(before.restored + 1);
+          expect(stats.lastRestoreUs).toBeGreaterThan(0);
+          expect(tag!.getLifecycleState()).toBe("active");
+          expect(tagUrls.slice(navigatedBeforeShow)).toContain(tagUrl);
+          log(
+            `Restored ${tagUrl} in ${(stats.lastRestoreUs / 1000).toFixed(1)} ms; ` +
+              `discarded=${stats.discarded} ` +
+              `reclaimed=${(stats.bytesReclaimed / (1024 * 1024)).toFixed(1)} MB`,
+          );
+        });
+      } finally {
+        removeCreatedListener();
+      }
+    },
+  }),
+];
@@ -13,6 +13,7 @@ import { navigationTests } from "./navigation.test";
 import { utilsTests } from "./utils.test";
 import { screenTests } from "./screen.test";
 import { sessionTests } from "./session.test";
+import { browserViewTests } from "./browserview.test";
 import { eventsTests } from "./events.test";
 import { preloadTests } from "./preload.test";
 import { updaterTests } from "./updater.test";
@@ -55,6 +56,7 @@ export const allTests: TestDefinition[] = [
   ...utilsTests,
   ...screenTests,
   ...sessionTests,
+  ...browserViewTests,
   ...eventsTests,
   ...preloadTests,
   ...updaterTests,
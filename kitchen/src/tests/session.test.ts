@@ -1,7 +1,7 @@
 // Session/Cookie API Tests
 
 import { defineTest, expect } from "../test-framework/types";
-import { Session } from "electrobun/main";
+import { BrowserView, Session } from "electrobun/main";
 
 export const sessionTests = [
   defineTest({
@@ -44,11 +44,217 @@ export const sessionTests = [
       expect(typeof session.cookies.get).toBe("function");
       expect(typeof session.cookies.remove).toBe("function");
       expect(typeof session.cookies.clear).toBe("function");
+      expect(typeof session.cookies.getAsync).toBe("function");
+      expect(typeof session.cookies.setAsync).toBe("function");
+      expect(typeof session.cookies.removeAsync).toBe("function");
+      expect(typeof session.cookies.clearAsync).toBe("function");
+      expect(typeof session.cookies.importAsync).toBe("function");
+      expect(typeof session.cookies.exportAsync).toBe("function");
 
       log("All cookies API methods exist");
     },
   }),
 
+  defineTest({
+    name: "cookies async round trip",
+    category: "Session",
+    description: "Set, read back, and remove a cookie through the async API",
+    async run({ log }) {
+      // The other platforms fall back to the synchronous calls disabled below.
+      if (process.platform !== "linux") {
+        log("Skipping async cookies on this platform");
+        return;
+      }
+      const session = Session.fromPartition("persist:cookie-async-test");
+      const set = await session.cookies.setAsync({
+        name: "async-cookie",
+        value: "value \"quoted\"",
+        domain: "localhost",
+        path: "/",
+        expirationDate: Math.floor(Date.now() / 1000) + 3600,
+      });
+      expect(set).toBe(true);
+
+      const cookies = await session.cookies.getAsync({ name: "async-cookie" });
+      expect(cookies.length).toBe(1);
+      expect(cookies[0]!.value).toBe('value "quoted"');
+
+      expect(await session.cookies.removeAsync("http://localhost/", "async-cookie")).toBe(true);
+      expect((await session.cookies.getAsync({ name: "async-cookie" })).length).toBe(0);
+      log("Async set/get/remove round trip succeeded");
+    },
+  }),
+
+  defineTest({
+    name: "cookies.getAsync 1,000 concurrent reads",
+    category: "Session",
+    description:
+      "Benchmark 1,000 concurrent async cookie reads against the same reads made one at a time",
+    timeout: 60000,
+    async run({ log }) {
+      if (process.platform !== "linux") {
+        log("Skipping the cookie read benchmark on this platform");
+        return;
+      }
+      const session = Session.fromPartition("persist:cookie-bench");
+      for (let index = 0; index < 20; index++) {
+        await session.cookies.setAsync({
+          name: `bench-${index}`,
+          value: String(index),
+          domain: "localhost",
+          path: "/",
+        });
+      }
+
+      const reads = 1000;
+      const concurrentStart = performance.now();
+      const results = await Promise.all(
+        Array.from({ length: reads }, () =>
+          session.cookies.getAsync({ url: "http://localhost/" }),
+        ),
+      );
+      const concurrentMs = performance.now() - concurrentStart;
+      for (const cookies of results) {
+        expect(cookies.length).toBeGreaterThanOrEqual(20);
+      }
+
+      const sequentialStart = performance.now();
+      for (let index = 0; index < reads; index++) {
+        session.cookies.get({ url: "http://localhost/" });
+      }
+      const sequentialMs = performance.now() - sequentialStart;
+
+      log(
+        `${reads} reads: ${concurrentMs.toFixed(1)} ms concurrent async ` +
+          `(${((concurrentMs * 1000) / reads).toFixed(1)} us/read), ` +
+          `${sequentialMs.toFixed(1)} ms sequential sync ` +
+          `(${((sequentialMs * 1000) / reads).toFixed(1)} us/read)`,
+      );
+      await session.cookies.clearAsync();
+    },
+  }),
+
+  defineTest({
+    name: "cookies import/export 10,000-cookie jar",
+    category: "Session",
+    description:
+      "Import a 10,000-cookie jar, export it and move it to another partition, reporting cookies/sec",
+    timeout: 120000,
+    async run({ log }) {
+      if (process.platform !== "linux") {
+        log("Skipping the cookie jar benchmark on this platform");
+        return;
+      }
+      const source = Session.fromPartition("persist:cookie-jar-source");
+      const target = Session.fromPartition("persist:cookie-jar-target");
+      await source.cookies.clearAsync();
+      await target.cookies.clearAsync();
+
+      const count = 10000;
+      const expirationDate = Math.floor(Date.now() / 1000) + 3600;
+      const jar = Array.from({ length: count }, (_, index) => ({
+        name: `jar-${index}`,
+        value: `value-${index}`,
+        domain: `site${index % 100}.localhost`,
+        path: "/",
+        expirationDate,
+      }));
+      const rate = (cookies: number, ms: number) =>
+        `${Math.round((cookies * 1000) / ms)} cookies/s`;
+
+      const importStart = performance.now();
+      const imported = await source.cookies.importAsync(jar);
+      const importMs = performance.now() - importStart;
+      expect(imported.imported).toBe(count);
+      expect(imported.failed).toBe(0);
+
+      const exportStart = performance.now();
+      const exported = await source.cookies.exportAsync({ domain: "localhost" });
+      const exportMs = performance.now() - exportStart;
+      const lines = exported.split("\n").filter((line) => line.length > 0);
+      expect(lines.length).toBe(count);
+
+      const migrateStart = performance.now();
+      const migrated = await target.cookies.importAsync(exported);
+      const migrateMs = performance.now() - migrateStart;
+      expect(migrated.imported).toBe(count);
+
+      log(
+        `${count} cookies: import ${importMs.toFixed(1)} ms (${rate(count, importMs)}), ` +
+          `export ${exportMs.toFixed(1)} ms (${rate(count, exportMs)}), ` +
+          `migrate ${migrateMs.toFixed(1)} ms (${rate(count, migrateMs)})`,
+      );
+      await source.cookies.clearAsync();
+      await target.cookies.clearAsync();
+    },
+  }),
+
+  defineTest({
+    name: "Session.prewarm first-webview latency",
+    category: "Session",
+    description:
+      "Compare creating the first webview in a cold persistent partition with one prewarmed by Session.prewarm",
+    timeout: 60000,
+    async run({ createWindow, log }) {
+      expect(typeof Session.prewarm).toBe("function");
+      expect(typeof Session.fromPartition("temp:prewarm").prewarm).toBe("function");
+      if (process.platform !== "linux") {
+        log("Skipping the partition prewarm benchmark on this platform");
+        return;
+      }
+      expect(await Session.fromPartition("temp:prewarm").prewarm()).toBe(false);
+
+      const host = await createWindow({
+        url: "views://test-harness/index.html",
+        title: "Partition prewarm",
+        hidden: true,
+        activate: false,
+      });
+      const rounds = 3;
+      const cold = Array.from({ length: rounds }, (_, index) => `persist:prewarm-bench-cold-${index}`);
+      const warm = Array.from({ length: rounds }, (_, index) => `persist:prewarm-bench-warm-${index}`);
+
+      const prewarmStart = performance.now();
+      const prewarmed = await Session.prewarm(warm);
+      const prewarmMs = performance.now() - prewarmStart;
+      expect(prewarmed.every(Boolean)).toBe(true);
+
+      const views: BrowserView<any>[] = [];
+      const createMs = (partition: string) => {
+        const start = performance.now();
+        views.push(
+          new BrowserView({
+            windowId: host.id,
+            partition,
+            url: "views://test-harness/index.html",
+            frame: { x: 0, y: 0, width: 320, height: 240 },
+          }),
+        );
+        return performance.now() - start;
+      };
+
+      try {
+        let coldMs = 0;
+        let warmMs = 0;
+        for (let index = 0; index < rounds; index++) {
+          coldMs += createMs(cold[index]!);
+          warmMs += createMs(warm[index]!);
+        }
+        coldMs /= rounds;
+        warmMs /= rounds;
+        log(
+          `First webview per partition: ${coldMs.toFixed(2)} ms cold, ` +
+            `${warmMs.toFixed(2)} ms prewarmed (${(coldMs - warmMs).toFixed(2)} ms saved); ` +
+            `prewarming ${rounds} partitions took ${prewarmMs.toFixed(1)} ms off the critical path`,
+        );
+      } finally {
+        for (const view of views) {
+          view.remove();
+        }
+      }
+    },
+  }),
+
   // DISABLED: Causes AVX crash in ARM Windows VM
   // defineTest({
   //   name: "cookies.set call",
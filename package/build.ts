@@ -1765,7 +1765,7 @@ async function vendorCEF() {
 			await $`rm -f src/native/build/process_helper_mac.o src/native/build/process_helper_win.obj src/native/linux/build/process_helper_linux.o`;
 			await $`rm -f src/native/build/libNativeWrapper.dylib src/native/build/libNativeWrapper.so src/native/build/libNativeWrapper_cef.so`;
 			await $`rm -f src/native/win/build/libNativeWrapper.dll src/native/win/build/nativeWrapper.obj`;
-			await $`rm -f src/native/macos/build/nativeWrapper.o src/native/linux/build/nativeWrapper.o src/native/linux/build/wayland_screen_capture.o src/native/linux/build/wayland_pipewire_capture.o`;
+			await $`rm -f src/native/macos/build/nativeWrapper.o src/native/linux/build/nativeWrapper.o src/native/linux/build/wayland_screen_capture.o src/native/linux/build/wayland_pipewire_capture.o src/native/linux/build/x11_shm_image.o src/native/linux/build/snapshot_encoder.o src/native/linux/build/x11_screen_capture.o`;
 		}
 	} else if (existsSync(cefDir) && !existsSync(versionFile)) {
 		// CEF dir exists but no version file (legacy state) — force re-vendor
@@ -1777,7 +1777,7 @@ async function vendorCEF() {
 		await $`rm -f src/native/build/process_helper_mac.o src/native/build/process_helper_win.obj src/native/linux/build/process_helper_linux.o`;
 		await $`rm -f src/native/build/libNativeWrapper.dylib src/native/build/libNativeWrapper.so src/native/build/libNativeWrapper_cef.so`;
 		await $`rm -f src/native/win/build/libNativeWrapper.dll src/native/win/build/nativeWrapper.obj`;
-		await $`rm -f src/native/macos/build/nativeWrapper.o src/native/linux/build/nativeWrapper.o src/native/linux/build/wayland_screen_capture.o src/native/linux/build/wayland_pipewire_capture.o`;
+		await $`rm -f src/native/macos/build/nativeWrapper.o src/native/linux/build/nativeWrapper.o src/native/linux/build/wayland_screen_capture.o src/native/linux/build/wayland_pipewire_capture.o src/native/linux/build/x11_shm_image.o src/native/linux/build/snapshot_encoder.o src/native/linux/build/x11_screen_capture.o`;
 	}
 
 	if (OS === "macos") {
@@ -2528,6 +2528,36 @@ async function buildNative() {
 			];
 			await $`${waylandPipeWireCaptureCompileCmd}`;
 
+			const x11ShmImageCompileCmd = [
+				"g++",
+				"-c",
+				...compileFlags,
+				"-o",
+				"src/native/linux/build/x11_shm_image.o",
+				"src/native/linux/x11_shm_image.cpp",
+			];
+			await $`${x11ShmImageCompileCmd}`;
+
+			const snapshotEncoderCompileCmd = [
+				"g++",
+				"-c",
+				...compileFlags,
+				"-o",
+				"src/native/linux/build/snapshot_encoder.o",
+				"src/native/linux/snapshot_encoder.cpp",
+			];
+			await $`${snapshotEncoderCompileCmd}`;
+
+			const x11ScreenCaptureCompileCmd = [
+				"g++",
+				"-c",
+				...compileFlags,
+				"-o",
+				"src/native/linux/build/x11_screen_capture.o",
+				"src/native/linux/x11_screen_capture.cpp",
+			];
+			await $`${x11ScreenCaptureCompileCmd}`;
+
 			// Link with WebKitGTK, AppIndicator, and optionally CEF libraries using weak linking
 			await $`mkdir -p src/native/build`;
 
@@ -2543,6 +2573,9 @@ async function buildNative() {
 				"src/native/linux/build/nativeWrapper.o",
 				"src/native/linux/build/wayland_screen_capture.o",
 				"src/native/linux/build/wayland_pipewire_capture.o",
+				"src/native/linux/build/x11_shm_image.o",
+				"src/native/linux/build/snapshot_encoder.o",
+				"src/native/linux/build/x11_screen_capture.o",
 				asarLib,
 				...pkgConfigLibs.split(/\s+/).filter((f) => f),
 				"-ldl",
@@ -2565,6 +2598,9 @@ async function buildNative() {
 					"src/native/linux/build/nativeWrapper.o",
 					"src/native/linux/build/wayland_screen_capture.o",
 					"src/native/linux/build/wayland_pipewire_capture.o",
+					"src/native/linux/build/x11_shm_image.o",
+					"src/native/linux/build/snapshot_encoder.o",
+					"src/native/linux/build/x11_screen_capture.o",
 					"src/native/linux/build/cef_loader.o",
 					asarLib,
 					...pkgConfigLibs.split(/\s+/).filter((f) => f),
@@ -32,20 +32,58 @@ export default {
 		"push:minor": "hutch check:release && node scripts/push-version.js minor",
 		"push:major": "hutch check:release && node scripts/push-version.js major",
 		"push:stable": "hutch check:release && node scripts/push-version.js stable",
+		"test:cache-migration-native":
+			"hutch scripts/test-cache-migration-native.js",
+		"test:cef-layout-nudge-native":
+			"hutch scripts/test-cef-layout-nudge-native.js",
 		"test:dialog-paths-native": "hutch scripts/test-dialog-paths-native.js",
 		"test:linux-cef-idle": "node scripts/test-linux-cef-idle.js",
 		"test:linux-dpi-native": "hutch scripts/test-linux-dpi-native.js",
+		"test:linux-mask-region-native":
+			"hutch scripts/test-linux-mask-region-native.js",
+		"test:linux-osr-frame-native": "hutch scripts/test-linux-osr-frame-native.js",
+		"test:linux-osr-paint-policy-native":
+			"hutch scripts/test-linux-osr-paint-policy-native.js",
+		"test:linux-process-stats-native":
+			"hutch scripts/test-linux-process-stats-native.js",
+		"bench:linux-osr-frame-native":
+			"hutch scripts/bench-linux-osr-frame-native.js",
+		"test:linux-x11-capture-native":
+			"hutch scripts/test-linux-x11-capture-native.js",
 		"test:linux-x11-geometry-native":
 			"hutch scripts/test-linux-x11-geometry-native.js",
+		"test:wayland-screen-capture-damage-native":
+			"hutch scripts/test-wayland-screen-capture-damage-native.js",
 		"test:wayland-screen-capture-frame-native":
 			"hutch scripts/test-wayland-screen-capture-frame-native.js",
+		"bench:wayland-screen-capture-native":
+			"hutch scripts/bench-wayland-screen-capture-native.js",
+		"test:session-cookies-native":
+			"hutch scripts/test-session-cookies-native.js",
+		"bench:session-cookies-native":
+			"hutch scripts/bench-session-cookies-native.js",
+		"test:startup-trace-native":
+			"hutch scripts/test-startup-trace-native.js",
 		"test:views-url-native": "hutch scripts/test-views-url-native.js",
+		"test:webview-frame-ring-native":
+			"hutch scripts/test-webview-frame-ring-native.js",
+		"test:webview-lifecycle-native":
+			"hutch scripts/test-webview-lifecycle-native.js",
+		"test:webview-pool-native": "hutch scripts/test-webview-pool-native.js",
+		"test:webview-snapshot-native":
+			"hutch scripts/test-webview-snapshot-native.js",
+		"test:wgpu-frame-stats-native":
+			"hutch scripts/test-wgpu-frame-stats-native.js",
+		"test:wgpu-stub-library-native":
+			"hutch scripts/test-wgpu-stub-library-native.js",
+		"test:wgpu-readback-ring-native":
+			"hutch scripts/test-wgpu-readback-ring-native.js",
 		"test:windows-ui-native": "hutch scripts/test-windows-ui-native.js",
 		"test:windows-ui-native-integration":
 			"hutch scripts/test-windows-ui-native.js --require-native-wrapper",
 		"test:installer-ui":
 			"node scripts/run-cottontail-test.js src/shared/windows-installer-progress.test.ts",
-		"test:unit": "node scripts/run-cottontail-test.js src/shared src/sdks/main src/config src/preload && hutch test:dialog-paths-native && hutch test:linux-dpi-native && hutch test:linux-x11-geometry-native && hutch test:wayland-screen-capture-frame-native && hutch test:views-url-native && hutch test:webview2-permissions && hutch test:windows-ui-native",
+		"test:unit": "node scripts/run-cottontail-test.js src/shared src/sdks/main src/config src/preload && hutch test:cache-migration-native && hutch test:cef-layout-nudge-native && hutch test:dialog-paths-native && hutch test:linux-dpi-native && hutch test:linux-mask-region-native && hutch test:linux-osr-frame-native && hutch test:linux-osr-paint-policy-native && hutch test:linux-process-stats-native && hutch test:linux-x11-capture-native && hutch test:linux-x11-geometry-native && hutch test:wayland-screen-capture-damage-native && hutch test:wayland-screen-capture-frame-native && hutch test:session-cookies-native && hutch test:startup-trace-native && hutch test:views-url-native && hutch test:webview-frame-ring-native && hutch test:webview-lifecycle-native && hutch test:webview-pool-native && hutch test:webview-snapshot-native && hutch test:wgpu-frame-stats-native && hutch test:wgpu-stub-library-native && hutch test:wgpu-readback-ring-native && hutch test:webview2-permissions && hutch test:windows-ui-native",
 		"test:native-symbol-contract":
 			"node scripts/run-cottontail-test.js src/shared/native-symbol-contract.test.ts",
 		"test:devkit-manifest":
@@ -0,0 +1,69 @@
+// Summarizes ELECTROBUN_STARTUP_TRACE files written by the Linux native
+// wrapper. Given one trace it lists each phase; given two it compares them,
+// e.g. a release against the previous one.
+//
+//   node scripts/startup-trace-summary.js before.json [after.json]
+import { readFileSync } from "node:fs";
+
+const files = process.argv.slice(2);
+if (files.length < 1 || files.length > 2) {
+	console.error("usage: startup-trace-summary.js <trace.json> [<trace.json>]");
+	process.exit(1);
+}
+
+// Phase name -> { start, end, thread } in milliseconds after libraryLoad.
+// Repeated phases keep their first occurrence.
+function loadPhases(file) {
+	const { traceEvents } = JSON.parse(readFileSync(file, "utf8"));
+	const threads = new Map();
+	for (const event of traceEvents) {
+		if (event.ph === "M") threads.set(event.tid, event.args.name);
+	}
+	const timed = traceEvents.filter((event) => event.ph !== "M");
+	const origin =
+		timed.find((event) => event.name === "libraryLoad")?.ts ??
+		Math.min(...timed.map((event) => event.ts));
+	const phases = new Map();
+	for (const event of timed) {
+		if (phases.has(event.name)) continue;
+		const start = (event.ts - origin) / 1000;
+		phases.set(event.name, {
+			start,
+			end: start + (event.dur ?? 0) / 1000,
+			thread: threads.get(event.tid) ?? `thread ${event.tid}`,
+		});
+	}
+	return phases;
+}
+
+const traces = files.map(loadPhases);
+const names = [...new Set(traces.flatMap((phases) => [...phases.keys()]))];
+names.sort(
+	(left, right) =>
+		(traces[0].get(left)?.start ?? Infinity) -
+		(traces[0].get(right)?.start ?? Infinity),
+);
+
+const format = (value) => (value === undefined ? "-" : value.toFixed(1));
+const header = ["phase", "thread", "start", "end", "ms"];
+if (traces.length === 2) header.push("after end", "after ms", "delta end");
+console.log(header.join("\t"));
+for (const name of names) {
+	const before = traces[0].get(name);
+	const row = [
+		name,
+		before?.thread ?? traces[1]?.get(name)?.thread ?? "-",
+		format(before?.start),
+		format(before?.end),
+		format(before && before.end - before.start),
+	];
+	if (traces.length === 2) {
+		const after = traces[1].get(name);
+		row.push(
+			format(after?.end),
+			format(after && after.end - after.start),
+			format(before && after && after.end - before.end),
+		);
+	}
+	console.log(row.join("\t"));
+}
@@ -0,0 +1,53 @@
+import { spawnSync } from "node:child_process";
+import { existsSync, mkdtempSync, rmSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join, resolve } from "node:path";
+
+const packageRoot = resolve(import.meta.dirname, "..");
+const zig =
+	process.env["ZIG_BINARY"] ?? join(packageRoot, "vendors", "zig", "zig");
+const sharedDirectory = join(packageRoot, "src", "native", "shared");
+const source = join(sharedDirectory, "wgpu_stub_library_test.cpp");
+const stubSource = join(sharedDirectory, "test_stubs", "wgpu_stub_library.cpp");
+
+// The stub is a shared library opened with dlopen, as the Linux surface
+// bridge opens Dawn.
+if (process.platform !== "linux") {
+	console.log("Skipping the WGPU stub library test on this platform");
+	process.exit(0);
+}
+
+if (!existsSync(zig)) {
+	throw new Error(`Vendored Zig was not found at ${zig}`);
+}
+
+const temporaryDirectory = mkdtempSync(
+	join(tmpdir(), "electrobun-wgpu-stub-library-"),
+);
+const stub = join(temporaryDirectory, "libwgpu-stub.so");
+const binary = join(temporaryDirectory, "wgpu-stub-library-test");
+
+function compile(args, what) {
+	const result = spawnSync(zig, ["c++", "-std=c++17", ...args], {
+		stdio: "inherit",
+	});
+	if (result.error) throw result.error;
+	if (result.status !== 0) {
+		throw new Error(`${what} compilation exited with ${result.status ?? 1}`);
+	}
+}
+
+try {
+	compile(["-shared", "-fPIC", stubSource, "-o", stub], "WGPU stub library");
+	compile([source, "-ldl", "-o", binary], "WGPU stub library native test");
+
+	const test = spawnSync(binary, [stub], { stdio: "inherit" });
+	if (test.error) throw test.error;
+	if (test.status !== 0) {
+		throw new Error(
+			`WGPU stub library native test exited with ${test.status ?? 1}`,
+		);
+	}
+} finally {
+	rmSync(temporaryDirectory, { recursive: true, force: true });
+}
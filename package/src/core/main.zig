@@ -112,6 +112,8 @@ const GlobalShortcutHandler = *const fn ([*:0]const u8) callconv(.c) void;
 const QuitRequestedHandler = *const fn () callconv(.c) void;
 const URLOpenHandler = *const fn ([*:0]const u8) callconv(.c) void;
 const AppReopenHandler = *const fn () callconv(.c) void;
+const WebviewSnapshotHandler = *const fn (u32, u32, u32, u32, u32, u64) callconv(.c) void;
+const WebviewFrameStreamHandler = *const fn (u32, u32) callconv(.c) void;
 const Aes256Gcm = std.crypto.aead.aes_gcm.Aes256Gcm;
 const WebviewSecretKey = [Aes256Gcm.key_length]u8;
 const websocket_magic = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
@@ -1759,6 +1761,36 @@ fn parseInternalRect(value: std.json.Value) ?InternalRect {
     return .{ .x = x, .y = y, .width = width, .height = height };
 }
 
+// Tags resync masks on every scroll frame. Decode the mask JSON here, where the
+// message is already being parsed, and hand the native side packed floats so
+// it never re-parses the string.
+fn resizeWebviewTagWithPackedMasks(webview_id: u32, frame: InternalRect, masks_json: []const u8) bool {
+    var parsed = std.json.parseFromSlice(std.json.Value, allocator, masks_json, .{}) catch return false;
+    defer parsed.deinit();
+    if (parsed.value != .array) return false;
+
+    const items = parsed.value.array.items;
+    const packed_rects = allocator.alloc(f32, items.len * 4) catch return false;
+    defer allocator.free(packed_rects);
+    for (items, 0..) |item, index| {
+        const rect = parseInternalRect(item) orelse return false;
+        packed_rects[index * 4] = @floatCast(rect.x);
+        packed_rects[index * 4 + 1] = @floatCast(rect.y);
+        packed_rects[index * 4 + 2] = @floatCast(rect.width);
+        packed_rects[index * 4 + 3] = @floatCast(rect.height);
+    }
+    const count = std.math.cast(u32, items.len) orelse return false;
+    return resizeWebviewWithMaskRects(
+        webview_id,
+        frame.x,
+        frame.y,
+        frame.width,
+        frame.height,
+        packed_rects.ptr,
+        count,
+    );
+}
+
 fn sendInternalBridgeResponse(
     host_webview_id: u32,
     request_id: []const u8,
@@ -2014,6 +2046,7 @@ fn handleInternalMessage(source_webview_id: u32, message_id: []const u8, payload
         const webview_id = jsonU32(payload_object.get("id") orelse return) orelse return;
         const frame = parseInternalRect(payload_object.get("frame") orelse return) orelse return;
         const masks = if (payload_object.get("masks")) |value| jsonString(value) orelse "[]" else "[]";
+        if (resizeWebviewTagWithPackedMasks(webview_id, frame, masks)) return;
         const masks_z = duplicateSentinelString(masks) orelse return;
         defer allocator.free(masks_z);
         resizeWebview(webview_id, frame.x, frame.y, frame.width, frame.height, masks_z.ptr);
@@ -3039,6 +3072,29 @@ export fn resizeWebview(
     resize_webview(webview, x, y, width, height, masks_json);
 }
 
+// Packed mask channel: rect_count x, y, width, height quadruples. Returns
+// false when the native wrapper has no binary path; callers then fall back to
+// resizeWebview with mask JSON.
+export fn resizeWebviewWithMaskRects(
+    webview_id: u32,
+    x: f64,
+    y: f64,
+    width: f64,
+    height: f64,
+    rects: ?[*]const f32,
+    rect_count: u32,
+) bool {
+    clearLastError();
+    const ResizeWebviewWithMaskRectsFn = *const fn (WebviewPtr, f64, f64, f64, f64, ?[*]const f32, u32) callconv(.c) void;
+    const webview = requireWebviewPtr(webview_id) orelse return false;
+    const resize_webview_with_mask_rects = lookupOptionalNativeSymbol(
+        ResizeWebviewWithMaskRectsFn,
+        "resizeWebviewWithMaskRects",
+    ) orelse return false;
+    resize_webview_with_mask_rects(webview, x, y, width, height, rects, if (rects == null) 0 else rect_count);
+    return true;
+}
+
 export fn loadURLInWebView(webview_id: u32, url: [*:0]const u8) void {
     clearLastError();
     const LoadURLInWebViewFn = *const fn (WebviewPtr, [*:0]const u8) callconv(.c) void;
@@ -3181,6 +3237,126 @@ export fn webviewSetSpellCheck(webview_id: u32, enabled: bool) bool {
     return webview_set_spell_check(webview, enabled);
 }
 
+export fn webviewSetWindowlessFrameRate(webview_id: u32, frame_rate: i32) bool {
+    clearLastError();
+    const WebviewSetWindowlessFrameRateFn = *const fn (WebviewPtr, i32) callconv(.c) bool;
+    const webview = requireWebviewPtr(webview_id) orelse return false;
+    const webview_set_windowless_frame_rate = lookupOptionalNativeSymbol(
+        WebviewSetWindowlessFrameRateFn,
+        "webviewSetWindowlessFrameRate",
+    ) orelse return false;
+    return webview_set_windowless_frame_rate(webview, frame_rate);
+}
+
+export fn webviewSetBackgroundThrottled(webview_id: u32, throttled: bool) bool {
+    clearLastError();
+    const WebviewSetBackgroundThrottledFn = *const fn (WebviewPtr, bool) callconv(.c) bool;
+    const webview = requireWebviewPtr(webview_id) orelse return false;
+    const webview_set_background_throttled = lookupOptionalNativeSymbol(
+        WebviewSetBackgroundThrottledFn,
+        "webviewSetBackgroundThrottled",
+    ) orelse return false;
+    return webview_set_background_throttled(webview, throttled);
+}
+
+export fn getWebviewSnapshotWithOptions(
+    webview_id: u32,
+    request_id: u32,
+    x: f64,
+    y: f64,
+    width: f64,
+    height: f64,
+    max_width: u32,
+    max_height: u32,
+    format: u32,
+    quality: u32,
+    out_rgba: ?[*]u8,
+    out_len: u64,
+    handler: ?WebviewSnapshotHandler,
+) bool {
+    clearLastError();
+    const GetWebviewSnapshotWithOptionsFn = *const fn (
+        WebviewPtr,
+        u32,
+        f64,
+        f64,
+        f64,
+        f64,
+        u32,
+        u32,
+        u32,
+        u32,
+        ?[*]u8,
+        u64,
+        ?WebviewSnapshotHandler,
+    ) callconv(.c) bool;
+    const webview = requireWebviewPtr(webview_id) orelse return false;
+    const get_webview_snapshot_with_options = lookupOptionalNativeSymbol(
+        GetWebviewSnapshotWithOptionsFn,
+        "getWebviewSnapshotWithOptions",
+    ) orelse return false;
+    return get_webview_snapshot_with_options(
+        webview,
+        request_id,
+        x,
+        y,
+        width,
+        height,
+        max_width,
+        max_height,
+        format,
+        quality,
+        out_rgba,
+        out_len,
+        handler,
+    );
+}
+
+export fn webviewStartFrameStream(
+    webview_id: u32,
+    ring: ?[*]u8,
+    ring_len: u64,
+    slot_count: u32,
+    max_fps: u32,
+    handler: ?WebviewFrameStreamHandler,
+) bool {
+    clearLastError();
+    const WebviewStartFrameStreamFn = *const fn (
+        WebviewPtr,
+        ?[*]u8,
+        u64,
+        u32,
+        u32,
+        ?WebviewFrameStreamHandler,
+    ) callconv(.c) bool;
+    const webview = requireWebviewPtr(webview_id) orelse return false;
+    const webview_start_frame_stream = lookupOptionalNativeSymbol(
+        WebviewStartFrameStreamFn,
+        "webviewStartFrameStream",
+    ) orelse return false;
+    return webview_start_frame_stream(webview, ring, ring_len, slot_count, max_fps, handler);
+}
+
+export fn webviewStopFrameStream(webview_id: u32) void {
+    clearLastError();
+    const WebviewStopFrameStreamFn = *const fn (WebviewPtr) callconv(.c) void;
+    const webview = requireWebviewPtr(webview_id) orelse return;
+    const webview_stop_frame_stream = lookupOptionalNativeSymbol(
+        WebviewStopFrameStreamFn,
+        "webviewStopFrameStream",
+    ) orelse return;
+    webview_stop_frame_stream(webview);
+}
+
+export fn takeWebviewSnapshotDataUrl(request_id: u32, out: ?[*]u8, out_len: u64) bool {
+    const TakeWebviewSnapshotDataUrlFn = *const fn (u32, ?[*]u8, u64) callconv(.c) bool;
+    const take_webview_snapshot_data_url = lookupOptionalNativeSymbol(
+        TakeWebviewSnapshotDataUrlFn,
+        "takeWebviewSnapshotDataUrl",
+    ) orelse return false;
+    return take_webview_snapshot_data_url(request_id, out, out_len);
+}
+
 export fn setWebviewNavigationRules(webview_id: u32, rules_json: [*:0]const u8) void {
     clearLastError();
     const SetWebviewNavigationRulesFn = *const fn (WebviewPtr, [*:0]const u8) callconv(.c) void;
@@ -3886,6 +4062,51 @@ export fn captureScreenRegion(
     return capture_screen_region(x, y, width, height, out_rgba, out_len);
 }
 
+export fn captureScreenRegionScaled(
+    x: f64,
+    y: f64,
+    width: u32,
+    height: u32,
+    output_width: u32,
+    output_height: u32,
+    out_rgba: ?[*]u8,
+    out_len: u64,
+) bool {
+    const CaptureScreenRegionScaledFn = *const fn (
+        f64,
+        f64,
+        u32,
+        u32,
+        u32,
+        u32,
+        ?[*]u8,
+        u64,
+    ) callconv(.c) bool;
+    const capture_screen_region_scaled = lookupOptionalNativeSymbol(
+        CaptureScreenRegionScaledFn,
+        "captureScreenRegionScaled",
+    ) orelse return false;
+    return capture_screen_region_scaled(
+        x,
+        y,
+        width,
+        height,
+        output_width,
+        output_height,
+        out_rgba,
+        out_len,
+    );
+}
+
+export fn getScreenRegionChangeSequence(x: f64, y: f64, width: u32, height: u32) u64 {
+    const GetScreenRegionChangeSequenceFn = *const fn (f64, f64, u32, u32) callconv(.c) u64;
+    const get_change_sequence = lookupOptionalNativeSymbol(
+        GetScreenRegionChangeSequenceFn,
+        "getScreenRegionChangeSequence",
+    ) orelse return 0;
+    return get_change_sequence(x, y, width, height);
+}
+
 export fn getMouseButtons() u64 {
     const GetMouseButtonsFn = *const fn () callconv(.c) u64;
     const get_mouse_buttons = lookupNativeSymbol(GetMouseButtonsFn, "getMouseButtons") orelse return 0;
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <map>
 #include <mutex>
+#include <unistd.h>
 #include "include/cef_app.h"
 #include "include/cef_client.h"
 #include "include/cef_v8.h"
@@ -63,6 +64,15 @@ public:
         // Log the context creation
         std::string frameUrl = frame->GetURL().ToString();
 
+        // Tell the browser process which renderer hosts this webview, for
+        // per-webview memory and CPU stats. Sent on every main frame context
+        // since a cross-site navigation can move the view to a new renderer.
+        if (frame->IsMain()) {
+            CefRefPtr<CefProcessMessage> pidMessage = CefProcessMessage::Create("ElectrobunRenderProcessId");
+            pidMessage->GetArgumentList()->SetInt(0, static_cast<int>(getpid()));
+            frame->SendProcessMessage(PID_BROWSER, pidMessage);
+        }
+
         // Get the global window object
         CefRefPtr<CefV8Context> v8Context = frame->GetV8Context();
         v8Context->Enter();
@@ -39,11 +39,16 @@
 #include <sys/stat.h>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <fstream>
 #include <filesystem>
 #include <set>
 #include <cstdarg>
 #include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <netinet/in.h>
 #include "dawn/webgpu.h"
 
@@ -72,8 +77,25 @@
 #include "../shared/dialog_paths.h"
 #include "../shared/cef_find_session.h"
 #include "../shared/linux_dpi.h"
+#include "../shared/linux_mask_region.h"
 #include "../shared/linux_x11_geometry.h"
+#include "../shared/cef_layout_nudge.h"
+#include "../shared/linux_osr_frame.h"
+#include "../shared/linux_process_stats.h"
+#include "../shared/webview_lifecycle.h"
+#include "../shared/screen_capture_downscale.h"
+#include "../shared/linux_osr_paint_policy.h"
+#include "../shared/webview_frame_ring.h"
+#include "../shared/wgpu_readback_ring.h"
+#include "../shared/wgpu_frame_stats.h"
+#include "../shared/linux_wgpu_library.h"
+#include "../shared/session_cookies.h"
+#include "../shared/webview_pool.h"
+#include "../shared/startup_trace.h"
+#include "x11_shm_image.h"
 #include "wayland_screen_capture.h"
+#include "x11_screen_capture.h"
+#include "snapshot_encoder.h"
 
 using namespace electrobun;
 
@@ -83,6 +105,18 @@ static AsarArchive* g_asarArchive = nullptr;
 static std::once_flag g_asarArchiveInitFlag;
 static std::mutex g_asarReadMutex; // Mutex to protect ASAR read operations
 
+// Opens g_asarArchive once, whichever of the views:// handlers or the startup
+// prefetch gets there first; the rest wait for it. `caller` prefixes the error.
+static void openAsarArchiveOnce(const char* asarPath, const char* caller) {
+    std::call_once(g_asarArchiveInitFlag, [asarPath, caller]() {
+        g_asarArchive = asar_open(asarPath);
+        if (!g_asarArchive) {
+            printf("ERROR %s: Failed to open ASAR archive at %s\n", caller, asarPath);
+            fflush(stdout);
+        }
+    });
+}
+
 // Global shutdown flag to prevent race conditions during cleanup
 // Note: shared/shutdown_guard.h provides ShutdownManager singleton for new code
 // This local atomic is kept for direct access patterns used throughout this file
@@ -127,6 +161,8 @@ using electrobun::OperationGuard;
 #include "../shared/permissions_cef.h"
 #include "../shared/partition_context.h"
 #include "include/cef_download_handler.h"
+#include "include/cef_frame_handler.h"
+#include "include/cef_devtools_message_observer.h"
 #include "include/wrapper/cef_helpers.h"
 
 // CEF dynamic loader for weak linking
@@ -232,6 +268,33 @@ static std::string deriveLinuxWindowClass(
     return result;
 }
 
+// Startup phase markers, recorded only when ELECTROBUN_STARTUP_TRACE is set
+// (see startup_trace.h). Null otherwise, so a marker is a single branch. The
+// trace is written after the first paint and again when the event loop exits.
+static electrobun::StartupTrace* g_startupTrace = nullptr;
+static std::string g_startupTracePath;
+
+// g_startupTrace for a phase that is only recorded the first time it runs.
+static electrobun::StartupTrace* startupTraceFirst(const char* name) {
+    return g_startupTrace && g_startupTrace->claimFirst(name) ? g_startupTrace : nullptr;
+}
+
+static void writeStartupTrace() {
+    if (g_startupTrace && !g_startupTrace->write(g_startupTracePath, getpid())) {
+        fprintf(stderr, "Failed to write the startup trace to %s\n", g_startupTracePath.c_str());
+    }
+}
+
+// Marks a webview milestone the first time any webview reaches it and writes
+// what startup has recorded so far. Windowed CEF has no paint callback, so
+// firstLoadFinished is its last startup marker.
+static void markStartupMilestone(const char* name, const char* engine) {
+    if (electrobun::StartupTrace* trace = startupTraceFirst(name)) {
+        trace->instant(name, engine);
+        writeStartupTrace();
+    }
+}
+
 // The launcher sets this private marker only for the exact `--automation`
 // opt-in. WebKitGTK permits automation on one context per process, so the first
 // context used by an Electrobun WebKit view becomes the sole automation context.
@@ -305,84 +368,33 @@ void applyApplicationMenuToX11Window(X11Window* x11win);
 using electrobun::parseMenuJson;
 
 // Mask rectangle structure for X11 regions
-struct MaskRect {
-    double x, y, width, height;
-};
+using MaskRect = electrobun::LinuxMaskRect;
 
 // Parse maskJSON string into rectangles
 std::vector<MaskRect> parseMaskJson(const std::string& jsonStr) {
-    std::vector<MaskRect> rects;
-    
-    
-    if (jsonStr.empty()) {
-        return rects;
-    }
-    
-    // Handle double-escaped JSON by unescaping quotes
-    std::string unescapedJson = jsonStr;
-    size_t pos = 0;
-    while ((pos = unescapedJson.find("\\\"", pos)) != std::string::npos) {
-        unescapedJson.replace(pos, 2, "\"");
-        pos += 1;
+    return electrobun::parseLinuxMaskJson(jsonStr.c_str());
+}
+
+// Replace one shape kind of window with a precomputed YX-banded region in a
+// single request, unless the window already carries exactly that region.
+static bool applyMaskRegion(
+    Display* display,
+    Window window,
+    int shapeKind,
+    const std::vector<LinuxXRectangleFields>& region,
+    electrobun::LinuxMaskRegionCache& cache
+) {
+    if (!display || !window || !cache.needsUpdate(window, region)) {
+        return false;
     }
-    
-    // Simple JSON parser for rectangle arrays
-    // Looking for patterns like [{"x":10,"y":20,"width":100,"height":50}]
-    size_t parsePos = 0;
-    while (parsePos < unescapedJson.length()) {
-        size_t objStart = unescapedJson.find("{", parsePos);
-        if (objStart == std::string::npos) break;
-        
-        size_t objEnd = unescapedJson.find("}", objStart);
-        if (objEnd == std::string::npos) break;
-        
-        std::string obj = unescapedJson.substr(objStart, objEnd - objStart + 1);
-        
-        MaskRect rect = {};
-        
-        // Geometry originates in getBoundingClientRect(), so retain fractional
-        // DIPs until the final X11 conversion.
-        // Parse x
-        size_t xPos = obj.find("\"x\":");
-        if (xPos != std::string::npos) {
-            size_t valueStart = obj.find_first_of("0123456789-.", xPos + 4);
-            if (valueStart != std::string::npos) {
-                rect.x = strtod(obj.c_str() + valueStart, nullptr);
-            }
-        }
-        
-        // Parse y
-        size_t yPos = obj.find("\"y\":");
-        if (yPos != std::string::npos) {
-            size_t valueStart = obj.find_first_of("0123456789-.", yPos + 4);
-            if (valueStart != std::string::npos) {
-                rect.y = strtod(obj.c_str() + valueStart, nullptr);
-            }
-        }
-        
-        // Parse width
-        size_t widthPos = obj.find("\"width\":");
-        if (widthPos != std::string::npos) {
-            size_t valueStart = obj.find_first_of("0123456789-.", widthPos + 8);
-            if (valueStart != std::string::npos) {
-                rect.width = strtod(obj.c_str() + valueStart, nullptr);
-            }
-        }
-        
-        // Parse height
-        size_t heightPos = obj.find("\"height\":");
-        if (heightPos != std::string::npos) {
-            size_t valueStart = obj.find_first_of("0123456789-.", heightPos + 9);
-            if (valueStart != std::string::npos) {
-                rect.height = strtod(obj.c_str() + valueStart, nullptr);
-            }
-        }
-        
-        rects.push_back(rect);
-        parsePos = objEnd + 1;
+    std::vector<XRectangle> rects(region.size());
+    for (size_t i = 0; i < region.size(); ++i) {
+        rects[i] = {region[i].x, region[i].y, region[i].width, region[i].height};
     }
-    
-    return rects;
+    XShapeCombineRectangles(display, window, shapeKind, 0, 0,
+                            rects.data(), static_cast<int>(rects.size()),
+                            ShapeSet, YXBanded);
+    return true;
 }
 
 // Check if a point is within any of the mask rectangles
@@ -403,6 +415,10 @@ class AbstractView;
 
 // Helper function to check navigation rules - defined after AbstractView class
 bool checkNavigationRules(std::shared_ptr<AbstractView> view, const std::string& url);
+// Times the reload of a discarded webview - defined with the lifecycle policy
+static void noteWebviewLifecycleLoadFinished(uint32_t webviewId);
+// Forgets untaken snapshot results - defined with getWebviewSnapshotWithOptions
+static void dropWebviewSnapshotResults(uint32_t webviewId);
 
 // CEF globals and implementation
 static std::atomic<bool> g_cefInitialized{false};
@@ -542,6 +558,8 @@ bool isCEFAvailable() {
         return g_useCEF;
     }
     
+    electrobun::StartupTraceScope trace(g_startupTrace, "isCEFAvailable");
+
     // Perform the check once and cache the result
     // Get the directory where the executable is located
     std::string execDir = getExecutableDir();
@@ -743,12 +761,7 @@ public:
         // Check if ASAR archive exists
         if (g_file_test(asarPath, G_FILE_TEST_EXISTS)) {
             // Thread-safe lazy-load ASAR archive on first use
-            std::call_once(g_asarArchiveInitFlag, [asarPath]() {
-                g_asarArchive = asar_open(asarPath);
-                if (!g_asarArchive) {
-                    printf("ERROR CEF loadViewsFile: Failed to open ASAR archive at %s\n", asarPath);
-                }
-            });
+            openAsarArchiveOnce(asarPath, "CEF loadViewsFile");
 
             // If ASAR archive is loaded, try to read from it
             if (g_asarArchive) {
@@ -1004,6 +1017,12 @@ private:
 };
 
 
+// CEF browser windows watched for MapNotify/ConfigureNotify layout signals.
+// Defined after ElectrobunClient; only touched on the GTK main thread.
+class ElectrobunClient;
+static void registerCEFLayoutWatchWindow(Window window, ElectrobunClient* client);
+static void unregisterCEFLayoutWatchWindow(Window window);
+
 // ElectrobunClient implementation for Linux
 class ElectrobunClient : public CefClient,
                         public CefLoadHandler,
@@ -1016,6 +1035,7 @@ class ElectrobunClient : public CefClient,
                         public CefPermissionHandler,
                         public CefDialogHandler,
                         public CefDownloadHandler,
+                        public CefFrameHandler,
                         public CefRenderHandler {
 private:
     uint32_t webview_id_;
@@ -1037,7 +1057,15 @@ private:
     std::function<void()> load_end_callback_;  // Callback for page load completion
     std::atomic<bool> owner_detached_{false};
     std::atomic<bool> initial_browser_creation_pending_{false};
-    guint layout_interval_source_id_ = 0;
+    // Reported by the renderer on each main frame context; 0 until then.
+    std::atomic<int> render_process_id_{0};
+    // Set while the lifecycle policy holds the page discarded on about:blank,
+    // whose navigation is neither filtered nor reported. Main thread only.
+    bool lifecycle_discarded_ = false;
+    CefLayoutNudgeState layout_nudge_;
+    guint layout_nudge_source_id_ = 0;
+    guint layout_fallback_source_id_ = 0;
+    Window layout_watch_window_ = 0;
     
     // OSR (Off-Screen Rendering) members for transparency
     Window x11_window_;
@@ -1046,6 +1074,27 @@ private:
     int osr_width_, osr_height_;
     Cursor osr_cursor_;
     std::mutex osr_state_mutex_;
+
+    // Persistent OSR presentation state. The visual, GC and image survive
+    // across frames and are rebuilt only when the target window or surface
+    // size changes.
+    x11_shm::Image osr_image_;
+    Visual* osr_visual_ = nullptr;
+    int osr_depth_ = 0;
+    GC osr_gc_ = nullptr;
+    LinuxOsrPixelFormat osr_format_ = {};
+    bool osr_format_valid_ = false;
+    bool osr_needs_full_upload_ = true;
+
+    // Frame rate and WasHidden state last pushed to the browser host.
+    LinuxOsrPaintPolicy osr_paint_policy_;
+    // Optional copy of each OSR frame for recording; guarded by
+    // osr_state_mutex_ like the rest of the OSR state.
+    WebviewFrameRingWriter frame_stream_;
+    WebviewFrameStreamHandler frame_stream_handler_ = nullptr;
+    std::vector<WebviewFrameDirtyRect> frame_stream_dirty_;
+    guint frame_stream_flush_source_id_ = 0;
+    LinuxOsrPaintDecision osr_applied_paint_ = {false, LinuxOsrPaintPolicy::kDefaultFrameRate};
     
     // Parent window handle for proper CEF window parenting
     Window parent_window_handle_;
@@ -1106,6 +1155,14 @@ public:
         return browser_;
     }
 
+    int GetRenderProcessId() const {
+        return render_process_id_.load();
+    }
+
+    void SetLifecycleDiscarded(bool discarded) {
+        lifecycle_discarded_ = discarded;
+    }
+
     void MarkInitialBrowserCreationPending() {
         bool expected = false;
         if (initial_browser_creation_pending_.compare_exchange_strong(expected, true)) {
@@ -1134,17 +1191,117 @@ public:
         load_end_callback_ = callback;
     }
 
-    void CancelLayoutInterval() {
-        const guint sourceId = layout_interval_source_id_;
-        layout_interval_source_id_ = 0;
-        if (sourceId) {
-            g_source_remove(sourceId);
+    void CancelLayoutNudges() {
+        const guint nudgeSourceId = layout_nudge_source_id_;
+        const guint fallbackSourceId = layout_fallback_source_id_;
+        layout_nudge_source_id_ = 0;
+        layout_fallback_source_id_ = 0;
+        layout_nudge_.cancel();
+        if (nudgeSourceId) {
+            g_source_remove(nudgeSourceId);
+        }
+        if (fallbackSourceId) {
+            g_source_remove(fallbackSourceId);
+        }
+        if (layout_watch_window_) {
+            unregisterCEFLayoutWatchWindow(layout_watch_window_);
+            layout_watch_window_ = 0;
+        }
+    }
+
+    // A frame that may need OOPIF placement appeared; the next signal, or
+    // this call, delivers one nudge.
+    void ArmLayoutNudge() {
+        layout_nudge_.arm();
+        RequestLayoutNudge();
+    }
+
+    // OOPIFs are positioned by Chromium only after it sees input or geometry
+    // changes on the browser window. Real signals call this; it does nothing
+    // unless a layout is pending, and requests within one main-loop turn
+    // share a single idle delivery.
+    void RequestLayoutNudge() {
+        if (!browser_ || g_shuttingDown.load() || owner_detached_.load()) {
+            return;
+        }
+        if (!layout_nudge_.request()) {
+            return;
+        }
+
+        struct LayoutNudgeData {
+            CefRefPtr<ElectrobunClient> owner;
+        };
+        layout_nudge_source_id_ = g_idle_add_full(
+            G_PRIORITY_DEFAULT_IDLE,
+            [](gpointer data) -> gboolean {
+                auto* nudge = static_cast<LayoutNudgeData*>(data);
+                nudge->owner->layout_nudge_source_id_ = 0;
+                nudge->owner->DeliverLayoutNudge();
+                return G_SOURCE_REMOVE;
+            },
+            new LayoutNudgeData{this},
+            [](gpointer data) {
+                delete static_cast<LayoutNudgeData*>(data);
+            });
+    }
+
+    void DeliverLayoutNudge() {
+        CefLayoutNudgeSize size = layout_nudge_.deliver();
+        CefRefPtr<CefBrowser> browser = browser_;
+        if (!browser || g_shuttingDown.load() || owner_detached_.load()) {
+            return;
+        }
+
+        CefWindowHandle cefWindow = browser->GetHost()->GetWindowHandle();
+        if (!cefWindow || cefWindow == 0x1) {
+            return;
+        }
+
+        // ConfigureNotify keeps the size current; query X only when no
+        // geometry has been observed yet.
+        if (!size.known) {
+            XWindowAttributes attrs;
+            if (!parent_display_ ||
+                XGetWindowAttributes(parent_display_, (Window)cefWindow, &attrs) == 0) {
+                return;
+            }
+            layout_nudge_.observeSize(attrs.width, attrs.height);
+            size = {true, attrs.width, attrs.height};
+        }
+
+        // A pointer move is enough input for Chromium to recompute OOPIF
+        // placement, and unlike a wheel it fires no page scroll handlers.
+        CefMouseEvent nudgeEvent;
+        nudgeEvent.x = size.width / 2;
+        nudgeEvent.y = size.height / 2;
+        browser->GetHost()->SendMouseMoveEvent(nudgeEvent, false);
+    }
+
+    // Called from the X11 drain for the watched CEF browser window.
+    void HandleLayoutWatchEvent(const XEvent& event) {
+        switch (event.type) {
+            case MapNotify:
+                RequestLayoutNudge();
+                break;
+            case ConfigureNotify:
+                layout_nudge_.observeSize(
+                    event.xconfigure.width,
+                    event.xconfigure.height);
+                RequestLayoutNudge();
+                break;
+            case DestroyNotify:
+                if (event.xdestroywindow.window == layout_watch_window_) {
+                    unregisterCEFLayoutWatchWindow(layout_watch_window_);
+                    layout_watch_window_ = 0;
+                }
+                break;
         }
     }
 
     void DetachOwnerCallbacks() {
         owner_detached_.store(true);
-        CancelLayoutInterval();
+        CancelLayoutNudges();
+        StopFrameStream();
         DisableOSR();
         browser_created_callback_ = nullptr;
         browser_close_callback_ = nullptr;
@@ -1161,18 +1318,27 @@ public:
     }
     
     void EnableOSR(Window x11_window, Display* display, int width, int height) {
-        std::lock_guard<std::mutex> lock(osr_state_mutex_);
-        x11_window_ = x11_window;
-        display_ = display;
-        osr_enabled_ = true;
-        osr_width_ = std::max(1, width);
-        osr_height_ = std::max(1, height);
-        printf("CEF: OSR enabled for window %lu, size %dx%d\n", x11_window, width, height);
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            if (x11_window_ != x11_window || display_ != display) {
+                ReleaseOSRPresentationLocked();
+            }
+            x11_window_ = x11_window;
+            display_ = display;
+            osr_enabled_ = true;
+            osr_paint_policy_.setMapped(true);
+            osr_width_ = std::max(1, width);
+            osr_height_ = std::max(1, height);
+            printf("CEF: OSR enabled for window %lu, size %dx%d\n", x11_window, width, height);
+        }
+        // Resume a host that OnPaint stopped while OSR was disabled.
+        ApplyOSRPaintPolicy();
     }
 
     void DisableOSR() {
         std::lock_guard<std::mutex> lock(osr_state_mutex_);
         osr_enabled_ = false;
+        ReleaseOSRPresentationLocked();
         if (display_ && osr_cursor_) {
             XFreeCursor(display_, osr_cursor_);
         }
@@ -1181,6 +1347,192 @@ public:
         display_ = nullptr;
     }
 
+    void ReleaseOSRPresentationLocked() {
+        osr_image_.release();
+        if (display_ && osr_gc_) {
+            XFreeGC(display_, osr_gc_);
+        }
+        osr_gc_ = nullptr;
+        osr_visual_ = nullptr;
+        osr_depth_ = 0;
+        osr_format_valid_ = false;
+        osr_needs_full_upload_ = true;
+    }
+
+    // Push the paint policy to the browser host when its outcome changes.
+    // Hidden views produce no OnPaint calls and have their timers throttled
+    // by Chromium; returning views repaint in full because X discarded the
+    // window contents while unmapped.
+    void ApplyOSRPaintPolicy() {
+        CefRefPtr<CefBrowser> browser;
+        LinuxOsrPaintDecision decision;
+        LinuxOsrPaintDecision applied;
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            if (!osr_enabled_ || !browser_) return;
+            decision = osr_paint_policy_.decision();
+            if (decision == osr_applied_paint_) return;
+            applied = osr_applied_paint_;
+            osr_applied_paint_ = decision;
+            if (applied.hidden && !decision.hidden) {
+                osr_needs_full_upload_ = true;
+            }
+            browser = browser_;
+        }
+
+        CefRefPtr<CefBrowserHost> host = browser->GetHost();
+        if (decision.frameRate != applied.frameRate) {
+            host->SetWindowlessFrameRate(decision.frameRate);
+        }
+        if (decision.hidden != applied.hidden) {
+            host->WasHidden(decision.hidden);
+            if (!decision.hidden) {
+                // The window may have moved between monitors while hidden.
+                host->NotifyScreenInfoChanged();
+                host->Invalidate(PET_VIEW);
+            }
+        }
+    }
+
+    void SetOSRFrameRate(int frameRate) {
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            osr_paint_policy_.setForegroundFrameRate(frameRate);
+        }
+        ApplyOSRPaintPolicy();
+    }
+
+    void SetOSRThrottled(bool throttled) {
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            osr_paint_policy_.setThrottled(throttled);
+        }
+        ApplyOSRPaintPolicy();
+    }
+
+    bool StartFrameStream(uint8_t* ring, uint64_t ringLength, uint32_t slotCount,
+                          uint32_t maxFps, WebviewFrameStreamHandler handler) {
+        CefRefPtr<CefBrowser> browser;
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            CancelFrameStreamFlushLocked();
+            frame_stream_handler_ = nullptr;
+            if (!frame_stream_.attach(ring, ringLength, slotCount, maxFps)) {
+                return false;
+            }
+            frame_stream_handler_ = handler;
+            browser = browser_;
+        }
+        // Publish the current contents now rather than at the next damage.
+        if (browser) {
+            browser->GetHost()->Invalidate(PET_VIEW);
+        }
+        return true;
+    }
+
+    void StopFrameStream() {
+        std::lock_guard<std::mutex> lock(osr_state_mutex_);
+        CancelFrameStreamFlushLocked();
+        frame_stream_.detach();
+        frame_stream_handler_ = nullptr;
+    }
+
+    void CancelFrameStreamFlushLocked() {
+        if (frame_stream_flush_source_id_) {
+            g_source_remove(frame_stream_flush_source_id_);
+            frame_stream_flush_source_id_ = 0;
+        }
+    }
+
+    // Copy a painted frame into the stream. Frames inside the max-FPS
+    // interval are skipped; if nothing paints afterwards, a repaint is
+    // requested once the interval ends so the last state is not lost.
+    void PublishStreamFrameLocked(const RectList& dirtyRects,
+                                  const void* buffer,
+                                  int width,
+                                  int height) {
+        frame_stream_dirty_.clear();
+        for (const auto& rect : dirtyRects) {
+            frame_stream_dirty_.push_back({rect.x, rect.y, rect.width, rect.height});
+        }
+        const uint64_t now = static_cast<uint64_t>(g_get_monotonic_time());
+        const auto result = frame_stream_.submit(
+            static_cast<const uint8_t*>(buffer), static_cast<size_t>(width) * 4,
+            width, height,
+            frame_stream_dirty_.empty() ? nullptr : frame_stream_dirty_.data(),
+            frame_stream_dirty_.size(), now);
+        if (result == WebviewFrameSubmitResult::Published) {
+            CancelFrameStreamFlushLocked();
+            if (frame_stream_handler_) {
+                frame_stream_handler_(webview_id_, static_cast<uint32_t>(frame_stream_.sequence()));
+            }
+            return;
+        }
+        if (result != WebviewFrameSubmitResult::Throttled || frame_stream_flush_source_id_) {
+            return;
+        }
+
+        struct FrameStreamFlushData {
+            CefRefPtr<ElectrobunClient> owner;
+        };
+        const guint delayMs = static_cast<guint>((frame_stream_.throttleDelayUs(now) + 999) / 1000);
+        frame_stream_flush_source_id_ = g_timeout_add_full(
+            G_PRIORITY_DEFAULT,
+            std::max<guint>(1, delayMs),
+            [](gpointer data) -> gboolean {
+                auto* flush = static_cast<FrameStreamFlushData*>(data);
+                CefRefPtr<CefBrowser> browser;
+                {
+                    std::lock_guard<std::mutex> lock(flush->owner->osr_state_mutex_);
+                    flush->owner->frame_stream_flush_source_id_ = 0;
+                    if (flush->owner->frame_stream_.hasPendingFrame()) {
+                        browser = flush->owner->browser_;
+                    }
+                }
+                if (browser && !g_shuttingDown.load()) {
+                    browser->GetHost()->Invalidate(PET_VIEW);
+                }
+                return G_SOURCE_REMOVE;
+            },
+            new FrameStreamFlushData{this},
+            [](gpointer data) {
+                delete static_cast<FrameStreamFlushData*>(data);
+            });
+    }
+
+    void SetOSRHidden(bool hidden) {
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            osr_paint_policy_.setHidden(hidden);
+        }
+        ApplyOSRPaintPolicy();
+    }
+
+    void HandleOSRVisibilityEvent(const XEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(osr_state_mutex_);
+            switch (event.type) {
+                case MapNotify:
+                    osr_paint_policy_.setMapped(true);
+                    break;
+                case UnmapNotify:
+                    osr_paint_policy_.setMapped(false);
+                    break;
+                case VisibilityNotify:
+                    osr_paint_policy_.setVisibility(
+                        event.xvisibility.state == VisibilityFullyObscured
+                            ? LinuxOsrPaintPolicy::Visibility::FullyObscured
+                            : event.xvisibility.state == VisibilityPartiallyObscured
+                                ? LinuxOsrPaintPolicy::Visibility::PartiallyObscured
+                                : LinuxOsrPaintPolicy::Visibility::Unobscured);
+                    break;
+                default:
+                    return;
+            }
+        }
+        ApplyOSRPaintPolicy();
+    }
+
     void UpdateOSRSize(int width, int height) {
         std::lock_guard<std::mutex> lock(osr_state_mutex_);
         if (!osr_enabled_) return;
@@ -1248,6 +1600,10 @@ public:
         return this;
     }
 
+    virtual CefRefPtr<CefFrameHandler> GetFrameHandler() override {
+        return this;
+    }
+
     virtual CefRefPtr<CefRenderHandler> GetRenderHandler() override {
         return this;
     }
@@ -1352,6 +1708,9 @@ public:
                        bool user_gesture,
                        bool is_redirect) override {
         std::string url = request->GetURL().ToString();
+        if (lifecycle_discarded_ && frame->IsMain() && url == "about:blank") {
+            return false;
+        }
 
         // Check for Ctrl key using GDK (must use pointer device, not keyboard, for gdk_device_get_state)
         GdkDisplay* display = gdk_display_get_default();
@@ -1455,6 +1814,7 @@ public:
     void OnLoadStart(CefRefPtr<CefBrowser> browser,
                      CefRefPtr<CefFrame> frame,
                      TransitionType transition_type) override {
+        if (lifecycle_discarded_) return;
         if (frame->IsMain() && webview_event_handler_) {
             std::string url = frame->GetURL().ToString();
             webview_event_handler_(webview_id_, strdup("did-commit-navigation"), strdup(url.c_str()));
@@ -1464,6 +1824,11 @@ public:
     void OnLoadEnd(CefRefPtr<CefBrowser> browser,
                   CefRefPtr<CefFrame> frame,
                   int httpStatusCode) override {
+        if (lifecycle_discarded_) return;
+        if (frame->IsMain()) {
+            markStartupMilestone("firstLoadFinished", "cef");
+            noteWebviewLifecycleLoadFinished(webview_id_);
+        }
         if (frame->IsMain() && webview_event_handler_) {
             std::string url = frame->GetURL().ToString();
             webview_event_handler_(webview_id_, strdup("did-navigate"), strdup(url.c_str()));
@@ -1473,7 +1838,21 @@ public:
         if (frame->IsMain() && !owner_detached_.load() && load_end_callback_) {
             load_end_callback_();
         }
-        
+
+        // Subframe loads are where OOPIFs commit.
+        if (!frame->IsMain()) {
+            ArmLayoutNudge();
+        }
+    }
+
+    void OnFrameAttached(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         bool reattached) override {
+        (void)browser;
+        (void)reattached;
+        if (!frame->IsMain()) {
+            ArmLayoutNudge();
+        }
     }
 
     // Context menu handler with DevTools option
@@ -1584,6 +1963,9 @@ public:
         SetBrowser(browser);
         ResolveInitialBrowserCreationPending();
 
+        // Push any frame rate or visibility configured before creation.
+        ApplyOSRPaintPolicy();
+
         // Keep a strong reference until OnBeforeClose. A view may already have
         // been removed from g_webviewMap while its close is still in flight.
         {
@@ -1605,79 +1987,6 @@ public:
             return;
         }
 
-        // Schedule rapid interval to trigger OOPIF positioning
-        // Runs every 5ms for up to 1 second to ensure OOPIFs are positioned correctly
-        struct LayoutIntervalData {
-            CefRefPtr<ElectrobunClient> owner;
-            CefRefPtr<CefBrowser> browser;
-            Display* display;
-            gint64 start_time;
-        };
-
-        CancelLayoutInterval();
-        auto* interval_data = new LayoutIntervalData{
-            this,
-            browser,
-            parent_display_,
-            g_get_monotonic_time(), // microseconds since arbitrary point
-        };
-
-        layout_interval_source_id_ = g_timeout_add_full(
-            G_PRIORITY_DEFAULT,
-            5,
-            [](gpointer data) -> gboolean {
-            auto* lid = static_cast<LayoutIntervalData*>(data);
-
-            const auto finish = [lid]() {
-                if (lid->owner) {
-                    lid->owner->layout_interval_source_id_ = 0;
-                }
-                return G_SOURCE_REMOVE;
-            };
-
-            // Check if 1 second has elapsed
-            gint64 elapsed = g_get_monotonic_time() - lid->start_time;
-            if (elapsed > 1000000) { // 1 second in microseconds
-                return finish();
-            }
-
-            if (g_shuttingDown.load() || !lid->owner ||
-                lid->owner->owner_detached_.load()) {
-                return finish();
-            }
-
-            if (lid->browser) {
-                CefWindowHandle cefWindow = lid->browser->GetHost()->GetWindowHandle();
-                
-                if (cefWindow && cefWindow != 0x1) {
-                    
-                    
-                    // Get window dimensions for mouse event coordinates
-                    Display* display = lid->display;
-                    XWindowAttributes attrs;
-                    if (display && XGetWindowAttributes(display, (Window)cefWindow, &attrs) != 0) {
-                        // Send mouse move event to trigger layout recalculation
-                        CefMouseEvent moveEvent;
-                        moveEvent.x = attrs.width / 2;
-                        moveEvent.y = attrs.height / 2;
-                        lid->browser->GetHost()->SendMouseMoveEvent(moveEvent, false);
-                        
-                        // Send minimal scroll event
-                        CefMouseEvent scrollEvent;
-                        scrollEvent.x = attrs.width / 2;
-                        scrollEvent.y = attrs.height / 2;
-                        lid->browser->GetHost()->SendMouseWheelEvent(scrollEvent, 0, 1);
-                        lid->browser->GetHost()->SendMouseWheelEvent(scrollEvent, 0, -1);
-                    }
-                    
-                }
-            }
-
-            return G_SOURCE_CONTINUE; // Continue interval
-        }, interval_data, [](gpointer data) {
-            delete static_cast<LayoutIntervalData*>(data);
-        });
-        
         // The CEF browser window is now fully created
         CefWindowHandle cefWindow = browser->GetHost()->GetWindowHandle();
         
@@ -1697,6 +2006,15 @@ public:
             // Ensure the CEF window is properly parented to the main window
             if (parent_window_handle_) {
                 if (cefWindow != 0x1 && result != 0) {
+                    // Watch the browser window before mapping it so the
+                    // MapNotify that follows drives the first layout nudge.
+                    CancelLayoutNudges();
+                    layout_nudge_.observeSize(attrs.width, attrs.height);
+                    layout_nudge_.arm();
+                    XSelectInput(display, cefWindow, StructureNotifyMask);
+                    registerCEFLayoutWatchWindow(cefWindow, this);
+                    layout_watch_window_ = cefWindow;
+
                     XReparentWindow(display, cefWindow, parent_window_handle_, 0, 0);
                     XMapRaised(display, cefWindow);
                     XFlush(display);
@@ -1742,6 +2060,25 @@ public:
             }
         }
 
+        // Bounded fallback for OOPIFs that attach without an observable
+        // signal; a single timer instead of a per-browser polling interval.
+        struct LayoutFallbackData {
+            CefRefPtr<ElectrobunClient> owner;
+        };
+        layout_fallback_source_id_ = g_timeout_add_full(
+            G_PRIORITY_DEFAULT,
+            CefLayoutNudgeState::kFallbackDelayMs,
+            [](gpointer data) -> gboolean {
+                auto* fallback = static_cast<LayoutFallbackData*>(data);
+                fallback->owner->layout_fallback_source_id_ = 0;
+                fallback->owner->ArmLayoutNudge();
+                return G_SOURCE_REMOVE;
+            },
+            new LayoutFallbackData{this},
+            [](gpointer data) {
+                delete static_cast<LayoutFallbackData*>(data);
+            });
+
         // Reparenting above resets child coordinates to 0,0. Notify the owning
         // view only after that step so its final WM/DPI-aware bounds win.
         if (!owner_detached_.load() && browser_created_callback_) {
@@ -1752,7 +2089,7 @@ public:
     // Critical: Handle browser cleanup to prevent use-after-free
     void OnBeforeClose(CefRefPtr<CefBrowser> browser) override {
         printf("CEF: OnBeforeClose called for browser %d\n", browser->GetIdentifier());
-        CancelLayoutInterval();
+        CancelLayoutNudges();
 
         // This is the shutdown barrier: only after this erase may the main
         // loop observe that every CEF browser has finished closing.
@@ -1895,8 +2232,13 @@ public:
         
         bool result = false;
 
+        // Sent by our helper itself, not page script, so sandboxed webviews report it too
+        if (messageName == "ElectrobunRenderProcessId") {
+            render_process_id_.store(message->GetArgumentList()->GetInt(0));
+            result = true;
+        }
         // eventBridge - event-only bridge (always process for all webviews, including sandboxed)
-        if (messageName == "EventBridgeMessage") {
+        else if (messageName == "EventBridgeMessage") {
             event_bridge_handler_(webview_id_, messageContent.c_str());
             result = true;
         }
@@ -2306,66 +2648,89 @@ public:
                  const void* buffer,
                  int width,
                  int height) override {
+        if (type == PET_VIEW) {
+            markStartupMilestone("firstPaint", "cef-osr");
+        }
         std::lock_guard<std::mutex> lock(osr_state_mutex_);
-        if (!osr_enabled_ || !display_ || !x11_window_ || type != PET_VIEW) {
-            printf("CEF OSR OnPaint: skipping (enabled=%d, display=%p, window=%lu, type=%d)\n", 
-                   osr_enabled_, display_, x11_window_, type);
+        if (type != PET_VIEW) {
+            return;
+        }
+        if (frame_stream_.attached()) {
+            PublishStreamFrameLocked(dirtyRects, buffer, width, height);
+        }
+        if (!osr_enabled_ || !display_ || !x11_window_) {
+            // Nothing can present these frames. Stop the host from producing
+            // more; ApplyOSRPaintPolicy resumes it once OSR is enabled again.
+            if (!osr_applied_paint_.hidden) {
+                osr_applied_paint_.hidden = true;
+                browser->GetHost()->WasHidden(true);
+            }
             return;
         }
-        
 
-        // Convert BGRA to ARGB format for X11
-        const uint32_t* src = static_cast<const uint32_t*>(buffer);
-        std::vector<uint32_t> converted_buffer(width * height);
-        
-        for (int i = 0; i < width * height; i++) {
-            uint32_t bgra = src[i];
-            uint32_t b = (bgra >> 0) & 0xFF;
-            uint32_t g = (bgra >> 8) & 0xFF;
-            uint32_t r = (bgra >> 16) & 0xFF;
-            uint32_t a = (bgra >> 24) & 0xFF;
-            
-            // Convert BGRA to ARGB
-            converted_buffer[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        // The window's visual and a GC are resolved once per target window
+        // instead of once per frame.
+        if (!osr_gc_) {
+            XWindowAttributes win_attrs = {};
+            if (!XGetWindowAttributes(display_, x11_window_, &win_attrs)) {
+                return;
+            }
+            osr_visual_ = win_attrs.visual;
+            osr_depth_ = win_attrs.depth;
+            osr_gc_ = XCreateGC(display_, x11_window_, 0, nullptr);
+            osr_needs_full_upload_ = true;
         }
-        
-        // Get window attributes to ensure we have the right visual
-        XWindowAttributes win_attrs = {};
-        if (!XGetWindowAttributes(display_, x11_window_, &win_attrs)) {
+
+        const bool resized = osr_image_.width() != width || osr_image_.height() != height;
+        if (!osr_image_.ensure(display_, osr_visual_, osr_depth_, width, height)) {
             return;
         }
-        
-        // Create XImage with the window's visual for proper transparency support
-        XImage* image = XCreateImage(display_,
-                                   win_attrs.visual,
-                                   win_attrs.depth, // Use window's depth
-                                   ZPixmap,
-                                   0,
-                                   reinterpret_cast<char*>(converted_buffer.data()),
-                                   width,
-                                   height,
-                                   32, // bitmap_pad
-                                   width * 4); // bytes_per_line
-        
-        if (image) {
-            // Create a GC compatible with the window's visual
-            GC gc = XCreateGC(display_, x11_window_, 0, nullptr);
-            
-            // Draw the image to the window
-            XPutImage(display_, x11_window_, gc,
-                     image, 0, 0, 0, 0, width, height);
-            
-            XFlush(display_);
-            XFreeGC(display_, gc);
-            
-            // Clean up (don't free the data since it's from converted_buffer)
-            image->data = nullptr;
-            XDestroyImage(image);
-            
-            
+        if (resized || !osr_format_valid_) {
+            XImage* image = osr_image_.image();
+            osr_format_valid_ = describeLinuxOsrPixelFormat(
+                image->bits_per_pixel,
+                osr_depth_,
+                image->byte_order == MSBFirst,
+                osr_visual_->red_mask,
+                osr_visual_->green_mask,
+                osr_visual_->blue_mask,
+                &osr_format_);
+            if (!osr_format_valid_) {
+                fprintf(stderr, "CEF OSR: unsupported X11 visual (depth %d, %d bpp)\n",
+                        osr_depth_, image->bits_per_pixel);
+                return;
+            }
+            osr_needs_full_upload_ = true;
         }
-        
-       
+
+        // A fresh image holds no pixels yet, so it needs one full upload;
+        // afterwards only CEF's dirty rects are converted and sent.
+        std::vector<LinuxOsrRect> uploads;
+        if (osr_needs_full_upload_) {
+            uploads.push_back({0, 0, width, height});
+            osr_needs_full_upload_ = false;
+        } else {
+            std::vector<LinuxOsrRect> dirty;
+            dirty.reserve(dirtyRects.size());
+            for (const auto& rect : dirtyRects) {
+                dirty.push_back({rect.x, rect.y, rect.width, rect.height});
+            }
+            uploads = planLinuxOsrUploads(dirty, width, height);
+        }
+        if (uploads.empty()) {
+            return;
+        }
+
+        // The server may still be reading the previous frame from the segment.
+        osr_image_.waitForServer();
+        const auto* src = static_cast<const uint8_t*>(buffer);
+        const size_t srcStride = static_cast<size_t>(width) * 4;
+        for (const auto& rect : uploads) {
+            copyLinuxOsrRect(src, srcStride, osr_image_.data(), osr_image_.stride(),
+                             rect, osr_format_);
+            osr_image_.put(x11_window_, osr_gc_, rect.x, rect.y, rect.width, rect.height);
+        }
+        XFlush(display_);
     }
 
 private:
@@ -2395,7 +2760,33 @@ static CefRefPtr<ElectrobunClient> getOSRClientForWindow(uint32_t windowId) {
     return it != g_osrClientsByWindowId.end() ? it->second : nullptr;
 }
 
-static int cefEventModifiersFromXState(unsigned int state) {
+static std::mutex g_cefLayoutWatchMutex;
+static std::map<Window, CefRefPtr<ElectrobunClient>> g_cefLayoutWatchWindows;
+
+static void registerCEFLayoutWatchWindow(Window window, ElectrobunClient* client) {
+    if (!window || !client) return;
+    std::lock_guard<std::mutex> lock(g_cefLayoutWatchMutex);
+    g_cefLayoutWatchWindows[window] = client;
+}
+
+static void unregisterCEFLayoutWatchWindow(Window window) {
+    // Release the client reference outside the lock.
+    CefRefPtr<ElectrobunClient> released;
+    std::lock_guard<std::mutex> lock(g_cefLayoutWatchMutex);
+    auto it = g_cefLayoutWatchWindows.find(window);
+    if (it != g_cefLayoutWatchWindows.end()) {
+        released = it->second;
+        g_cefLayoutWatchWindows.erase(it);
+    }
+}
+
+static CefRefPtr<ElectrobunClient> getCEFLayoutWatchClient(Window window) {
+    std::lock_guard<std::mutex> lock(g_cefLayoutWatchMutex);
+    auto it = g_cefLayoutWatchWindows.find(window);
+    return it != g_cefLayoutWatchWindows.end() ? it->second : nullptr;
+}
+
+static int cefEventModifiersFromXState(unsigned int state) {
     int modifiers = EVENTFLAG_NONE;
     if (state & ShiftMask) modifiers |= EVENTFLAG_SHIFT_DOWN;
     if (state & ControlMask) modifiers |= EVENTFLAG_CONTROL_DOWN;
@@ -2509,6 +2900,40 @@ static void forwardX11EventToOSRClient(const XEvent& event, Display* display, Wi
     }
 }
 
+// Seconds after CEF starts before stale cache tombstones are deleted, so the
+// delete's disk traffic stays clear of the first window and page loads.
+static constexpr guint kCacheTombstoneSweepDelaySeconds = 10;
+
+// Deletes tombstones left by cache migrations, this launch's or an earlier
+// one that did not finish, on a detached thread at idle CPU and I/O
+// priority. Called when findCacheTombstones found some. Exiting mid-delete
+// is safe: the rest is found next launch.
+static void scheduleCacheTombstoneSweep(const std::string& cachePath) {
+    g_timeout_add_seconds_full(G_PRIORITY_LOW, kCacheTombstoneSweepDelaySeconds, [](gpointer data) -> gboolean {
+        std::string cachePath = *static_cast<std::string*>(data);
+        std::thread([cachePath]() {
+            // Both apply to the calling thread only on Linux.
+            setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+            constexpr int kIoprioWhoProcess = 1;
+            constexpr int kIoprioClassIdle = 3;
+            syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprioClassIdle << 13);
+
+            for (const auto& tombstone : electrobun::findCacheTombstones(cachePath)) {
+                electrobun::StartupTraceScope trace(g_startupTrace, "cacheTombstoneSweep");
+                const electrobun::CacheTombstoneSweep sweep =
+                    electrobun::deleteCacheTombstone(tombstone);
+                fprintf(stderr, "[cache_migration] reclaimed %ju bytes from %s%s\n",
+                        static_cast<uintmax_t>(sweep.bytesReclaimed),
+                        tombstone.c_str(),
+                        sweep.complete ? "" : " (incomplete, retried next launch)");
+            }
+        }).detach();
+        return G_SOURCE_REMOVE;
+    }, new std::string(cachePath), [](gpointer data) {
+        delete static_cast<std::string*>(data);
+    });
+}
+
 // Initialize CEF for Linux
 bool initializeCEF() {
     if (g_cefInitialized) return true;
@@ -2559,42 +2984,71 @@ bool initializeCEF() {
     CefMainArgs main_args(argc, argv);
     g_app = new ElectrobunApp();
 
-    // Read user-defined chromium flags from build.json
-    std::string buildJsonPath = getExecutableDir() + "/../Resources/build.json";
-    std::string buildJsonContent = electrobun::readFileToString(buildJsonPath);
-    if (!buildJsonContent.empty()) {
-        g_userChromiumFlags = electrobun::parseChromiumFlags(buildJsonContent);
+    // Independent startup I/O runs beside GTK initialization, which has to
+    // stay on this thread:
+    //
+    //   build.json -> chromium flags -> remote debugging port   (worker)
+    //   cache folder creation and format migration              (worker)
+    //   gtk_init, CEF paths                                     (this thread)
+    //
+    // Both workers are joined before CefInitialize reads their results, and
+    // only this thread prints or touches the main loop.
+    struct RemoteDebuggingSelection {
+        electrobun::RemoteDebuggingDecision decision;
+        int port = 0;
+    };
+    auto remoteDebuggingReady = std::async(std::launch::async, []() {
+        if (g_startupTrace) g_startupTrace->nameThread("startup-config");
+        std::string buildJsonContent;
+        {
+            // Read user-defined chromium flags from build.json
+            electrobun::StartupTraceScope trace(g_startupTrace, "readBuildJson");
+            std::string buildJsonPath = getExecutableDir() + "/../Resources/build.json";
+            buildJsonContent = electrobun::readFileToString(buildJsonPath);
+            if (!buildJsonContent.empty()) {
+                g_userChromiumFlags = electrobun::parseChromiumFlags(buildJsonContent);
+            }
+        }
+        electrobun::StartupTraceScope trace(g_startupTrace, "remoteDebuggingPort");
+        RemoteDebuggingSelection selection;
+        selection.decision = electrobun::resolveRemoteDebugging(
+            buildJsonContent,
+            g_userChromiumFlags,
+            getenv(electrobun::kRemoteDebuggingPortEnvironment));
+        selection.port = electrobun::selectRemoteDebuggingPort(
+            selection.decision,
+            IsPortAvailable);
+        return selection;
+    });
+
+    // Set cache path with identifier/channel structure (consistent with CLI and updater)
+    // Use ~/.cache/identifier/channel/CEF
+    std::string cachePath;
+    if (const char* home = getenv("HOME")) {
+        std::string basePath = std::string(home) + "/.cache";
+        cachePath = buildAppDataPath(basePath, g_electrobunIdentifier, g_electrobunChannel, "CEF");
     }
+    // Resolves to true when stale cache tombstones are waiting to be deleted.
+    auto cacheReady = std::async(std::launch::async, [cachePath]() {
+        if (cachePath.empty()) return false;
+        if (g_startupTrace) g_startupTrace->nameThread("startup-cache");
+        // One-shot wipe if Electrobun's cache format version has been bumped
+        // since the user's last launch. See cache_migration.h. The stale
+        // folder is only renamed here; scheduleCacheTombstoneSweep deletes it
+        // once the app is up.
+        electrobun::StartupTraceScope trace(g_startupTrace, "cacheMigration");
+        electrobun::migrateCacheFolderIfNeeded(
+            cachePath,
+            electrobun::CEF_CACHE_FORMAT_VERSION,
+            electrobun::CacheWipeMode::tombstone);
+        return !electrobun::findCacheTombstones(cachePath).empty();
+    });
 
     CefSettings settings;
     settings.no_sandbox = true;
     settings.windowless_rendering_enabled = true;  // Required for OSR/transparent windows
     settings.log_severity = LOGSEVERITY_ERROR;  // Change to WARNING to see more CEF logs
 
-    const auto remoteDebugging = electrobun::resolveRemoteDebugging(
-        buildJsonContent,
-        g_userChromiumFlags,
-        getenv(electrobun::kRemoteDebuggingPortEnvironment));
-    const int selectedPort = electrobun::selectRemoteDebuggingPort(
-        remoteDebugging,
-        IsPortAvailable);
-    if (selectedPort != 0) {
-        settings.remote_debugging_port = selectedPort;
-        std::cout << "[CEF] Remote debugging enabled on 127.0.0.1:"
-                  << selectedPort << " ("
-                  << electrobun::remoteDebuggingSourceName(remoteDebugging.source)
-                  << ")" << std::endl;
-    } else if (remoteDebugging.enabled()) {
-        std::cout << "[CEF] Remote debugging disabled: no free port in "
-                  << electrobun::kDefaultRemoteDebuggingPort << "-"
-                  << electrobun::kLastAutomaticRemoteDebuggingPort << std::endl;
-    } else if (remoteDebugging.source == electrobun::RemoteDebuggingSource::invalid_configuration ||
-               remoteDebugging.source == electrobun::RemoteDebuggingSource::invalid_environment) {
-        std::cout << "[CEF] Remote debugging disabled: "
-                  << electrobun::remoteDebuggingSourceName(remoteDebugging.source)
-                  << std::endl;
-    }
-    
     // Use centralized GTK initialization to ensure proper setlocale handling
     initializeGTK();
     
@@ -2607,26 +3061,43 @@ bool initializeCEF() {
     // Match the helper name to the actual host executable (Cottontail or native main).
     CefString(&settings.browser_subprocess_path) =
         execDir + "/" + getExecutableBaseName() + " Helper";
-    
-    // Set cache path with identifier/channel structure (consistent with CLI and updater)
-    // Use ~/.cache/identifier/channel/CEF
-    char* home = getenv("HOME");
-    if (home) {
-        std::string basePath = std::string(home) + "/.cache";
-        std::string cachePath = buildAppDataPath(basePath, g_electrobunIdentifier, g_electrobunChannel, "CEF");
-        std::cout << "[CEF] Using path: " << cachePath << std::endl;
 
-        // One-shot wipe if Electrobun's cache format version has been bumped
-        // since the user's last launch. See cache_migration.h.
-        electrobun::migrateCacheFolderIfNeeded(cachePath);
+    const RemoteDebuggingSelection remoteDebugging = remoteDebuggingReady.get();
+    const int selectedPort = remoteDebugging.port;
+    if (selectedPort != 0) {
+        settings.remote_debugging_port = selectedPort;
+        std::cout << "[CEF] Remote debugging enabled on 127.0.0.1:"
+                  << selectedPort << " ("
+                  << electrobun::remoteDebuggingSourceName(remoteDebugging.decision.source)
+                  << ")" << std::endl;
+    } else if (remoteDebugging.decision.enabled()) {
+        std::cout << "[CEF] Remote debugging disabled: no free port in "
+                  << electrobun::kDefaultRemoteDebuggingPort << "-"
+                  << electrobun::kLastAutomaticRemoteDebuggingPort << std::endl;
+    } else if (remoteDebugging.decision.source == electrobun::RemoteDebuggingSource::invalid_configuration ||
+               remoteDebugging.decision.source == electrobun::RemoteDebuggingSource::invalid_environment) {
+        std::cout << "[CEF] Remote debugging disabled: "
+                  << electrobun::remoteDebuggingSourceName(remoteDebugging.decision.source)
+                  << std::endl;
+    }
 
+    const bool cacheTombstonesPending = cacheReady.get();
+    if (!cachePath.empty()) {
+        std::cout << "[CEF] Using path: " << cachePath << std::endl;
+        if (cacheTombstonesPending) {
+            scheduleCacheTombstoneSweep(cachePath);
+        }
         CefString(&settings.root_cache_path) = cachePath;
     }
     
     // Set language
     CefString(&settings.accept_language_list) = "en-US,en";
     
-    bool result = CefInitialize(main_args, settings, g_app.get(), nullptr);
+    bool result;
+    {
+        electrobun::StartupTraceScope trace(g_startupTrace, "CefInitialize");
+        result = CefInitialize(main_args, settings, g_app.get(), nullptr);
+    }
 
     // Cleanup
     if (argv) {
@@ -2670,6 +3141,10 @@ public:
     bool isReceivingInput = true;
     bool isRemoved = false;  // Flag to prevent operations on removed webviews
     std::string maskJSON;
+    // maskJSON parsed once per distinct value. False when the rects came
+    // packed and maskJSON no longer describes them.
+    std::vector<MaskRect> maskRects;
+    bool maskJSONCurrent = true;
     GdkRectangle visualBounds = {};
     bool creationFailed = false;
 
@@ -2680,6 +3155,8 @@ public:
     bool hasPendingResize = false;
     LogicalRect pendingResizeFrame = {};
     std::string pendingResizeMasks;
+    std::vector<MaskRect> pendingResizeMaskRects;
+    bool pendingResizeMasksPacked = false;
 
     // Navigation rules for URL filtering
     std::vector<std::string> navigationRules;
@@ -2687,6 +3164,14 @@ public:
     // Root directory for views:// protocol resolution
     std::string viewsRoot;
 
+    // Background lifecycle policy state (main thread only): the page a
+    // discarded view reloads when shown, when that reload started, and
+    // whether a discard is waiting on its memory sample.
+    electrobun::WebviewLifecycle lifecycle;
+    std::string discardedUrl;
+    int64_t restoreStartUs = 0;
+    bool discardSamplePending = false;
+
     AbstractView(uint32_t webviewId) : webviewId(webviewId) {}
     virtual ~AbstractView() {}
 
@@ -2776,6 +3261,35 @@ public:
     virtual void setPassthrough(bool enable) { isMousePassthroughEnabled = enable; }
     virtual void setHidden(bool hidden) {}
 
+    // Windowless (OSR) paint control. Views that render into their own X11
+    // child window return false.
+    virtual bool setWindowlessFrameRate(int frameRate) { return false; }
+    virtual bool setBackgroundThrottled(bool throttled) { return false; }
+
+    // Start an asynchronous capture on the main thread. On success the job's
+    // completion runs exactly once, later; on false it has not been consumed.
+    virtual bool captureSnapshot(snapshot_encoder::Job&& job) { return false; }
+
+    // Publish frames into a caller-owned ring (see webview_frame_ring.h)
+    // until stopFrameStream, after which the ring is no longer touched.
+    virtual bool startFrameStream(uint8_t* ring, uint64_t ringLength, uint32_t slotCount,
+                                  uint32_t maxFps, WebviewFrameStreamHandler handler) {
+        return false;
+    }
+    virtual void stopFrameStream() {}
+
+    // The process rendering this view, or 0 when unknown. Safe off the main
+    // thread.
+    virtual int rendererProcessId() const { return 0; }
+
+    // Moves the engine between background lifecycle states on the main
+    // thread. `entered` runs on the main thread once the engine is in `to`,
+    // which may be after this returns, and never when it cannot enter it;
+    // the policy counts the view as there either way so it is not retried.
+    virtual void setLifecycleState(electrobun::WebviewLifecycleState from,
+                                   electrobun::WebviewLifecycleState to,
+                                   std::function<void()> entered) {}
+
     // Find in page methods
     virtual void findInPage(const char* searchText, bool forward, bool matchCase) = 0;
     virtual void stopFindInPage() = 0;
@@ -2785,21 +3299,66 @@ public:
     virtual void closeDevTools() = 0;
     virtual void toggleDevTools() = 0;
 
+    // Resyncs usually resend the previous masks verbatim; only parse when
+    // the JSON actually changed. Null keeps the current masks, which is how
+    // internal relayouts resize without touching them.
+    void assignMaskJSON(const char* masksJson) {
+        if (!masksJson) return;
+        if (maskJSONCurrent && maskJSON == masksJson) return;
+        maskJSON = masksJson;
+        maskJSONCurrent = true;
+        maskRects = parseMaskJson(maskJSON);
+    }
+
+    // Masks from the packed channel are used as they are. maskJSON no longer
+    // describes them, so the next JSON resync is parsed even if unchanged.
+    void assignMaskRects(std::vector<MaskRect>&& rects) {
+        maskJSON.clear();
+        maskJSONCurrent = false;
+        maskRects = std::move(rects);
+    }
+
+    void clearMasks() {
+        maskJSON.clear();
+        maskJSONCurrent = true;
+        maskRects.clear();
+    }
+
     void storePendingResize(const LogicalRect& frame, const char* masksJson) {
         std::lock_guard<std::mutex> lock(pendingResizeMutex);
         pendingResizeFrame = frame;
         pendingResizeMasks = masksJson ? masksJson : "";
+        pendingResizeMaskRects.clear();
+        pendingResizeMasksPacked = false;
         hasPendingResize = true;
         pendingResizeGeneration++;
     }
 
-    bool consumePendingResize(LogicalRect& outFrame, std::string& outMasks) {
+    void storePendingResize(const LogicalRect& frame, std::vector<MaskRect>&& masks) {
+        std::lock_guard<std::mutex> lock(pendingResizeMutex);
+        pendingResizeFrame = frame;
+        pendingResizeMasks.clear();
+        pendingResizeMaskRects = std::move(masks);
+        pendingResizeMasksPacked = true;
+        hasPendingResize = true;
+        pendingResizeGeneration++;
+    }
+
+    bool consumePendingResize(
+        LogicalRect& outFrame,
+        std::string& outMasks,
+        std::vector<MaskRect>& outMaskRects,
+        bool& outMasksPacked
+    ) {
         std::lock_guard<std::mutex> lock(pendingResizeMutex);
         if (!hasPendingResize) return false;
         uint64_t gen = pendingResizeGeneration.load();
         if (gen == appliedResizeGeneration) return false;
         outFrame = pendingResizeFrame;
         outMasks = pendingResizeMasks;
+        outMaskRects.swap(pendingResizeMaskRects);
+        pendingResizeMaskRects.clear();
+        outMasksPacked = pendingResizeMasksPacked;
         appliedResizeGeneration = gen;
         hasPendingResize = false;
         return true;
@@ -2818,8 +3377,13 @@ static void drainPendingResizes() {
         if (!view) continue;
         LogicalRect frame = {};
         std::string masks;
-        if (view->consumePendingResize(frame, masks)) {
-            view->resizeLogical(frame, masks.c_str());
+        std::vector<MaskRect> maskRects;
+        bool masksPacked = false;
+        if (view->consumePendingResize(frame, masks, maskRects, masksPacked)) {
+            if (masksPacked) {
+                view->assignMaskRects(std::move(maskRects));
+            }
+            view->resizeLogical(frame, masksPacked ? nullptr : masks.c_str());
         }
     }
 }
@@ -2961,6 +3525,159 @@ static void configureWebKitAutomation(
     }
 }
 
+// Builds the bare WebKitWebView every WebKit webview starts from. With
+// `relatedView`, the new view shares that view's context and web process.
+static GtkWidget* createWebKitWebViewWidget(WebKitWebContext* context,
+                                            WebKitUserContentManager* manager,
+                                            bool autoResize,
+                                            bool isControlledByAutomation,
+                                            WebKitWebView* relatedView = nullptr) {
+    WebKitSettings* settings = webkit_settings_new();
+    if (!settings) {
+        fprintf(stderr, "ERROR: Failed to create WebKit settings\n");
+        return nullptr;
+    }
+    webkit_settings_set_enable_developer_extras(settings, TRUE);
+    webkit_settings_set_enable_javascript(settings, TRUE);
+    webkit_settings_set_javascript_can_access_clipboard(settings, FALSE);
+    webkit_settings_set_javascript_can_open_windows_automatically(settings, TRUE);
+    webkit_settings_set_enable_back_forward_navigation_gestures(settings, TRUE);
+    webkit_settings_set_enable_smooth_scrolling(settings, TRUE);
+
+    // WebKitGTK's accelerated backing store disappears when a positioned
+    // view is partially outside its toplevel. Software compositing keeps
+    // the full view allocation while its GTK ancestors clip it correctly.
+    if (!autoResize) {
+        webkit_settings_set_hardware_acceleration_policy(
+            settings,
+            WEBKIT_HARDWARE_ACCELERATION_POLICY_NEVER);
+    }
+
+    // Enable media stream and WebRTC for camera/microphone access
+    webkit_settings_set_enable_media_stream(settings, TRUE);
+    webkit_settings_set_enable_webrtc(settings, TRUE);
+    webkit_settings_set_enable_media(settings, TRUE);
+
+    // Try to improve offscreen rendering without breaking stability
+    // webkit_settings_set_enable_accelerated_2d_canvas is deprecated - removed
+
+    GtkWidget* webview = relatedView
+        ? GTK_WIDGET(g_object_new(WEBKIT_TYPE_WEB_VIEW,
+            "related-view", relatedView,
+            "user-content-manager", manager,
+            "settings", settings,
+            NULL))
+        : GTK_WIDGET(g_object_new(WEBKIT_TYPE_WEB_VIEW,
+            "web-context", context,
+            "user-content-manager", manager,
+            "settings", settings,
+            "is-controlled-by-automation", isControlledByAutomation ? TRUE : FALSE,
+            NULL));
+    g_object_unref(settings);
+    return webview;
+}
+
+// Spare WebKit views that initWebview hands out instead of building a new
+// one. The settings, the context and an empty user content manager are
+// ready; the webview that takes a spare adds its own scripts, handlers and
+// signals. Spares hold a strong ref and have no parent. Pools are keyed by
+// partition and by autoResize, which fixes the acceleration policy, and
+// exist only for persistent partitions, whose context outlives a webview.
+// Main thread only.
+struct WebKitSpareView {
+    GtkWidget* webview = nullptr;
+    WebKitUserContentManager* manager = nullptr;
+};
+
+static electrobun::WebviewPool<WebKitSpareView> g_webkitViewPool;
+static bool g_webkitViewPoolRefillScheduled = false;
+
+static std::string webkitViewPoolKey(const std::string& partition, bool autoResize) {
+    return std::string(1, autoResize ? 'f' : 'p') + partition;
+}
+
+static bool buildWebKitSpareView(const std::string& partition,
+                                 bool autoResize,
+                                 WebKitWebView* relatedView,
+                                 WebKitSpareView* spare) {
+    WebKitWebContext* context = relatedView ? nullptr : getContextForPartition(partition.c_str());
+    if (!relatedView && !context) {
+        return false;
+    }
+    WebKitUserContentManager* manager = webkit_user_content_manager_new();
+    GtkWidget* webview = createWebKitWebViewWidget(context, manager, autoResize, false, relatedView);
+    if (!webview) {
+        g_object_unref(manager);
+        return false;
+    }
+    spare->webview = GTK_WIDGET(g_object_ref_sink(webview));
+    spare->manager = manager;
+    return true;
+}
+
+static void destroyWebKitSpareView(WebKitSpareView& spare) {
+    gtk_widget_destroy(spare.webview);
+    g_object_unref(spare.webview);
+    g_object_unref(spare.manager);
+}
+
+// Tops the pools up one spare per low-priority idle callback, so building
+// them never delays input, drawing or a webview being created.
+static void scheduleWebKitViewPoolRefill() {
+    std::string key;
+    if (g_webkitViewPoolRefillScheduled || !g_webkitViewPool.nextRefill(&key)) {
+        return;
+    }
+    g_webkitViewPoolRefillScheduled = true;
+    g_idle_add_full(G_PRIORITY_LOW, [](gpointer) -> gboolean {
+        std::string key;
+        if (g_webkitViewPool.nextRefill(&key)) {
+            WebKitSpareView spare;
+            if (buildWebKitSpareView(key.substr(1), key[0] == 'f', nullptr, &spare)) {
+                g_webkitViewPool.put(key, spare, false);
+                return G_SOURCE_CONTINUE;
+            }
+            // Retried on the next handout rather than spinning here.
+            fprintf(stderr, "WebKit: failed to build a spare webview for %s\n", key.c_str() + 1);
+        }
+        g_webkitViewPoolRefillScheduled = false;
+        return G_SOURCE_REMOVE;
+    }, nullptr, nullptr);
+}
+
+static bool takeWebKitSpareView(const std::string& partition, bool autoResize, WebKitSpareView* spare) {
+    const bool taken = g_webkitViewPool.take(webkitViewPoolKey(partition, autoResize), spare);
+    scheduleWebKitViewPoolRefill();
+    return taken;
+}
+
+// Turns a removed webview into the next spare when the pool has room. The
+// page and its history go with the old view; the spare is a related view,
+// so only the running web process carries over. Only views whose main frame
+// never committed anything but the app's own views:// content qualify, so a
+// process that ran remote pages is never handed to another webview.
+static void recycleWebKitView(const std::string& partition, bool autoResize, GtkWidget* webview,
+                              bool committedRemoteContent) {
+    const std::string key = webkitViewPoolKey(partition, autoResize);
+    if (committedRemoteContent || !g_webkitViewPool.wants(key) || !WEBKIT_IS_WEB_VIEW(webview)) {
+        return;
+    }
+    const char* uri = webkit_web_view_get_uri(WEBKIT_WEB_VIEW(webview));
+    if (!uri || strncmp(uri, "views://", 8) != 0) {
+        return;
+    }
+#if WEBKIT_CHECK_VERSION(2, 34, 0)
+    if (!webkit_web_view_get_is_web_process_responsive(WEBKIT_WEB_VIEW(webview))) {
+        return;
+    }
+#endif
+    WebKitSpareView spare;
+    if (buildWebKitSpareView(partition, autoResize, WEBKIT_WEB_VIEW(webview), &spare) &&
+        !g_webkitViewPool.put(key, spare, true)) {
+        destroyWebKitSpareView(spare);
+    }
+}
+
 // WebKitGTK implementation
 class WebKitWebViewImpl : public AbstractView {
 public:
@@ -2975,12 +3692,25 @@ public:
     std::string electrobunPreloadScript;
     std::string customPreloadScript;
     std::string partition;
+    // autoResize at creation, which picked the view's settings.
+    bool createdAutoResize = false;
     bool partitionContextReleased = false;
     bool isTransparent = false;
     bool isHidden = false;
+    // Set once the main frame commits anything outside views://, which keeps
+    // the view's web process out of the spare pool.
+    bool committedRemoteContent = false;
     
     // Navigation state tracking
     bool lastNavigationWasBlocked = false;
+
+    // WebKitGTK exposes no paint hook, so frame streams are periodic
+    // visible-region snapshots with at most one in flight.
+    WebviewFrameRingWriter frameStream;
+    WebviewFrameStreamHandler frameStreamHandler = nullptr;
+    GCancellable* frameStreamCancellable = nullptr;
+    guint frameStreamSourceId = 0;
+    bool frameStreamCaptureInFlight = false;
     
     WebKitWebViewImpl(uint32_t webviewId,
                       GtkWidget* window,
@@ -3005,7 +3735,8 @@ public:
           internalBridgeHandler(internalBridgeHandler), isSandboxed(sandbox),
           electrobunPreloadScript(electrobunPreloadScript ? electrobunPreloadScript : ""),
           customPreloadScript(customPreloadScript ? customPreloadScript : ""),
-          partition(partitionIdentifier ? partitionIdentifier : "")
+          partition(partitionIdentifier ? partitionIdentifier : ""),
+          createdAutoResize(autoResize)
     {
         // Set initial state flags
         this->pendingStartTransparent = startTransparent;
@@ -3016,57 +3747,31 @@ public:
         // runtime is already initialized, while WebKit has not initialized yet.
         restoreWebKitAutomationInspectorServer();
         
-        // Create the user content controller and manager
-        manager = webkit_user_content_manager_new();
-        if (!manager) {
-            fprintf(stderr, "ERROR: Failed to create WebKit user content manager\n");
-            throw std::runtime_error("Failed to create WebKit user content manager");
-        }
-        
-        // Create WebKit settings
-        WebKitSettings* settings = webkit_settings_new();
-        if (!settings) {
-            fprintf(stderr, "ERROR: Failed to create WebKit settings\n");
-            throw std::runtime_error("Failed to create WebKit settings");
-        }
-        webkit_settings_set_enable_developer_extras(settings, TRUE);
-        webkit_settings_set_enable_javascript(settings, TRUE);
-        webkit_settings_set_javascript_can_access_clipboard(settings, FALSE);
-        webkit_settings_set_javascript_can_open_windows_automatically(settings, TRUE);
-        webkit_settings_set_enable_back_forward_navigation_gestures(settings, TRUE);
-        webkit_settings_set_enable_smooth_scrolling(settings, TRUE);
-
-        // WebKitGTK's accelerated backing store disappears when a positioned
-        // view is partially outside its toplevel. Software compositing keeps
-        // the full view allocation while its GTK ancestors clip it correctly.
-        if (!autoResize) {
-            webkit_settings_set_hardware_acceleration_policy(
-                settings,
-                WEBKIT_HARDWARE_ACCELERATION_POLICY_NEVER);
-        }
-        
-        // Enable media stream and WebRTC for camera/microphone access
-        webkit_settings_set_enable_media_stream(settings, TRUE);
-        webkit_settings_set_enable_webrtc(settings, TRUE);
-        webkit_settings_set_enable_media(settings, TRUE);
-        
-        // Try to improve offscreen rendering without breaking stability
-        // webkit_settings_set_enable_accelerated_2d_canvas is deprecated - removed
-
         // Get or create shared context for this partition
         WebKitWebContext* context = getContextForPartition(partition.empty() ? nullptr : partition.c_str());
         const bool isControlledByAutomation = selectWebKitAutomationContext(context);
 
-        // Create webview with context and user content manager
-        webview = GTK_WIDGET(g_object_new(WEBKIT_TYPE_WEB_VIEW,
-            "web-context", context,
-            "user-content-manager", manager,
-            "settings", settings,
-            "is-controlled-by-automation", isControlledByAutomation ? TRUE : FALSE,
-            NULL));
-        if (!webview) {
-            fprintf(stderr, "ERROR: Failed to create WebKit webview\n");
-            throw std::runtime_error("Failed to create WebKit webview");
+        WebKitSpareView spare;
+        if (!isControlledByAutomation && takeWebKitSpareView(partition, autoResize, &spare)) {
+            // Hand the pool's ref back as the floating one a new widget
+            // would have, for the container to sink.
+            manager = spare.manager;
+            webview = spare.webview;
+            g_object_force_floating(G_OBJECT(webview));
+        } else {
+            // Create the user content controller and manager
+            manager = webkit_user_content_manager_new();
+            if (!manager) {
+                fprintf(stderr, "ERROR: Failed to create WebKit user content manager\n");
+                throw std::runtime_error("Failed to create WebKit user content manager");
+            }
+
+            // Create webview with context and user content manager
+            webview = createWebKitWebViewWidget(context, manager, autoResize, isControlledByAutomation);
+            if (!webview) {
+                fprintf(stderr, "ERROR: Failed to create WebKit webview\n");
+                throw std::runtime_error("Failed to create WebKit webview");
+            }
         }
         g_object_set_data(
             G_OBJECT(webview),
@@ -3156,9 +3861,10 @@ public:
         // Connect navigation decision handler for both navigation callbacks AND navigation rules
         g_signal_connect(webview, "decide-policy", G_CALLBACK(onDecidePolicy), this);
         
-        // Set up event handlers
+        // Set up event handlers. load-changed also tracks remote commits for
+        // the spare pool, so it is connected without a handler too.
+        g_signal_connect(webview, "load-changed", G_CALLBACK(onLoadChanged), this);
         if (eventHandler) {
-            g_signal_connect(webview, "load-changed", G_CALLBACK(onLoadChanged), this);
             g_signal_connect(webview, "load-failed", G_CALLBACK(onLoadFailed), this);
         }
         
@@ -3287,13 +3993,18 @@ public:
             std::lock_guard<std::mutex> lock(g_webviewMapMutex);
             g_webviewMap.erase(webviewId);
         }
+        dropWebviewSnapshotResults(webviewId);
         
         // Mark as removed to prevent further operations
         isRemoved = true;
+        stopFrameStream();
         
         if (webview) {
             GtkWidget* widget_to_destroy = webview;
             webview = nullptr;  // Clear our reference immediately
+
+            recycleWebKitView(partition, createdAutoResize, widget_to_destroy,
+                              committedRemoteContent);
             
             // gtk_widget_destroy on the parent window recursively destroys all
             // children, so the webview widget may already be invalid by the time
@@ -3432,7 +4143,7 @@ public:
             
             visualBounds = frame;
         }
-        maskJSON = masksJson ? masksJson : "";
+        assignMaskJSON(masksJson);
         
         // Store maskJSON for potential future use, but masking is not implemented for WebKit
         // See applyVisualMask() method for technical details on why WebKit masking isn't feasible
@@ -3659,6 +4370,12 @@ public:
     
     static void onLoadChanged(WebKitWebView* webview, WebKitLoadEvent event, gpointer user_data) {
         WebKitWebViewImpl* impl = static_cast<WebKitWebViewImpl*>(user_data);
+        if (event == WEBKIT_LOAD_COMMITTED) {
+            const char* committed = webkit_web_view_get_uri(webview);
+            if (!committed || strncmp(committed, "views://", 8) != 0) {
+                impl->committedRemoteContent = true;
+            }
+        }
         if (impl->eventHandler) {
             const char* uri = webkit_web_view_get_uri(webview);
             switch (event) {
@@ -3671,8 +4388,14 @@ public:
                 case WEBKIT_LOAD_COMMITTED:
                     impl->eventHandler(impl->webviewId, "load-committed", uri);
                     impl->eventHandler(impl->webviewId, "did-commit-navigation", uri);
+                    if (g_startupTrace && g_startupTrace->claimFirst("firstLoadCommitted")) {
+                        g_startupTrace->instant("firstLoadCommitted", "webkit");
+                        g_signal_connect_after(webview, "draw", G_CALLBACK(onFirstDrawAfterCommit), nullptr);
+                    }
                     break;
                 case WEBKIT_LOAD_FINISHED:
+                    markStartupMilestone("firstLoadFinished", "webkit");
+                    noteWebviewLifecycleLoadFinished(impl->webviewId);
                     impl->eventHandler(impl->webviewId, "load-finished", uri);
                     // Only fire did-navigate event if navigation wasn't blocked
                     if (!impl->lastNavigationWasBlocked) {
@@ -3683,6 +4406,13 @@ public:
         }
     }
     
+    // The first GTK draw of the first committed page, for the startup trace.
+    static gboolean onFirstDrawAfterCommit(GtkWidget* widget, cairo_t*, gpointer) {
+        markStartupMilestone("firstPaint", "webkit");
+        g_signal_handlers_disconnect_by_func(widget, (gpointer)onFirstDrawAfterCommit, nullptr);
+        return FALSE;
+    }
+
     static gboolean onLoadFailed(WebKitWebView* webview, WebKitLoadEvent event, gchar* uri, GError* error, gpointer user_data) {
         WebKitWebViewImpl* impl = static_cast<WebKitWebViewImpl*>(user_data);
         if (impl->eventHandler) {
@@ -4038,6 +4768,163 @@ public:
         }
     }
 
+    // A hidden view already reports document.hidden and WebKit throttles its
+    // timers, and WebKitGTK has no way to freeze a page, so only discards
+    // reach the engine: the web process is terminated and the page reloaded
+    // from its URL when the view is shown.
+    void setLifecycleState(electrobun::WebviewLifecycleState from,
+                           electrobun::WebviewLifecycleState to,
+                           std::function<void()> entered) override {
+        if (isRemoved || !WEBKIT_IS_WEB_VIEW(webview)) return;
+        WebKitWebView* view = WEBKIT_WEB_VIEW(webview);
+        switch (to) {
+            case electrobun::WebviewLifecycleState::throttled:
+                break;
+            case electrobun::WebviewLifecycleState::frozen:
+                return;
+            case electrobun::WebviewLifecycleState::discarded: {
+#if WEBKIT_CHECK_VERSION(2, 34, 0)
+                const char* uri = webkit_web_view_get_uri(view);
+                if (!uri) return;
+                discardedUrl = uri;
+                webkit_web_view_terminate_web_process(view);
+                break;
+#else
+                return;
+#endif
+            }
+            case electrobun::WebviewLifecycleState::active:
+                if (from == electrobun::WebviewLifecycleState::discarded && !discardedUrl.empty()) {
+                    webkit_web_view_load_uri(view, discardedUrl.c_str());
+                }
+                break;
+        }
+        if (entered) entered();
+    }
+
+    bool captureSnapshot(snapshot_encoder::Job&& job) override {
+        if (isRemoved || !WEBKIT_IS_WEB_VIEW(webview)) return false;
+
+        // The visible region comes back at device scale; the allocation gives
+        // the logical size it covers for cropping.
+        GtkAllocation allocation = {};
+        gtk_widget_get_allocation(webview, &allocation);
+        job.viewWidth = allocation.width;
+        job.viewHeight = allocation.height;
+        webkit_web_view_get_snapshot(
+            WEBKIT_WEB_VIEW(webview),
+            WEBKIT_SNAPSHOT_REGION_VISIBLE,
+            isTransparent ? WEBKIT_SNAPSHOT_OPTIONS_TRANSPARENT_BACKGROUND
+                          : WEBKIT_SNAPSHOT_OPTIONS_NONE,
+            nullptr,
+            onSnapshotReady,
+            new snapshot_encoder::Job(std::move(job)));
+        return true;
+    }
+
+    // WebKit renders the snapshot in its web process; only the hand-off to
+    // the encoder worker happens here on the main thread.
+    static void onSnapshotReady(GObject* source, GAsyncResult* result, gpointer userData) {
+        std::unique_ptr<snapshot_encoder::Job> job(static_cast<snapshot_encoder::Job*>(userData));
+        GError* error = nullptr;
+        cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(
+            WEBKIT_WEB_VIEW(source), result, &error);
+        if (!surface) {
+            if (error) {
+                fprintf(stderr, "WebKit: snapshot failed: %s\n", error->message);
+                g_error_free(error);
+            }
+            if (job->complete) job->complete(snapshot_encoder::Result{});
+            return;
+        }
+        snapshot_encoder::submitSurface(std::move(*job), surface);
+        cairo_surface_destroy(surface);
+    }
+
+    bool startFrameStream(uint8_t* ring, uint64_t ringLength, uint32_t slotCount,
+                          uint32_t maxFps, WebviewFrameStreamHandler handler) override {
+        stopFrameStream();
+        if (isRemoved || !WEBKIT_IS_WEB_VIEW(webview)) return false;
+        // Polling needs a period; unlimited means the default 30 FPS here.
+        const uint32_t fps = std::clamp<uint32_t>(maxFps ? maxFps : 30, 1, 60);
+        if (!frameStream.attach(ring, ringLength, slotCount, fps)) return false;
+        frameStreamHandler = handler;
+        frameStreamCancellable = g_cancellable_new();
+        frameStreamSourceId = g_timeout_add(1000 / fps, onFrameStreamTick, this);
+        onFrameStreamTick(this);
+        return true;
+    }
+
+    void stopFrameStream() override {
+        if (frameStreamSourceId) {
+            g_source_remove(frameStreamSourceId);
+            frameStreamSourceId = 0;
+        }
+        // A capture still in flight completes as cancelled without touching
+        // this view or the ring.
+        if (frameStreamCancellable) {
+            g_cancellable_cancel(frameStreamCancellable);
+            g_object_unref(frameStreamCancellable);
+            frameStreamCancellable = nullptr;
+        }
+        frameStreamCaptureInFlight = false;
+        frameStreamHandler = nullptr;
+        frameStream.detach();
+    }
+
+    static gboolean onFrameStreamTick(gpointer userData) {
+        auto* view = static_cast<WebKitWebViewImpl*>(userData);
+        if (view->frameStreamCaptureInFlight || !WEBKIT_IS_WEB_VIEW(view->webview)) {
+            return G_SOURCE_CONTINUE;
+        }
+        // Unmapped views have nothing new to show.
+        if (!gtk_widget_get_mapped(view->webview)) {
+            return G_SOURCE_CONTINUE;
+        }
+        view->frameStreamCaptureInFlight = true;
+        webkit_web_view_get_snapshot(
+            WEBKIT_WEB_VIEW(view->webview),
+            WEBKIT_SNAPSHOT_REGION_VISIBLE,
+            view->isTransparent ? WEBKIT_SNAPSHOT_OPTIONS_TRANSPARENT_BACKGROUND
+                                : WEBKIT_SNAPSHOT_OPTIONS_NONE,
+            view->frameStreamCancellable,
+            onFrameStreamSnapshot,
+            view);
+        return G_SOURCE_CONTINUE;
+    }
+
+    static void onFrameStreamSnapshot(GObject* source, GAsyncResult* result, gpointer userData) {
+        GError* error = nullptr;
+        cairo_surface_t* surface = webkit_web_view_get_snapshot_finish(
+            WEBKIT_WEB_VIEW(source), result, &error);
+        if (error && g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            // stopFrameStream already reset the view; it may be gone.
+            g_error_free(error);
+            if (surface) cairo_surface_destroy(surface);
+            return;
+        }
+        if (error) g_error_free(error);
+
+        auto* view = static_cast<WebKitWebViewImpl*>(userData);
+        view->frameStreamCaptureInFlight = false;
+        if (!surface) return;
+        if (cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_IMAGE &&
+            cairo_image_surface_get_format(surface) == CAIRO_FORMAT_ARGB32) {
+            cairo_surface_flush(surface);
+            const auto published = view->frameStream.submit(
+                cairo_image_surface_get_data(surface),
+                static_cast<size_t>(cairo_image_surface_get_stride(surface)),
+                cairo_image_surface_get_width(surface),
+                cairo_image_surface_get_height(surface),
+                nullptr, 0, static_cast<uint64_t>(g_get_monotonic_time()));
+            if (published == WebviewFrameSubmitResult::Published && view->frameStreamHandler) {
+                view->frameStreamHandler(view->webviewId,
+                                         static_cast<uint32_t>(view->frameStream.sequence()));
+            }
+        }
+        cairo_surface_destroy(surface);
+    }
+
 };
 
 // WGPUView implementation (non-webview rendering surface)
@@ -4049,6 +4936,12 @@ public:
     Window xWindow = 0;
     Window inputXWindow = 0;
     Cursor inputCursor = 0;
+    LinuxMaskRegionCache boundingShapeCache;
+    LinuxMaskRegionCache inputShapeCache;
+    LinuxMaskRegionCache drawingInputShapeCache;
+    // Opt-in: create this view's surface on a dedicated render thread (see
+    // WgpuSurfaceRenderThread). Read when the surface is created.
+    bool renderThreadRequested = false;
 
     WGPUViewImpl(uint32_t webviewId)
         : AbstractView(webviewId) {}
@@ -4163,46 +5056,31 @@ public:
         return false;
     }
 
-    void setInputShape(Display* display, Window window, const std::vector<MaskRect>& masks) {
-        if (!display || !window) {
-            return;
+    // Window rectangle minus mask holes, in the view's local pixels.
+    std::vector<LinuxXRectangleFields> currentMaskRegion() const {
+        std::vector<LinuxPhysicalRect> holes;
+        holes.reserve(maskRects.size());
+        for (const auto& mask : maskRects) {
+            holes.push_back(logicalToLinuxPhysicalRect(
+                mask.x, mask.y, mask.width, mask.height, 1.0));
         }
+        return buildLinuxMaskRegion(
+            std::max(1, visualBounds.width),
+            std::max(1, visualBounds.height),
+            holes);
+    }
 
-        if (isMousePassthroughEnabled) {
-            XRectangle emptyRect = {0, 0, 0, 0};
-            XShapeCombineRectangles(display, window, ShapeInput, 0, 0, &emptyRect, 1, ShapeSet, YXBanded);
+    void setInputShape(Display* display, Window window) {
+        if (!display || !window) {
             return;
         }
 
-        const LinuxXRectangleFields baseFields =
-            linuxPhysicalRectToXRectangleFields({
-                0,
-                0,
-                std::max(1, visualBounds.width),
-                std::max(1, visualBounds.height),
-            });
-        XRectangle baseRect = {
-            baseFields.x,
-            baseFields.y,
-            baseFields.width,
-            baseFields.height,
-        };
-        XShapeCombineRectangles(display, window, ShapeInput, 0, 0, &baseRect, 1, ShapeSet, YXBanded);
-
-        for (const auto& mask : masks) {
-            const LinuxXRectangleFields fields =
-                linuxPhysicalRectToXRectangleFields(
-                    logicalToLinuxPhysicalRect(
-                        mask.x, mask.y, mask.width, mask.height, 1.0));
-            if (fields.width == 0 || fields.height == 0) continue;
-            XRectangle rect = {
-                fields.x,
-                fields.y,
-                fields.width,
-                fields.height,
-            };
-            XShapeCombineRectangles(display, window, ShapeInput, 0, 0, &rect, 1, ShapeSubtract, YXBanded);
-        }
+        // Passthrough keeps an empty input region.
+        const std::vector<LinuxXRectangleFields> region =
+            isMousePassthroughEnabled
+                ? std::vector<LinuxXRectangleFields>()
+                : currentMaskRegion();
+        applyMaskRegion(display, window, ShapeInput, region, inputShapeCache);
     }
 
     void clearInputShape(Display* display, Window window) {
@@ -4210,8 +5088,7 @@ public:
             return;
         }
 
-        XRectangle emptyRect = {0, 0, 0, 0};
-        XShapeCombineRectangles(display, window, ShapeInput, 0, 0, &emptyRect, 1, ShapeSet, YXBanded);
+        applyMaskRegion(display, window, ShapeInput, {}, drawingInputShapeCache);
     }
 
     void applyCurrentInputShape() {
@@ -4226,12 +5103,7 @@ public:
             XRaiseWindow(display, inputXWindow);
         }
 
-        std::vector<MaskRect> masks;
-        if (!maskJSON.empty() && maskJSON != "[]") {
-            masks = parseMaskJson(maskJSON);
-        }
-
-        setInputShape(display, inputXWindow ? inputXWindow : drawingWindow, masks);
+        setInputShape(display, inputXWindow ? inputXWindow : drawingWindow);
         XFlush(display);
     }
 
@@ -4295,9 +5167,9 @@ public:
 
             visualBounds = frame;
         }
-        maskJSON = masksJson ? masksJson : "";
+        assignMaskJSON(masksJson);
 
-        if (masksJson && strlen(masksJson) > 0 && strcmp(masksJson, "[]") != 0) {
+        if (!maskRects.empty()) {
             applyVisualMask();
         } else {
             removeMasks();
@@ -4305,7 +5177,7 @@ public:
     }
 
     void applyVisualMask() override {
-        if (maskJSON.empty()) {
+        if (maskRects.empty()) {
             return;
         }
 
@@ -4315,41 +5187,12 @@ public:
             return;
         }
 
-        std::vector<MaskRect> masks = parseMaskJson(maskJSON);
-        if (masks.empty()) {
+        if (maskRects.empty()) {
             applyCurrentInputShape();
             return;
         }
 
-        const LinuxXRectangleFields baseFields =
-            linuxPhysicalRectToXRectangleFields({
-                0,
-                0,
-                std::max(1, visualBounds.width),
-                std::max(1, visualBounds.height),
-            });
-        XRectangle baseRect = {
-            baseFields.x,
-            baseFields.y,
-            baseFields.width,
-            baseFields.height,
-        };
-        XShapeCombineRectangles(display, window, ShapeBounding, 0, 0, &baseRect, 1, ShapeSet, YXBanded);
-
-        for (const auto& mask : masks) {
-            const LinuxXRectangleFields fields =
-                linuxPhysicalRectToXRectangleFields(
-                    logicalToLinuxPhysicalRect(
-                        mask.x, mask.y, mask.width, mask.height, 1.0));
-            if (fields.width == 0 || fields.height == 0) continue;
-            XRectangle rect = {
-                fields.x,
-                fields.y,
-                fields.width,
-                fields.height,
-            };
-            XShapeCombineRectangles(display, window, ShapeBounding, 0, 0, &rect, 1, ShapeSubtract, YXBanded);
-        }
+        applyMaskRegion(display, window, ShapeBounding, currentMaskRegion(), boundingShapeCache);
         applyCurrentInputShape();
         XFlush(display);
     }
@@ -4361,8 +5204,13 @@ public:
             return;
         }
 
-        XShapeCombineMask(display, window, ShapeBounding, 0, 0, None, ShapeSet);
-        maskJSON.clear();
+        // Unmasked resyncs arrive on every layout pass; only reset a shape
+        // that was actually applied.
+        if (boundingShapeCache.valid()) {
+            XShapeCombineMask(display, window, ShapeBounding, 0, 0, None, ShapeSet);
+            boundingShapeCache.invalidate();
+        }
+        clearMasks();
         applyCurrentInputShape();
         XFlush(display);
     }
@@ -4478,6 +5326,68 @@ CefRefPtr<CefRequestContext> CreateRequestContextForPartition(const char* partit
 }
 
 // CEF WebView implementation
+// Routes DevTools method results: Page.captureScreenshot to its snapshot
+// job, and other methods to a callback told whether they succeeded. CEF
+// runs on the GTK main thread here, so results arrive there too; decoding,
+// cropping and re-encoding happen on the snapshot worker.
+class CEFDevToolsObserver : public CefDevToolsMessageObserver {
+public:
+    void add(int messageId, snapshot_encoder::Job&& job) {
+        pending_[messageId] = std::move(job);
+    }
+
+    void addResult(int messageId, std::function<void(bool)> done) {
+        pendingResults_[messageId] = std::move(done);
+    }
+
+    void failAll() {
+        std::map<int, snapshot_encoder::Job> pending;
+        pending.swap(pending_);
+        for (auto& [messageId, job] : pending) {
+            if (job.complete) job.complete(snapshot_encoder::Result{});
+        }
+        std::map<int, std::function<void(bool)>> pendingResults;
+        pendingResults.swap(pendingResults_);
+        for (auto& [messageId, done] : pendingResults) {
+            done(false);
+        }
+    }
+
+    void OnDevToolsMethodResult(CefRefPtr<CefBrowser> browser,
+                                int message_id,
+                                bool success,
+                                const void* result,
+                                size_t result_size) override {
+        auto done = pendingResults_.find(message_id);
+        if (done != pendingResults_.end()) {
+            std::function<void(bool)> callback = std::move(done->second);
+            pendingResults_.erase(done);
+            callback(success);
+            return;
+        }
+        auto it = pending_.find(message_id);
+        if (it == pending_.end()) return;
+        snapshot_encoder::Job job = std::move(it->second);
+        pending_.erase(it);
+
+        std::string data;
+        if (success && result) {
+            data = extractDevToolsScreenshotData(static_cast<const char*>(result), result_size);
+        }
+        if (data.empty()) {
+            if (job.complete) job.complete(snapshot_encoder::Result{});
+            return;
+        }
+        snapshot_encoder::submitPngBase64(std::move(job), std::move(data));
+    }
+
+private:
+    std::map<int, snapshot_encoder::Job> pending_;
+    std::map<int, std::function<void(bool)>> pendingResults_;
+
+    IMPLEMENT_REFCOUNTING(CEFDevToolsObserver);
+};
+
 class CEFWebViewImpl : public AbstractView {
 public:
     CefRefPtr<CefBrowser> browser;
@@ -4503,6 +5413,8 @@ public:
     // For popup reparenting approach
     unsigned long parentXWindow = 0;
     Display* parentXDisplay = nullptr;
+    LinuxMaskRegionCache boundingShapeCache;
+    LinuxMaskRegionCache inputShapeCache;
     CefRect targetBounds;
     double lastAppliedScaleFactor = 1.0;
     
@@ -4516,6 +5428,10 @@ public:
     
     // Transparent OSR input is forwarded by the shared X11 event source.
     uint32_t osr_window_id_ = 0;
+
+    // Registered with the browser host on the first DevTools method call.
+    CefRefPtr<CEFDevToolsObserver> devToolsObserver;
+    CefRefPtr<CefRegistration> devToolsObserverRegistration;
     
     CEFWebViewImpl(uint32_t webviewId,
                    GtkWidget* window,
@@ -4767,7 +5683,7 @@ public:
                 finalBounds = pendingFrame;
             }
             hasPendingFrame = false;
-            resizeLogical(finalBounds, maskJSON.c_str());
+            resizeLogical(finalBounds, nullptr);
             
             // Apply deferred initial transparent/passthrough state now that browser is ready
             // Don't apply transparency immediately - wait for page load to complete
@@ -5042,6 +5958,7 @@ public:
             std::lock_guard<std::mutex> lock(g_webviewMapMutex);
             g_webviewMap.erase(webviewId);
         }
+        dropWebviewSnapshotResults(webviewId);
 
         CefRefPtr<CefBrowser> browser_to_close;
         GtkWidget* widget_to_destroy = nullptr;
@@ -5057,6 +5974,14 @@ public:
             widget = nullptr;
         }
 
+        // Screenshots and lifecycle changes still in flight will never get
+        // a result.
+        devToolsObserverRegistration = nullptr;
+        if (devToolsObserver) {
+            devToolsObserver->failAll();
+            devToolsObserver = nullptr;
+        }
+
         // The client may outlive this view while asynchronous creation, load, or
         // close callbacks are still pending. It also closes a browser that is
         // created after this view has already been removed.
@@ -5183,11 +6108,10 @@ public:
         OperationGuard guard;
         if (!guard.isValid()) return;
 
-        // Internal relayouts may pass maskJSON.c_str(); copy before assigning
-        // the destination string so that aliased storage cannot be invalidated.
-        const std::string nextMasks = masksJson ? masksJson : "";
+        // Internal relayouts pass null masks; assignMaskJSON() leaves the
+        // current rects untouched then and when the JSON did not change.
         rememberLogicalBounds(frame);
-        maskJSON = nextMasks;
+        assignMaskJSON(masksJson);
 
         CefRefPtr<CefBrowser> browserRef;
         {
@@ -5212,9 +6136,8 @@ public:
             syncCEFPositionWithFrame(frame);
         }
 
-        // Apply visual mask if maskJSON is provided
-        // Check if masksJson is nullptr, empty, or just "[]" (empty array)
-        if (!maskJSON.empty() && maskJSON != "[]") {
+        // Apply visual mask if there are any masks
+        if (!maskRects.empty()) {
             applyVisualMask();
         } else {
             // If no masks, remove any existing masks
@@ -5248,13 +6171,13 @@ public:
             LogicalRect actualBounds = {
                 0.0, 0.0, static_cast<double>(width), static_cast<double>(height)};
             queryParentPhysicalBounds(actualBounds);
-            resizeLogical(actualBounds, maskJSON.c_str());
+            resizeLogical(actualBounds, nullptr);
         } else if (!fullSize) {
             const double nextScaleFactor = parentDeviceScaleFactor();
             const bool scaleChanged =
                 std::abs(nextScaleFactor - lastAppliedScaleFactor) > 0.0001;
             if (scaleChanged) {
-                resizeLogical(logicalBounds, maskJSON.c_str());
+                resizeLogical(logicalBounds, nullptr);
             }
         }
 
@@ -5262,13 +6185,7 @@ public:
     
     void applyVisualMask() override {
         
-        if (!browser || maskJSON.empty()) {
-            return;
-        }
-        
-        // Parse mask rectangles from JSON
-        std::vector<MaskRect> masks = parseMaskJson(maskJSON);
-        if (masks.empty()) {
+        if (!browser || maskRects.empty()) {
             return;
         }
         
@@ -5287,57 +6204,32 @@ public:
         // Convert local mask edges against the original view origin, then
         // express them relative to the clipped child origin. This keeps holes
         // aligned at fractional scale and while a child is scrolled offscreen.
-        std::vector<XRectangle> xrects;
-        for (const auto& mask : masks) {
-            const LinuxPhysicalRect physicalMask =
-                logicalSubrectToLinuxPhysicalRect(
-                    clippedBounds.x,
-                    clippedBounds.y,
-                    logicalBounds.x + mask.x - clippedBounds.x,
-                    logicalBounds.y + mask.y - clippedBounds.y,
-                    mask.width,
-                    mask.height,
-                    scaleFactor);
-            const LinuxXRectangleFields fields =
-                linuxPhysicalRectToXRectangleFields(physicalMask);
-            if (fields.width == 0 || fields.height == 0) continue;
-            XRectangle rect = {fields.x, fields.y, fields.width, fields.height};
-            xrects.push_back(rect);
-        }
-        
-        // Apply the shape mask to the X11 window. Rebuild the base even when
-        // every parsed hole clips to zero so an older shape cannot linger.
-        {
-            // First, create the base shape (full window rectangle)
-            LinuxPhysicalRect physicalBase = toX11BoundsRect(logicalBounds);
-            physicalBase.x = 0;
-            physicalBase.y = 0;
-            const LinuxXRectangleFields baseFields =
-                linuxPhysicalRectToXRectangleFields(physicalBase);
-            XRectangle baseRect = {
-                baseFields.x,
-                baseFields.y,
-                baseFields.width,
-                baseFields.height};
-            
-            // Set the base shape to the full window
-            XShapeCombineRectangles(display, window, ShapeBounding, 0, 0,
-                                   &baseRect, 1, ShapeSet, YXBanded);
-            if (!isMousePassthroughEnabled) {
-                XShapeCombineRectangles(display, window, ShapeInput, 0, 0,
-                                       &baseRect, 1, ShapeSet, YXBanded);
-            }
-            
-            // Subtract each mask rectangle individually
-            for (size_t i = 0; i < xrects.size(); i++) {
-                XShapeCombineRectangles(display, window, ShapeBounding, 0, 0,
-                                       &xrects[i], 1, ShapeSubtract, YXBanded);
-                if (!isMousePassthroughEnabled) {
-                    XShapeCombineRectangles(display, window, ShapeInput, 0, 0,
-                                           &xrects[i], 1, ShapeSubtract, YXBanded);
-                }
-            }
-            
+        std::vector<LinuxPhysicalRect> holes;
+        holes.reserve(maskRects.size());
+        for (const auto& mask : maskRects) {
+            holes.push_back(logicalSubrectToLinuxPhysicalRect(
+                clippedBounds.x,
+                clippedBounds.y,
+                logicalBounds.x + mask.x - clippedBounds.x,
+                logicalBounds.y + mask.y - clippedBounds.y,
+                mask.width,
+                mask.height,
+                scaleFactor));
+        }
+        
+        // The full window minus every hole, as one banded region. Rebuilding
+        // from the base each time means an older shape cannot linger when
+        // every hole clips away; resyncs with unchanged geometry send nothing.
+        const LinuxPhysicalRect physicalBase = toX11BoundsRect(logicalBounds);
+        const std::vector<LinuxXRectangleFields> region =
+            buildLinuxMaskRegion(physicalBase.width, physicalBase.height, holes);
+        bool changed = applyMaskRegion(
+            display, window, ShapeBounding, region, boundingShapeCache);
+        if (!isMousePassthroughEnabled) {
+            changed = applyMaskRegion(
+                display, window, ShapeInput, region, inputShapeCache) || changed;
+        }
+        if (changed) {
             XFlush(display);
         }
     }
@@ -5356,16 +6248,25 @@ public:
         Display* display = parentXDisplay;
         if (!display) return;
         
-        // Reset the window shape to be fully opaque/visible
-        // This removes any existing shape mask
-        XShapeCombineMask(display, window, ShapeBounding, 0, 0, None, ShapeSet);
-        if (!isMousePassthroughEnabled) {
+        // Reset the window shape to be fully opaque/visible. Unmasked resyncs
+        // arrive on every layout pass, so only reset shapes we applied.
+        bool changed = false;
+        if (boundingShapeCache.valid()) {
+            XShapeCombineMask(display, window, ShapeBounding, 0, 0, None, ShapeSet);
+            boundingShapeCache.invalidate();
+            changed = true;
+        }
+        if (!isMousePassthroughEnabled && inputShapeCache.valid()) {
             XShapeCombineMask(display, window, ShapeInput, 0, 0, None, ShapeSet);
+            inputShapeCache.invalidate();
+            changed = true;
+        }
+        if (changed) {
+            XFlush(display);
         }
-        XFlush(display);
         
         // Clear the mask JSON
-        maskJSON.clear();
+        clearMasks();
     }
     
     void toggleMirrorMode(bool enable) override {
@@ -5374,6 +6275,11 @@ public:
     }
     
     void setHidden(bool hidden) override {
+        if (parentTransparent && client) {
+            // Windowless views have no X11 window to unmap; stop painting.
+            client->SetOSRHidden(hidden);
+            return;
+        }
         if (browser) {
             // Use X11 APIs to show/hide the CEF window
             CefWindowHandle window = browser->GetHost()->GetWindowHandle();
@@ -5389,9 +6295,146 @@ public:
         }
     }
     
-    void setTransparent(bool transparent) override {
-        // Use the same approach as setHidden: XUnmapWindow/XMapWindow
-        if (browser) {
+    bool setWindowlessFrameRate(int frameRate) override {
+        if (!parentTransparent || !client) return false;
+        client->SetOSRFrameRate(frameRate);
+        return true;
+    }
+
+    bool setBackgroundThrottled(bool throttled) override {
+        if (!parentTransparent || !client) return false;
+        client->SetOSRThrottled(throttled);
+        return true;
+    }
+
+    // Only windowless views expose their paint buffers.
+    bool startFrameStream(uint8_t* ring, uint64_t ringLength, uint32_t slotCount,
+                          uint32_t maxFps, WebviewFrameStreamHandler handler) override {
+        if (!parentTransparent || !client || isRemoved) return false;
+        return client->StartFrameStream(ring, ringLength, slotCount, maxFps, handler);
+    }
+
+    void stopFrameStream() override {
+        if (client) client->StopFrameStream();
+    }
+
+    int rendererProcessId() const override {
+        return client ? client->GetRenderProcessId() : 0;
+    }
+
+    // Sends a DevTools method, registering the result observer first so the
+    // reply cannot be missed. Returns the message id, 0 when not sent.
+    int executeDevToolsMethod(CefRefPtr<CefBrowserHost> host,
+                              const char* method,
+                              CefRefPtr<CefDictionaryValue> params) {
+        if (!devToolsObserver) {
+            devToolsObserver = new CEFDevToolsObserver();
+            devToolsObserverRegistration = host->AddDevToolsMessageObserver(devToolsObserver);
+        }
+        return host->ExecuteDevToolsMethod(0, method, params);
+    }
+
+    // Hidden windowless views already report hidden and stop painting, so
+    // throttling only tells windowed browsers. Freezing uses the DevTools
+    // page lifecycle and counts once DevTools reports it applied. CEF has no
+    // way to drop a browser's renderer short of closing the browser, so a
+    // discard replaces the page with about:blank in its own history entry:
+    // the document and its memory go, the renderer process stays, and the
+    // restore replaces that entry with the page again.
+    void setLifecycleState(electrobun::WebviewLifecycleState from,
+                           electrobun::WebviewLifecycleState to,
+                           std::function<void()> entered) override {
+        if (isRemoved || !client) return;
+        CefRefPtr<CefBrowser> current;
+        {
+            std::lock_guard<std::mutex> lock(g_cefBrowserMutex);
+            current = browser;
+        }
+        if (!current) return;
+        CefRefPtr<CefBrowserHost> host = current->GetHost();
+        CefRefPtr<CefFrame> frame = current->GetMainFrame();
+        // `done` runs with whether the page reached `state`.
+        auto setPageLifecycle = [&](const char* state, std::function<void(bool)> done) {
+            CefRefPtr<CefDictionaryValue> params = CefDictionaryValue::Create();
+            params->SetString("state", state);
+            const int messageId = executeDevToolsMethod(host, "Page.setWebLifecycleState", params);
+            if (messageId == 0) {
+                if (done) done(false);
+            } else if (done) {
+                devToolsObserver->addResult(messageId, std::move(done));
+            }
+        };
+        switch (to) {
+            case electrobun::WebviewLifecycleState::throttled:
+                if (!parentTransparent) host->WasHidden(true);
+                break;
+            case electrobun::WebviewLifecycleState::frozen:
+                setPageLifecycle("frozen", [entered](bool success) {
+                    if (success && entered) entered();
+                });
+                return;
+            case electrobun::WebviewLifecycleState::discarded: {
+                if (!frame) return;
+                discardedUrl = frame->GetURL().ToString();
+                client->SetLifecycleDiscarded(true);
+                auto blank = [frame]() {
+                    frame->ExecuteJavaScript(electrobun::webviewLifecycleReplaceScript("about:blank"), "", 0);
+                };
+                // A frozen page runs no script until it is resumed, so the
+                // discard only counts once it has been.
+                if (from == electrobun::WebviewLifecycleState::frozen) {
+                    setPageLifecycle("active", [blank, entered](bool success) {
+                        if (!success) return;
+                        blank();
+                        if (entered) entered();
+                    });
+                    return;
+                }
+                blank();
+                break;
+            }
+            case electrobun::WebviewLifecycleState::active:
+                if (from == electrobun::WebviewLifecycleState::discarded) {
+                    client->SetLifecycleDiscarded(false);
+                    if (frame && !discardedUrl.empty()) {
+                        frame->ExecuteJavaScript(electrobun::webviewLifecycleReplaceScript(discardedUrl), "", 0);
+                    }
+                } else if (from == electrobun::WebviewLifecycleState::frozen) {
+                    setPageLifecycle("active", nullptr);
+                }
+                if (!parentTransparent) host->WasHidden(false);
+                break;
+        }
+        if (entered) entered();
+    }
+
+    // DevTools captures both windowed and OSR browsers at device scale, from
+    // the compositor, without a synchronous paint round-trip.
+    bool captureSnapshot(snapshot_encoder::Job&& job) override {
+        OperationGuard guard;
+        if (!guard.isValid() || isRemoved) return false;
+
+        CefRefPtr<CefBrowserHost> host;
+        {
+            std::lock_guard<std::mutex> lock(g_cefBrowserMutex);
+            if (browser) host = browser->GetHost();
+        }
+        if (!host) return false;
+
+        CefRefPtr<CefDictionaryValue> params = CefDictionaryValue::Create();
+        params->SetString("format", "png");
+        const int messageId = executeDevToolsMethod(host, "Page.captureScreenshot", params);
+        if (messageId == 0) return false;
+
+        job.viewWidth = logicalBounds.width;
+        job.viewHeight = logicalBounds.height;
+        devToolsObserver->add(messageId, std::move(job));
+        return true;
+    }
+
+    void setTransparent(bool transparent) override {
+        // Use the same approach as setHidden: XUnmapWindow/XMapWindow
+        if (browser) {
             CefWindowHandle window = browser->GetHost()->GetWindowHandle();
             if (window && parentXDisplay) {
                 Display* display = parentXDisplay;
@@ -5419,13 +6462,16 @@ public:
             CefWindowHandle window = browser->GetHost()->GetWindowHandle();
             if (window && parentXDisplay) {
                 Display* display = parentXDisplay;
+                // Passthrough owns the input shape; forget the cached mask
+                // region so it is sent again when masks take over.
+                inputShapeCache.invalidate();
                 if (enable) {
                     // Make window invisible to mouse events
                     XRectangle rect = {0, 0, 0, 0}; // Empty rectangle
                     XShapeCombineRectangles(display, window, ShapeInput, 0, 0,
                                            &rect, 1, ShapeSet, YXBanded);
                 } else {
-                    if (!maskJSON.empty() && maskJSON != "[]") {
+                    if (!maskRects.empty()) {
                         applyVisualMask();
                     } else {
                         XShapeCombineMask(
@@ -5721,8 +6767,7 @@ public:
                 // Auto-resize webviews should fill the entire window
                 // Preserve any native-layer masks while the SDK computes and
                 // applies updated anchor geometry for the new client size.
-                const std::string masks = view->maskJSON;
-                view->resize(frame, masks.c_str());
+                view->resize(frame, nullptr);
             }
             // OOPIFs (fullSize=false) keep their positioning and don't auto-resize
             // The JavaScript ResizeObserver will handle repositioning them
@@ -6303,15 +7348,7 @@ static void handleViewsURIScheme(WebKitURISchemeRequest* request, gpointer user_
     // Check if ASAR archive exists (only if file not found in viewsRoot)
     if (!foundFile && g_file_test(asarPath, G_FILE_TEST_EXISTS)) {
         // Thread-safe lazy-load ASAR archive on first use
-        std::call_once(g_asarArchiveInitFlag, [asarPath]() {
-            g_asarArchive = asar_open(asarPath);
-            if (g_asarArchive) {
-                fflush(stdout);
-            } else {
-                printf("ERROR WebKit loadViewsFile: Failed to open ASAR archive at %s\n", asarPath);
-                fflush(stdout);
-            }
-        });
+        openAsarArchiveOnce(asarPath, "WebKit loadViewsFile");
 
         // If ASAR archive is loaded, try to read from it
         if (g_asarArchive) {
@@ -6385,6 +7422,8 @@ void initializeGTK() {
     {
         std::unique_lock<std::mutex> lock(g_gtkInitMutex);
         if (!g_gtkInitialized) {
+            electrobun::StartupTraceScope trace(g_startupTrace, "initializeGTK");
+
             // Shared Display contract: XInitThreads must precede gtk_init/CEF
             // and every XOpenDisplay. Each X11Window owns its Display, ordinary
             // event/mutation work runs on the GLib main context, and OSR paint
@@ -6787,6 +7826,14 @@ void on_library_load() {
     // Library constructors run before callers can initialize GTK/CEF or open a
     // Display, satisfying Xlib's ordering requirement for thread support.
     ensureXlibThreadSupport();
+
+    g_startupTracePath = electrobun::resolveStartupTracePath(
+        getenv(electrobun::kStartupTraceEnvironment), getenv("TMPDIR"), getpid());
+    if (!g_startupTracePath.empty()) {
+        g_startupTrace = new electrobun::StartupTrace();
+        g_startupTrace->nameThread("loader");
+        g_startupTrace->instant("libraryLoad");
+    }
 }
 
 static bool cefBrowsersFinishedClosing() {
@@ -6953,6 +8000,18 @@ gboolean process_x11_events(gpointer data) {
             XEvent event;
             XNextEvent(x11win->display, &event);
 
+            // Structure events from CEF browser windows drive OOPIF layout
+            // nudges; they never belong to the parent window's handlers.
+            if (event.type == MapNotify || event.type == ConfigureNotify ||
+                event.type == DestroyNotify) {
+                CefRefPtr<ElectrobunClient> layoutClient =
+                    getCEFLayoutWatchClient(event.xany.window);
+                if (layoutClient) {
+                    layoutClient->HandleLayoutWatchEvent(event);
+                    continue;
+                }
+            }
+
             std::shared_ptr<X11Window> childParentWindow;
             {
                 std::lock_guard<std::mutex> lock(g_x11WindowsMutex);
@@ -7031,6 +8090,17 @@ gboolean process_x11_events(gpointer data) {
                     // Handle expose events if needed
                     break;
 
+                case MapNotify:
+                case UnmapNotify:
+                case VisibilityNotify:
+                    if (x11win->transparent) {
+                        CefRefPtr<ElectrobunClient> osrClient = getOSRClientForWindow(windowId);
+                        if (osrClient) {
+                            osrClient->HandleOSRVisibilityEvent(event);
+                        }
+                    }
+                    break;
+
                 case FocusIn:
                     // Window received focus
                     if (x11win->focusCallback) {
@@ -7195,11 +8265,16 @@ void runGTKEventLoop() {
 }
 
 void runEventLoop() {    
+    if (g_startupTrace) {
+        g_startupTrace->nameThread("main");
+        g_startupTrace->instant("startEventLoop");
+    }
     if (isCEFAvailable()) {      
         runCEFEventLoop();
     } else {  
         runGTKEventLoop();
     }
+    writeStartupTrace();
 }
 
 
@@ -7303,6 +8378,11 @@ void* createX11Window(uint32_t windowId, double x, double y, double width, doubl
                              ButtonPressMask | ButtonReleaseMask | PointerMotionMask |
                              FocusChangeMask | EnterWindowMask | LeaveWindowMask |
                              StructureNotifyMask;
+            // Transparent windows host windowless CEF views, which stop
+            // painting while X reports the window fully obscured.
+            if (transparent) {
+                event_mask |= VisibilityChangeMask;
+            }
             XSelectInput(display, x11_window, event_mask);
             
             // Handle window decorations based on titleBarStyle
@@ -7549,6 +8629,7 @@ ELECTROBUN_EXPORT void* createWindowWithFrameAndStyleFromWorker(uint32_t windowI
                                              WindowCloseCallback closeCallback, WindowMoveCallback moveCallback, WindowResizeCallback resizeCallback, WindowFocusCallback focusCallback, WindowBlurCallback blurCallback, WindowKeyHandler keyCallback, WindowShouldCloseHandler shouldCloseCallback) {
     (void)trafficLightOffsetX;
     (void)trafficLightOffsetY;
+    electrobun::StartupTraceScope trace(startupTraceFirst("firstWindow"), "firstWindow");
 
     // CEF supports custom frames and transparency, GTK doesn't
     if (isCEFAvailable()) {
@@ -7975,6 +9056,8 @@ ELECTROBUN_EXPORT AbstractView* initWebview(uint32_t webviewId,
     // Wait for GTK initialization to complete before creating any webviews
     waitForGTKInit();
 
+    electrobun::StartupTraceScope trace(startupTraceFirst("firstWebview"), "firstWebview",
+                                        isCEFAvailable() ? "cef" : "webkit");
     AbstractView* view = nullptr;
     if (isCEFAvailable()) {
         view = initCEFWebview(webviewId, window, renderer, url, x, y, width, height, autoResize,
@@ -8257,6 +9340,7 @@ typedef WGPUWaitStatus (*PFN_wgpuInstanceWaitAny)(WGPUInstance instance, size_t
 typedef void* (*PFN_wgpuBufferGetMappedRange)(WGPUBuffer buffer, size_t offset, size_t size);
 typedef void* (*PFN_wgpuBufferGetConstMappedRange)(WGPUBuffer buffer, size_t offset, size_t size);
 typedef void (*PFN_wgpuBufferUnmap)(WGPUBuffer buffer);
+typedef void (*PFN_wgpuSurfaceRelease)(void* surface);
 
 static void* wgpuLibHandle = nullptr;
 static PFN_wgpuInstanceCreateSurface p_wgpuInstanceCreateSurface = nullptr;
@@ -8269,24 +9353,15 @@ static PFN_wgpuInstanceWaitAny p_wgpuInstanceWaitAny = nullptr;
 static PFN_wgpuBufferGetMappedRange p_wgpuBufferGetMappedRange = nullptr;
 static PFN_wgpuBufferGetConstMappedRange p_wgpuBufferGetConstMappedRange = nullptr;
 static PFN_wgpuBufferUnmap p_wgpuBufferUnmap = nullptr;
+static PFN_wgpuSurfaceRelease p_wgpuSurfaceRelease = nullptr;
 
 static void* loadWgpuLibrary() {
     if (wgpuLibHandle) return wgpuLibHandle;
     std::string execDir = getExecutableDir();
-    std::vector<std::string> candidates = {
+    wgpuLibHandle = electrobun::openWgpuLibrary({
         execDir + "/libwebgpu_dawn.so",
         execDir + "/../Resources/libwebgpu_dawn.so",
-    };
-    for (const auto& path : candidates) {
-        wgpuLibHandle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
-        if (wgpuLibHandle) break;
-    }
-    if (!wgpuLibHandle) {
-        wgpuLibHandle = dlopen("libwebgpu_dawn.so", RTLD_NOW | RTLD_LOCAL);
-    }
-    if (!wgpuLibHandle) {
-        fprintf(stderr, "WGPU: failed to load libwebgpu_dawn.so: %s\n", dlerror());
-    }
+    }, "libwebgpu_dawn.so");
     return wgpuLibHandle;
 }
 
@@ -8308,6 +9383,7 @@ static bool ensureWgpuSymbols() {
     p_wgpuBufferGetMappedRange = (PFN_wgpuBufferGetMappedRange)dlsym(handle, "wgpuBufferGetMappedRange");
     p_wgpuBufferGetConstMappedRange = (PFN_wgpuBufferGetConstMappedRange)dlsym(handle, "wgpuBufferGetConstMappedRange");
     p_wgpuBufferUnmap = (PFN_wgpuBufferUnmap)dlsym(handle, "wgpuBufferUnmap");
+    p_wgpuSurfaceRelease = (PFN_wgpuSurfaceRelease)dlsym(handle, "wgpuSurfaceRelease");
     if (!p_wgpuInstanceCreateSurface || !p_wgpuSurfaceConfigure || !p_wgpuSurfaceGetCurrentTexture || !p_wgpuSurfacePresent
         || !p_wgpuQueueOnSubmittedWorkDone || !p_wgpuBufferMapAsync || !p_wgpuInstanceWaitAny
         || !p_wgpuBufferGetMappedRange || !p_wgpuBufferUnmap) {
@@ -8423,6 +9499,33 @@ ELECTROBUN_EXPORT void wgpuSurfaceCapabilitiesFreeMembersShim(void* capabilities
     *capabilities = {};
 }
 
+static uint64_t wgpuSurfaceNowUs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Refresh period of the monitor showing the view, in microseconds; 0 when
+// GDK does not know it. Main thread only.
+static uint32_t wgpuViewRefreshPeriodUs(WGPUViewImpl* view) {
+    GdkDisplay* gdkDisplay = gdk_display_get_default();
+    if (!view || !gdkDisplay) return 0;
+    GdkMonitor* monitor = nullptr;
+    if (view->viewWidget && gtk_widget_get_window(view->viewWidget)) {
+        monitor = gdk_display_get_monitor_at_window(gdkDisplay, gtk_widget_get_window(view->viewWidget));
+    } else if (view->xDisplay && view->xWindow) {
+        int rootX = 0;
+        int rootY = 0;
+        Window child = 0;
+        XTranslateCoordinates(view->xDisplay, view->xWindow, DefaultRootWindow(view->xDisplay),
+                              0, 0, &rootX, &rootY, &child);
+        monitor = gdk_display_get_monitor_at_point(gdkDisplay, rootX, rootY);
+    }
+    if (!monitor) monitor = gdk_display_get_primary_monitor(gdkDisplay);
+    // Millihertz; 0 when unknown.
+    const int refreshRate = monitor ? gdk_monitor_get_refresh_rate(monitor) : 0;
+    return refreshRate > 0 ? (uint32_t)(1000000000ULL / (uint64_t)refreshRate) : 0;
+}
+
 struct GPUTestState {
     WGPUInstance instance = nullptr;
     WGPUSurface surface = nullptr;
@@ -8437,6 +9540,9 @@ struct GPUTestState {
     Display* display = nullptr;
     Window window = 0;
     guint timerId = 0;
+    // Frame clock tick driving the frames when the view has a GTK widget.
+    guint tickId = 0;
+    GtkWidget* tickWidget = nullptr;
     float angle = 0.0f;
     uint32_t lastWidth = 0;
     uint32_t lastHeight = 0;
@@ -8444,6 +9550,8 @@ struct GPUTestState {
     bool useAlt = false;
     bool running = false;
     WGPUViewImpl* view = nullptr;
+    // Drives the frame pacer; reset with the rest of the state.
+    electrobun::WgpuFrameStatsRecorder frameStats;
 };
 
 static GPUTestState g_gpuTest;
@@ -8557,6 +9665,10 @@ void stopWgpuTestForWindow(Window window) {
         g_source_remove(g_gpuTest.timerId);
         g_gpuTest.timerId = 0;
     }
+    if (g_gpuTest.tickId) {
+        // The destroy notify clears tickId and tickWidget.
+        gtk_widget_remove_tick_callback(g_gpuTest.tickWidget, g_gpuTest.tickId);
+    }
     g_gpuTest.running = false;
     if (!window || g_gpuTest.window == window) {
         g_gpuTest.window = 0;
@@ -8783,7 +9895,9 @@ static void gpuTestRenderFrame(GPUTestState* state) {
     p_wgpuQueueWriteBuffer(state->queue, state->vertexBuffer, 0, verts, sizeof(verts));
 
     WGPUSurfaceTexture surfaceTexture = {};
+    const uint64_t acquireStart = wgpuSurfaceNowUs();
     p_wgpuSurfaceGetCurrentTexture(state->surface, &surfaceTexture);
+    state->frameStats.recordAcquire(acquireStart, wgpuSurfaceNowUs());
     if (surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessOptimal &&
         surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessSuboptimal) {
         state->surfaceConfigured = false;
@@ -8820,7 +9934,9 @@ static void gpuTestRenderFrame(GPUTestState* state) {
 
     WGPUCommandBuffer cmd = p_wgpuCommandEncoderFinish(encoder, nullptr);
     p_wgpuQueueSubmit(state->queue, 1, &cmd);
-    p_wgpuSurfacePresent(state->surface);
+    const uint64_t presentStart = wgpuSurfaceNowUs();
+    const int32_t presentStatus = p_wgpuSurfacePresent(state->surface);
+    state->frameStats.recordPresent(presentStart, wgpuSurfaceNowUs(), presentStatus == WGPUStatus_Success);
 
     p_wgpuTextureViewRelease(view);
     p_wgpuTextureRelease(surfaceTexture.texture);
@@ -8844,13 +9960,57 @@ static void gpuTestUncapturedErrorCallback(WGPUDevice const* /*device*/, WGPUErr
     logWgpuStringView(prefix, message);
 }
 
-static gboolean gpuTestTimerProc(gpointer data) {
+static gboolean gpuTestTimerProc(gpointer data);
+
+static gboolean gpuTestTickProc(GtkWidget* /*widget*/, GdkFrameClock* /*clock*/, gpointer data) {
     GPUTestState* state = static_cast<GPUTestState*>(data);
-    if (!state || !state->running) return G_SOURCE_REMOVE;
+    if (!state->running) return G_SOURCE_REMOVE;
     gpuTestRenderFrame(state);
     return state->running ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
 }
 
+static void gpuTestTickDestroyed(gpointer data) {
+    GPUTestState* state = static_cast<GPUTestState*>(data);
+    state->tickId = 0;
+    state->tickWidget = nullptr;
+}
+
+// Views with a GTK widget render from its frame clock, which GDK times to
+// the display. X11 child views have none, so their next frame is scheduled
+// from the last present rather than a fixed 16 ms timer, which drifts
+// against the display and alternates between one and two refreshes per
+// frame.
+static void gpuTestScheduleFrame(GPUTestState* state) {
+    if (state->tickId) return;
+    if (state->view && state->view->viewWidget) {
+        state->tickWidget = state->view->viewWidget;
+        state->tickId = gtk_widget_add_tick_callback(state->tickWidget, gpuTestTickProc, state,
+                                                     gpuTestTickDestroyed);
+        return;
+    }
+    const uint32_t period = state->frameStats.refreshPeriod();
+    uint64_t delayUs = period;
+    if (state->frameStats.lastPresentUs() != 0) {
+        delayUs = electrobun::wgpuFramePacingDelayUs(wgpuSurfaceNowUs(), state->frameStats.lastPresentUs(),
+                                                     period, state->frameStats.stats().avgWorkUs);
+    }
+    // GLib timers have millisecond resolution; round so a 16.7 ms delay is
+    // not cut to 16 ms and started early every frame.
+    state->timerId = g_timeout_add((guint)((delayUs + 500) / 1000), gpuTestTimerProc, state);
+}
+
+static gboolean gpuTestTimerProc(gpointer data) {
+    GPUTestState* state = static_cast<GPUTestState*>(data);
+    if (!state) return G_SOURCE_REMOVE;
+    state->timerId = 0;
+    if (!state->running) return G_SOURCE_REMOVE;
+    gpuTestRenderFrame(state);
+    if (state->running && !state->timerId) {
+        gpuTestScheduleFrame(state);
+    }
+    return G_SOURCE_REMOVE;
+}
+
 static void gpuTestRequestDeviceCallback(WGPURequestDeviceStatus status, WGPUDevice device, WGPUStringView message, void* userdata1, void* userdata2);
 
 static void gpuTestRequestAdapterCallback(WGPURequestAdapterStatus status, WGPUAdapter adapter, WGPUStringView message, void* userdata1, void* userdata2) {
@@ -8899,8 +10059,12 @@ static void gpuTestRequestDeviceCallback(WGPURequestDeviceStatus status, WGPUDev
             state->timerId = 0;
         }
         state->running = true;
-        state->timerId = g_timeout_add(16, gpuTestTimerProc, state);
+        state->frameStats = electrobun::WgpuFrameStatsRecorder();
+        state->frameStats.setRefreshPeriod(wgpuViewRefreshPeriodUs(state->view));
         gpuTestRenderFrame(state);
+        if (state->running && !state->timerId) {
+            gpuTestScheduleFrame(state);
+        }
     });
 }
 
@@ -8923,13 +10087,185 @@ ELECTROBUN_EXPORT void* wgpuInstanceCreateSurfaceMainThread(void* instance, void
     });
 }
 
+// ----------------------- WGPU Surface Render Threads -----------------------
+//
+// By default every surface call hops synchronously to the GTK main thread,
+// which owns the X connection the surface was created on, so a busy UI
+// thread stalls configure/acquire/present and caps the frame rate. Views
+// that opt in get a render thread with its own X connection to the same
+// display; their surface is created on that connection and the surface
+// calls hop to the render thread instead. Geometry and visibility stay with
+// the UI thread, which flushes them on its own connection as before.
+
+class WgpuSurfaceRenderThread {
+public:
+    ~WgpuSurfaceRenderThread() {
+        stop();
+    }
+
+    // Open a connection to displayName on a new thread. False when the
+    // display cannot be opened.
+    bool start(const std::string& displayName, uint32_t viewId) {
+        std::promise<Display*> opened;
+        std::future<Display*> openedFuture = opened.get_future();
+        thread_ = std::thread([this, displayName, viewId, &opened]() {
+            char name[16];
+            snprintf(name, sizeof(name), "wgpu-view-%u", viewId);
+            pthread_setname_np(pthread_self(), name);
+            Display* display = XOpenDisplay(displayName.empty() ? nullptr : displayName.c_str());
+            display_ = display;
+            opened.set_value(display);
+            if (display) {
+                runTasks();
+                XCloseDisplay(display);
+            }
+        });
+        if (!openedFuture.get()) {
+            thread_.join();
+            return false;
+        }
+        return true;
+    }
+
+    Display* display() const {
+        return display_;
+    }
+
+    // Run fn on the render thread and wait for it.
+    template <typename Fn>
+    void run(Fn& fn) {
+        Task task;
+        task.fn = [](void* context) { (*static_cast<Fn*>(context))(); };
+        task.context = &fn;
+        if (push(&task)) wait(&task);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_one();
+        if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+            thread_.join();
+        }
+    }
+
+private:
+    // A queued call. Tasks live on the waiting caller's stack and are linked
+    // in place, so a frame costs no heap traffic.
+    struct Task {
+        void (*fn)(void*) = nullptr;
+        void* context = nullptr;
+        Task* next = nullptr;
+        bool queued = false;
+    };
+
+    bool push(Task* task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || !thread_.joinable()) return false;
+            task->next = nullptr;
+            task->queued = true;
+            if (tail_) {
+                tail_->next = task;
+            } else {
+                head_ = task;
+            }
+            tail_ = task;
+        }
+        condition_.notify_one();
+        return true;
+    }
+
+    void wait(Task* task) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [task] { return !task->queued; });
+    }
+
+    void runTasks() {
+        for (;;) {
+            Task* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || head_; });
+                if (!head_) return;
+                task = head_;
+                head_ = task->next;
+                if (!head_) tail_ = nullptr;
+            }
+            task->fn(task->context);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task->queued = false;
+            }
+            done_.notify_all();
+        }
+    }
+
+    std::thread thread_;
+    Display* display_ = nullptr;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable done_;
+    Task* head_ = nullptr;
+    Task* tail_ = nullptr;
+    bool stopping_ = false;
+};
+
+// A surface created for a WGPUViewImpl, with its frame statistics and, when
+// the view opted in, the render thread that owns it.
+struct WgpuViewSurface {
+    uint32_t viewId = 0;
+    std::shared_ptr<WgpuSurfaceRenderThread> renderThread;
+    electrobun::WgpuSurfaceFrameTimer frames;
+
+    WgpuViewSurface(uint32_t id, std::shared_ptr<WgpuSurfaceRenderThread> thread)
+        : viewId(id), renderThread(std::move(thread)), frames(renderThread != nullptr, wgpuSurfaceNowUs) {}
+};
+
+static std::mutex g_wgpuViewSurfacesMutex;
+static std::map<void*, std::shared_ptr<WgpuViewSurface>> g_wgpuViewSurfaces;
+
+static std::shared_ptr<WgpuViewSurface> findWgpuViewSurface(void* surface) {
+    std::lock_guard<std::mutex> lock(g_wgpuViewSurfacesMutex);
+    auto it = g_wgpuViewSurfaces.find(surface);
+    return it == g_wgpuViewSurfaces.end() ? nullptr : it->second;
+}
+
+static std::shared_ptr<WgpuViewSurface> findWgpuViewSurfaceForView(uint32_t viewId) {
+    std::lock_guard<std::mutex> lock(g_wgpuViewSurfacesMutex);
+    for (const auto& entry : g_wgpuViewSurfaces) {
+        if (entry.second->viewId == viewId) {
+            return entry.second;
+        }
+    }
+    return nullptr;
+}
+
+// Run a surface call on the thread that owns the surface.
+template <typename Fn>
+static void runOnSurfaceThread(const std::shared_ptr<WgpuViewSurface>& owner, Fn fn) {
+    if (owner && owner->renderThread) {
+        owner->renderThread->run(fn);
+    } else {
+        runOnMainThreadSyncVoid(fn);
+    }
+}
+
 ELECTROBUN_EXPORT void* wgpuCreateSurfaceForView(void* wgpuInstance, AbstractView* abstractView) {
     if (!wgpuInstance || !abstractView) return nullptr;
     if (!ensureWgpuSymbols()) return nullptr;
 
-    return runOnMainThreadSyncPtr([&]() -> void* {
+    uint32_t viewId = 0;
+    uint32_t refreshPeriodUs = 0;
+    std::string displayName;
+    Window renderWindow = 0;
+    void* surface = runOnMainThreadSyncPtr([&]() -> void* {
         WGPUViewImpl* view = dynamic_cast<WGPUViewImpl*>(abstractView);
         if (!view) return nullptr;
+        viewId = view->webviewId;
+        refreshPeriodUs = wgpuViewRefreshPeriodUs(view);
 
         Display* display = nullptr;
         Window window = 0;
@@ -8946,6 +10282,16 @@ ELECTROBUN_EXPORT void* wgpuCreateSurfaceForView(void* wgpuInstance, AbstractVie
 
         if (!display || !window) return nullptr;
 
+        // Only X11 child views have a window of their own to hand over.
+        if (view->renderThreadRequested && view->xDisplay && view->xWindow) {
+            // The render thread's connection refers to the window by XID,
+            // so it must exist on the server first.
+            XSync(display, False);
+            displayName = DisplayString(display);
+            renderWindow = window;
+            return nullptr;
+        }
+
         WGPUSurfaceSourceXlibWindow xlibSource = {};
         xlibSource.chain.sType = WGPUSType_SurfaceSourceXlibWindow;
         xlibSource.display = display;
@@ -8955,23 +10301,147 @@ ELECTROBUN_EXPORT void* wgpuCreateSurfaceForView(void* wgpuInstance, AbstractVie
         surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&xlibSource);
         return p_wgpuInstanceCreateSurface(wgpuInstance, &surfaceDesc);
     });
+
+    std::shared_ptr<WgpuSurfaceRenderThread> renderThread;
+    if (renderWindow) {
+        renderThread = std::make_shared<WgpuSurfaceRenderThread>();
+        if (renderThread->start(displayName, viewId)) {
+            auto createSurface = [&]() {
+                WGPUSurfaceSourceXlibWindow xlibSource = {};
+                xlibSource.chain.sType = WGPUSType_SurfaceSourceXlibWindow;
+                xlibSource.display = renderThread->display();
+                xlibSource.window = static_cast<uint64_t>(renderWindow);
+
+                WGPUSurfaceDescriptor surfaceDesc = {};
+                surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&xlibSource);
+                surface = p_wgpuInstanceCreateSurface(wgpuInstance, &surfaceDesc);
+            };
+            renderThread->run(createSurface);
+        }
+        if (!surface) {
+            fprintf(stderr, "WGPU: render thread surface failed for view %u; using the main thread\n", viewId);
+            renderThread.reset();
+            surface = runOnMainThreadSyncPtr([&]() -> void* {
+                WGPUViewImpl* view = dynamic_cast<WGPUViewImpl*>(abstractView);
+                if (!view) return nullptr;
+                view->renderThreadRequested = false;
+                WGPUSurfaceSourceXlibWindow xlibSource = {};
+                xlibSource.chain.sType = WGPUSType_SurfaceSourceXlibWindow;
+                xlibSource.display = view->xDisplay;
+                xlibSource.window = static_cast<uint64_t>(renderWindow);
+
+                WGPUSurfaceDescriptor surfaceDesc = {};
+                surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&xlibSource);
+                return view->xDisplay ? p_wgpuInstanceCreateSurface(wgpuInstance, &surfaceDesc) : nullptr;
+            });
+        }
+    }
+
+    if (surface) {
+        auto owner = std::make_shared<WgpuViewSurface>(viewId, std::move(renderThread));
+        owner->frames.setRefreshPeriod(refreshPeriodUs);
+        std::lock_guard<std::mutex> lock(g_wgpuViewSurfacesMutex);
+        g_wgpuViewSurfaces[surface] = std::move(owner);
+    }
+    return surface;
+}
+
+// Release a surface from wgpuCreateSurfaceForView on its owning thread, then
+// stop that thread. Surfaces from elsewhere are released directly, as the
+// caller would have done.
+ELECTROBUN_EXPORT void wgpuReleaseSurfaceForView(void* surface) {
+    if (!surface || !ensureWgpuSymbols() || !p_wgpuSurfaceRelease) return;
+    std::shared_ptr<WgpuViewSurface> owner;
+    {
+        std::lock_guard<std::mutex> lock(g_wgpuViewSurfacesMutex);
+        auto it = g_wgpuViewSurfaces.find(surface);
+        if (it != g_wgpuViewSurfaces.end()) {
+            owner = std::move(it->second);
+            g_wgpuViewSurfaces.erase(it);
+        }
+    }
+    if (owner && owner->renderThread) {
+        auto release = [&]() { p_wgpuSurfaceRelease(surface); };
+        owner->renderThread->run(release);
+        owner->renderThread->stop();
+        return;
+    }
+    p_wgpuSurfaceRelease(surface);
+}
+
+// Must be called before the view's WebGPU context creates its surface.
+ELECTROBUN_EXPORT void wgpuViewSetRenderThread(void* abstractView, bool enabled) {
+    if (!abstractView) return;
+    runOnMainThreadSyncVoid([&]() {
+        WGPUViewImpl* view = dynamic_cast<WGPUViewImpl*>((AbstractView*)abstractView);
+        if (view) view->renderThreadRequested = enabled;
+    });
+}
+
+// Fills a WgpuFrameStats (88 bytes, see wgpu_frame_stats.h) for the view's
+// current surface. False when the view has no surface.
+ELECTROBUN_EXPORT bool wgpuViewGetFrameStats(void* abstractView, void* outStats) {
+    if (!abstractView || !outStats) return false;
+    std::shared_ptr<WgpuViewSurface> owner = findWgpuViewSurfaceForView(((AbstractView*)abstractView)->webviewId);
+    if (!owner) return false;
+    const electrobun::WgpuFrameStats stats = owner->frames.stats();
+    memcpy(outStats, &stats, sizeof(stats));
+    return true;
+}
+
+// Copies up to maxFrames of the view's most recent WgpuFrameTiming records
+// (32 bytes each, oldest first) and returns how many were copied.
+ELECTROBUN_EXPORT uint32_t wgpuViewGetFrameTimeline(void* abstractView, void* outTimings, uint32_t maxFrames) {
+    if (!abstractView || !outTimings || maxFrames == 0) return 0;
+    std::shared_ptr<WgpuViewSurface> owner = findWgpuViewSurfaceForView(((AbstractView*)abstractView)->webviewId);
+    if (!owner) return 0;
+    return (uint32_t)owner->frames.copyTimeline(static_cast<electrobun::WgpuFrameTiming*>(outTimings), maxFrames);
+}
+
+// Microseconds to wait before starting the view's next frame so its present
+// lands just ahead of a refresh; 0 to start now or when nothing is known yet.
+ELECTROBUN_EXPORT uint64_t wgpuViewGetFramePacingDelay(void* abstractView) {
+    if (!abstractView) return 0;
+    std::shared_ptr<WgpuViewSurface> owner = findWgpuViewSurfaceForView(((AbstractView*)abstractView)->webviewId);
+    if (!owner) return 0;
+    return owner->frames.pacingDelayUs();
 }
 
 ELECTROBUN_EXPORT void wgpuSurfaceConfigureMainThread(void* surface, void* config) {
     if (!ensureWgpuSymbols()) return;
-    runOnMainThreadSyncVoid([&]() { p_wgpuSurfaceConfigure(surface, config); });
+    runOnSurfaceThread(findWgpuViewSurface(surface), [&]() { p_wgpuSurfaceConfigure(surface, config); });
 }
 
 ELECTROBUN_EXPORT void wgpuSurfaceGetCurrentTextureMainThread(void* surface, void* surfaceTexture) {
     if (!ensureWgpuSymbols()) return;
-    runOnMainThreadSyncVoid([&]() { p_wgpuSurfaceGetCurrentTexture(surface, surfaceTexture); });
+    std::shared_ptr<WgpuViewSurface> owner = findWgpuViewSurface(surface);
+    auto acquire = [&]() {
+        runOnSurfaceThread(owner, [&]() { p_wgpuSurfaceGetCurrentTexture(surface, surfaceTexture); });
+    };
+    if (owner) {
+        owner->frames.acquire(acquire);
+    } else {
+        acquire();
+    }
 }
 
+// Present stays synchronous in both modes: JS keeps using the device for
+// the next frame as soon as this returns, and Dawn devices are not
+// synchronized across threads here.
 ELECTROBUN_EXPORT int32_t wgpuSurfacePresentMainThread(void* surface) {
     if (!ensureWgpuSymbols()) return 0;
-    return (int32_t)(intptr_t)runOnMainThreadSyncPtr([&]() -> void* {
-        return (void*)(intptr_t)p_wgpuSurfacePresent(surface);
-    });
+    std::shared_ptr<WgpuViewSurface> owner = findWgpuViewSurface(surface);
+    int32_t status = 0;
+    auto present = [&]() {
+        runOnSurfaceThread(owner, [&]() { status = p_wgpuSurfacePresent(surface); });
+        return status == WGPUStatus_Success;
+    };
+    if (owner) {
+        owner->frames.present(present);
+    } else {
+        present();
+    }
+    return status;
 }
 
 ELECTROBUN_EXPORT uint64_t wgpuQueueOnSubmittedWorkDoneShim(void* queue, void* callbackInfo) {
@@ -9202,67 +10672,395 @@ ELECTROBUN_EXPORT void wgpuBufferReadbackFreeShim(void* jobPtr) {
     free(job);
 }
 
-ELECTROBUN_EXPORT void wgpuRunGPUTest(void* abstractView) {
-    if (!abstractView) return;
-    if (!ensureWgpuTestSymbols()) return;
-
-    runOnMainThreadSyncVoid([&]() {
-        WGPUViewImpl* view = dynamic_cast<WGPUViewImpl*>((AbstractView*)abstractView);
-        if (!view) {
-            wgpu_log("run test called with non-WGPU view");
-            return;
-        }
+// ----------------------- WGPU Readback Pool -----------------------
+//
+// Apps that read results back every frame reuse a fixed set of MAP_READ
+// staging buffers and host slabs instead of allocating a buffer, a job and an
+// output copy per readback. A submit copies the source range into a free
+// staging buffer, maps it, and the map callback copies it into that slot's
+// slab and unmaps straight away, so the staging buffer is ready for the next
+// frame while the caller reads the slab in place.
+//
+// With notifications enabled, a waiter thread blocks in wgpuInstanceWaitAny
+// on outstanding maps so callbacks run as soon as the GPU finishes, and each
+// callback pushes its id to a completion queue and bumps an eventfd the host
+// watches, as with getHostMessageWakeupReadFD. Render loops then overlap
+// readbacks with the next frame instead of polling status.
+
+typedef void (*PFN_wgpuCommandEncoderCopyBufferToBuffer)(WGPUCommandEncoder encoder, WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, uint64_t size);
+typedef void (*PFN_wgpuBufferDestroy)(WGPUBuffer buffer);
+typedef void (*PFN_wgpuBufferRelease)(WGPUBuffer buffer);
+
+static PFN_wgpuCommandEncoderCopyBufferToBuffer p_wgpuCommandEncoderCopyBufferToBuffer = nullptr;
+static PFN_wgpuBufferDestroy p_wgpuBufferDestroy = nullptr;
+static PFN_wgpuBufferRelease p_wgpuBufferRelease = nullptr;
+
+static bool ensureWgpuReadbackPoolSymbols() {
+    if (p_wgpuCommandEncoderCopyBufferToBuffer && p_wgpuBufferDestroy && p_wgpuBufferRelease) {
+        return true;
+    }
+    if (!ensureWgpuTestSymbols()) return false;
+    void* handle = loadWgpuLibrary();
+    if (!handle) return false;
+    p_wgpuCommandEncoderCopyBufferToBuffer = (PFN_wgpuCommandEncoderCopyBufferToBuffer)dlsym(handle, "wgpuCommandEncoderCopyBufferToBuffer");
+    p_wgpuBufferDestroy = (PFN_wgpuBufferDestroy)dlsym(handle, "wgpuBufferDestroy");
+    p_wgpuBufferRelease = (PFN_wgpuBufferRelease)dlsym(handle, "wgpuBufferRelease");
+    if (!p_wgpuCommandEncoderCopyBufferToBuffer || !p_wgpuBufferDestroy || !p_wgpuBufferRelease) {
+        wgpu_log("missing readback pool symbols");
+        return false;
+    }
+    return true;
+}
 
-        Display* display = nullptr;
-        Window window = 0;
-        if (view->xDisplay && view->xWindow) {
-            display = view->xDisplay;
-            window = view->xWindow;
-        } else if (view->viewWidget) {
-            GdkWindow* gdkWindow = gtk_widget_get_window(view->viewWidget);
-            if (gdkWindow) {
-                display = gdk_x11_display_get_xdisplay(gdk_window_get_display(gdkWindow));
-                window = GDK_WINDOW_XID(gdkWindow);
-            }
-        }
+struct WGPUReadbackPool {
+    WGPUReadbackPool(uint32_t slotCount, uint64_t slotSize)
+        : ring(slotCount, slotSize), completions(ring.slotCount() * 2) {}
 
-        if (!display || !window) {
-            wgpu_log("failed to resolve native window for test");
-            return;
-        }
+    WGPUDevice device = nullptr;
+    WGPUQueue queue = nullptr;
+    std::vector<WGPUBuffer> staging;
+    electrobun::WgpuReadbackRing ring;
+
+    // Notification state, idle until wgpuReadbackPoolEnableNotify.
+    electrobun::WgpuReadbackCompletionQueue completions;
+    // Held from loading notifyFd until the wakeup is written, so destroy
+    // cannot close the fd under a map callback on another thread.
+    std::mutex notifyMutex;
+    std::atomic<int> notifyFd{-1};
+    WGPUInstance instance = nullptr;
+    std::thread waiter;
+    std::mutex waitMutex;
+    std::condition_variable waitCondition;
+    std::vector<WGPUFuture> waitFutures;
+    bool stopWaiter = false;
+};
 
-        stopWgpuTestForWindow(0);
-        g_gpuTest = GPUTestState{};
-        g_gpuTest.display = display;
-        g_gpuTest.window = window;
-        g_gpuTest.view = view;
-        g_gpuTest.useAlt = false;
+// Long enough to stay off the CPU, short enough that destroy does not stall.
+static const uint64_t kWgpuReadbackWaitSliceNs = 50ull * 1000 * 1000;
 
-        if (!g_gpuTest.instance) {
-            g_gpuTest.instance = p_wgpuCreateInstance(nullptr);
+static void wgpuReadbackPoolWaiterMain(WGPUReadbackPool* pool) {
+    for (;;) {
+        WGPUFuture future = {};
+        {
+            std::unique_lock<std::mutex> lock(pool->waitMutex);
+            pool->waitCondition.wait(lock, [pool] {
+                return pool->stopWaiter || !pool->waitFutures.empty();
+            });
+            if (pool->stopWaiter) return;
+            // One queue executes copies in order, so the oldest map is the
+            // next to finish.
+            future = pool->waitFutures.front();
         }
-        if (!g_gpuTest.instance) {
-            wgpu_log("failed to create WGPU instance");
-            return;
+        WGPUFutureWaitInfo waitInfo;
+        waitInfo.future = future;
+        waitInfo.completed = WGPU_FALSE;
+        WGPUWaitStatus status = p_wgpuInstanceWaitAny(
+            pool->instance, 1, &waitInfo, kWgpuReadbackWaitSliceNs);
+        if (status == WGPUWaitStatus_TimedOut) continue;
+        if (status != WGPUWaitStatus_Success) {
+            wgpu_log("readback pool wait failed status=%d", (int)status);
         }
-
-        WGPUSurfaceSourceXlibWindow xlibSource = {};
-        xlibSource.chain.sType = WGPUSType_SurfaceSourceXlibWindow;
-        xlibSource.display = display;
-        xlibSource.window = static_cast<uint64_t>(window);
-
-        WGPUSurfaceDescriptor surfaceDesc = {};
-        surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&xlibSource);
-        g_gpuTest.surface = (WGPUSurface)p_wgpuInstanceCreateSurface(g_gpuTest.instance, &surfaceDesc);
-        if (!g_gpuTest.surface) {
-            wgpu_log("failed to create surface");
-            return;
+        std::lock_guard<std::mutex> lock(pool->waitMutex);
+        if (!pool->waitFutures.empty() && pool->waitFutures.front().id == future.id) {
+            pool->waitFutures.erase(pool->waitFutures.begin());
         }
+    }
+}
 
-        WGPURequestAdapterOptions opts = {};
-        opts.compatibleSurface = g_gpuTest.surface;
-        WGPURequestAdapterCallbackInfo cbInfo = {};
-        cbInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+static void wgpuReadbackPoolComplete(
+    WGPUReadbackPool* pool,
+    uint32_t slot,
+    electrobun::WgpuReadbackStatus status
+) {
+    const uint64_t id = pool->ring.complete(slot, status);
+    if (id == 0) return;
+    std::lock_guard<std::mutex> lock(pool->notifyMutex);
+    const int fd = pool->notifyFd.load(std::memory_order_acquire);
+    if (fd < 0) return;
+    // A dropped completion is still visible through status(); the wakeup
+    // tells the host to look.
+    pool->completions.push(id, status);
+    const uint64_t one = 1;
+    ssize_t written = write(fd, &one, sizeof(one));
+    (void)written;
+}
+
+static void wgpuReadbackPoolMapCallback(
+    WGPUMapAsyncStatus status,
+    WGPUStringView /*message*/,
+    void* userdata1,
+    void* userdata2
+) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)userdata1;
+    const uint32_t slot = (uint32_t)(uintptr_t)userdata2;
+    if (!pool || slot >= pool->staging.size()) return;
+    WGPUBuffer buffer = pool->staging[slot];
+    if (status != WGPUMapAsyncStatus_Success) {
+        wgpuReadbackPoolComplete(pool, slot, electrobun::WgpuReadbackStatus::MapFailed);
+        return;
+    }
+    const size_t size = (size_t)pool->ring.size(slot);
+    const void* mapped = nullptr;
+    if (p_wgpuBufferGetConstMappedRange) {
+        mapped = p_wgpuBufferGetConstMappedRange(buffer, 0, size);
+    }
+    if (!mapped) {
+        mapped = p_wgpuBufferGetMappedRange(buffer, 0, size);
+    }
+    if (mapped) {
+        memcpy(pool->ring.slab(slot), mapped, size);
+    }
+    p_wgpuBufferUnmap(buffer);
+    wgpuReadbackPoolComplete(pool, slot, mapped ? electrobun::WgpuReadbackStatus::Ready
+                                                : electrobun::WgpuReadbackStatus::RangeFailed);
+}
+
+ELECTROBUN_EXPORT void* wgpuReadbackPoolCreate(
+    void* device,
+    void* queue,
+    uint32_t slotCount,
+    uint64_t slotSize
+) {
+    if (!device || !queue || !electrobun::WgpuReadbackRing::fits(slotCount, slotSize)) {
+        return nullptr;
+    }
+    // Buffer copies and maps work in 4-byte units.
+    if (slotSize % 4 != 0) return nullptr;
+    if (!ensureWgpuReadbackPoolSymbols()) return nullptr;
+
+    // The slab is caller-sized; an allocation failure must not unwind
+    // through the FFI boundary.
+    WGPUReadbackPool* pool = nullptr;
+    try {
+        pool = new WGPUReadbackPool(slotCount, slotSize);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    pool->device = (WGPUDevice)device;
+    pool->queue = (WGPUQueue)queue;
+    for (uint32_t i = 0; i < pool->ring.slotCount(); ++i) {
+        WGPUBufferDescriptor desc = {};
+        desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
+        desc.size = slotSize;
+        desc.mappedAtCreation = WGPU_FALSE;
+        WGPUBuffer buffer = p_wgpuDeviceCreateBuffer(pool->device, &desc);
+        if (!buffer) {
+            for (WGPUBuffer created : pool->staging) {
+                p_wgpuBufferDestroy(created);
+                p_wgpuBufferRelease(created);
+            }
+            delete pool;
+            return nullptr;
+        }
+        pool->staging.push_back(buffer);
+    }
+    return pool;
+}
+
+// Queue a copy of [offset, offset + size) of a COPY_SRC buffer into a pooled
+// slot. Returns the readback id, or 0 when no slot is free (counted as a
+// stall) or the arguments are invalid.
+ELECTROBUN_EXPORT uint64_t wgpuReadbackPoolSubmit(
+    void* poolPtr,
+    void* source,
+    uint64_t offset,
+    uint64_t size
+) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool || !source || size % 4 != 0 || offset % 4 != 0) return 0;
+
+    uint64_t id = 0;
+    uint32_t slot = 0;
+    if (!pool->ring.acquire(size, &id, &slot)) return 0;
+
+    WGPUBuffer staging = pool->staging[slot];
+    WGPUCommandEncoder encoder = p_wgpuDeviceCreateCommandEncoder(pool->device, nullptr);
+    if (!encoder) {
+        wgpuReadbackPoolComplete(pool, slot, electrobun::WgpuReadbackStatus::MapFailed);
+        return id;
+    }
+    p_wgpuCommandEncoderCopyBufferToBuffer(encoder, (WGPUBuffer)source, offset, staging, 0, size);
+    WGPUCommandBuffer commands = p_wgpuCommandEncoderFinish(encoder, nullptr);
+    p_wgpuCommandEncoderRelease(encoder);
+    if (!commands) {
+        wgpuReadbackPoolComplete(pool, slot, electrobun::WgpuReadbackStatus::MapFailed);
+        return id;
+    }
+    p_wgpuQueueSubmit(pool->queue, 1, &commands);
+    p_wgpuCommandBufferRelease(commands);
+
+    WGPUBufferMapCallbackInfo mapInfo = {};
+    mapInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    mapInfo.callback = wgpuReadbackPoolMapCallback;
+    mapInfo.userdata1 = pool;
+    mapInfo.userdata2 = (void*)(uintptr_t)slot;
+    WGPUFuture future = p_wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0, (size_t)size, mapInfo);
+    if (pool->notifyFd.load(std::memory_order_acquire) >= 0) {
+        std::lock_guard<std::mutex> lock(pool->waitMutex);
+        pool->waitFutures.push_back(future);
+        pool->waitCondition.notify_one();
+    }
+    return id;
+}
+
+// Start completion notifications and return a non-blocking eventfd that
+// becomes readable whenever readbacks finish; drain them with
+// wgpuReadbackPoolPopCompleted. Idempotent. Returns -1 when the eventfd or
+// waiter thread cannot be created, leaving the pool in polling mode.
+ELECTROBUN_EXPORT int32_t wgpuReadbackPoolEnableNotify(void* poolPtr, void* instance) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool || !instance) return -1;
+    const int existing = pool->notifyFd.load(std::memory_order_acquire);
+    if (existing >= 0) return existing;
+
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        wgpu_log("readback pool eventfd failed errno=%d", errno);
+        return -1;
+    }
+    pool->instance = (WGPUInstance)instance;
+    try {
+        pool->waiter = std::thread(wgpuReadbackPoolWaiterMain, pool);
+    } catch (...) {
+        close(fd);
+        return -1;
+    }
+    pool->notifyFd.store(fd, std::memory_order_release);
+    return fd;
+}
+
+// Next finished readback since the last call, or 0 when none is queued.
+// outStatus receives its WgpuReadbackStatus as of completion.
+ELECTROBUN_EXPORT uint64_t wgpuReadbackPoolPopCompleted(void* poolPtr, int32_t* outStatus) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool) return 0;
+    electrobun::WgpuReadbackCompletionQueue::Entry entry;
+    if (!pool->completions.pop(&entry)) return 0;
+    if (outStatus) *outStatus = (int32_t)entry.status;
+    return entry.id;
+}
+
+// 0 pending, 1 ready, 2 map failed, 3 mapped range unavailable, 4 unknown id
+// (never submitted or already released).
+ELECTROBUN_EXPORT int32_t wgpuReadbackPoolStatus(void* poolPtr, uint64_t id) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool) return (int32_t)electrobun::WgpuReadbackStatus::Unknown;
+    return (int32_t)pool->ring.status(id);
+}
+
+// The pooled slab holding a ready readback. It stays valid, and is not
+// reused, until wgpuReadbackPoolRelease(id).
+ELECTROBUN_EXPORT void* wgpuReadbackPoolData(void* poolPtr, uint64_t id, uint64_t* outSize) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool) return nullptr;
+    return pool->ring.data(id, outSize);
+}
+
+ELECTROBUN_EXPORT bool wgpuReadbackPoolRelease(void* poolPtr, uint64_t id) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    return pool && pool->ring.release(id);
+}
+
+// Fills a WgpuReadbackRingStats (56 bytes, see wgpu_readback_ring.h).
+ELECTROBUN_EXPORT void wgpuReadbackPoolGetStats(void* poolPtr, void* outStats) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool || !outStats) return;
+    electrobun::WgpuReadbackRingStats stats = pool->ring.stats();
+    stats.completionsDropped = pool->completions.dropped();
+    memcpy(outStats, &stats, sizeof(stats));
+}
+
+// Destroying the staging buffers aborts any map still in flight, and Dawn
+// delivers that callback before wgpuBufferDestroy returns, so no callback
+// can outlive the pool. The waiter is stopped first so it cannot run one
+// concurrently, and a callback elsewhere that already loaded the eventfd
+// finishes its write before it is closed. The host must stop watching the
+// eventfd before this.
+ELECTROBUN_EXPORT void wgpuReadbackPoolDestroy(void* poolPtr) {
+    WGPUReadbackPool* pool = (WGPUReadbackPool*)poolPtr;
+    if (!pool) return;
+    if (pool->waiter.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(pool->waitMutex);
+            pool->stopWaiter = true;
+        }
+        pool->waitCondition.notify_one();
+        pool->waiter.join();
+    }
+    int fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(pool->notifyMutex);
+        fd = pool->notifyFd.exchange(-1);
+    }
+    for (WGPUBuffer buffer : pool->staging) {
+        p_wgpuBufferDestroy(buffer);
+        p_wgpuBufferRelease(buffer);
+    }
+    if (fd >= 0) close(fd);
+    delete pool;
+}
+
+ELECTROBUN_EXPORT void wgpuRunGPUTest(void* abstractView) {
+    if (!abstractView) return;
+    if (!ensureWgpuTestSymbols()) return;
+
+    runOnMainThreadSyncVoid([&]() {
+        WGPUViewImpl* view = dynamic_cast<WGPUViewImpl*>((AbstractView*)abstractView);
+        if (!view) {
+            wgpu_log("run test called with non-WGPU view");
+            return;
+        }
+
+        Display* display = nullptr;
+        Window window = 0;
+        if (view->xDisplay && view->xWindow) {
+            display = view->xDisplay;
+            window = view->xWindow;
+        } else if (view->viewWidget) {
+            GdkWindow* gdkWindow = gtk_widget_get_window(view->viewWidget);
+            if (gdkWindow) {
+                display = gdk_x11_display_get_xdisplay(gdk_window_get_display(gdkWindow));
+                window = GDK_WINDOW_XID(gdkWindow);
+            }
+        }
+
+        if (!display || !window) {
+            wgpu_log("failed to resolve native window for test");
+            return;
+        }
+
+        stopWgpuTestForWindow(0);
+        g_gpuTest = GPUTestState{};
+        g_gpuTest.display = display;
+        g_gpuTest.window = window;
+        g_gpuTest.view = view;
+        g_gpuTest.useAlt = false;
+
+        if (!g_gpuTest.instance) {
+            g_gpuTest.instance = p_wgpuCreateInstance(nullptr);
+        }
+        if (!g_gpuTest.instance) {
+            wgpu_log("failed to create WGPU instance");
+            return;
+        }
+
+        WGPUSurfaceSourceXlibWindow xlibSource = {};
+        xlibSource.chain.sType = WGPUSType_SurfaceSourceXlibWindow;
+        xlibSource.display = display;
+        xlibSource.window = static_cast<uint64_t>(window);
+
+        WGPUSurfaceDescriptor surfaceDesc = {};
+        surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&xlibSource);
+        g_gpuTest.surface = (WGPUSurface)p_wgpuInstanceCreateSurface(g_gpuTest.instance, &surfaceDesc);
+        if (!g_gpuTest.surface) {
+            wgpu_log("failed to create surface");
+            return;
+        }
+
+        WGPURequestAdapterOptions opts = {};
+        opts.compatibleSurface = g_gpuTest.surface;
+        WGPURequestAdapterCallbackInfo cbInfo = {};
+        cbInfo.mode = WGPUCallbackMode_AllowSpontaneous;
         cbInfo.callback = gpuTestRequestAdapterCallback;
         cbInfo.userdata1 = &g_gpuTest;
         p_wgpuInstanceRequestAdapter(g_gpuTest.instance, &opts, cbInfo);
@@ -9498,14 +11296,12 @@ void updateActiveWebviewForMousePosition(uint32_t windowId, int mouseX, int mous
             mouseY < webview->visualBounds.y + webview->visualBounds.height) {
             
             // Check if the mouse is in a masked area
-            if (!webview->maskJSON.empty()) {
-                std::vector<MaskRect> masks = parseMaskJson(webview->maskJSON);
-                
+            if (!webview->maskRects.empty()) {
                 // Convert mouse position to webview-relative coordinates
                 int relativeX = mouseX - webview->visualBounds.x;
                 int relativeY = mouseY - webview->visualBounds.y;
                 
-                if (isPointInMask(relativeX, relativeY, masks)) {
+                if (isPointInMask(relativeX, relativeY, webview->maskRects)) {
                     // Mouse is in a masked area, continue to next webview
                     continue;
                 }
@@ -9548,6 +11344,19 @@ ELECTROBUN_EXPORT void resizeWebview(AbstractView* abstractView, double x, doubl
     schedulePendingResizeDrain();
 }
 
+// Binary mask channel: rectCount x, y, width, height quadruples in view-local
+// logical pixels. Avoids building and re-parsing mask JSON on every resync.
+ELECTROBUN_EXPORT void resizeWebviewWithMaskRects(AbstractView* abstractView, double x, double y, double width, double height, const float* rects, uint32_t rectCount) {
+    if (!abstractView || abstractView->isRemoved) {
+        return;
+    }
+
+    LogicalRect frame = {x, y, width, height};
+    abstractView->storePendingResize(frame, unpackLinuxMaskRects(rects, rectCount));
+    g_pendingResizeQueue.enqueue(abstractView);
+    schedulePendingResizeDrain();
+}
+
 ELECTROBUN_EXPORT void evaluateJavaScriptWithNoCompletion(AbstractView* abstractView, const char* js) {
     if (abstractView && js) {
         std::string jsString(js);  // Copy the string to ensure it survives
@@ -9581,14 +11390,341 @@ void webviewSetPassthrough(AbstractView* abstractView, bool enablePassthrough) {
     }
 }
 
+// Background lifecycle policy for hidden webviews (see webview_lifecycle.h).
+// Views hidden through webviewSetHidden are wound down by a one-second tick
+// that runs while the policy is on and some view is hidden. Main thread only.
+static electrobun::WebviewLifecyclePolicy g_webviewLifecyclePolicy;
+static electrobun::WebviewLifecycleStats g_webviewLifecycleStats;
+static guint g_webviewLifecycleTimer = 0;
+// Discarded pages are torn down asynchronously; their processes are sampled
+// again this long after the discard.
+static constexpr guint kWebviewDiscardSampleDelaySeconds = 3;
+
+// Resident memory of the processes a discard can free: the view's renderer
+// when known, otherwise every renderer and WebKit web process. Walks /proc,
+// so it runs on a worker. Reads only each process's stat, except that
+// telling Chromium renderers apart needs their command lines when the view's
+// own is not known.
+static std::map<int, uint64_t> sampleWebviewDiscardProcesses(int rendererPid) {
+    electrobun::LinuxProcessSampler sampler(sysconf(_SC_CLK_TCK), sysconf(_SC_PAGESIZE));
+    sampler.setRssOnly(rendererPid > 0 || !isCEFAvailable());
+    const std::vector<int> pids = rendererPid > 0
+        ? std::vector<int>{rendererPid}
+        : sampler.descendantsOf(getpid());
+    std::map<int, uint64_t> rss;
+    for (const int pid : pids) {
+        electrobun::LinuxProcessStats stats;
+        if (!sampler.sample(pid, &stats)) continue;
+        const auto kind = static_cast<electrobun::LinuxProcessKind>(stats.kind);
+        if (rendererPid > 0 || kind == electrobun::LinuxProcessKind::renderer ||
+            kind == electrobun::LinuxProcessKind::webkitWeb) {
+            rss[pid] = stats.rssBytes;
+        }
+    }
+    return rss;
+}
+
+struct WebviewDiscardSample {
+    int rendererPid;
+    std::map<int, uint64_t> before;
+};
+
+// Throttles or freezes a view. Discards go through startWebviewDiscard.
+static void enterWebviewLifecycleState(AbstractView* view, electrobun::WebviewLifecycleState state) {
+    const electrobun::WebviewLifecycleState from = view->lifecycle.state();
+    view->lifecycle.enter(state);
+    switch (state) {
+        case electrobun::WebviewLifecycleState::throttled:
+            view->setLifecycleState(from, state, []() { ++g_webviewLifecycleStats.throttled; });
+            break;
+        case electrobun::WebviewLifecycleState::frozen:
+            view->setLifecycleState(from, state, []() { ++g_webviewLifecycleStats.frozen; });
+            break;
+        default:
+            break;
+    }
+}
+
+static void discardWebview(AbstractView* view, WebviewDiscardSample sample) {
+    const electrobun::WebviewLifecycleState from = view->lifecycle.state();
+    view->lifecycle.enter(electrobun::WebviewLifecycleState::discarded);
+    view->setLifecycleState(from, electrobun::WebviewLifecycleState::discarded,
+                            [sample = std::move(sample)]() {
+        ++g_webviewLifecycleStats.discarded;
+        // The second sample runs on a worker too.
+        g_timeout_add_seconds_full(G_PRIORITY_LOW, kWebviewDiscardSampleDelaySeconds, [](gpointer data) -> gboolean {
+            std::thread([sample = *static_cast<WebviewDiscardSample*>(data)]() {
+                const uint64_t reclaimed = electrobun::webviewDiscardReclaimedBytes(
+                    sample.before,
+                    sampleWebviewDiscardProcesses(sample.rendererPid),
+                    sample.rendererPid > 0);
+                dispatch_async_main_void([reclaimed]() {
+                    g_webviewLifecycleStats.bytesReclaimed += reclaimed;
+                });
+            }).detach();
+            return G_SOURCE_REMOVE;
+        }, new WebviewDiscardSample(sample), [](gpointer data) {
+            delete static_cast<WebviewDiscardSample*>(data);
+        });
+    });
+}
+
+// Samples the processes a discard can free on a worker, then discards the
+// view back on the main thread if the policy still wants it discarded.
+static void startWebviewDiscard(AbstractView* view) {
+    view->discardSamplePending = true;
+    const uint32_t webviewId = view->webviewId;
+    const int rendererPid = view->rendererProcessId();
+    std::thread([webviewId, rendererPid]() {
+        WebviewDiscardSample sample{rendererPid, sampleWebviewDiscardProcesses(rendererPid)};
+        dispatch_async_main_void([webviewId, sample = std::move(sample)]() {
+            std::shared_ptr<AbstractView> view;
+            {
+                std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+                auto it = g_webviewMap.find(webviewId);
+                if (it != g_webviewMap.end()) view = it->second;
+            }
+            if (!view) return;
+            view->discardSamplePending = false;
+            // Shown, removed or the policy changed while sampling.
+            const uint64_t nowMs = g_get_monotonic_time() / 1000;
+            if (view->isRemoved ||
+                view->lifecycle.next(g_webviewLifecyclePolicy, nowMs) !=
+                    electrobun::WebviewLifecycleState::discarded) {
+                return;
+            }
+            discardWebview(view.get(), sample);
+        });
+    }).detach();
+}
+
+static gboolean tickWebviewLifecycle(gpointer) {
+    std::vector<std::shared_ptr<AbstractView>> hidden;
+    {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        for (const auto& [webviewId, view] : g_webviewMap) {
+            if (view && !view->isRemoved && view->lifecycle.hidden()) hidden.push_back(view);
+        }
+    }
+    if (hidden.empty() || !g_webviewLifecyclePolicy.enabled()) {
+        g_webviewLifecycleTimer = 0;
+        return G_SOURCE_REMOVE;
+    }
+    const uint64_t nowMs = g_get_monotonic_time() / 1000;
+    for (const auto& view : hidden) {
+        if (view->discardSamplePending) continue;
+        for (auto next = view->lifecycle.next(g_webviewLifecyclePolicy, nowMs);
+             next != view->lifecycle.state();
+             next = view->lifecycle.next(g_webviewLifecyclePolicy, nowMs)) {
+            if (next == electrobun::WebviewLifecycleState::discarded) {
+                startWebviewDiscard(view.get());
+                break;
+            }
+            enterWebviewLifecycleState(view.get(), next);
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static void scheduleWebviewLifecycleTick() {
+    if (g_webviewLifecycleTimer == 0 && g_webviewLifecyclePolicy.enabled()) {
+        g_webviewLifecycleTimer = g_timeout_add_seconds(1, tickWebviewLifecycle, nullptr);
+    }
+}
+
+// Starts the hidden clock, or brings a wound-down view back. A discarded
+// view reloads its page here and is timed until the load finishes.
+static void updateWebviewLifecycleVisibility(AbstractView* view, bool hidden) {
+    if (hidden) {
+        view->lifecycle.hide(g_get_monotonic_time() / 1000);
+        scheduleWebviewLifecycleTick();
+        return;
+    }
+    if (!view->lifecycle.hidden()) return;
+    const electrobun::WebviewLifecycleState from = view->lifecycle.show();
+    if (from == electrobun::WebviewLifecycleState::active) return;
+    if (from == electrobun::WebviewLifecycleState::discarded) {
+        view->restoreStartUs = g_get_monotonic_time();
+    }
+    view->setLifecycleState(from, electrobun::WebviewLifecycleState::active, nullptr);
+}
+
+static void noteWebviewLifecycleLoadFinished(uint32_t webviewId) {
+    std::shared_ptr<AbstractView> view;
+    {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        auto it = g_webviewMap.find(webviewId);
+        if (it != g_webviewMap.end()) view = it->second;
+    }
+    if (!view || view->restoreStartUs == 0) return;
+    g_webviewLifecycleStats.recordRestore(
+        static_cast<uint64_t>(g_get_monotonic_time() - view->restoreStartUs));
+    view->restoreStartUs = 0;
+}
+
 void webviewSetHidden(AbstractView* abstractView, bool hidden) {
     if (abstractView) {
         dispatch_sync_main_void([&]() {
             abstractView->setHidden(hidden);
+            updateWebviewLifecycleVisibility(abstractView, hidden);
+        });
+    }
+}
+
+// Linux-only: frame rate for windowless CEF views (transparent windows).
+// Zero restores Chromium's default; values above 60 are clamped.
+ELECTROBUN_EXPORT bool webviewSetWindowlessFrameRate(AbstractView* abstractView, int32_t frameRate) {
+    bool applied = false;
+    if (abstractView) {
+        dispatch_sync_main_void([&]() {
+            applied = abstractView->setWindowlessFrameRate(frameRate);
+        });
+    }
+    return applied;
+}
+
+// Linux-only: drop a windowless CEF view to a background frame rate while it
+// stays visible. Unmapped or fully obscured views stop painting on their own.
+ELECTROBUN_EXPORT bool webviewSetBackgroundThrottled(AbstractView* abstractView, bool throttled) {
+    bool applied = false;
+    if (abstractView) {
+        dispatch_sync_main_void([&]() {
+            applied = abstractView->setBackgroundThrottled(throttled);
+        });
+    }
+    return applied;
+}
+
+// Encoded snapshots wait here until the completion handler's caller has
+// allocated dataUrlLength bytes and takes them. Results for removed webviews
+// are dropped, and any left untaken, e.g. by a caller that timed out, expire
+// when the next result is stored.
+struct WebviewSnapshotResult {
+    uint32_t webviewId;
+    gint64 storedUs;
+    std::string dataUrl;
+};
+static std::map<uint32_t, WebviewSnapshotResult> g_webviewSnapshotResults;
+static std::mutex g_webviewSnapshotResultsMutex;
+static constexpr gint64 kWebviewSnapshotResultTtlUs = 30 * G_USEC_PER_SEC;
+
+static void dropWebviewSnapshotResults(uint32_t webviewId) {
+    std::lock_guard<std::mutex> lock(g_webviewSnapshotResultsMutex);
+    for (auto it = g_webviewSnapshotResults.begin(); it != g_webviewSnapshotResults.end();) {
+        it = it->second.webviewId == webviewId ? g_webviewSnapshotResults.erase(it) : std::next(it);
+    }
+}
+
+static void storeWebviewSnapshotResult(uint32_t requestId, uint32_t webviewId, std::string&& dataUrl) {
+    const gint64 nowUs = g_get_monotonic_time();
+    std::lock_guard<std::mutex> lock(g_webviewSnapshotResultsMutex);
+    for (auto it = g_webviewSnapshotResults.begin(); it != g_webviewSnapshotResults.end();) {
+        it = nowUs - it->second.storedUs > kWebviewSnapshotResultTtlUs
+            ? g_webviewSnapshotResults.erase(it)
+            : std::next(it);
+    }
+    g_webviewSnapshotResults[requestId] = {webviewId, nowUs, std::move(dataUrl)};
+}
+
+// Linux-only: capture the visible webview, optionally cropped to a logical
+// region and aspect-fit into maxWidth x maxHeight (0 = unbounded). Format 0/1
+// produces a PNG/JPEG data URL; format 2 writes straight RGBA into outRgba,
+// which must stay alive until the handler runs. The handler normally runs on
+// the snapshot worker thread; abandoned captures complete on the main thread.
+ELECTROBUN_EXPORT bool getWebviewSnapshotWithOptions(
+    AbstractView* abstractView,
+    uint32_t requestId,
+    double x,
+    double y,
+    double width,
+    double height,
+    uint32_t maxWidth,
+    uint32_t maxHeight,
+    uint32_t format,
+    uint32_t quality,
+    uint8_t* outRgba,
+    uint64_t outLen,
+    WebviewSnapshotCompletionHandler completionHandler
+) {
+    snapshot_encoder::Job job;
+    if (!abstractView || !completionHandler ||
+        !parseWebviewSnapshotFormat(format, &job.format) ||
+        (job.format == WebviewSnapshotFormat::Rgba && (!outRgba || outLen == 0))) {
+        return false;
+    }
+    const uint32_t webviewId = abstractView->webviewId;
+    job.quality = static_cast<int>(std::clamp<uint32_t>(quality ? quality : 90, 1, 100));
+    job.maxWidth = static_cast<int>(std::min<uint32_t>(maxWidth, G_MAXINT));
+    job.maxHeight = static_cast<int>(std::min<uint32_t>(maxHeight, G_MAXINT));
+    job.regionX = x;
+    job.regionY = y;
+    job.regionWidth = width;
+    job.regionHeight = height;
+    job.outRgba = outRgba;
+    job.outLen = outLen;
+    job.complete = [requestId, webviewId, completionHandler](snapshot_encoder::Result&& result) {
+        uint64_t dataUrlLength = 0;
+        if (result.success && !result.dataUrl.empty()) {
+            dataUrlLength = result.dataUrl.size();
+            storeWebviewSnapshotResult(requestId, webviewId, std::move(result.dataUrl));
+        }
+        completionHandler(requestId, webviewId, result.success ? 1 : 0,
+                          static_cast<uint32_t>(result.width),
+                          static_cast<uint32_t>(result.height), dataUrlLength);
+    };
+
+    bool started = false;
+    dispatch_sync_main_void([&]() {
+        started = abstractView->captureSnapshot(std::move(job));
+    });
+    return started;
+}
+
+// Linux-only: stream frames into a caller-owned ring laid out as described in
+// shared/webview_frame_ring.h. Supported for windowless CEF views (every
+// OnPaint) and WebKitGTK views (periodic snapshots at maxFps, default 30 and
+// at most 60). handler may be null for consumers that poll the ring.
+ELECTROBUN_EXPORT bool webviewStartFrameStream(
+    AbstractView* abstractView,
+    uint8_t* ring,
+    uint64_t ringLength,
+    uint32_t slotCount,
+    uint32_t maxFps,
+    WebviewFrameStreamHandler handler
+) {
+    bool started = false;
+    if (abstractView && ring) {
+        dispatch_sync_main_void([&]() {
+            started = abstractView->startFrameStream(ring, ringLength, slotCount, maxFps, handler);
+        });
+    }
+    return started;
+}
+
+// After this returns the ring is no longer written and may be released.
+ELECTROBUN_EXPORT void webviewStopFrameStream(AbstractView* abstractView) {
+    if (abstractView) {
+        dispatch_sync_main_void([&]() {
+            abstractView->stopFrameStream();
         });
     }
 }
 
+// Copy and release an encoded snapshot. outLen must match dataUrlLength.
+ELECTROBUN_EXPORT bool takeWebviewSnapshotDataUrl(uint32_t requestId, uint8_t* out, uint64_t outLen) {
+    std::string dataUrl;
+    {
+        std::lock_guard<std::mutex> lock(g_webviewSnapshotResultsMutex);
+        auto it = g_webviewSnapshotResults.find(requestId);
+        if (it == g_webviewSnapshotResults.end()) return false;
+        dataUrl = std::move(it->second.dataUrl);
+        g_webviewSnapshotResults.erase(it);
+    }
+    if (!out || outLen != dataUrl.size()) return false;
+    memcpy(out, dataUrl.data(), dataUrl.size());
+    return true;
+}
+
 ELECTROBUN_EXPORT bool webviewSetSpellCheck(AbstractView* abstractView, bool enabled) {
     (void)abstractView;
     (void)enabled;
@@ -10540,7 +12676,35 @@ ELECTROBUN_EXPORT void showContextMenu(const char* jsonString, void* contextMenu
 }
 
 ELECTROBUN_EXPORT void getWebviewSnapshot(uint32_t hostId, uint32_t webviewId, double x, double y, double width, double height, void* completionHandler) {
-    // TODO: Implement webview snapshot
+    auto callback = reinterpret_cast<SnapshotCallback>(completionHandler);
+    if (!callback) return;
+
+    std::shared_ptr<AbstractView> view;
+    {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        auto it = g_webviewMap.find(webviewId);
+        if (it != g_webviewMap.end()) view = it->second;
+    }
+
+    snapshot_encoder::Job job;
+    job.regionX = x;
+    job.regionY = y;
+    job.regionWidth = width;
+    job.regionHeight = height;
+    job.complete = [hostId, webviewId, callback](snapshot_encoder::Result&& result) {
+        callback(hostId, webviewId,
+                 result.success ? result.dataUrl.c_str() : "data:image/png;base64,");
+    };
+
+    bool started = false;
+    if (view) {
+        dispatch_sync_main_void([&]() {
+            started = view->captureSnapshot(std::move(job));
+        });
+    }
+    if (!started) {
+        callback(hostId, webviewId, "data:image/png;base64,");
+    }
 }
 
 void setJSUtils(void* getMimeType, void* getHTMLForWebviewSync) {
@@ -10580,6 +12744,25 @@ const char* getWebviewHTMLContent(uint32_t webviewId) {
 // Forward declaration - stopEventLoop is defined after startEventLoop
 ELECTROBUN_EXPORT void stopEventLoop();
 
+// Opens app.asar and builds its index on a background thread while GTK and
+// the renderer start, so the first views:// request finds it ready. The
+// request paths share g_asarArchiveInitFlag and wait if it is still opening.
+static void prefetchAsarArchive() {
+    gchar* cwd = g_get_current_dir();
+    gchar* asarPath = g_build_filename(cwd, "..", "Resources", "app.asar", nullptr);
+    std::string path(asarPath);
+    g_free(asarPath);
+    g_free(cwd);
+    if (!g_file_test(path.c_str(), G_FILE_TEST_EXISTS)) {
+        return;
+    }
+    std::thread([path]() {
+        if (g_startupTrace) g_startupTrace->nameThread("asar-prefetch");
+        electrobun::StartupTraceScope trace(g_startupTrace, "asarOpen");
+        openAsarArchiveOnce(path.c_str(), "asar prefetch");
+    }).detach();
+}
+
 ELECTROBUN_EXPORT void startEventLoop(const char* identifier, const char* name, const char* channel) {
     // Store app identity before any native windows or renderer contexts are made.
     if (identifier && identifier[0]) {
@@ -10595,6 +12778,8 @@ ELECTROBUN_EXPORT void startEventLoop(const char* identifier, const char* name,
         g_electrobunName,
         g_electrobunChannel);
 
+    prefetchAsarArchive();
+
     // Linux uses runEventLoop instead
     runEventLoop();
 }
@@ -10608,6 +12793,8 @@ ELECTROBUN_EXPORT void stopEventLoop() {
 
     runOnMainThreadAsyncVoid([]() {
         wayland_screen_capture::shutdown();
+        x11_screen_capture::shutdown();
+        snapshot_encoder::shutdown();
         if (g_cefInitialized.load()) {
             beginCEFShutdownOnMainThread();
         } else {
@@ -10765,6 +12952,11 @@ void cleanupWebviewsForWindow(uint32_t windowId) {
                 }
             }
         }
+        for (auto& webview : container->abstractViews) {
+            if (webview && !dynamic_cast<WGPUViewImpl*>(webview.get())) {
+                dropWebviewSnapshotResults(webview->webviewId);
+            }
+        }
         {
             std::lock_guard<std::mutex> lock(g_wgpuViewMapMutex);
             for (auto& webview : container->abstractViews) {
@@ -12156,15 +14348,52 @@ ELECTROBUN_EXPORT const char* getCursorScreenPoint() {
     return resultStorage.c_str();
 }
 
-ELECTROBUN_EXPORT bool captureScreenRegion(
+// Root window device scale for the X11 capture thread, which cannot ask GDK
+// itself. Read once on the GTK thread; GDK re-emits monitors-changed when
+// XRandR or the xsettings window scale changes.
+static std::atomic<int> g_x11CaptureScale{0};
+
+static void refreshX11CaptureScale(GdkScreen*, gpointer) {
+    GdkWindow* root = gdk_get_default_root_window();
+    g_x11CaptureScale.store(root ? gdk_window_get_scale_factor(root) : 0);
+}
+
+static int x11CaptureScale() {
+    const int cached = g_x11CaptureScale.load();
+    if (cached > 0) {
+        return cached;
+    }
+    return dispatch_sync_main([]() -> int {
+        static bool watching = false;
+        GdkDisplay* display = gdk_display_get_default();
+        GdkScreen* screen = gdk_screen_get_default();
+        if (!display || !GDK_IS_X11_DISPLAY(display) || !screen) {
+            return 0;
+        }
+        if (!watching) {
+            watching = true;
+            g_signal_connect(screen, "monitors-changed",
+                             G_CALLBACK(refreshX11CaptureScale), nullptr);
+        }
+        refreshX11CaptureScale(screen, nullptr);
+        return g_x11CaptureScale.load();
+    });
+}
+
+// Shared by the full-size and thumbnail exports. An output size smaller than
+// the logical region is box-filtered by whichever backend serves the read.
+static bool captureScreenRegionAtSize(
     double x,
     double y,
     uint32_t width,
     uint32_t height,
+    uint32_t output_width,
+    uint32_t output_height,
     uint8_t* out_rgba,
     uint64_t out_len
 ) {
-    if (!out_rgba || width == 0 || height == 0 ||
+    if (!out_rgba || width == 0 || height == 0 || output_width == 0 ||
+        output_height == 0 || output_width > width || output_height > height ||
         !std::isfinite(x) || !std::isfinite(y)) {
         return false;
     }
@@ -12178,9 +14407,12 @@ ELECTROBUN_EXPORT bool captureScreenRegion(
     if (logicalPixels > std::numeric_limits<uint64_t>::max() / 4) {
         return false;
     }
-    const uint64_t requiredOutputBytes = logicalPixels * 4;
+    // The output is never larger than the logical region.
+    const uint64_t requiredOutputBytes =
+        static_cast<uint64_t>(output_width) * output_height * 4;
+    const bool downscale = output_width != width || output_height != height;
     if (out_len != requiredOutputBytes ||
-        requiredOutputBytes > std::numeric_limits<size_t>::max() ||
+        logicalPixels * 4 > std::numeric_limits<size_t>::max() ||
         width > static_cast<uint32_t>(G_MAXINT) ||
         height > static_cast<uint32_t>(G_MAXINT)) {
         return false;
@@ -12200,6 +14432,25 @@ ELECTROBUN_EXPORT bool captureScreenRegion(
     const int64_t requestedLeft = static_cast<int64_t>(roundedX);
     const int64_t requestedTop = static_cast<int64_t>(roundedY);
 
+    // On X11 the read happens on the capture thread's own connection, so
+    // polling callers never wait on (or stall) the GTK main loop. The GDK
+    // path below only runs when that thread cannot serve the display.
+    if (!wayland_screen_capture::isWaylandSession()) {
+        const int scale = x11CaptureScale();
+        if (scale > 0) {
+            switch (x11_screen_capture::captureRegion(
+                requestedLeft, requestedTop, width, height, output_width,
+                output_height, scale, out_rgba, out_len)) {
+            case x11_screen_capture::CaptureStatus::Captured:
+                return true;
+            case x11_screen_capture::CaptureStatus::Rejected:
+                return false;
+            case x11_screen_capture::CaptureStatus::Unavailable:
+                break;
+            }
+        }
+    }
+
     return dispatch_sync_main([=]() -> bool {
         if (wayland_screen_capture::isWaylandSession()) {
             return wayland_screen_capture::captureRegion(
@@ -12207,6 +14458,8 @@ ELECTROBUN_EXPORT bool captureScreenRegion(
                 static_cast<double>(requestedTop),
                 width,
                 height,
+                output_width,
+                output_height,
                 out_rgba,
                 out_len);
         }
@@ -12296,7 +14549,15 @@ ELECTROBUN_EXPORT bool captureScreenRegion(
 
         // The pixbuf is device-resolution (logical dimensions multiplied by
         // the root window's integer scale). Sample the center device pixel for
-        // each requested logical pixel and always expose opaque RGBA.
+        // each requested logical pixel and always expose opaque RGBA. This
+        // fallback only runs without the capture thread, so thumbnails are
+        // filtered from the logical-size pixels rather than the pixbuf.
+        std::vector<uint8_t> logicalRgba;
+        uint8_t* destination = out_rgba;
+        if (downscale) {
+            logicalRgba.resize(static_cast<size_t>(logicalPixels) * 4);
+            destination = logicalRgba.data();
+        }
         const int sampleOffset = scaleX / 2;
         for (uint32_t destinationY = 0; destinationY < height; ++destinationY) {
             const int sourceY =
@@ -12315,18 +14576,66 @@ ELECTROBUN_EXPORT bool captureScreenRegion(
                 const uint64_t destinationOffset =
                     destinationRow + static_cast<uint64_t>(destinationX) * 4;
 
-                out_rgba[destinationOffset] = source[sourceOffset];
-                out_rgba[destinationOffset + 1] = source[sourceOffset + 1];
-                out_rgba[destinationOffset + 2] = source[sourceOffset + 2];
-                out_rgba[destinationOffset + 3] = 255;
+                destination[destinationOffset] = source[sourceOffset];
+                destination[destinationOffset + 1] = source[sourceOffset + 1];
+                destination[destinationOffset + 2] = source[sourceOffset + 2];
+                destination[destinationOffset + 3] = 255;
             }
         }
 
         g_object_unref(pixbuf);
+        if (downscale) {
+            return downscaleScreenCaptureBox(
+                destination, static_cast<size_t>(logicalWidth) * 4, width, height,
+                ScreenCaptureChannelOrder{0, 1, 2}, output_width, output_height,
+                out_rgba, static_cast<size_t>(output_width) * 4);
+        }
         return true;
     });
 }
 
+ELECTROBUN_EXPORT bool captureScreenRegion(
+    double x,
+    double y,
+    uint32_t width,
+    uint32_t height,
+    uint8_t* out_rgba,
+    uint64_t out_len
+) {
+    return captureScreenRegionAtSize(
+        x, y, width, height, width, height, out_rgba, out_len);
+}
+
+// Capture a region box-filtered down to output_width x output_height, so a
+// monitor thumbnail never crosses FFI (or touches memory) at full size.
+ELECTROBUN_EXPORT bool captureScreenRegionScaled(
+    double x,
+    double y,
+    uint32_t width,
+    uint32_t height,
+    uint32_t output_width,
+    uint32_t output_height,
+    uint8_t* out_rgba,
+    uint64_t out_len
+) {
+    return captureScreenRegionAtSize(
+        x, y, width, height, output_width, output_height, out_rgba, out_len);
+}
+
+// Damage sequence of the last change to a screen region. Only the Wayland
+// portal stream carries damage; 0 tells callers to capture unconditionally.
+ELECTROBUN_EXPORT uint64_t getScreenRegionChangeSequence(
+    double x,
+    double y,
+    uint32_t width,
+    uint32_t height
+) {
+    if (!wayland_screen_capture::isWaylandSession()) {
+        return 0;
+    }
+    return wayland_screen_capture::regionChangeSequence(x, y, width, height);
+}
+
 ELECTROBUN_EXPORT uint64_t getMouseButtons() {
     return dispatch_sync_main([&]() -> uint64_t {
         GdkDisplay* display = gdk_display_get_default();
@@ -12421,470 +14730,934 @@ static WebKitWebsiteDataManager* getDataManagerForPartition(const char* partitio
 }
 
 
-// Helper struct for async cookie operations
-struct CookieCallbackData {
-    std::string* result;
-    bool* done;
-    GMainLoop* loop;
-};
-
-// Callback for getting cookies
-static void onGetCookiesFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
-    CookieCallbackData* data = static_cast<CookieCallbackData*>(user_data);
-    GError* error = nullptr;
-    GList* cookies = webkit_cookie_manager_get_cookies_finish(
-        WEBKIT_COOKIE_MANAGER(source), result, &error);
+// Completion of an asynchronous session call, run once. `result` is the
+// cookie JSON for get calls, the JSON-lines jar for exports, the counts for
+// imports and empty otherwise.
+using SessionCompletion = std::function<void(bool success, std::string result)>;
 
-    std::ostringstream json;
-    json << "[";
+static electrobun::SessionResultStore g_sessionResults;
 
-    if (!error && cookies) {
-        GList* item = cookies;
-        bool first = true;
-        while (item) {
-            SoupCookie* cookie = static_cast<SoupCookie*>(item->data);
-            if (!first) json << ",";
-            first = false;
+// CefBaseTime counts microseconds from 1601-01-01 UTC.
+static constexpr int64_t kCefBaseTimeUnixEpochUs = 11644473600LL * 1000000LL;
 
-            json << "{";
-            json << "\"name\":\"" << (soup_cookie_get_name(cookie) ?: "") << "\",";
-            json << "\"value\":\"" << (soup_cookie_get_value(cookie) ?: "") << "\",";
-            json << "\"domain\":\"" << (soup_cookie_get_domain(cookie) ?: "") << "\",";
-            json << "\"path\":\"" << (soup_cookie_get_path(cookie) ?: "") << "\",";
-            json << "\"secure\":" << (soup_cookie_get_secure(cookie) ? "true" : "false") << ",";
-            json << "\"httpOnly\":" << (soup_cookie_get_http_only(cookie) ? "true" : "false");
+// Engines may report a failure and then run the callback anyway; only the
+// first call counts.
+static SessionCompletion onceSessionCompletion(SessionCompletion done) {
+    auto fired = std::make_shared<std::atomic<bool>>(false);
+    return [fired, done = std::move(done)](bool success, std::string result) {
+        if (!fired->exchange(true)) {
+            done(success, std::move(result));
+        }
+    };
+}
 
-            GDateTime* expires = soup_cookie_get_expires(cookie);
-            if (expires) {
-                json << ",\"expirationDate\":" << g_date_time_to_unix(expires);
-            }
+// The data manager behind the partition's live webviews, so session calls
+// see their cookie jar; otherwise a standalone manager on the same storage.
+static WebKitWebsiteDataManager* sessionDataManagerForPartition(const std::string& partition) {
+    auto it = g_partitionContexts.find(partition);
+    if (it != g_partitionContexts.end() && it->second) {
+        return webkit_web_context_get_website_data_manager(it->second);
+    }
+    return getDataManagerForPartition(partition.c_str());
+}
 
-            json << "}";
+static WebKitCookieManager* sessionCookieManagerForPartition(const std::string& partition) {
+    WebKitWebsiteDataManager* dataManager = sessionDataManagerForPartition(partition);
+    return dataManager ? webkit_website_data_manager_get_cookie_manager(dataManager) : nullptr;
+}
 
-            item = item->next;
-        }
-        g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+static electrobun::SessionCookie sessionCookieFromSoup(SoupCookie* cookie) {
+    electrobun::SessionCookie entry;
+    entry.name = soup_cookie_get_name(cookie) ?: "";
+    entry.value = soup_cookie_get_value(cookie) ?: "";
+    entry.domain = soup_cookie_get_domain(cookie) ?: "";
+    entry.path = soup_cookie_get_path(cookie) ?: "";
+    entry.secure = soup_cookie_get_secure(cookie);
+    entry.httpOnly = soup_cookie_get_http_only(cookie);
+    if (GDateTime* expires = soup_cookie_get_expires(cookie)) {
+        entry.expirationDate = g_date_time_to_unix(expires);
     }
+    return entry;
+}
 
-    if (error) {
-        g_error_free(error);
+// Cookie manager for a CEF partition. persist:* contexts are shared, so any
+// caller reaches the same jar; other partitions get a context per webview,
+// so use a live webview's.
+static CefRefPtr<CefCookieManager> sessionCefCookieManager(const std::string& partition) {
+    if (!g_cefInitialized) return nullptr;
+    CefRefPtr<CefRequestContext> context;
+    if (partition.compare(0, 8, "persist:") == 0) {
+        context = CreateRequestContextForPartition(partition.c_str(), 0);
+    } else {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        for (const auto& entry : g_webviewMap) {
+            CEFWebViewImpl* view = dynamic_cast<CEFWebViewImpl*>(entry.second.get());
+            if (view && view->partition == partition && view->browser) {
+                context = view->browser->GetHost()->GetRequestContext();
+                break;
+            }
+        }
     }
+    return context ? context->GetCookieManager(nullptr) : nullptr;
+}
 
-    json << "]";
-    *(data->result) = json.str();
-    *(data->done) = true;
+// Serializes cookies as CEF hands them over, so an export never holds the
+// jar twice.
+class SessionCookieVisitor : public CefCookieVisitor {
+public:
+    SessionCookieVisitor(electrobun::SessionCookieFilter filter, bool lines, SessionCompletion done)
+        : filter_(std::move(filter)), writer_(lines), done_(std::move(done)) {}
 
-    if (data->loop) {
-        g_main_loop_quit(data->loop);
+    // CEF releases the visitor after the last cookie, or right away when
+    // there are none, so the result is reported from here.
+    ~SessionCookieVisitor() override {
+        done_(!failed_, writer_.finish());
     }
-}
 
-// Get cookies for a partition (WebKit2GTK)
-ELECTROBUN_EXPORT const char* sessionGetCookies(const char* partitionIdentifier, const char* filterJson) {
-    // Copy arguments before dispatching to main thread
-    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
-    std::string filterStr = filterJson ? filterJson : "{}";
+    void fail() {
+        failed_ = true;
+    }
 
-    return dispatch_sync_main([partitionStr, filterStr]() -> const char* {
-        WebKitWebsiteDataManager* dataManager = getDataManagerForPartition(partitionStr.c_str());
-        if (!dataManager) {
-            return strdup("[]");
+    bool Visit(const CefCookie& cookie, int count, int total, bool& deleteCookie) override {
+        (void)count;
+        (void)total;
+        deleteCookie = false;
+        electrobun::SessionCookie entry;
+        entry.name = CefString(&cookie.name).ToString();
+        entry.value = CefString(&cookie.value).ToString();
+        entry.domain = CefString(&cookie.domain).ToString();
+        entry.path = CefString(&cookie.path).ToString();
+        entry.secure = cookie.secure != 0;
+        entry.httpOnly = cookie.httponly != 0;
+        if (cookie.has_expires && cookie.expires.val > kCefBaseTimeUnixEpochUs) {
+            entry.expirationDate = (cookie.expires.val - kCefBaseTimeUnixEpochUs) / 1000000;
         }
-
-        WebKitCookieManager* cookieManager = webkit_website_data_manager_get_cookie_manager(dataManager);
-        if (!cookieManager) {
-            return strdup("[]");
+        if (filter_.matches(entry)) {
+            writer_.add(entry);
         }
+        return true;
+    }
 
-        // Parse filter for URL
-        std::string filterUrl;
-
-        size_t urlPos = filterStr.find("\"url\"");
-        if (urlPos != std::string::npos) {
-            size_t colonPos = filterStr.find(':', urlPos);
-            size_t quoteStart = filterStr.find('"', colonPos);
-            size_t quoteEnd = filterStr.find('"', quoteStart + 1);
-            if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                filterUrl = filterStr.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-            }
-        }
+private:
+    electrobun::SessionCookieFilter filter_;
+    electrobun::SessionCookieWriter writer_;
+    SessionCompletion done_;
+    bool failed_ = false;
 
-        std::string result = "[]";
-        bool done = false;
+    IMPLEMENT_REFCOUNTING(SessionCookieVisitor);
+};
 
-        CookieCallbackData callbackData;
-        callbackData.result = &result;
-        callbackData.done = &done;
-        callbackData.loop = g_main_loop_new(NULL, FALSE);
+class SessionSetCookieCallback : public CefSetCookieCallback {
+public:
+    explicit SessionSetCookieCallback(SessionCompletion done) : done_(std::move(done)) {}
 
-        const char* uri = filterUrl.empty() ? "https://localhost" : filterUrl.c_str();
-        webkit_cookie_manager_get_cookies(cookieManager, uri, nullptr, onGetCookiesFinished, &callbackData);
+    void OnComplete(bool success) override {
+        done_(success, std::string());
+    }
 
-        // Run main loop until done or timeout
-        GSource* timeout = g_timeout_source_new(5000);
-        g_source_set_callback(timeout, [](gpointer data) -> gboolean {
-            g_main_loop_quit(static_cast<GMainLoop*>(data));
-            return G_SOURCE_REMOVE;
-        }, callbackData.loop, nullptr);
-        g_source_attach(timeout, g_main_loop_get_context(callbackData.loop));
+private:
+    SessionCompletion done_;
 
-        g_main_loop_run(callbackData.loop);
-        g_source_destroy(timeout);
-        g_source_unref(timeout);
-        g_main_loop_unref(callbackData.loop);
+    IMPLEMENT_REFCOUNTING(SessionSetCookieCallback);
+};
 
-        return strdup(result.c_str());
-    });
-}
+class SessionDeleteCookiesCallback : public CefDeleteCookiesCallback {
+public:
+    // With requireMatch, deleting nothing counts as a failure.
+    SessionDeleteCookiesCallback(SessionCompletion done, bool requireMatch)
+        : done_(std::move(done)), requireMatch_(requireMatch) {}
 
-// Callback for setting cookie
-static void onSetCookieFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
-    CookieCallbackData* data = static_cast<CookieCallbackData*>(user_data);
-    GError* error = nullptr;
-    gboolean success = webkit_cookie_manager_add_cookie_finish(
-        WEBKIT_COOKIE_MANAGER(source), result, &error);
+    void OnComplete(int numDeleted) override {
+        done_(!requireMatch_ || numDeleted > 0, std::string());
+    }
 
-    *(data->result) = success ? "true" : "false";
-    *(data->done) = true;
+private:
+    SessionCompletion done_;
+    bool requireMatch_;
 
-    if (error) {
-        g_error_free(error);
-    }
+    IMPLEMENT_REFCOUNTING(SessionDeleteCookiesCallback);
+};
 
-    if (data->loop) {
-        g_main_loop_quit(data->loop);
-    }
+static void sessionClearWebKitData(WebKitWebsiteDataManager* dataManager,
+                                   WebKitWebsiteDataTypes types,
+                                   SessionCompletion done) {
+    webkit_website_data_manager_clear(dataManager, types, 0, nullptr,
+        [](GObject* source, GAsyncResult* result, gpointer userData) {
+            std::unique_ptr<SessionCompletion> done(static_cast<SessionCompletion*>(userData));
+            GError* error = nullptr;
+            const gboolean cleared = webkit_website_data_manager_clear_finish(
+                WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
+            if (error) {
+                g_error_free(error);
+            }
+            (*done)(cleared, std::string());
+        }, new SessionCompletion(std::move(done)));
 }
 
-// Set a cookie (WebKit2GTK)
-ELECTROBUN_EXPORT bool sessionSetCookie(const char* partitionIdentifier, const char* cookieJson) {
-    // Copy arguments before dispatching to main thread
-    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
-    std::string jsonStr = cookieJson ? cookieJson : "{}";
+// The session*Start functions run on the GTK main thread and return as soon
+// as the engine call is issued; `done` runs when it finishes. With `lines`,
+// cookies come back as a JSON-lines jar instead of a `Cookie[]` array.
+static void sessionStartGetCookies(const std::string& partition,
+                                   const std::string& filterJson,
+                                   bool lines,
+                                   SessionCompletion done) {
+    electrobun::SessionCookieFilter filter = electrobun::SessionCookieFilter::parse(filterJson);
+    const std::string empty = lines ? "" : "[]";
 
-    return dispatch_sync_main([partitionStr, jsonStr]() -> bool {
-        WebKitWebsiteDataManager* dataManager = getDataManagerForPartition(partitionStr.c_str());
-        if (!dataManager) {
-            return false;
+    if (isCEFAvailable()) {
+        CefRefPtr<CefCookieManager> manager = sessionCefCookieManager(partition);
+        if (!manager) {
+            done(false, empty);
+            return;
         }
-
-        WebKitCookieManager* cookieManager = webkit_website_data_manager_get_cookie_manager(dataManager);
-        if (!cookieManager) {
-            return false;
+        const std::string url = filter.url;
+        CefRefPtr<SessionCookieVisitor> visitor =
+            new SessionCookieVisitor(std::move(filter), lines, std::move(done));
+        const bool started = url.empty()
+            ? manager->VisitAllCookies(visitor)
+            : manager->VisitUrlCookies(url, true, visitor);
+        if (!started) {
+            visitor->fail();
         }
+        return;
+    }
 
-        // Parse JSON (simple parsing)
-        auto extractString = [&jsonStr](const std::string& key) -> std::string {
-            std::string searchKey = "\"" + key + "\"";
-            size_t pos = jsonStr.find(searchKey);
-            if (pos == std::string::npos) return "";
-            size_t colonPos = jsonStr.find(':', pos);
-            size_t quoteStart = jsonStr.find('"', colonPos);
-            size_t quoteEnd = jsonStr.find('"', quoteStart + 1);
-            if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                return jsonStr.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+    WebKitCookieManager* cookieManager = sessionCookieManagerForPartition(partition);
+    if (!cookieManager) {
+        done(false, empty);
+        return;
+    }
+
+    struct GetCookiesData {
+        electrobun::SessionCookieFilter filter;
+        bool lines;
+        SessionCompletion done;
+        bool all;
+    };
+    GAsyncReadyCallback finished = [](GObject* source, GAsyncResult* result, gpointer userData) {
+        std::unique_ptr<GetCookiesData> data(static_cast<GetCookiesData*>(userData));
+        GError* error = nullptr;
+#if WEBKIT_CHECK_VERSION(2, 42, 0)
+        GList* cookies = data->all
+            ? webkit_cookie_manager_get_all_cookies_finish(WEBKIT_COOKIE_MANAGER(source), result, &error)
+            : webkit_cookie_manager_get_cookies_finish(WEBKIT_COOKIE_MANAGER(source), result, &error);
+#else
+        GList* cookies = webkit_cookie_manager_get_cookies_finish(WEBKIT_COOKIE_MANAGER(source), result, &error);
+#endif
+        electrobun::SessionCookieWriter writer(data->lines);
+        for (GList* item = cookies; item; item = item->next) {
+            const electrobun::SessionCookie cookie = sessionCookieFromSoup(static_cast<SoupCookie*>(item->data));
+            if (data->filter.matches(cookie)) {
+                writer.add(cookie);
             }
-            return "";
-        };
+        }
+        if (cookies) {
+            g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+        }
+        const bool succeeded = error == nullptr;
+        if (error) {
+            g_error_free(error);
+        }
+        data->done(succeeded, writer.finish());
+    };
 
-        auto extractBool = [&jsonStr](const std::string& key) -> bool {
-            std::string searchKey = "\"" + key + "\"";
-            size_t pos = jsonStr.find(searchKey);
-            if (pos == std::string::npos) return false;
-            size_t commaPos = jsonStr.find(',', pos);
-            size_t truePos = jsonStr.find("true", pos);
-            return truePos != std::string::npos && (commaPos == std::string::npos || truePos < commaPos);
-        };
+    const std::string url = filter.url;
+    auto* data = new GetCookiesData{std::move(filter), lines, std::move(done), url.empty()};
+#if WEBKIT_CHECK_VERSION(2, 42, 0)
+    if (url.empty()) {
+        webkit_cookie_manager_get_all_cookies(cookieManager, nullptr, finished, data);
+        return;
+    }
+#endif
+    // Older WebKitGTK can only list cookies for a URL.
+    webkit_cookie_manager_get_cookies(cookieManager, url.empty() ? "https://localhost" : url.c_str(),
+                                      nullptr, finished, data);
+}
+
+// `url` may be empty, in which case one is derived from the cookie.
+static void sessionSetCefCookie(CefRefPtr<CefCookieManager> manager,
+                                const electrobun::SessionCookie& cookie,
+                                const std::string& url,
+                                SessionCompletion done) {
+    CefCookie cefCookie;
+    CefString(&cefCookie.name).FromString(cookie.name);
+    CefString(&cefCookie.value).FromString(cookie.value);
+    CefString(&cefCookie.domain).FromString(cookie.domain);
+    CefString(&cefCookie.path).FromString(cookie.path);
+    cefCookie.secure = cookie.secure;
+    cefCookie.httponly = cookie.httpOnly;
+    if (cookie.expirationDate > 0) {
+        cefCookie.has_expires = 1;
+        cefCookie.expires.val = cookie.expirationDate * 1000000 + kCefBaseTimeUnixEpochUs;
+    }
+    SessionCompletion once = onceSessionCompletion(std::move(done));
+    if (!manager->SetCookie(url.empty() ? electrobun::sessionCookieUrl(cookie) : url, cefCookie,
+                            new SessionSetCookieCallback(once))) {
+        once(false, std::string());
+    }
+}
+
+static void sessionAddWebKitCookie(WebKitCookieManager* cookieManager,
+                                   const electrobun::SessionCookie& cookie,
+                                   SessionCompletion done) {
+    SoupCookie* soupCookie =
+        soup_cookie_new(cookie.name.c_str(), cookie.value.c_str(), cookie.domain.c_str(), cookie.path.c_str(), -1);
+    if (!soupCookie) {
+        done(false, std::string());
+        return;
+    }
+    soup_cookie_set_secure(soupCookie, cookie.secure);
+    soup_cookie_set_http_only(soupCookie, cookie.httpOnly);
+    if (cookie.expirationDate > 0) {
+        GDateTime* expires = g_date_time_new_from_unix_utc(cookie.expirationDate);
+        soup_cookie_set_expires(soupCookie, expires);
+        g_date_time_unref(expires);
+    }
 
-        auto extractDouble = [&jsonStr](const std::string& key) -> double {
-            std::string searchKey = "\"" + key + "\"";
-            size_t pos = jsonStr.find(searchKey);
-            if (pos == std::string::npos) return 0;
-            size_t colonPos = jsonStr.find(':', pos);
-            size_t numStart = colonPos + 1;
-            while (numStart < jsonStr.size() && (jsonStr[numStart] == ' ' || jsonStr[numStart] == '\t')) numStart++;
-            try {
-                return std::stod(jsonStr.substr(numStart));
-            } catch (...) {
-                return 0;
+    struct SetCookieData {
+        SoupCookie* cookie;
+        SessionCompletion done;
+    };
+    webkit_cookie_manager_add_cookie(cookieManager, soupCookie, nullptr,
+        [](GObject* source, GAsyncResult* result, gpointer userData) {
+            std::unique_ptr<SetCookieData> data(static_cast<SetCookieData*>(userData));
+            GError* error = nullptr;
+            const gboolean added = webkit_cookie_manager_add_cookie_finish(
+                WEBKIT_COOKIE_MANAGER(source), result, &error);
+            if (error) {
+                g_error_free(error);
             }
-        };
+            soup_cookie_free(data->cookie);
+            data->done(added, std::string());
+        }, new SetCookieData{soupCookie, std::move(done)});
+}
 
-        std::string name = extractString("name");
-        std::string value = extractString("value");
-        std::string domain = extractString("domain");
-        std::string path = extractString("path");
-        std::string url = extractString("url");
-        bool secure = extractBool("secure");
-        bool httpOnly = extractBool("httpOnly");
-        double expirationDate = extractDouble("expirationDate");
+static void sessionStartSetCookie(const std::string& partition, const std::string& cookieJson, SessionCompletion done) {
+    electrobun::SessionCookie cookie;
+    std::string url;
+    if (!electrobun::parseSessionCookie(cookieJson, &cookie, &url)) {
+        done(false, std::string());
+        return;
+    }
 
-        if (name.empty()) {
-            return false;
+    if (isCEFAvailable()) {
+        CefRefPtr<CefCookieManager> manager = sessionCefCookieManager(partition);
+        if (!manager) {
+            done(false, std::string());
+            return;
         }
+        sessionSetCefCookie(manager, cookie, url, std::move(done));
+        return;
+    }
+
+    WebKitCookieManager* cookieManager = sessionCookieManagerForPartition(partition);
+    if (!cookieManager) {
+        done(false, std::string());
+        return;
+    }
+    sessionAddWebKitCookie(cookieManager, cookie, std::move(done));
+}
 
-        // Derive domain from URL if not provided
-        if (domain.empty() && !url.empty()) {
-            size_t start = url.find("://");
-            if (start != std::string::npos) {
-                start += 3;
-                size_t end = url.find('/', start);
-                domain = url.substr(start, end - start);
+// Cookies an import keeps in flight. Each one is a store write on the
+// engine's network process, so a window overlaps those round trips without
+// decoding the whole jar up front.
+static constexpr size_t kSessionImportWindow = 64;
+
+// Streams a JSON-lines jar into a partition's cookie store, parsing a line
+// only when a window slot frees up. Lives on the GTK main thread, where both
+// engines complete cookie writes, and is kept alive by its pending writes.
+class SessionCookieImport : public std::enable_shared_from_this<SessionCookieImport> {
+public:
+    SessionCookieImport(std::string jar,
+                        CefRefPtr<CefCookieManager> cefManager,
+                        WebKitCookieManager* cookieManager,
+                        SessionCompletion done)
+        : jar_(std::move(jar)),
+          reader_(jar_.data(), jar_.size()),
+          cefManager_(cefManager),
+          cookieManager_(cookieManager),
+          done_(std::move(done)) {
+        if (cookieManager_) {
+            g_object_ref(cookieManager_);
+        }
+    }
+
+    ~SessionCookieImport() {
+        if (cookieManager_) {
+            g_object_unref(cookieManager_);
+        }
+    }
+
+    void pump() {
+        // A write that fails synchronously settles from inside the loop
+        // below, which picks the freed slot up itself.
+        if (pumping_) return;
+        pumping_ = true;
+        std::string line;
+        while (inFlight_ < kSessionImportWindow && reader_.next(&line)) {
+            electrobun::SessionCookie cookie;
+            std::string url;
+            if (!electrobun::parseSessionCookie(line, &cookie, &url)) {
+                ++failed_;
+                continue;
+            }
+            ++inFlight_;
+            auto self = shared_from_this();
+            SessionCompletion settled = [self](bool success, std::string) { self->settle(success); };
+            if (cefManager_) {
+                sessionSetCefCookie(cefManager_, cookie, url, std::move(settled));
+            } else {
+                sessionAddWebKitCookie(cookieManager_, cookie, std::move(settled));
             }
         }
+        pumping_ = false;
 
-        if (domain.empty()) {
-            return false;
+        if (inFlight_ == 0 && reader_.done() && done_) {
+            SessionCompletion done = std::move(done_);
+            done_ = nullptr;
+            done(true, "{\"imported\":" + std::to_string(imported_) +
+                           ",\"failed\":" + std::to_string(failed_) + "}");
         }
+    }
 
-        if (path.empty()) path = "/";
-
-        // Create SoupCookie
-        SoupCookie* cookie = soup_cookie_new(name.c_str(), value.c_str(), domain.c_str(), path.c_str(), -1);
-        if (!cookie) {
-            return false;
+private:
+    void settle(bool success) {
+        --inFlight_;
+        if (success) {
+            ++imported_;
+        } else {
+            ++failed_;
         }
+        pump();
+    }
 
-        soup_cookie_set_secure(cookie, secure);
-        soup_cookie_set_http_only(cookie, httpOnly);
+    std::string jar_;
+    electrobun::SessionCookieLineReader reader_;
+    CefRefPtr<CefCookieManager> cefManager_;
+    WebKitCookieManager* cookieManager_;
+    SessionCompletion done_;
+    size_t inFlight_ = 0;
+    uint64_t imported_ = 0;
+    uint64_t failed_ = 0;
+    bool pumping_ = false;
+};
 
-        if (expirationDate > 0) {
-            GDateTime* expires = g_date_time_new_from_unix_utc((gint64)expirationDate);
-            soup_cookie_set_expires(cookie, expires);
-            g_date_time_unref(expires);
-        }
+// Resolves the partition's store once for the whole jar. Lines that do not
+// parse, or that the engine rejects, are counted as failed rather than
+// stopping the import.
+static void sessionStartImportCookies(const std::string& partition, std::string jar, SessionCompletion done) {
+    CefRefPtr<CefCookieManager> cefManager;
+    WebKitCookieManager* cookieManager = nullptr;
+    if (isCEFAvailable()) {
+        cefManager = sessionCefCookieManager(partition);
+    } else {
+        cookieManager = sessionCookieManagerForPartition(partition);
+    }
+    if (!cefManager && !cookieManager) {
+        done(false, std::string());
+        return;
+    }
+    std::make_shared<SessionCookieImport>(std::move(jar), cefManager, cookieManager, std::move(done))->pump();
+}
 
-        std::string result = "false";
-        bool done = false;
+static void sessionStartRemoveCookie(const std::string& partition,
+                                     const std::string& url,
+                                     const std::string& name,
+                                     SessionCompletion done) {
+    if (isCEFAvailable()) {
+        CefRefPtr<CefCookieManager> manager = sessionCefCookieManager(partition);
+        if (!manager) {
+            done(false, std::string());
+            return;
+        }
+        SessionCompletion once = onceSessionCompletion(std::move(done));
+        if (!manager->DeleteCookies(url, name, new SessionDeleteCookiesCallback(once, true))) {
+            once(false, std::string());
+        }
+        return;
+    }
 
-        CookieCallbackData callbackData;
-        callbackData.result = &result;
-        callbackData.done = &done;
-        callbackData.loop = g_main_loop_new(NULL, FALSE);
+    WebKitCookieManager* cookieManager = sessionCookieManagerForPartition(partition);
+    if (!cookieManager) {
+        done(false, std::string());
+        return;
+    }
 
-        webkit_cookie_manager_add_cookie(cookieManager, cookie, nullptr, onSetCookieFinished, &callbackData);
+    // WebKit deletes by cookie, so look the cookie up first.
+    struct RemoveCookieData {
+        std::string name;
+        SessionCompletion done;
+        SoupCookie* match = nullptr;
+    };
+    webkit_cookie_manager_get_cookies(cookieManager, url.c_str(), nullptr,
+        [](GObject* source, GAsyncResult* result, gpointer userData) {
+            std::unique_ptr<RemoveCookieData> data(static_cast<RemoveCookieData*>(userData));
+            WebKitCookieManager* cookieManager = WEBKIT_COOKIE_MANAGER(source);
+            GError* error = nullptr;
+            GList* cookies = webkit_cookie_manager_get_cookies_finish(cookieManager, result, &error);
+            if (error) {
+                g_error_free(error);
+            }
+            for (GList* item = cookies; item; item = item->next) {
+                SoupCookie* cookie = static_cast<SoupCookie*>(item->data);
+                const char* cookieName = soup_cookie_get_name(cookie);
+                if (cookieName && data->name == cookieName) {
+                    data->match = soup_cookie_copy(cookie);
+                    break;
+                }
+            }
+            if (cookies) {
+                g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+            }
+            if (!data->match) {
+                data->done(false, std::string());
+                return;
+            }
+            SoupCookie* match = data->match;
+            webkit_cookie_manager_delete_cookie(cookieManager, match, nullptr,
+                [](GObject* source, GAsyncResult* result, gpointer userData) {
+                    std::unique_ptr<RemoveCookieData> data(static_cast<RemoveCookieData*>(userData));
+                    GError* error = nullptr;
+                    const gboolean deleted = webkit_cookie_manager_delete_cookie_finish(
+                        WEBKIT_COOKIE_MANAGER(source), result, &error);
+                    if (error) {
+                        g_error_free(error);
+                    }
+                    soup_cookie_free(data->match);
+                    data->done(deleted, std::string());
+                }, data.release());
+        }, new RemoveCookieData{name, std::move(done)});
+}
 
-        // Run main loop until done or timeout
-        GSource* timeout = g_timeout_source_new(5000);
-        g_source_set_callback(timeout, [](gpointer data) -> gboolean {
-            g_main_loop_quit(static_cast<GMainLoop*>(data));
-            return G_SOURCE_REMOVE;
-        }, callbackData.loop, nullptr);
-        g_source_attach(timeout, g_main_loop_get_context(callbackData.loop));
+// Storage types named in a StorageType[] JSON array; everything for "all"
+// or an empty list.
+static unsigned int sessionStorageTypes(const std::string& typesJson) {
+    if (typesJson.length() <= 2 || typesJson.find("\"all\"") != std::string::npos) {
+        return WEBKIT_WEBSITE_DATA_ALL;
+    }
+    unsigned int types = 0;
+    if (typesJson.find("cookies") != std::string::npos) {
+        types |= WEBKIT_WEBSITE_DATA_COOKIES;
+    }
+    if (typesJson.find("localStorage") != std::string::npos) {
+        types |= WEBKIT_WEBSITE_DATA_LOCAL_STORAGE;
+    }
+    if (typesJson.find("indexedDB") != std::string::npos) {
+        types |= WEBKIT_WEBSITE_DATA_INDEXEDDB_DATABASES;
+    }
+    if (typesJson.find("cache") != std::string::npos) {
+        types |= WEBKIT_WEBSITE_DATA_DISK_CACHE;
+        types |= WEBKIT_WEBSITE_DATA_MEMORY_CACHE;
+    }
+    if (typesJson.find("serviceWorkers") != std::string::npos) {
+        types |= WEBKIT_WEBSITE_DATA_SERVICE_WORKER_REGISTRATIONS;
+    }
+    return types;
+}
 
-        g_main_loop_run(callbackData.loop);
-        g_source_destroy(timeout);
-        g_source_unref(timeout);
-        g_main_loop_unref(callbackData.loop);
+// CEF exposes no storage-clearing API to embedders beyond cookies, so under
+// CEF only the cookie part of a request is honoured.
+static void sessionStartClearStorageData(const std::string& partition, unsigned int types, SessionCompletion done) {
+    if (types == 0) {
+        done(true, std::string());
+        return;
+    }
 
-        soup_cookie_free(cookie);
+    if (isCEFAvailable()) {
+        if (!(types & WEBKIT_WEBSITE_DATA_COOKIES)) {
+            done(true, std::string());
+            return;
+        }
+        CefRefPtr<CefCookieManager> manager = sessionCefCookieManager(partition);
+        if (!manager) {
+            done(false, std::string());
+            return;
+        }
+        SessionCompletion once = onceSessionCompletion(std::move(done));
+        if (!manager->DeleteCookies(CefString(), CefString(), new SessionDeleteCookiesCallback(once, false))) {
+            once(false, std::string());
+        }
+        return;
+    }
 
-        return result == "true";
-    });
+    WebKitWebsiteDataManager* dataManager = sessionDataManagerForPartition(partition);
+    if (!dataManager) {
+        done(false, std::string());
+        return;
+    }
+    sessionClearWebKitData(dataManager, static_cast<WebKitWebsiteDataTypes>(types), std::move(done));
 }
 
-// Callback for deleting cookie
-static void onDeleteCookieFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
-    CookieCallbackData* data = static_cast<CookieCallbackData*>(user_data);
-    GError* error = nullptr;
-    gboolean success = webkit_cookie_manager_delete_cookie_finish(
-        WEBKIT_COOKIE_MANAGER(source), result, &error);
+// Blocks the calling thread, not the GTK loop, until a session call
+// completes or `timeoutMs` passes; a completion after the timeout is
+// dropped. The completion arrives on the GTK thread, so a call made there
+// fails at once rather than nesting the main loop; use the session*Async
+// calls from that thread.
+static bool runSessionCallSync(std::function<void(SessionCompletion)> start, int timeoutMs, std::string* result) {
+    if (g_main_context_is_owner(g_main_context_default())) {
+        fprintf(stderr, "Session: synchronous call on the GTK thread rejected; use the async variant\n");
+        return false;
+    }
 
-    *(data->result) = success ? "true" : "false";
-    *(data->done) = true;
+    struct SyncState {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+        bool success = false;
+        std::string result;
+    };
+    auto state = std::make_shared<SyncState>();
+    SessionCompletion complete = onceSessionCompletion([state](bool success, std::string value) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done = true;
+        state->success = success;
+        state->result = std::move(value);
+        state->condition.notify_all();
+    });
 
-    if (error) {
-        g_error_free(error);
+    dispatch_async_main_void([start = std::move(start), complete]() { start(complete); });
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() { return state->done; });
+    if (result && state->done) {
+        *result = state->result;
     }
+    return state->done && state->success;
+}
 
-    if (data->loop) {
-        g_main_loop_quit(data->loop);
-    }
+// Get cookies for a partition
+ELECTROBUN_EXPORT const char* sessionGetCookies(const char* partitionIdentifier, const char* filterJson) {
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string filterStr = filterJson ? filterJson : "{}";
+    std::string result = "[]";
+    runSessionCallSync([partitionStr, filterStr](SessionCompletion done) {
+        sessionStartGetCookies(partitionStr, filterStr, false, std::move(done));
+    }, 5000, &result);
+    return strdup(result.empty() ? "[]" : result.c_str());
 }
 
-// Remove a specific cookie (WebKit2GTK)
+// Set a cookie
+ELECTROBUN_EXPORT bool sessionSetCookie(const char* partitionIdentifier, const char* cookieJson) {
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string jsonStr = cookieJson ? cookieJson : "{}";
+    return runSessionCallSync([partitionStr, jsonStr](SessionCompletion done) {
+        sessionStartSetCookie(partitionStr, jsonStr, std::move(done));
+    }, 5000, nullptr);
+}
+
+// Remove a specific cookie
 ELECTROBUN_EXPORT bool sessionRemoveCookie(const char* partitionIdentifier, const char* urlStr, const char* cookieName) {
     if (!urlStr || !cookieName) return false;
-
-    // Copy arguments before dispatching to main thread
     std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
     std::string urlString = urlStr;
     std::string nameString = cookieName;
+    return runSessionCallSync([partitionStr, urlString, nameString](SessionCompletion done) {
+        sessionStartRemoveCookie(partitionStr, urlString, nameString, std::move(done));
+    }, 5000, nullptr);
+}
 
-    return dispatch_sync_main([partitionStr, urlString, nameString]() -> bool {
-        WebKitWebsiteDataManager* dataManager = getDataManagerForPartition(partitionStr.c_str());
-        if (!dataManager) {
-            return false;
-        }
+// Clear all cookies
+ELECTROBUN_EXPORT void sessionClearCookies(const char* partitionIdentifier) {
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    runSessionCallSync([partitionStr](SessionCompletion done) {
+        sessionStartClearStorageData(partitionStr, WEBKIT_WEBSITE_DATA_COOKIES, std::move(done));
+    }, 5000, nullptr);
+}
 
-        WebKitCookieManager* cookieManager = webkit_website_data_manager_get_cookie_manager(dataManager);
-        if (!cookieManager) {
-            return false;
-        }
+// Clear storage data
+ELECTROBUN_EXPORT void sessionClearStorageData(const char* partitionIdentifier, const char* storageTypesJson) {
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    const unsigned int types = sessionStorageTypes(storageTypesJson ? storageTypesJson : "");
+    runSessionCallSync([partitionStr, types](SessionCompletion done) {
+        sessionStartClearStorageData(partitionStr, types, std::move(done));
+    }, 10000, nullptr);
+}
+
+// Completion for the session*Async calls, on the GTK main thread. A
+// non-empty result (the cookie JSON for get) waits for sessionTakeResult,
+// since a threadsafe FFI callback runs after this call has returned.
+typedef void (*SessionCompletionCallback)(uint32_t requestId, bool success, uint64_t resultLength);
+
+static void startSessionCallAsync(uint32_t requestId,
+                                  SessionCompletionCallback callback,
+                                  std::function<void(SessionCompletion)> start) {
+    SessionCompletion complete = onceSessionCompletion([requestId, callback](bool success, std::string result) {
+        const uint64_t length = result.size();
+        if (length > 0) {
+            g_sessionResults.put(requestId, std::move(result));
+        }
+        callback(requestId, success, length);
+    });
+    dispatch_async_main_void([start = std::move(start), complete]() { start(complete); });
+}
 
-        // First get all cookies for the URL, then delete the matching one
-        std::string result = "[]";
-        bool done = false;
+// The session*Async calls return immediately and report through `callback`.
+// Any number may be in flight; none blocks the caller or nests the GTK loop.
+ELECTROBUN_EXPORT bool sessionGetCookiesAsync(const char* partitionIdentifier,
+                                              const char* filterJson,
+                                              uint32_t requestId,
+                                              SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string filterStr = filterJson ? filterJson : "{}";
+    startSessionCallAsync(requestId, callback, [partitionStr, filterStr](SessionCompletion done) {
+        sessionStartGetCookies(partitionStr, filterStr, false, std::move(done));
+    });
+    return true;
+}
 
-        CookieCallbackData callbackData;
-        callbackData.result = &result;
-        callbackData.done = &done;
-        callbackData.loop = g_main_loop_new(NULL, FALSE);
+ELECTROBUN_EXPORT bool sessionSetCookieAsync(const char* partitionIdentifier,
+                                             const char* cookieJson,
+                                             uint32_t requestId,
+                                             SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string jsonStr = cookieJson ? cookieJson : "{}";
+    startSessionCallAsync(requestId, callback, [partitionStr, jsonStr](SessionCompletion done) {
+        sessionStartSetCookie(partitionStr, jsonStr, std::move(done));
+    });
+    return true;
+}
 
-        // Get cookies first
-        webkit_cookie_manager_get_cookies(cookieManager, urlString.c_str(), nullptr,
-            [](GObject* source, GAsyncResult* result, gpointer user_data) {
-                CookieCallbackData* data = static_cast<CookieCallbackData*>(user_data);
-                GError* error = nullptr;
-                GList* cookies = webkit_cookie_manager_get_cookies_finish(
-                    WEBKIT_COOKIE_MANAGER(source), result, &error);
+ELECTROBUN_EXPORT bool sessionRemoveCookieAsync(const char* partitionIdentifier,
+                                                const char* urlStr,
+                                                const char* cookieName,
+                                                uint32_t requestId,
+                                                SessionCompletionCallback callback) {
+    if (!callback || !urlStr || !cookieName) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string urlString = urlStr;
+    std::string nameString = cookieName;
+    startSessionCallAsync(requestId, callback, [partitionStr, urlString, nameString](SessionCompletion done) {
+        sessionStartRemoveCookie(partitionStr, urlString, nameString, std::move(done));
+    });
+    return true;
+}
 
-                if (cookies) {
-                    // Store cookies list in result for now
-                    *(data->result) = std::to_string(reinterpret_cast<uintptr_t>(cookies));
-                } else {
-                    *(data->result) = "0";
-                }
-                *(data->done) = true;
+ELECTROBUN_EXPORT bool sessionClearCookiesAsync(const char* partitionIdentifier,
+                                                uint32_t requestId,
+                                                SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    startSessionCallAsync(requestId, callback, [partitionStr](SessionCompletion done) {
+        sessionStartClearStorageData(partitionStr, WEBKIT_WEBSITE_DATA_COOKIES, std::move(done));
+    });
+    return true;
+}
 
-                if (error) {
-                    g_error_free(error);
-                }
+ELECTROBUN_EXPORT bool sessionClearStorageDataAsync(const char* partitionIdentifier,
+                                                    const char* storageTypesJson,
+                                                    uint32_t requestId,
+                                                    SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    const unsigned int types = sessionStorageTypes(storageTypesJson ? storageTypesJson : "");
+    startSessionCallAsync(requestId, callback, [partitionStr, types](SessionCompletion done) {
+        sessionStartClearStorageData(partitionStr, types, std::move(done));
+    });
+    return true;
+}
 
-                if (data->loop) {
-                    g_main_loop_quit(data->loop);
-                }
-            }, &callbackData);
+// Writes a JSON-lines jar (one Cookie object per line) into the partition.
+// The buffer is copied before returning. The result is
+// {"imported":n,"failed":n}.
+ELECTROBUN_EXPORT bool sessionImportCookiesAsync(const char* partitionIdentifier,
+                                                 const uint8_t* jar,
+                                                 uint64_t jarLength,
+                                                 uint32_t requestId,
+                                                 SessionCompletionCallback callback) {
+    if (!callback || (!jar && jarLength > 0)) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string jarStr(reinterpret_cast<const char*>(jar), static_cast<size_t>(jarLength));
+    startSessionCallAsync(requestId, callback, [partitionStr, jarStr = std::move(jarStr)](SessionCompletion done) mutable {
+        sessionStartImportCookies(partitionStr, std::move(jarStr), std::move(done));
+    });
+    return true;
+}
 
-        GSource* timeout = g_timeout_source_new(5000);
-        g_source_set_callback(timeout, [](gpointer data) -> gboolean {
-            g_main_loop_quit(static_cast<GMainLoop*>(data));
-            return G_SOURCE_REMOVE;
-        }, callbackData.loop, nullptr);
-        g_source_attach(timeout, g_main_loop_get_context(callbackData.loop));
+// Reads the partition's cookies, filtered like sessionGetCookiesAsync, as a
+// JSON-lines jar that sessionImportCookiesAsync accepts.
+ELECTROBUN_EXPORT bool sessionExportCookiesAsync(const char* partitionIdentifier,
+                                                 const char* filterJson,
+                                                 uint32_t requestId,
+                                                 SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    std::string filterStr = filterJson ? filterJson : "{}";
+    startSessionCallAsync(requestId, callback, [partitionStr, filterStr](SessionCompletion done) {
+        sessionStartGetCookies(partitionStr, filterStr, true, std::move(done));
+    });
+    return true;
+}
 
-        g_main_loop_run(callbackData.loop);
-        g_source_destroy(timeout);
-        g_source_unref(timeout);
-        g_main_loop_unref(callbackData.loop);
+// Builds a partition's context ahead of its first webview, so that webview
+// skips creating the WebKit data manager, cookie database and scheme
+// handlers, or the CEF request context and its profile directory. Only
+// contexts that outlive a webview can be built early: persistent partitions,
+// plus WebKit's default context. Returns false for anything else.
+static bool prewarmPartitionContext(const std::string& partition) {
+    if (isCEFAvailable()) {
+        if (!g_cefInitialized || !isPersistentWebKitPartition(partition)) {
+            return false;
+        }
+        return CreateRequestContextForPartition(partition.c_str(), 0) != nullptr;
+    }
+    if (!partition.empty() && !isPersistentWebKitPartition(partition)) {
+        return false;
+    }
+    return getContextForPartition(partition.empty() ? nullptr : partition.c_str()) != nullptr;
+}
 
-        // Parse the cookies list pointer
-        GList* cookies = reinterpret_cast<GList*>(std::stoull(result));
-        bool found = false;
+// Partitions waiting to be prewarmed, drained one per low-priority idle
+// callback so input, drawing and IPC always run first. Main thread only.
+static std::deque<std::pair<std::string, SessionCompletion>> g_partitionPrewarmQueue;
+static bool g_partitionPrewarmScheduled = false;
 
-        if (cookies) {
-            GList* item = cookies;
-            while (item) {
-                SoupCookie* cookie = static_cast<SoupCookie*>(item->data);
-                if (std::string(soup_cookie_get_name(cookie)) == nameString) {
-                    // Delete this cookie
-                    done = false;
-                    result = "false";
-                    callbackData.loop = g_main_loop_new(NULL, FALSE);
-
-                    webkit_cookie_manager_delete_cookie(cookieManager, cookie, nullptr, onDeleteCookieFinished, &callbackData);
-
-                    timeout = g_timeout_source_new(5000);
-                    g_source_set_callback(timeout, [](gpointer data) -> gboolean {
-                        g_main_loop_quit(static_cast<GMainLoop*>(data));
-                        return G_SOURCE_REMOVE;
-                    }, callbackData.loop, nullptr);
-                    g_source_attach(timeout, g_main_loop_get_context(callbackData.loop));
-
-                    g_main_loop_run(callbackData.loop);
-                    g_source_destroy(timeout);
-                    g_source_unref(timeout);
-                    g_main_loop_unref(callbackData.loop);
-
-                    found = (result == "true");
-                    break;
-                }
-                item = item->next;
-            }
-            g_list_free_full(cookies, (GDestroyNotify)soup_cookie_free);
+static void queuePartitionPrewarm(const std::string& partition, SessionCompletion done) {
+    g_partitionPrewarmQueue.emplace_back(partition, std::move(done));
+    if (g_partitionPrewarmScheduled) return;
+    g_partitionPrewarmScheduled = true;
+    g_idle_add_full(G_PRIORITY_LOW, [](gpointer) -> gboolean {
+        auto [partition, done] = std::move(g_partitionPrewarmQueue.front());
+        g_partitionPrewarmQueue.pop_front();
+        const bool prewarmed = prewarmPartitionContext(partition);
+        done(prewarmed, std::string());
+        if (!g_partitionPrewarmQueue.empty()) {
+            return G_SOURCE_CONTINUE;
         }
+        g_partitionPrewarmScheduled = false;
+        return G_SOURCE_REMOVE;
+    }, nullptr, nullptr);
+}
 
-        return found;
+// Reports success once the partition's context is ready, including when a
+// webview already built it, and failure when it cannot be built early.
+ELECTROBUN_EXPORT bool sessionPrewarmPartitionAsync(const char* partitionIdentifier,
+                                                    uint32_t requestId,
+                                                    SessionCompletionCallback callback) {
+    if (!callback) return false;
+    std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
+    startSessionCallAsync(requestId, callback, [partitionStr](SessionCompletion done) {
+        queuePartitionPrewarm(partitionStr, std::move(done));
     });
+    return true;
 }
 
-// Clear all cookies (WebKit2GTK)
-// Clear all cookies (WebKit2GTK) - STUB implementation to prevent crashes
-ELECTROBUN_EXPORT void sessionClearCookies(const char* partitionIdentifier) {
-    // Stub implementation: do nothing and return immediately
-    // This prevents crashes from complex WebKit async patterns during tests
-    // while maintaining API compatibility
-    (void)partitionIdentifier; // Suppress unused parameter warning
-    return;
+// Copy out and forget the result of a completed session*Async call.
+ELECTROBUN_EXPORT bool sessionTakeResult(uint32_t requestId, uint8_t* out, uint64_t outLength) {
+    return g_sessionResults.take(requestId, out, outLength);
 }
 
-// Clear storage data (WebKit2GTK)
-ELECTROBUN_EXPORT void sessionClearStorageData(const char* partitionIdentifier, const char* storageTypesJson) {
-    // Copy arguments before dispatching to main thread
+// Keeps `size` spare webviews, at most kMaxWebviewPoolSize, ready for a
+// persistent partition, built in the background and handed out by the next
+// initWebview calls. Spares are per autoResize mode, which fixes their
+// compositing. CEF builds every browser from its own client and extra info,
+// so it has nothing to pool and returns false, as do ephemeral partitions.
+ELECTROBUN_EXPORT bool setWebviewPoolSize(const char* partitionIdentifier,
+                                          bool autoResize,
+                                          uint32_t size) {
     std::string partitionStr = partitionIdentifier ? partitionIdentifier : "";
-    std::string typesStr = storageTypesJson ? storageTypesJson : "";
-
-    dispatch_sync_main_void([partitionStr, typesStr]() {
-        WebKitWebsiteDataManager* dataManager = getDataManagerForPartition(partitionStr.c_str());
-        if (!dataManager) {
-            return;
+    if (isCEFAvailable() || !isPersistentWebKitPartition(partitionStr)) {
+        return false;
+    }
+    dispatch_sync_main_void([&]() {
+        for (WebKitSpareView& spare :
+             g_webkitViewPool.setCapacity(webkitViewPoolKey(partitionStr, autoResize), size)) {
+            destroyWebKitSpareView(spare);
         }
+        scheduleWebKitViewPoolRefill();
+    });
+    return true;
+}
 
-        unsigned int typesFlags = 0;
+ELECTROBUN_EXPORT void getWebviewPoolStats(electrobun::WebviewPoolStats* out) {
+    if (!out) return;
+    dispatch_sync_main_void([&]() {
+        *out = g_webkitViewPool.stats();
+    });
+}
 
-        if (typesStr.length() > 2) {
-            if (typesStr.find("cookies") != std::string::npos) {
-                typesFlags |= WEBKIT_WEBSITE_DATA_COOKIES;
-            }
-            if (typesStr.find("localStorage") != std::string::npos) {
-                typesFlags |= WEBKIT_WEBSITE_DATA_LOCAL_STORAGE;
-            }
-            if (typesStr.find("indexedDB") != std::string::npos) {
-                typesFlags |= WEBKIT_WEBSITE_DATA_INDEXEDDB_DATABASES;
-            }
-            if (typesStr.find("cache") != std::string::npos) {
-                typesFlags |= WEBKIT_WEBSITE_DATA_DISK_CACHE;
-                typesFlags |= WEBKIT_WEBSITE_DATA_MEMORY_CACHE;
-            }
-            if (typesStr.find("serviceWorkers") != std::string::npos) {
-                typesFlags |= WEBKIT_WEBSITE_DATA_SERVICE_WORKER_REGISTRATIONS;
-            }
-        } else {
-            // Clear all
-            typesFlags = WEBKIT_WEBSITE_DATA_ALL;
+// Memory and CPU per webview from /proc, without a main thread round-trip.
+// Webviews come first, in id order, then this process and every other
+// process it started, such as the GPU process and WebKit's web and network
+// processes. Views sharing a renderer each report it. WebKitGTK does not
+// say which web process renders a view, so its views report pid 0 and
+// their processes appear among the others. Returns the number of records
+// available, of which at most `maxRecords` are written. A null `out` only
+// counts them, reading each process's stat but not its smaps_rollup.
+ELECTROBUN_EXPORT uint32_t getWebviewProcessStats(electrobun::LinuxProcessStats* out,
+                                                  uint32_t maxRecords) {
+    // Copy out the renderers so /proc is read without holding the map.
+    std::vector<std::pair<uint32_t, int>> views;
+    {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        views.reserve(g_webviewMap.size());
+        for (const auto& [webviewId, view] : g_webviewMap) {
+            if (view) views.emplace_back(webviewId, view->rendererProcessId());
         }
+    }
 
-        if (typesFlags == 0) {
-            return;
+    std::vector<electrobun::LinuxProcessStats> records;
+    electrobun::LinuxProcessSampler sampler(sysconf(_SC_CLK_TCK), sysconf(_SC_PAGESIZE));
+    sampler.setRssOnly(out == nullptr);
+    std::set<int> reported;
+    for (const auto& [webviewId, pid] : views) {
+        electrobun::LinuxProcessStats record;
+        record.webviewId = webviewId;
+        if (pid > 0 && sampler.sample(pid, &record)) {
+            reported.insert(pid);
         }
+        records.push_back(record);
+    }
 
-        WebKitWebsiteDataTypes types = static_cast<WebKitWebsiteDataTypes>(typesFlags);
+    electrobun::LinuxProcessStats self;
+    if (sampler.sample(getpid(), &self)) {
+        self.kind = static_cast<uint32_t>(electrobun::LinuxProcessKind::browser);
+        records.push_back(self);
+    }
+    for (const int pid : sampler.descendantsOf(getpid())) {
+        electrobun::LinuxProcessStats record;
+        if (!reported.count(pid) && sampler.sample(pid, &record)) {
+            records.push_back(record);
+        }
+    }
 
-        GMainLoop* loop = g_main_loop_new(NULL, FALSE);
+    if (out) {
+        std::copy_n(records.begin(), std::min<size_t>(records.size(), maxRecords), out);
+    }
+    return static_cast<uint32_t>(records.size());
+}
 
-        webkit_website_data_manager_clear(dataManager, types, 0, nullptr,
-            [](GObject* source, GAsyncResult* result, gpointer user_data) {
-                GMainLoop* loop = static_cast<GMainLoop*>(user_data);
-                GError* error = nullptr;
-                webkit_website_data_manager_clear_finish(WEBKIT_WEBSITE_DATA_MANAGER(source), result, &error);
-                if (error) {
-                    g_error_free(error);
-                }
-                g_main_loop_quit(loop);
-            }, loop);
+// Winds webviews down once they have been hidden for the given times:
+// throttled, then frozen, then discarded and reloaded when shown. 0 skips a
+// step and all 0 turns the policy off; views already wound down stay so
+// until shown.
+ELECTROBUN_EXPORT void setWebviewLifecyclePolicy(uint32_t throttleAfterMs,
+                                                 uint32_t freezeAfterMs,
+                                                 uint32_t discardAfterMs) {
+    dispatch_sync_main_void([&]() {
+        g_webviewLifecyclePolicy = {throttleAfterMs, freezeAfterMs, discardAfterMs};
+        scheduleWebviewLifecycleTick();
+    });
+}
 
-        GSource* timeout = g_timeout_source_new(10000);
-        g_source_set_callback(timeout, [](gpointer data) -> gboolean {
-            g_main_loop_quit(static_cast<GMainLoop*>(data));
-            return G_SOURCE_REMOVE;
-        }, loop, nullptr);
-        g_source_attach(timeout, g_main_loop_get_context(loop));
+ELECTROBUN_EXPORT void getWebviewLifecycleStats(electrobun::WebviewLifecycleStats* out) {
+    if (!out) return;
+    dispatch_sync_main_void([&]() {
+        *out = g_webviewLifecycleStats;
+    });
+}
 
-        g_main_loop_run(loop);
-        g_source_destroy(timeout);
-        g_source_unref(timeout);
-        g_main_loop_unref(loop);
+// A webview's electrobun::WebviewLifecycleState; active for unknown ids.
+ELECTROBUN_EXPORT uint32_t getWebviewLifecycleState(uint32_t webviewId) {
+    uint32_t state = 0;
+    dispatch_sync_main_void([&]() {
+        std::lock_guard<std::mutex> lock(g_webviewMapMutex);
+        auto it = g_webviewMap.find(webviewId);
+        if (it != g_webviewMap.end() && it->second) {
+            state = static_cast<uint32_t>(it->second->lifecycle.state());
+        }
     });
+    return state;
 }
 
 ELECTROBUN_EXPORT void setURLOpenHandler(void (*callback)(const char*)) {
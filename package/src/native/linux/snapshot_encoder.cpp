@@ -0,0 +1,330 @@
+#include "snapshot_encoder.h"
+
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <glib.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace electrobun::snapshot_encoder {
+namespace {
+
+// Premultiplied BGRA view of a captured image.
+struct Pixels {
+    const std::uint8_t* data = nullptr;
+    std::size_t stride = 0;
+    int width = 0;
+    int height = 0;
+    bool opaque = false;
+};
+
+Result fail() {
+    return Result{};
+}
+
+bool encodeImage(
+    const std::vector<std::uint8_t>& rgba,
+    int width,
+    int height,
+    WebviewSnapshotFormat format,
+    int quality,
+    std::string* dataUrl
+) {
+    std::vector<std::uint8_t> rgb;
+    GdkPixbuf* pixbuf = nullptr;
+    if (format == WebviewSnapshotFormat::Jpeg) {
+        rgb.resize(static_cast<std::size_t>(width) * height * 3);
+        flattenWebviewSnapshotRgba(rgba.data(), static_cast<std::size_t>(width) * height, rgb.data());
+        pixbuf = gdk_pixbuf_new_from_data(
+            rgb.data(), GDK_COLORSPACE_RGB, FALSE, 8, width, height, width * 3,
+            nullptr, nullptr);
+    } else {
+        pixbuf = gdk_pixbuf_new_from_data(
+            rgba.data(), GDK_COLORSPACE_RGB, TRUE, 8, width, height, width * 4,
+            nullptr, nullptr);
+    }
+    if (!pixbuf) {
+        return false;
+    }
+
+    gchar* buffer = nullptr;
+    gsize bufferSize = 0;
+    GError* error = nullptr;
+    gboolean saved = FALSE;
+    if (format == WebviewSnapshotFormat::Jpeg) {
+        char qualityValue[8];
+        std::snprintf(qualityValue, sizeof(qualityValue), "%d", quality);
+        saved = gdk_pixbuf_save_to_buffer(
+            pixbuf, &buffer, &bufferSize, "jpeg", &error, "quality", qualityValue, NULL);
+    } else {
+        saved = gdk_pixbuf_save_to_buffer(
+            pixbuf, &buffer, &bufferSize, "png", &error, NULL);
+    }
+    g_object_unref(pixbuf);
+
+    if (!saved || !buffer) {
+        if (error) {
+            std::fprintf(stderr, "[electrobun] snapshot encoding failed: %s\n", error->message);
+            g_error_free(error);
+        }
+        g_free(buffer);
+        return false;
+    }
+    *dataUrl = encodeWebviewSnapshotDataUrl(
+        format == WebviewSnapshotFormat::Jpeg ? "image/jpeg" : "image/png",
+        reinterpret_cast<const std::uint8_t*>(buffer), bufferSize);
+    g_free(buffer);
+    return true;
+}
+
+Result process(const Job& job, const Pixels& pixels) {
+    const WebviewSnapshotRect crop = webviewSnapshotCropRect(
+        job.regionX, job.regionY, job.regionWidth, job.regionHeight,
+        job.viewWidth, job.viewHeight, pixels.width, pixels.height);
+    const WebviewSnapshotSize size =
+        fitWebviewSnapshotSize(crop.width, crop.height, job.maxWidth, job.maxHeight);
+    if (size.width <= 0 || size.height <= 0) {
+        return fail();
+    }
+
+    const std::uint64_t outputBytes =
+        static_cast<std::uint64_t>(size.width) * static_cast<std::uint64_t>(size.height) * 4;
+    const bool direct = job.format == WebviewSnapshotFormat::Rgba;
+    if (direct && (!job.outRgba || job.outLen < outputBytes)) {
+        return fail();
+    }
+
+    std::vector<std::uint8_t> rgba;
+    std::uint8_t* destination = job.outRgba;
+    if (!direct) {
+        rgba.resize(static_cast<std::size_t>(outputBytes));
+        destination = rgba.data();
+    }
+    resampleWebviewSnapshotBgra(
+        pixels.data + static_cast<std::size_t>(crop.y) * pixels.stride +
+            static_cast<std::size_t>(crop.x) * 4,
+        pixels.stride, crop.width, crop.height,
+        destination, size.width, size.height, pixels.opaque);
+
+    Result result;
+    result.width = size.width;
+    result.height = size.height;
+    result.success = direct ||
+        encodeImage(rgba, size.width, size.height, job.format, job.quality, &result.dataUrl);
+    return result;
+}
+
+Result processSurface(const Job& job, cairo_surface_t* surface) {
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS ||
+        cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE) {
+        return fail();
+    }
+    const cairo_format_t format = cairo_image_surface_get_format(surface);
+    if (format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24) {
+        return fail();
+    }
+    Pixels pixels;
+    pixels.data = cairo_image_surface_get_data(surface);
+    pixels.stride = static_cast<std::size_t>(cairo_image_surface_get_stride(surface));
+    pixels.width = cairo_image_surface_get_width(surface);
+    pixels.height = cairo_image_surface_get_height(surface);
+    pixels.opaque = format == CAIRO_FORMAT_RGB24;
+    if (!pixels.data) {
+        return fail();
+    }
+    // cairo stores native-endian 0xAARRGGBB words; the resampler reads BGRA
+    // bytes, which is that layout on little-endian hosts.
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                  "snapshot resampling assumes little-endian cairo pixels");
+    return process(job, pixels);
+}
+
+Result processPngBase64(const Job& job, const std::string& base64) {
+    gsize length = 0;
+    guchar* bytes = g_base64_decode(base64.c_str(), &length);
+    if (!bytes) {
+        return fail();
+    }
+
+    WebviewSnapshotSize size = {};
+    const bool wholeImage = !(job.regionWidth > 0.0) || !(job.regionHeight > 0.0);
+    if (job.format == WebviewSnapshotFormat::Png && wholeImage &&
+        readWebviewSnapshotPngSize(bytes, length, &size)) {
+        const WebviewSnapshotSize fitted =
+            fitWebviewSnapshotSize(size.width, size.height, job.maxWidth, job.maxHeight);
+        if (fitted.width == size.width && fitted.height == size.height) {
+            g_free(bytes);
+            Result result;
+            result.success = true;
+            result.width = size.width;
+            result.height = size.height;
+            result.dataUrl = "data:image/png;base64," + base64;
+            return result;
+        }
+    }
+
+    GdkPixbufLoader* loader = gdk_pixbuf_loader_new_with_type("png", nullptr);
+    GdkPixbuf* decoded = nullptr;
+    if (loader) {
+        const gboolean written = gdk_pixbuf_loader_write(loader, bytes, length, nullptr);
+        const gboolean closed = gdk_pixbuf_loader_close(loader, nullptr);
+        if (written && closed) {
+            decoded = gdk_pixbuf_loader_get_pixbuf(loader);
+            if (decoded) {
+                g_object_ref(decoded);
+            }
+        }
+        g_object_unref(loader);
+    }
+    g_free(bytes);
+    if (!decoded) {
+        return fail();
+    }
+
+    // Decoded PNGs are straight RGB(A); premultiply into BGRA once so both
+    // capture paths share the resampler.
+    const int width = gdk_pixbuf_get_width(decoded);
+    const int height = gdk_pixbuf_get_height(decoded);
+    const int channels = gdk_pixbuf_get_n_channels(decoded);
+    const int rowstride = gdk_pixbuf_get_rowstride(decoded);
+    const guchar* source = gdk_pixbuf_read_pixels(decoded);
+    if (gdk_pixbuf_get_bits_per_sample(decoded) != 8 || (channels != 3 && channels != 4) ||
+        width <= 0 || height <= 0 || !source) {
+        g_object_unref(decoded);
+        return fail();
+    }
+    std::vector<std::uint8_t> bgra(static_cast<std::size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const guchar* in = source + static_cast<std::size_t>(y) * rowstride;
+        std::uint8_t* out = bgra.data() + static_cast<std::size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x, in += channels, out += 4) {
+            const unsigned alpha = channels == 4 ? in[3] : 255u;
+            out[0] = static_cast<std::uint8_t>((in[2] * alpha + 127u) / 255u);
+            out[1] = static_cast<std::uint8_t>((in[1] * alpha + 127u) / 255u);
+            out[2] = static_cast<std::uint8_t>((in[0] * alpha + 127u) / 255u);
+            out[3] = static_cast<std::uint8_t>(alpha);
+        }
+    }
+    g_object_unref(decoded);
+
+    Pixels pixels;
+    pixels.data = bgra.data();
+    pixels.stride = static_cast<std::size_t>(width) * 4;
+    pixels.width = width;
+    pixels.height = height;
+    return process(job, pixels);
+}
+
+// A single lazily started worker. Snapshots are occasional (tab thumbnails),
+// so one thread is enough to keep encoding off the GTK main loop.
+class Worker {
+public:
+    // The static outlives main when the process exits without the shutdown
+    // path, and destroying a joinable thread would terminate it.
+    ~Worker() {
+        stop();
+    }
+
+    void post(std::function<Result()> task, Job&& job) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_) {
+            lock.unlock();
+            if (job.complete) job.complete(fail());
+            return;
+        }
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this] { run(); });
+        }
+        queue_.push_back({std::move(task), std::move(job.complete)});
+        lock.unlock();
+        ready_.notify_one();
+    }
+
+    void stop() {
+        std::deque<Entry> abandoned;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+            abandoned.swap(queue_);
+        }
+        ready_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        for (auto& entry : abandoned) {
+            if (entry.complete) entry.complete(fail());
+        }
+    }
+
+private:
+    struct Entry {
+        std::function<Result()> task;
+        std::function<void(Result&&)> complete;
+    };
+
+    void run() {
+        for (;;) {
+            Entry entry;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (stopping_) return;
+                entry = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            Result result = entry.task();
+            if (entry.complete) {
+                entry.complete(std::move(result));
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Entry> queue_;
+    std::thread thread_;
+    bool stopping_ = false;
+};
+
+Worker& worker() {
+    static Worker instance;
+    return instance;
+}
+
+}  // namespace
+
+void submitSurface(Job&& job, cairo_surface_t* surface) {
+    if (!surface) {
+        if (job.complete) job.complete(fail());
+        return;
+    }
+    cairo_surface_t* owned = cairo_surface_reference(surface);
+    // The task owns the surface reference whether or not it runs.
+    auto holder = std::shared_ptr<cairo_surface_t>(owned, cairo_surface_destroy);
+    Job settings = job;
+    settings.complete = nullptr;
+    worker().post([settings, holder]() { return processSurface(settings, holder.get()); },
+                  std::move(job));
+}
+
+void submitPngBase64(Job&& job, std::string&& base64) {
+    Job settings = job;
+    settings.complete = nullptr;
+    worker().post([settings, data = std::move(base64)]() {
+        return processPngBase64(settings, data);
+    }, std::move(job));
+}
+
+void shutdown() {
+    worker().stop();
+}
+
+}  // namespace electrobun::snapshot_encoder
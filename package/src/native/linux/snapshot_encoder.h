@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../shared/webview_snapshot.h"
+
+#include <cairo.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace electrobun::snapshot_encoder {
+
+struct Result {
+    bool success = false;
+    int width = 0;
+    int height = 0;
+    // PNG/JPEG data URL. Empty for Rgba, whose pixels are in Job::outRgba.
+    std::string dataUrl;
+};
+
+// One getWebviewSnapshot request. The region is view-local and logical; an
+// empty region means the whole captured image. viewWidth/viewHeight give the
+// logical size the captured image covers so the region can be mapped onto it.
+struct Job {
+    WebviewSnapshotFormat format = WebviewSnapshotFormat::Png;
+    int quality = 90;
+    int maxWidth = 0;
+    int maxHeight = 0;
+    double regionX = 0;
+    double regionY = 0;
+    double regionWidth = 0;
+    double regionHeight = 0;
+    double viewWidth = 0;
+    double viewHeight = 0;
+    // Caller-owned destination for Rgba; must stay valid until complete runs.
+    std::uint8_t* outRgba = nullptr;
+    std::uint64_t outLen = 0;
+    // Runs exactly once: on the snapshot worker thread, or on the submitting
+    // thread if the worker has been shut down.
+    std::function<void(Result&&)> complete;
+};
+
+// Crop, downscale and encode an ARGB32/RGB24 image surface on the worker.
+// Takes its own reference; the caller keeps (and may drop) theirs.
+void submitSurface(Job&& job, cairo_surface_t* surface);
+
+// Same for a base64 PNG, as returned by DevTools Page.captureScreenshot. PNG
+// results that need no crop or downscale are forwarded without decoding.
+void submitPngBase64(Job&& job, std::string&& base64);
+
+// Stop the worker after the job in progress. Queued jobs complete with
+// failure. Safe to call more than once.
+void shutdown();
+
+}  // namespace electrobun::snapshot_encoder
@@ -19,6 +19,7 @@
 #include <cstdio>
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <new>
 #include <string>
@@ -26,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "../shared/wayland_screen_capture_damage.h"
 #include "../shared/wayland_screen_capture_frame.h"
 
 namespace electrobun::wayland_pipewire_capture {
@@ -33,6 +35,7 @@ namespace {
 
 constexpr const char* kPipeWireLibrary = "libpipewire-0.3.so.0";
 constexpr std::uint32_t kMaximumFrameExtent = 32768;
+constexpr std::int32_t kMaximumDamageRegions = 16;
 
 constexpr std::int32_t cursorMetaSize(std::uint32_t width, std::uint32_t height) {
     return static_cast<std::int32_t>(
@@ -171,8 +174,11 @@ enum class State {
     stopping,
 };
 
+// The cropped stream pixels in their negotiated byte order. Conversion to
+// RGBA happens in capture(), for the requested region only.
 struct CachedFrame {
-    std::vector<std::uint8_t> rgba;
+    std::vector<std::uint8_t> pixels;
+    WaylandScreenCapturePixelLayout layout = WaylandScreenCapturePixelLayout::rgbx;
     std::uint32_t pixelWidth = 0;
     std::uint32_t pixelHeight = 0;
     LogicalBounds logicalBounds{};
@@ -180,18 +186,18 @@ struct CachedFrame {
 
 struct CachedCursor {
     bool valid = false;
+    // Orders updates across monitor streams; the newest valid one wins.
+    std::uint64_t serial = 0;
     double logicalX = 0;
     double logicalY = 0;
     std::int32_t hotspotPixelX = 0;
     std::int32_t hotspotPixelY = 0;
 };
 
+// One monitor stream, consumed on its own PipeWire main-loop thread so a slow
+// or stalled output never delays the others.
 struct Session {
-    // start() and stop() serialize on this mutex. The worker never takes it,
-    // allowing stop() to hold it while joining the thread.
-    std::mutex controlMutex;
     std::thread worker;
-    PipeWireApi api;
     std::atomic<State> state{State::stopped};
     std::atomic<bool> stopRequested{false};
 
@@ -206,13 +212,32 @@ struct Session {
     std::mutex cacheMutex;
     CachedFrame frame;
     CachedCursor cursor;
+    WaylandScreenCaptureChangeHistory history;
+};
+
+struct Streams {
+    // start() and stop() serialize on this mutex. Workers never take it,
+    // allowing stop() to hold it while joining their threads.
+    std::mutex controlMutex;
+    PipeWireApi api;
+    bool initialized = false;
+
+    // Guards the session list. Readers hold it for the whole capture so
+    // stop() cannot destroy a session underneath them.
+    std::mutex listMutex;
+    std::vector<std::unique_ptr<Session>> sessions;
+
+    std::atomic<std::uint64_t> changeSequence{0};
+    std::atomic<std::uint64_t> cursorSerial{0};
 };
 
-Session& session() {
+constexpr std::size_t kMaximumStreams = 8;
+
+Streams& streams() {
     // Explicit shutdown occurs before the native wrapper exits. Keeping this
     // process-lifetime object alive avoids destructor-order races with dynamic
     // library teardown if an embedding application skips orderly shutdown.
-    static Session* value = new Session();
+    static Streams* value = new Streams();
     return *value;
 }
 
@@ -220,6 +245,8 @@ void clearCache(Session& capture) {
     std::lock_guard<std::mutex> lock(capture.cacheMutex);
     capture.frame = CachedFrame{};
     capture.cursor = CachedCursor{};
+    // Sequences keep counting across streams so pollers never see one reused.
+    capture.history.reset();
     capture.hasFrame.store(false, std::memory_order_release);
 }
 
@@ -232,6 +259,13 @@ struct WorkerRuntime {
     pw_stream* stream = nullptr;
     spa_hook streamListener{};
     spa_video_info_raw video{};
+    // Swapped with Session::frame on refresh so steady-state polling reuses
+    // two allocations instead of faulting in a new frame every time.
+    CachedFrame spareFrame;
+    // Damage reported since the last refresh, and the damage spareFrame has
+    // not seen yet (what the published frame received at that refresh).
+    WaylandScreenCaptureDamage pendingDamage;
+    WaylandScreenCaptureDamage spareDamage;
     bool formatReady = false;
     bool reportedUnsupportedTransform = false;
 };
@@ -245,6 +279,12 @@ void failWorker(WorkerRuntime& runtime, const char* reason) {
     if (runtime.mainLoop) runtime.api->mainLoopQuit(runtime.mainLoop);
 }
 
+WaylandScreenCapturePixelLayout pixelLayout(spa_video_format format) {
+    return format == SPA_VIDEO_FORMAT_BGRx || format == SPA_VIDEO_FORMAT_BGRA
+        ? WaylandScreenCapturePixelLayout::bgrx
+        : WaylandScreenCapturePixelLayout::rgbx;
+}
+
 int bytesPerPixel(spa_video_format format) {
     switch (format) {
         case SPA_VIDEO_FORMAT_BGRx:
@@ -305,7 +345,7 @@ void onStreamParamChanged(
     std::uint8_t storage[2048];
     spa_pod_builder builder{};
     spa_pod_builder_init(&builder, storage, sizeof(storage));
-    const spa_pod* parameters[5]{};
+    const spa_pod* parameters[6]{};
 
     parameters[0] = static_cast<const spa_pod*>(spa_pod_builder_add_object(
         &builder,
@@ -368,8 +408,23 @@ void onStreamParamChanged(
         SPA_PARAM_META_size,
         SPA_POD_Int(sizeof(spa_meta_videotransform))));
 
+    // Damage lets a refresh copy only the rectangles that changed and lets
+    // pollers skip regions that did not. Buffers without it count as fully
+    // damaged, so compositors that do not offer it behave as before.
+    parameters[5] = static_cast<const spa_pod*>(spa_pod_builder_add_object(
+        &builder,
+        SPA_TYPE_OBJECT_ParamMeta,
+        SPA_PARAM_Meta,
+        SPA_PARAM_META_type,
+        SPA_POD_Id(SPA_META_VideoDamage),
+        SPA_PARAM_META_size,
+        SPA_POD_CHOICE_RANGE_Int(
+            sizeof(spa_meta_region) * kMaximumDamageRegions,
+            sizeof(spa_meta_region),
+            sizeof(spa_meta_region) * kMaximumDamageRegions)));
+
     const int result =
-        runtime.api->streamUpdateParams(runtime.stream, parameters, 5);
+        runtime.api->streamUpdateParams(runtime.stream, parameters, 6);
     if (result < 0) {
         failWorker(runtime, "PipeWire rejected the screen buffer parameters");
         return;
@@ -524,6 +579,8 @@ void updateCursor(
 
     std::lock_guard<std::mutex> lock(capture.cacheMutex);
     capture.cursor.valid = true;
+    capture.cursor.serial =
+        streams().cursorSerial.fetch_add(1, std::memory_order_relaxed) + 1;
     capture.cursor.logicalX = logicalX;
     capture.cursor.logicalY = logicalY;
     if (hasBitmapUpdate) {
@@ -532,12 +589,19 @@ void updateCursor(
     }
 }
 
-bool copyMappedFrame(
+// The validated pixels of one PipeWire buffer, starting at the crop origin.
+struct MappedFrame {
+    const std::uint8_t* pixels = nullptr;
+    std::size_t stride = 0;
+    Crop crop;
+};
+
+bool mapFrame(
     WorkerRuntime& runtime,
     const spa_buffer* buffer,
     const Crop& crop,
-    CachedFrame* destination) {
-    if (!destination || buffer->n_datas == 0 || !buffer->datas) return false;
+    MappedFrame* mapped) {
+    if (!mapped || buffer->n_datas == 0 || !buffer->datas) return false;
     const spa_data& data = buffer->datas[0];
     const std::uint32_t chunkFlags = data.chunk
         ? static_cast<std::uint32_t>(data.chunk->flags)
@@ -581,62 +645,101 @@ bool copyMappedFrame(
         return false;
     }
 
-    std::size_t outputPixels = 0;
-    std::size_t outputBytes = 0;
-    if (!checkedMultiply(crop.width, crop.height, &outputPixels) ||
-        !checkedMultiply(outputPixels, 4, &outputBytes)) {
+    mapped->pixels = static_cast<const std::uint8_t*>(data.data) + chunkOffset +
+        static_cast<std::size_t>(crop.y) * stride +
+        static_cast<std::size_t>(crop.x) * 4;
+    mapped->stride = stride;
+    mapped->crop = crop;
+    return true;
+}
+
+bool hasFrameGeometry(
+    const WorkerRuntime& runtime,
+    const CachedFrame& frame,
+    const Crop& crop) {
+    const LogicalBounds& bounds = runtime.capture->logicalBounds;
+    return !frame.pixels.empty() && frame.pixelWidth == crop.width &&
+           frame.pixelHeight == crop.height &&
+           frame.layout == pixelLayout(runtime.video.format) &&
+           frame.logicalBounds.x == bounds.x && frame.logicalBounds.y == bounds.y &&
+           frame.logicalBounds.width == bounds.width &&
+           frame.logicalBounds.height == bounds.height;
+}
+
+bool resizeFrame(WorkerRuntime& runtime, const Crop& crop, CachedFrame* frame) {
+    std::size_t pixels = 0;
+    std::size_t bytes = 0;
+    if (!checkedMultiply(crop.width, crop.height, &pixels) ||
+        !checkedMultiply(pixels, 4, &bytes)) {
         return false;
     }
+    frame->pixels.resize(bytes);
+    frame->layout = pixelLayout(runtime.video.format);
+    frame->pixelWidth = crop.width;
+    frame->pixelHeight = crop.height;
+    frame->logicalBounds = runtime.capture->logicalBounds;
+    return true;
+}
 
-    destination->rgba.resize(outputBytes);
-    destination->pixelWidth = crop.width;
-    destination->pixelHeight = crop.height;
-    destination->logicalBounds = runtime.capture->logicalBounds;
-
-    const auto* sourceBase =
-        static_cast<const std::uint8_t*>(data.data) + chunkOffset;
-    const spa_video_format format = runtime.video.format;
-    for (std::uint32_t y = 0; y < crop.height; ++y) {
-        const auto* source = sourceBase +
-            static_cast<std::size_t>(crop.y + y) * stride +
-            static_cast<std::size_t>(crop.x) * 4;
-        auto* output = destination->rgba.data() +
-            static_cast<std::size_t>(y) * crop.width * 4;
-
-        for (std::uint32_t x = 0; x < crop.width; ++x) {
-            switch (format) {
-                case SPA_VIDEO_FORMAT_BGRx:
-                    output[0] = source[2];
-                    output[1] = source[1];
-                    output[2] = source[0];
-                    output[3] = 255;
-                    break;
-                case SPA_VIDEO_FORMAT_BGRA:
-                    output[0] = source[2];
-                    output[1] = source[1];
-                    output[2] = source[0];
-                    output[3] = 255;
-                    break;
-                case SPA_VIDEO_FORMAT_RGBx:
-                    output[0] = source[0];
-                    output[1] = source[1];
-                    output[2] = source[2];
-                    output[3] = 255;
-                    break;
-                case SPA_VIDEO_FORMAT_RGBA:
-                    output[0] = source[0];
-                    output[1] = source[1];
-                    output[2] = source[2];
-                    output[3] = 255;
-                    break;
-                default:
-                    return false;
-            }
-            source += 4;
-            output += 4;
-        }
+void copyFrameRect(
+    const MappedFrame& source,
+    const WaylandScreenCapturePixelRect& rect,
+    CachedFrame* destination) {
+    const std::uint32_t right = std::min(rect.x + rect.width, destination->pixelWidth);
+    const std::uint32_t bottom = std::min(rect.y + rect.height, destination->pixelHeight);
+    if (right <= rect.x || bottom <= rect.y) return;
+
+    const std::size_t rowBytes = static_cast<std::size_t>(destination->pixelWidth) * 4;
+    const std::size_t copyBytes = static_cast<std::size_t>(right - rect.x) * 4;
+    const std::uint8_t* from = source.pixels +
+        static_cast<std::size_t>(rect.y) * source.stride +
+        static_cast<std::size_t>(rect.x) * 4;
+    std::uint8_t* to = destination->pixels.data() +
+        static_cast<std::size_t>(rect.y) * rowBytes +
+        static_cast<std::size_t>(rect.x) * 4;
+    const std::uint32_t rows = bottom - rect.y;
+    if (copyBytes == rowBytes && source.stride == rowBytes) {
+        std::memcpy(to, from, copyBytes * rows);
+        return;
+    }
+    for (std::uint32_t y = 0; y < rows; ++y) {
+        std::memcpy(to + y * rowBytes, from + y * source.stride, copyBytes);
+    }
+}
+
+// Record what a dequeued buffer changed, whether or not it is copied.
+void accumulateDamage(WorkerRuntime& runtime, const spa_buffer* buffer) {
+    if (!runtime.formatReady || !buffer || buffer->n_datas == 0 ||
+        !buffer->datas || !buffer->datas[0].chunk) {
+        return;
+    }
+    // Cursor-only updates arrive as empty buffers and change no pixels.
+    const spa_chunk* chunk = buffer->datas[0].chunk;
+    if (chunk->size == 0 ||
+        (static_cast<std::uint32_t>(chunk->flags) & SPA_CHUNK_FLAG_EMPTY) != 0) {
+        return;
+    }
+
+    const Crop crop = getCrop(runtime, buffer);
+    spa_meta* metadata = spa_buffer_find_meta(buffer, SPA_META_VideoDamage);
+    if (!metadata || !metadata->data || metadata->size < sizeof(spa_meta_region)) {
+        runtime.pendingDamage.addFull(crop.width, crop.height);
+        return;
+    }
+    // Regions are in buffer pixels; a zero-sized region ends the list.
+    spa_meta_region* region = nullptr;
+    spa_meta_for_each(region, metadata) {
+        if (!spa_meta_region_is_valid(region)) break;
+        runtime.pendingDamage.add(
+            region->region.position.x,
+            region->region.position.y,
+            region->region.size.width,
+            region->region.size.height,
+            crop.x,
+            crop.y,
+            crop.width,
+            crop.height);
     }
-    return true;
 }
 
 void processBuffer(WorkerRuntime& runtime, spa_buffer* buffer) {
@@ -647,34 +750,61 @@ void processBuffer(WorkerRuntime& runtime, spa_buffer* buffer) {
 
     Session& capture = *runtime.capture;
     if (transformUnsupported) {
+        runtime.pendingDamage.addFull(crop.width, crop.height);
         capture.hasFrame.store(false, std::memory_order_release);
         return;
     }
 
+    const bool hasFrame = capture.hasFrame.load(std::memory_order_acquire);
     const bool shouldRefresh =
         capture.refreshRequested.exchange(false, std::memory_order_acq_rel) ||
-        !capture.hasFrame.load(std::memory_order_acquire);
+        !hasFrame;
     if (!shouldRefresh) return;
 
-    CachedFrame nextFrame;
-    if (!copyMappedFrame(runtime, buffer, crop, &nextFrame)) {
+    CachedFrame& nextFrame = runtime.spareFrame;
+    if (!hasFrameGeometry(runtime, nextFrame, crop)) {
+        runtime.pendingDamage.addFull(crop.width, crop.height);
+        runtime.spareDamage.addFull(crop.width, crop.height);
+    }
+    // Nothing changed since the published frame; keep it.
+    if (hasFrame && runtime.pendingDamage.empty()) return;
+
+    MappedFrame mapped;
+    if (!mapFrame(runtime, buffer, crop, &mapped) ||
+        (runtime.spareDamage.full() && !resizeFrame(runtime, crop, &nextFrame))) {
         // Retry on a later PipeWire buffer. A previous valid cache remains
         // usable while a transient malformed/corrupt buffer is skipped.
         capture.refreshRequested.store(true, std::memory_order_release);
         return;
     }
 
+    // The spare frame is one refresh behind: bring it up to date with both
+    // what it missed last time and what changed since.
+    WaylandScreenCaptureDamage copyDamage = runtime.spareDamage;
+    copyDamage.merge(runtime.pendingDamage);
+    for (const auto& rect : copyDamage.rects()) {
+        copyFrameRect(mapped, rect, &nextFrame);
+    }
+
     {
         std::lock_guard<std::mutex> lock(capture.cacheMutex);
-        capture.frame = std::move(nextFrame);
+        std::swap(capture.frame, nextFrame);
+        if (!runtime.pendingDamage.empty()) {
+            capture.history.record(
+                runtime.pendingDamage,
+                streams().changeSequence.fetch_add(1, std::memory_order_relaxed) + 1);
+        }
         capture.hasFrame.store(true, std::memory_order_release);
     }
+    runtime.spareDamage = runtime.pendingDamage;
+    runtime.pendingDamage.clear();
 }
 
 void onStreamProcess(void* userData) {
     auto& runtime = *static_cast<WorkerRuntime*>(userData);
     pw_buffer* latest = nullptr;
     while (pw_buffer* next = runtime.api->streamDequeueBuffer(runtime.stream)) {
+        accumulateDamage(runtime, next->buffer);
         if (latest) runtime.api->streamQueueBuffer(runtime.stream, latest);
         latest = next;
     }
@@ -749,7 +879,7 @@ const spa_pod* buildFormatParameter(
 void workerMain(Session* capture, int portalFd) {
     WorkerRuntime runtime{
         .capture = capture,
-        .api = &capture->api,
+        .api = &streams().api,
     };
     bool pipeWireOwnsFd = false;
 
@@ -871,15 +1001,18 @@ bool validateCaptureArguments(
     double y,
     std::uint32_t width,
     std::uint32_t height,
+    std::uint32_t outputWidth,
+    std::uint32_t outputHeight,
     std::uint8_t* output,
     std::uint64_t outputLength,
     std::int64_t* left,
     std::int64_t* top) {
     if (!output || !left || !top || width == 0 || height == 0 ||
-        !std::isfinite(x) || !std::isfinite(y)) {
+        outputWidth == 0 || outputHeight == 0 || outputWidth > width ||
+        outputHeight > height || !std::isfinite(x) || !std::isfinite(y)) {
         return false;
     }
-    const std::uint64_t pixels = static_cast<std::uint64_t>(width) * height;
+    const std::uint64_t pixels = static_cast<std::uint64_t>(outputWidth) * outputHeight;
     if (pixels > std::numeric_limits<std::uint64_t>::max() / 4 ||
         outputLength != pixels * 4 ||
         outputLength > std::numeric_limits<std::size_t>::max()) {
@@ -911,71 +1044,145 @@ bool start(
         return false;
     }
 
-    Session& capture = session();
-    std::lock_guard<std::mutex> controlLock(capture.controlMutex);
-    if (capture.state.load(std::memory_order_acquire) != State::stopped ||
-        capture.worker.joinable()) {
-        close(portalFd);
-        return false;
+    Streams& all = streams();
+    std::lock_guard<std::mutex> controlLock(all.controlMutex);
+    {
+        std::lock_guard<std::mutex> listLock(all.listMutex);
+        const bool duplicate = std::any_of(
+            all.sessions.begin(), all.sessions.end(),
+            [nodeId](const std::unique_ptr<Session>& existing) {
+                return existing->nodeId == nodeId;
+            });
+        if (duplicate || all.sessions.size() >= kMaximumStreams) {
+            close(portalFd);
+            return false;
+        }
     }
 
-    if (!capture.api.load()) {
-        close(portalFd);
-        return false;
+    if (!all.initialized) {
+        if (!all.api.load()) {
+            close(portalFd);
+            return false;
+        }
+        all.api.init(nullptr, nullptr);
+        all.initialized = true;
     }
-    capture.api.init(nullptr, nullptr);
-    capture.logicalBounds = logicalBounds;
-    capture.nodeId = nodeId;
-    capture.stopRequested.store(false, std::memory_order_release);
-    capture.refreshRequested.store(true, std::memory_order_release);
-    capture.state.store(State::starting, std::memory_order_release);
-    clearCache(capture);
+
+    auto capture = std::make_unique<Session>();
+    capture->logicalBounds = logicalBounds;
+    capture->nodeId = nodeId;
+    capture->state.store(State::starting, std::memory_order_release);
 
     try {
-        capture.worker = std::thread(workerMain, &capture, portalFd);
+        capture->worker = std::thread(workerMain, capture.get(), portalFd);
     } catch (...) {
-        capture.state.store(State::stopped, std::memory_order_release);
-        capture.api.deinit();
-        capture.api.unload();
         close(portalFd);
         return false;
     }
+    std::lock_guard<std::mutex> listLock(all.listMutex);
+    all.sessions.push_back(std::move(capture));
     return true;
 }
 
 void stop() {
-    Session& capture = session();
-    std::lock_guard<std::mutex> controlLock(capture.controlMutex);
-    if (!capture.worker.joinable()) {
-        clearCache(capture);
-        capture.state.store(State::stopped, std::memory_order_release);
-        return;
+    Streams& all = streams();
+    std::lock_guard<std::mutex> controlLock(all.controlMutex);
+    std::vector<std::unique_ptr<Session>> stopping;
+    {
+        std::lock_guard<std::mutex> listLock(all.listMutex);
+        stopping.swap(all.sessions);
     }
 
-    capture.state.store(State::stopping, std::memory_order_release);
-    capture.stopRequested.store(true, std::memory_order_release);
-    {
-        std::lock_guard<std::mutex> lock(capture.runtimeMutex);
-        if (capture.runtimeMainLoop) {
-            capture.api.mainLoopQuit(capture.runtimeMainLoop);
+    // Ask every worker to quit before joining any, so shutdown takes as long
+    // as the slowest stream rather than the sum of them.
+    for (auto& capture : stopping) {
+        capture->state.store(State::stopping, std::memory_order_release);
+        capture->stopRequested.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(capture->runtimeMutex);
+        if (capture->runtimeMainLoop) {
+            all.api.mainLoopQuit(capture->runtimeMainLoop);
         }
     }
-    capture.worker.join();
-    capture.api.deinit();
-    capture.api.unload();
-    clearCache(capture);
-    capture.state.store(State::stopped, std::memory_order_release);
+    for (auto& capture : stopping) {
+        if (capture->worker.joinable()) capture->worker.join();
+    }
+    stopping.clear();
+
+    if (all.initialized) {
+        all.api.deinit();
+        all.api.unload();
+        all.initialized = false;
+    }
 }
 
 bool hasFailed() {
-    return session().state.load(std::memory_order_acquire) == State::failed;
+    Streams& all = streams();
+    std::lock_guard<std::mutex> listLock(all.listMutex);
+    return !all.sessions.empty() && std::all_of(
+        all.sessions.begin(), all.sessions.end(),
+        [](const std::unique_ptr<Session>& capture) {
+            return capture->state.load(std::memory_order_acquire) == State::failed;
+        });
 }
 
+namespace {
+
+// Split a logical region across the running streams. Callers hold listMutex.
+bool planRegion(
+    const Streams& all,
+    std::int64_t left,
+    std::int64_t top,
+    std::uint32_t width,
+    std::uint32_t height,
+    std::vector<WaylandScreenCaptureStitchPiece>* pieces) {
+    std::vector<WaylandScreenCaptureLogicalBounds> bounds;
+    bounds.reserve(all.sessions.size());
+    for (const auto& capture : all.sessions) {
+        bounds.push_back({
+            .x = capture->logicalBounds.x,
+            .y = capture->logicalBounds.y,
+            .width = capture->logicalBounds.width,
+            .height = capture->logicalBounds.height,
+        });
+    }
+    return planWaylandScreenCaptureStitch(
+        bounds.data(),
+        bounds.size(),
+        WaylandScreenCaptureRegion{
+            .x = left,
+            .y = top,
+            .width = width,
+            .height = height,
+        },
+        pieces);
+}
+
+WaylandScreenCaptureFrameView frameView(const CachedFrame& frame) {
+    return WaylandScreenCaptureFrameView{
+        .pixels = frame.pixels.data(),
+        .byte_length = frame.pixels.size(),
+        .pixel_width = frame.pixelWidth,
+        .pixel_height = frame.pixelHeight,
+        .row_stride = static_cast<std::size_t>(frame.pixelWidth) * 4,
+        .logical_bounds = {
+            .x = frame.logicalBounds.x,
+            .y = frame.logicalBounds.y,
+            .width = frame.logicalBounds.width,
+            .height = frame.logicalBounds.height,
+        },
+        .layout = frame.layout,
+    };
+}
+
+}  // namespace
+
 bool capture(
     double x,
     double y,
     std::uint32_t width,
     std::uint32_t height,
+    std::uint32_t outputWidth,
+    std::uint32_t outputHeight,
     std::uint8_t* outRgba,
     std::uint64_t outLen) {
     std::int64_t left = 0;
@@ -985,6 +1192,8 @@ bool capture(
             y,
             width,
             height,
+            outputWidth,
+            outputHeight,
             outRgba,
             outLen,
             &left,
@@ -992,49 +1201,146 @@ bool capture(
         return false;
     }
 
-    Session& captureSession = session();
-    captureSession.refreshRequested.store(true, std::memory_order_release);
-    if (!captureSession.hasFrame.load(std::memory_order_acquire)) return false;
+    Streams& all = streams();
+    std::lock_guard<std::mutex> listLock(all.listMutex);
+    std::vector<WaylandScreenCaptureStitchPiece> pieces;
+    if (!planRegion(all, left, top, width, height, &pieces)) return false;
+
+    // A region on a failed monitor fails; the other monitors keep working.
+    bool ready = true;
+    for (const auto& piece : pieces) {
+        Session& captureSession = *all.sessions[piece.frame_index];
+        if (captureSession.state.load(std::memory_order_acquire) == State::failed) return false;
+        captureSession.refreshRequested.store(true, std::memory_order_release);
+        ready = ready && captureSession.hasFrame.load(std::memory_order_acquire);
+    }
+    if (!ready) return false;
+
+    // Each monitor fills its own columns/rows of the caller's buffer.
+    const std::size_t outputStride = static_cast<std::size_t>(outputWidth) * 4;
+    const bool downscale = outputWidth != width || outputHeight != height;
+    for (const auto& piece : pieces) {
+        if (downscale) {
+            // A monitor's share of the output is its share of the region,
+            // with edges computed the same way so neighbours tile exactly.
+            const auto outputEdge = [](std::int64_t offset, std::uint32_t extent,
+                                       std::uint32_t outputExtent) {
+                return static_cast<std::uint32_t>(
+                    static_cast<std::uint64_t>(offset) * outputExtent / extent);
+            };
+            const std::uint32_t outputLeft =
+                outputEdge(piece.region.x - left, width, outputWidth);
+            const std::uint32_t outputTop =
+                outputEdge(piece.region.y - top, height, outputHeight);
+            const std::uint32_t outputRight = outputEdge(
+                piece.region.x + piece.region.width - left, width, outputWidth);
+            const std::uint32_t outputBottom = outputEdge(
+                piece.region.y + piece.region.height - top, height, outputHeight);
+            if (outputRight <= outputLeft || outputBottom <= outputTop) continue;
+
+            Session& captureSession = *all.sessions[piece.frame_index];
+            const std::size_t offset =
+                static_cast<std::size_t>(outputTop) * outputStride +
+                static_cast<std::size_t>(outputLeft) * 4;
+            std::lock_guard<std::mutex> lock(captureSession.cacheMutex);
+            if (captureSession.frame.pixels.empty() ||
+                !downscaleWaylandScreenCaptureRegion(
+                    frameView(captureSession.frame),
+                    piece.region,
+                    outputRight - outputLeft,
+                    outputBottom - outputTop,
+                    outRgba + offset,
+                    outputStride,
+                    static_cast<std::size_t>(outLen) - offset)) {
+                return false;
+            }
+            continue;
+        }
 
-    std::lock_guard<std::mutex> lock(captureSession.cacheMutex);
-    if (captureSession.frame.rgba.empty()) return false;
-    const WaylandScreenCaptureFrameView frameView{
-        .rgba = captureSession.frame.rgba.data(),
-        .byte_length = captureSession.frame.rgba.size(),
-        .pixel_width = captureSession.frame.pixelWidth,
-        .pixel_height = captureSession.frame.pixelHeight,
-        .row_stride =
-            static_cast<std::size_t>(captureSession.frame.pixelWidth) * 4,
-        .logical_bounds = {
-            .x = captureSession.frame.logicalBounds.x,
-            .y = captureSession.frame.logicalBounds.y,
-            .width = captureSession.frame.logicalBounds.width,
-            .height = captureSession.frame.logicalBounds.height,
-        },
-    };
-    const WaylandScreenCaptureRegion region{
-        .x = left,
-        .y = top,
-        .width = width,
-        .height = height,
-    };
-    return copyWaylandScreenCaptureRegion(
-        frameView,
-        region,
-        outRgba,
-        static_cast<std::size_t>(outLen));
+        Session& captureSession = *all.sessions[piece.frame_index];
+        const std::size_t offset =
+            static_cast<std::size_t>(piece.region.y - top) * outputStride +
+            static_cast<std::size_t>(piece.region.x - left) * 4;
+        std::lock_guard<std::mutex> lock(captureSession.cacheMutex);
+        if (captureSession.frame.pixels.empty() ||
+            !copyWaylandScreenCaptureRegionWithStride(
+                frameView(captureSession.frame),
+                piece.region,
+                outRgba + offset,
+                outputStride,
+                static_cast<std::size_t>(outLen) - offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t changeSequence(
+    double x,
+    double y,
+    std::uint32_t width,
+    std::uint32_t height) {
+    if (width == 0 || height == 0 || !std::isfinite(x) || !std::isfinite(y) ||
+        std::floor(x) < static_cast<double>(std::numeric_limits<std::int32_t>::min()) ||
+        std::floor(x) > static_cast<double>(std::numeric_limits<std::int32_t>::max()) ||
+        std::floor(y) < static_cast<double>(std::numeric_limits<std::int32_t>::min()) ||
+        std::floor(y) > static_cast<double>(std::numeric_limits<std::int32_t>::max())) {
+        return 0;
+    }
+    const std::int64_t left = static_cast<std::int64_t>(std::floor(x));
+    const std::int64_t top = static_cast<std::int64_t>(std::floor(y));
+
+    Streams& all = streams();
+    std::lock_guard<std::mutex> listLock(all.listMutex);
+    std::vector<WaylandScreenCaptureStitchPiece> pieces;
+    if (!planRegion(all, left, top, width, height, &pieces)) return 0;
+
+    std::uint64_t latest = 0;
+    for (const auto& piece : pieces) {
+        Session& captureSession = *all.sessions[piece.frame_index];
+        if (captureSession.state.load(std::memory_order_acquire) == State::failed) return 0;
+        // Asking counts as demand: the next buffer's damage is applied and
+        // recorded, so a poller that skips capture() still sees later changes.
+        captureSession.refreshRequested.store(true, std::memory_order_release);
+        if (!captureSession.hasFrame.load(std::memory_order_acquire)) return 0;
+
+        std::lock_guard<std::mutex> lock(captureSession.cacheMutex);
+        const CachedFrame& frame = captureSession.frame;
+        WaylandScreenCapturePixelRect rect{};
+        if (frame.pixels.empty() ||
+            !mapWaylandScreenCaptureRegionToPixels(
+                frameView(frame).logical_bounds,
+                frame.pixelWidth,
+                frame.pixelHeight,
+                piece.region,
+                &rect)) {
+            return 0;
+        }
+        const std::uint64_t changed = captureSession.history.lastChange(rect);
+        if (changed == 0) return 0;
+        latest = std::max(latest, changed);
+    }
+    return latest;
 }
 
 bool getCursorPoint(CursorPoint* point) {
     if (!point) return false;
-    Session& capture = session();
-    std::lock_guard<std::mutex> lock(capture.cacheMutex);
-    if (!capture.cursor.valid) return false;
-    point->logicalX = capture.cursor.logicalX;
-    point->logicalY = capture.cursor.logicalY;
-    point->hotspotPixelX = capture.cursor.hotspotPixelX;
-    point->hotspotPixelY = capture.cursor.hotspotPixelY;
-    return true;
+    Streams& all = streams();
+    std::lock_guard<std::mutex> listLock(all.listMutex);
+    bool found = false;
+    std::uint64_t newest = 0;
+    for (const auto& captureSession : all.sessions) {
+        std::lock_guard<std::mutex> lock(captureSession->cacheMutex);
+        const CachedCursor& cursor = captureSession->cursor;
+        if (!cursor.valid || (found && cursor.serial < newest)) continue;
+        found = true;
+        newest = cursor.serial;
+        point->logicalX = cursor.logicalX;
+        point->logicalY = cursor.logicalY;
+        point->hotspotPixelX = cursor.hotspotPixelX;
+        point->hotspotPixelY = cursor.hotspotPixelY;
+    }
+    return found;
 }
 
 }  // namespace electrobun::wayland_pipewire_capture
@@ -1059,11 +1365,17 @@ bool capture(
     double,
     std::uint32_t,
     std::uint32_t,
+    std::uint32_t,
+    std::uint32_t,
     std::uint8_t*,
     std::uint64_t) {
     return false;
 }
 
+std::uint64_t changeSequence(double, double, std::uint32_t, std::uint32_t) {
+    return 0;
+}
+
 bool getCursorPoint(CursorPoint*) {
     return false;
 }
@@ -14,7 +14,7 @@ struct LogicalBounds {
 struct CursorPoint {
     // Portal-global compositor logical coordinates. PipeWire cursor metadata
     // is expressed in stream pixels; the capture backend maps it through the
-    // selected monitor's logical bounds before exposing it here.
+    // reporting monitor's logical bounds before exposing it here.
     double logicalX;
     double logicalY;
 
@@ -25,40 +25,57 @@ struct CursorPoint {
     std::int32_t hotspotPixelY;
 };
 
-// Start consuming one ScreenCast portal stream on a private PipeWire main-loop
-// thread. Ownership of portalFd is transferred on entry, including when this
-// function returns false. The current implementation supports one monitor
-// stream with an untransformed, packed, CPU-mappable raw-video buffer.
+// Start consuming one ScreenCast portal stream on its own PipeWire main-loop
+// thread. Call once per monitor of a portal session, each with its own
+// OpenPipeWireRemote fd; streams start independently of each other. Ownership
+// of portalFd is transferred on entry, including when this function returns
+// false. Streams must be untransformed, packed, CPU-mappable raw video.
 bool start(
     int portalFd,
     std::uint32_t nodeId,
     const LogicalBounds& logicalBounds);
 
-// Stop the stream thread and release all cached pixels/cursor state. Safe to
-// call more than once, but not from a PipeWire callback.
+// Stop every stream thread and release all cached pixels/cursor state. Safe
+// to call more than once, but not from a PipeWire callback.
 void stop();
 
-// Report an asynchronous stream/worker failure after start() has returned.
-// This lets the portal owner close its session instead of polling a stream that
-// can no longer produce frames.
+// Report that every stream has failed asynchronously after start() returned,
+// so the portal owner can close a session that can no longer produce frames.
+// While some monitors still stream, capture() and changeSequence() fail only
+// for regions that touch a failed one.
 bool hasFailed();
 
-// Copy one RGBA output pixel per compositor logical coordinate. This also
-// requests that the next available PipeWire frame refresh the full-frame
-// cache, limiting expensive frame conversion to consumer demand.
+// Copy one RGBA output pixel per compositor logical coordinate. Regions that
+// span monitors are stitched from each stream; gaps between monitors fail. The cache
+// keeps the stream's own byte order and only the requested region is
+// converted. This also requests that the next PipeWire frame refresh the
+// cache, so frame copies follow consumer demand. An output size smaller than
+// the region box-filters the cached device pixels down to it instead.
 bool capture(
     double x,
     double y,
     std::uint32_t width,
     std::uint32_t height,
+    std::uint32_t outputWidth,
+    std::uint32_t outputHeight,
     std::uint8_t* outRgba,
     std::uint64_t outLen);
 
-// Return the last compositor-owned cursor position reported for the selected
-// monitor. Cursor metadata uses id == 0 to mean "no new data", so the last
-// position remains cached across those buffers. False means no valid cursor
+// Return the sequence number of the last cache update that changed any pixel
+// of the logical region, from the compositor's damage metadata. A poller can
+// skip capture() while this stays the same. 0 means unknown (no frame yet, or
+// the region is outside the stream). Like capture(), this requests a refresh.
+std::uint64_t changeSequence(
+    double x,
+    double y,
+    std::uint32_t width,
+    std::uint32_t height);
+
+// Return the newest compositor-owned cursor position reported by any stream.
+// Cursor metadata uses id == 0 to mean "no new data", so the last position
+// remains cached across those buffers. False means no valid cursor
 // position has arrived, an unsupported transform was reported, or an explicit
-// position update placed the pointer outside the selected stream.
+// position update placed the pointer outside every stream.
 bool getCursorPoint(CursorPoint* point);
 
 }  // namespace electrobun::wayland_pipewire_capture
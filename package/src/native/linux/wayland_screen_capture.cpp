@@ -16,6 +16,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <unistd.h>
 
@@ -75,7 +76,11 @@ struct CaptureSession {
     RequestKind pendingRequest = RequestKind::none;
     std::string pendingRequestPath;
     std::string sessionPath;
-    PortalStream stream;
+    // One entry per monitor the user shared. Each gets its own PipeWire
+    // remote and worker; remotes are opened concurrently.
+    std::vector<PortalStream> streams;
+    size_t pendingRemotes = 0;
+    size_t startedStreams = 0;
     uint32_t cursorMode = 0;
 };
 
@@ -369,20 +374,44 @@ void callPortalRequest(
 
 void requestSelectSources(CaptureSession& capture);
 void requestStartSession(CaptureSession& capture);
-void openPipeWireRemote(CaptureSession& capture);
+void openPipeWireRemotes(CaptureSession& capture);
+
+struct RemoteContext {
+    CaptureSession* capture = nullptr;
+    PortalStream stream;
+};
+
+// Called once per shared monitor. Capture starts with the first stream to
+// come up; a monitor whose remote fails is logged and left out unless none
+// of them start.
+void finishRemote(CaptureSession& capture, bool started) {
+    bool allFailed = false;
+    {
+        std::lock_guard<std::mutex> lock(capture.stateMutex);
+        if (capture.pendingRemotes > 0) --capture.pendingRemotes;
+        if (started) ++capture.startedStreams;
+        allFailed = capture.pendingRemotes == 0 && capture.startedStreams == 0;
+    }
+    if (allFailed) {
+        markFailed(capture, "no shared monitor produced a PipeWire stream");
+    }
+}
 
 void onPipeWireRemoteOpened(
     GObject* source,
     GAsyncResult* result,
     gpointer userData) {
-    auto& capture = *static_cast<CaptureSession*>(userData);
+    std::unique_ptr<RemoteContext> context(static_cast<RemoteContext*>(userData));
+    auto& capture = *context->capture;
     GError* error = nullptr;
     GUnixFDList* fdList = nullptr;
     GVariant* reply = g_dbus_connection_call_with_unix_fd_list_finish(
         G_DBUS_CONNECTION(source), &fdList, result, &error);
     if (!reply) {
         if (fdList) g_object_unref(fdList);
-        markFailed(capture, "could not open the portal PipeWire remote", error);
+        logError("could not open the portal PipeWire remote", error);
+        if (error) g_error_free(error);
+        finishRemote(capture, false);
         return;
     }
 
@@ -391,27 +420,29 @@ void onPipeWireRemoteOpened(
     g_variant_unref(reply);
     if (!fdList || fdIndex < 0) {
         if (fdList) g_object_unref(fdList);
-        markFailed(capture, "portal returned no PipeWire file descriptor");
+        logMessage("portal returned no PipeWire file descriptor");
+        finishRemote(capture, false);
         return;
     }
 
     const int fd = g_unix_fd_list_get(fdList, fdIndex, &error);
     g_object_unref(fdList);
     if (fd < 0) {
-        markFailed(capture, "could not duplicate the portal PipeWire fd", error);
+        logError("could not duplicate the portal PipeWire fd", error);
+        if (error) g_error_free(error);
+        finishRemote(capture, false);
         return;
     }
 
-    PortalStream stream;
     {
         std::lock_guard<std::mutex> lock(capture.stateMutex);
         if (isTerminalState(capture.state)) {
             close(fd);
             return;
         }
-        stream = capture.stream;
     }
 
+    const PortalStream& stream = context->stream;
     const wayland_pipewire_capture::LogicalBounds bounds{
         .x = stream.logicalX,
         .y = stream.logicalY,
@@ -420,87 +451,101 @@ void onPipeWireRemoteOpened(
     };
     // start() takes ownership of fd, including when startup fails.
     if (!wayland_pipewire_capture::start(fd, stream.nodeId, bounds)) {
-        markFailed(capture, "could not start the PipeWire capture stream");
+        logMessage("could not start a PipeWire capture stream");
+        finishRemote(capture, false);
         return;
     }
 
+    bool first = false;
     {
         std::lock_guard<std::mutex> lock(capture.stateMutex);
         if (isTerminalState(capture.state)) {
             stopCaptureStream();
             return;
         }
+        first = capture.state != CaptureState::streaming;
         capture.state = CaptureState::streaming;
     }
-    logMessage("monitor sharing approved; awaiting the first PipeWire frame");
+    finishRemote(capture, true);
+    if (first) {
+        logMessage("monitor sharing approved; awaiting the first PipeWire frame");
+    }
 }
 
-void openPipeWireRemote(CaptureSession& capture) {
+void openPipeWireRemotes(CaptureSession& capture) {
+    std::vector<PortalStream> streams;
     {
         std::lock_guard<std::mutex> lock(capture.stateMutex);
         if (isTerminalState(capture.state)) return;
         capture.state = CaptureState::opening_remote;
+        capture.pendingRemotes = capture.streams.size();
+        capture.startedStreams = 0;
+        streams = capture.streams;
     }
 
-    GVariantBuilder options;
-    g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
-    g_dbus_connection_call_with_unix_fd_list(
-        capture.connection,
-        kPortalBusName,
-        kPortalObjectPath,
-        kScreenCastInterface,
-        "OpenPipeWireRemote",
-        g_variant_new(
-            "(o@a{sv})",
-            capture.sessionPath.c_str(),
-            finishOptions(&options)),
-        G_VARIANT_TYPE("(h)"),
-        G_DBUS_CALL_FLAGS_NONE,
-        -1,
-        nullptr,
-        capture.cancellable,
-        onPipeWireRemoteOpened,
-        &capture);
+    // Each OpenPipeWireRemote call returns a fresh connection, so every
+    // monitor's worker owns its fd and all of them negotiate in parallel.
+    for (const PortalStream& stream : streams) {
+        GVariantBuilder options;
+        g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
+        g_dbus_connection_call_with_unix_fd_list(
+            capture.connection,
+            kPortalBusName,
+            kPortalObjectPath,
+            kScreenCastInterface,
+            "OpenPipeWireRemote",
+            g_variant_new(
+                "(o@a{sv})",
+                capture.sessionPath.c_str(),
+                finishOptions(&options)),
+            G_VARIANT_TYPE("(h)"),
+            G_DBUS_CALL_FLAGS_NONE,
+            -1,
+            nullptr,
+            capture.cancellable,
+            onPipeWireRemoteOpened,
+            new RemoteContext{&capture, stream});
+    }
 }
 
-bool parseFirstStream(GVariant* results, PortalStream* stream) {
+bool parseStreams(GVariant* results, std::vector<PortalStream>* parsed) {
     GVariant* streams = g_variant_lookup_value(
         results, "streams", G_VARIANT_TYPE("a(ua{sv})"));
     if (!streams) return false;
 
+    parsed->clear();
     GVariantIter iterator;
     g_variant_iter_init(&iterator, streams);
     guint32 nodeId = 0;
     GVariant* properties = nullptr;
-    const bool found =
-        g_variant_iter_next(&iterator, "(u@a{sv})", &nodeId, &properties);
-    g_variant_unref(streams);
-    if (!found || !properties) return false;
-
-    gint32 x = 0;
-    gint32 y = 0;
-    gint32 width = 0;
-    gint32 height = 0;
-    const bool hasPosition =
-        g_variant_lookup(properties, "position", "(ii)", &x, &y);
-    const bool hasSize =
-        g_variant_lookup(properties, "size", "(ii)", &width, &height);
-
-    g_variant_unref(properties);
-
-    if (!hasPosition || !hasSize || width <= 0 || height <= 0) {
-        logMessage(
-            "portal stream omitted the monitor position/size needed for "
-            "logical coordinate mapping");
-        return false;
+    while (g_variant_iter_next(&iterator, "(u@a{sv})", &nodeId, &properties)) {
+        gint32 x = 0;
+        gint32 y = 0;
+        gint32 width = 0;
+        gint32 height = 0;
+        const bool hasPosition =
+            g_variant_lookup(properties, "position", "(ii)", &x, &y);
+        const bool hasSize =
+            g_variant_lookup(properties, "size", "(ii)", &width, &height);
+        g_variant_unref(properties);
+        properties = nullptr;
+
+        if (!hasPosition || !hasSize || width <= 0 || height <= 0) {
+            logMessage(
+                "portal stream omitted the monitor position/size needed for "
+                "logical coordinate mapping");
+            continue;
+        }
+        parsed->push_back(PortalStream{
+            .nodeId = nodeId,
+            .logicalX = x,
+            .logicalY = y,
+            .logicalWidth = width,
+            .logicalHeight = height,
+        });
     }
-
-    stream->nodeId = nodeId;
-    stream->logicalX = x;
-    stream->logicalY = y;
-    stream->logicalWidth = width;
-    stream->logicalHeight = height;
-    return true;
+    g_variant_unref(streams);
+    return !parsed->empty();
 }
 
 void requestSelectSources(CaptureSession& capture) {
@@ -515,7 +560,9 @@ void requestSelectSources(CaptureSession& capture) {
     g_variant_builder_init(&options, G_VARIANT_TYPE_VARDICT);
     addStringOption(&options, "handle_token", token);
     addUintOption(&options, "types", 1);  // MONITOR
-    addBoolOption(&options, "multiple", false);
+    // Share every monitor the user picks; captures spanning them are
+    // stitched from one stream per monitor.
+    addBoolOption(&options, "multiple", true);
     if (capture.cursorMode != 0) {
         addUintOption(&options, "cursor_mode", capture.cursorMode);
     }
@@ -635,13 +682,20 @@ void onRequestResponse(
             requestStartSession(capture);
             return;
         case RequestKind::start_session:
-            if (!results || !parseFirstStream(results, &capture.stream)) {
-                if (results) g_variant_unref(results);
-                markFailed(capture, "portal returned no mappable monitor stream");
-                return;
+            {
+                std::vector<PortalStream> streams;
+                if (!results || !parseStreams(results, &streams)) {
+                    if (results) g_variant_unref(results);
+                    markFailed(capture, "portal returned no mappable monitor stream");
+                    return;
+                }
+                g_variant_unref(results);
+                {
+                    std::lock_guard<std::mutex> lock(capture.stateMutex);
+                    capture.streams = std::move(streams);
+                }
             }
-            g_variant_unref(results);
-            openPipeWireRemote(capture);
+            openPipeWireRemotes(capture);
             return;
         case RequestKind::none:
             break;
@@ -751,6 +805,8 @@ bool captureRegion(
     double y,
     uint32_t width,
     uint32_t height,
+    uint32_t outputWidth,
+    uint32_t outputHeight,
     uint8_t* outRgba,
     uint64_t outLen) {
     CaptureSession& capture = session();
@@ -761,11 +817,25 @@ bool captureRegion(
         if (capture.state != CaptureState::streaming) return false;
     }
     if (wayland_pipewire_capture::hasFailed()) {
-        markFailed(capture, "the PipeWire capture stream stopped unexpectedly");
+        markFailed(capture, "every PipeWire capture stream stopped unexpectedly");
         return false;
     }
     return wayland_pipewire_capture::capture(
-        x, y, width, height, outRgba, outLen);
+        x, y, width, height, outputWidth, outputHeight, outRgba, outLen);
+}
+
+uint64_t regionChangeSequence(
+    double x,
+    double y,
+    uint32_t width,
+    uint32_t height) {
+    CaptureSession& capture = session();
+    {
+        std::lock_guard<std::mutex> lock(capture.stateMutex);
+        if (capture.state != CaptureState::streaming) return 0;
+    }
+    if (wayland_pipewire_capture::hasFailed()) return 0;
+    return wayland_pipewire_capture::changeSequence(x, y, width, height);
 }
 
 bool getCursorScreenPoint(double* x, double* y) {
@@ -835,11 +905,17 @@ bool captureRegion(
     double,
     uint32_t,
     uint32_t,
+    uint32_t,
+    uint32_t,
     uint8_t*,
     uint64_t) {
     return false;
 }
 
+uint64_t regionChangeSequence(double, double, uint32_t, uint32_t) {
+    return 0;
+}
+
 bool getCursorScreenPoint(double*, double*) {
     return false;
 }
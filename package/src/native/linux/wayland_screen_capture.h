@@ -11,24 +11,37 @@ bool isWaylandSession();
 
 // Capture one RGBA pixel for each logical desktop coordinate in the requested
 // rectangle. On Wayland, the first call starts the asynchronous ScreenCast
-// portal flow and returns false until the user has approved a monitor and the
-// first frame has arrived. Cancellation and setup failures are terminal for the
-// process lifetime, so polling this function never causes repeated prompts.
+// portal flow and returns false until the user has approved the monitors to
+// share and their first frames have arrived. Regions spanning several shared
+// monitors are stitched from each monitor's stream. An output size smaller
+// than the rectangle box-filters it down to outputWidth x outputHeight.
+// Cancellation and setup failures are terminal for the process lifetime, so
+// polling this function never causes repeated prompts.
 bool captureRegion(
     double x,
     double y,
     uint32_t width,
     uint32_t height,
+    uint32_t outputWidth,
+    uint32_t outputHeight,
     uint8_t* outRgba,
     uint64_t outLen);
 
-// Return the compositor cursor position supplied alongside the current
-// PipeWire stream. This stays accurate while the pointer is over native
+// Report the damage sequence of the last change to a logical region of the
+// portal streams, or 0 when it is unknown. This never starts the portal flow.
+uint64_t regionChangeSequence(
+    double x,
+    double y,
+    uint32_t width,
+    uint32_t height);
+
+// Return the compositor cursor position most recently supplied by any shared
+// monitor's PipeWire stream. This stays accurate while the pointer is over native
 // Wayland surfaces, unlike XWayland's root-pointer query.
 bool getCursorScreenPoint(double* x, double* y);
 
-// Stop the PipeWire stream, close the portal request/session, and release
-// the cached frame. Call this on the GTK/GLib main context before its event loop
+// Stop every PipeWire stream, close the portal request/session, and release
+// the cached frames. Call this on the GTK/GLib main context before its event loop
 // exits. It is safe to call more than once.
 void shutdown();
 
@@ -0,0 +1,257 @@
+#include "x11_screen_capture.h"
+
+#include "x11_shm_image.h"
+#include "../shared/linux_x11_capture.h"
+
+#include <X11/Xlib.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace electrobun::x11_screen_capture {
+namespace {
+
+// Magnifiers and colour pickers alternate between a handful of fixed sizes;
+// keep one shared-memory image for each instead of reallocating per call.
+constexpr int kCachedImages = 4;
+
+struct Request {
+    LinuxX11CaptureRect device = {};
+    int scale = 1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t outputWidth = 0;
+    uint32_t outputHeight = 0;
+    uint8_t* outRgba = nullptr;
+    CaptureStatus status = CaptureStatus::Unavailable;
+    bool done = false;
+};
+
+class CaptureThread {
+public:
+    // Covers a plain exit that skipped the shutdown path.
+    ~CaptureThread() {
+        stop();
+    }
+
+    CaptureStatus capture(Request& request) {
+        std::lock_guard<std::mutex> callLock(callMutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_ || unavailable_) {
+            return CaptureStatus::Unavailable;
+        }
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this] { run(); });
+        }
+        pending_ = &request;
+        wake_.notify_one();
+        finished_.wait(lock, [&request] { return request.done; });
+        return request.status;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    struct CachedImage {
+        std::unique_ptr<x11_shm::Image> image;
+        uint64_t lastUse = 0;
+    };
+
+    void run() {
+        // A private connection keeps the blocking readback off GDK's socket.
+        // GDK's X error handler ignores errors from displays it did not open,
+        // so a failed XShmGetImage here only surfaces as a false return.
+        display_ = XOpenDisplay(nullptr);
+        if (!display_) {
+            std::fprintf(stderr, "[electrobun] X11 capture thread could not open the display\n");
+        }
+
+        for (;;) {
+            Request* request = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!display_) unavailable_ = true;
+                wake_.wait(lock, [this] { return stopping_ || pending_; });
+                request = pending_;
+                pending_ = nullptr;
+                if (stopping_ || !display_) {
+                    if (request) {
+                        request->status = CaptureStatus::Unavailable;
+                        request->done = true;
+                        finished_.notify_all();
+                    }
+                    if (stopping_) break;
+                    continue;
+                }
+            }
+
+            const CaptureStatus status = read(*request);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (status == CaptureStatus::Unavailable) unavailable_ = true;
+                request->status = status;
+                request->done = true;
+            }
+            finished_.notify_all();
+        }
+
+        for (CachedImage& cached : images_) {
+            cached.image.reset();
+        }
+        if (display_) {
+            XCloseDisplay(display_);
+            display_ = nullptr;
+        }
+    }
+
+    CaptureStatus read(Request& request) {
+        const int screen = DefaultScreen(display_);
+        const Window root = RootWindow(display_, screen);
+        // DisplayWidth/Height are fixed at connect time; ask the server so
+        // XRandR changes made since then are honoured.
+        Window ignoredRoot = 0;
+        int ignoredX = 0;
+        int ignoredY = 0;
+        unsigned int rootWidth = 0;
+        unsigned int rootHeight = 0;
+        unsigned int ignoredBorder = 0;
+        unsigned int ignoredDepth = 0;
+        if (!XGetGeometry(display_, root, &ignoredRoot, &ignoredX, &ignoredY,
+                          &rootWidth, &rootHeight, &ignoredBorder, &ignoredDepth)) {
+            return CaptureStatus::Rejected;
+        }
+        const LinuxX11CaptureRect& device = request.device;
+        if (device.x + device.width > static_cast<int>(rootWidth) ||
+            device.y + device.height > static_cast<int>(rootHeight)) {
+            return CaptureStatus::Rejected;
+        }
+
+        x11_shm::Image* image = imageFor(device.width, device.height);
+        if (!image ||
+            !image->ensure(display_, DefaultVisual(display_, screen),
+                           DefaultDepth(display_, screen), device.width, device.height)) {
+            return CaptureStatus::Rejected;
+        }
+
+        XImage* ximage = image->image();
+        Visual* visual = DefaultVisual(display_, screen);
+        LinuxOsrPixelFormat format = {};
+        if (!describeLinuxOsrPixelFormat(
+                ximage->bits_per_pixel, ximage->depth, ximage->byte_order == MSBFirst,
+                visual->red_mask, visual->green_mask, visual->blue_mask, &format)) {
+            return CaptureStatus::Unavailable;
+        }
+        if (!image->get(root, device.x, device.y)) {
+            return CaptureStatus::Rejected;
+        }
+
+        if (request.outputWidth == request.width && request.outputHeight == request.height) {
+            convertLinuxX11CaptureToRgba(image->data(), image->stride(), format, request.scale,
+                                         request.width, request.height, request.outRgba);
+            return CaptureStatus::Captured;
+        }
+        // Thumbnails average the whole device rectangle straight out of the
+        // shared-memory image, so only the small output is written.
+        ScreenCaptureChannelOrder order = {};
+        if (!linuxX11CaptureChannelOrder(format, &order)) {
+            return CaptureStatus::Unavailable;
+        }
+        return downscaleScreenCaptureBox(image->data(), image->stride(), device.width,
+                                         device.height, order, request.outputWidth,
+                                         request.outputHeight, request.outRgba,
+                                         static_cast<size_t>(request.outputWidth) * 4)
+            ? CaptureStatus::Captured
+            : CaptureStatus::Rejected;
+    }
+
+    x11_shm::Image* imageFor(int width, int height) {
+        ++useCounter_;
+        CachedImage* victim = &images_[0];
+        for (CachedImage& cached : images_) {
+            if (cached.image && cached.image->width() == width &&
+                cached.image->height() == height) {
+                cached.lastUse = useCounter_;
+                return cached.image.get();
+            }
+            if (!cached.image || cached.lastUse < victim->lastUse) {
+                victim = &cached;
+            }
+        }
+        if (!victim->image) {
+            victim->image = std::make_unique<x11_shm::Image>();
+        }
+        victim->lastUse = useCounter_;
+        return victim->image.get();
+    }
+
+    std::mutex callMutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    Request* pending_ = nullptr;
+    std::thread thread_;
+    bool stopping_ = false;
+    bool unavailable_ = false;
+
+    // Owned by the capture thread.
+    Display* display_ = nullptr;
+    CachedImage images_[kCachedImages];
+    uint64_t useCounter_ = 0;
+};
+
+CaptureThread& captureThread() {
+    static CaptureThread instance;
+    return instance;
+}
+
+}  // namespace
+
+CaptureStatus captureRegion(
+    int64_t x,
+    int64_t y,
+    uint32_t width,
+    uint32_t height,
+    uint32_t outputWidth,
+    uint32_t outputHeight,
+    int scale,
+    uint8_t* outRgba,
+    uint64_t outLen) {
+    if (!outRgba || outputWidth == 0 || outputHeight == 0 || outputWidth > width ||
+        outputHeight > height ||
+        outLen != static_cast<uint64_t>(outputWidth) * static_cast<uint64_t>(outputHeight) * 4) {
+        return CaptureStatus::Rejected;
+    }
+    Request request;
+    // The root bound is rechecked against the live geometry on the capture
+    // thread; this only maps and range-checks the logical request.
+    if (!mapLinuxX11CaptureRect(x, y, width, height, scale, 1 << 15, 1 << 15,
+                                &request.device)) {
+        return CaptureStatus::Rejected;
+    }
+    request.scale = scale;
+    request.width = width;
+    request.height = height;
+    request.outputWidth = outputWidth;
+    request.outputHeight = outputHeight;
+    request.outRgba = outRgba;
+    return captureThread().capture(request);
+}
+
+void shutdown() {
+    captureThread().stop();
+}
+
+}  // namespace electrobun::x11_screen_capture
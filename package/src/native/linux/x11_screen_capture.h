@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace electrobun::x11_screen_capture {
+
+enum class CaptureStatus {
+    // outRgba holds the requested region at the requested output size.
+    Captured,
+    // The region does not fit the root window or the read failed; the GDK
+    // path would fail the same way.
+    Rejected,
+    // No capture connection (no DISPLAY, unsupported visual, or shut down).
+    // Callers may fall back to the GDK path.
+    Unavailable,
+};
+
+// Capture one opaque RGBA pixel per logical root-window coordinate. The read
+// runs on a dedicated thread with its own Xlib connection and a persistent
+// MIT-SHM image per request size, so polling never touches the GTK main loop.
+// `scale` is the root window's integer device scale. An output size smaller
+// than the region box-filters every device pixel down to outputWidth x
+// outputHeight instead. The calling thread blocks until outRgba has been
+// written.
+CaptureStatus captureRegion(
+    int64_t x,
+    int64_t y,
+    uint32_t width,
+    uint32_t height,
+    uint32_t outputWidth,
+    uint32_t outputHeight,
+    int scale,
+    uint8_t* outRgba,
+    uint64_t outLen);
+
+// Join the capture thread and close its connection. Later captures report
+// Unavailable. It is safe to call more than once.
+void shutdown();
+
+}  // namespace electrobun::x11_screen_capture
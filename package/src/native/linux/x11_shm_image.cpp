@@ -0,0 +1,244 @@
+#include "x11_shm_image.h"
+
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace electrobun::x11_shm {
+namespace {
+
+// Xlib reports XShmAttach failures asynchronously through the process-wide
+// error handler. Trap only errors from MIT-SHM requests while probing and
+// forward everything else to the handler that was installed before.
+std::mutex g_trapMutex;
+int g_trapMajorOpcode = 0;
+bool g_trapFailed = false;
+XErrorHandler g_previousHandler = nullptr;
+
+int trapShmErrors(Display* display, XErrorEvent* error) {
+    if (error->request_code == g_trapMajorOpcode) {
+        g_trapFailed = true;
+        return 0;
+    }
+    return g_previousHandler ? g_previousHandler(display, error) : 0;
+}
+
+bool attachChecked(Display* display, XShmSegmentInfo* info) {
+    int majorOpcode = 0;
+    int firstEvent = 0;
+    int firstError = 0;
+    if (!XQueryExtension(display, "MIT-SHM", &majorOpcode, &firstEvent, &firstError)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_trapMutex);
+    XSync(display, False);
+    g_trapMajorOpcode = majorOpcode;
+    g_trapFailed = false;
+    g_previousHandler = XSetErrorHandler(trapShmErrors);
+    const Bool attached = XShmAttach(display, info);
+    XSync(display, False);
+    XSetErrorHandler(g_previousHandler);
+    g_previousHandler = nullptr;
+    return attached && !g_trapFailed;
+}
+
+std::mutex g_availabilityMutex;
+std::map<std::string, bool> g_availabilityByServer;
+
+}  // namespace
+
+bool isAvailable(Display* display) {
+    if (!display) {
+        return false;
+    }
+    const std::string server = DisplayString(display) ? DisplayString(display) : "";
+    {
+        std::lock_guard<std::mutex> lock(g_availabilityMutex);
+        auto cached = g_availabilityByServer.find(server);
+        if (cached != g_availabilityByServer.end()) {
+            return cached->second;
+        }
+    }
+
+    bool available = false;
+    if (XShmQueryExtension(display)) {
+        XShmSegmentInfo probe = {};
+        probe.shmid = shmget(IPC_PRIVATE, 4096, IPC_CREAT | 0600);
+        if (probe.shmid >= 0) {
+            probe.shmaddr = static_cast<char*>(shmat(probe.shmid, nullptr, 0));
+            if (probe.shmaddr != reinterpret_cast<char*>(-1)) {
+                probe.readOnly = False;
+                available = attachChecked(display, &probe);
+                if (available) {
+                    XShmDetach(display, &probe);
+                    XSync(display, False);
+                }
+                shmdt(probe.shmaddr);
+            }
+            shmctl(probe.shmid, IPC_RMID, nullptr);
+        }
+    }
+    if (!available) {
+        std::fprintf(stderr,
+                     "[electrobun] X11: MIT-SHM unavailable on %s, using socket transfers\n",
+                     server.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(g_availabilityMutex);
+    g_availabilityByServer[server] = available;
+    return available;
+}
+
+Image::~Image() {
+    release();
+}
+
+bool Image::ensure(Display* display, Visual* visual, int depth, int width, int height) {
+    if (!display || !visual || width <= 0 || height <= 0) {
+        release();
+        return false;
+    }
+    if (image_ && display == display_ && visual == visual_ && depth == depth_ &&
+        width == width_ && height == height_) {
+        return true;
+    }
+    release();
+
+    display_ = display;
+    visual_ = visual;
+    depth_ = depth;
+    width_ = width;
+    height_ = height;
+
+    if (isAvailable(display)) {
+        auto* info = new XShmSegmentInfo{};
+        XImage* image = XShmCreateImage(
+            display, visual, static_cast<unsigned int>(depth), ZPixmap,
+            nullptr, info, static_cast<unsigned int>(width),
+            static_cast<unsigned int>(height));
+        if (image) {
+            const std::size_t bytes =
+                static_cast<std::size_t>(image->bytes_per_line) * image->height;
+            info->shmid = shmget(IPC_PRIVATE, bytes, IPC_CREAT | 0600);
+            if (info->shmid >= 0) {
+                info->shmaddr = static_cast<char*>(shmat(info->shmid, nullptr, 0));
+                if (info->shmaddr != reinterpret_cast<char*>(-1)) {
+                    image->data = info->shmaddr;
+                    info->readOnly = False;
+                    if (attachChecked(display, info)) {
+                        // The segment stays alive until both sides detach.
+                        shmctl(info->shmid, IPC_RMID, nullptr);
+                        image_ = image;
+                        shmInfo_ = info;
+                        shared_ = true;
+                        return true;
+                    }
+                    shmdt(info->shmaddr);
+                }
+                shmctl(info->shmid, IPC_RMID, nullptr);
+            }
+            image->data = nullptr;
+            XDestroyImage(image);
+        }
+        delete info;
+    }
+
+    // Socket fallback: a heap XImage reused across frames.
+    XImage* image = XCreateImage(
+        display, visual, static_cast<unsigned int>(depth), ZPixmap, 0, nullptr,
+        static_cast<unsigned int>(width), static_cast<unsigned int>(height), 32, 0);
+    if (!image) {
+        release();
+        return false;
+    }
+    image->data = static_cast<char*>(
+        std::malloc(static_cast<std::size_t>(image->bytes_per_line) * image->height));
+    if (!image->data) {
+        XDestroyImage(image);
+        release();
+        return false;
+    }
+    image_ = image;
+    shared_ = false;
+    return true;
+}
+
+void Image::release() {
+    if (image_ && display_) {
+        if (shared_) {
+            auto* info = static_cast<XShmSegmentInfo*>(shmInfo_);
+            XShmDetach(display_, info);
+            XSync(display_, False);
+            shmdt(info->shmaddr);
+            delete info;
+            image_->data = nullptr;
+        }
+        // XDestroyImage frees heap-backed pixel data.
+        XDestroyImage(image_);
+    }
+    image_ = nullptr;
+    shmInfo_ = nullptr;
+    shared_ = false;
+    uploadInFlight_ = false;
+    display_ = nullptr;
+    visual_ = nullptr;
+    depth_ = 0;
+    width_ = 0;
+    height_ = 0;
+}
+
+std::uint8_t* Image::data() const {
+    return image_ ? reinterpret_cast<std::uint8_t*>(image_->data) : nullptr;
+}
+
+std::size_t Image::stride() const {
+    return image_ ? static_cast<std::size_t>(image_->bytes_per_line) : 0;
+}
+
+bool Image::put(Drawable drawable, GC gc, int x, int y, int width, int height) {
+    if (!image_ || !drawable || width <= 0 || height <= 0) {
+        return false;
+    }
+    if (shared_) {
+        XShmPutImage(display_, drawable, gc, image_, x, y, x, y,
+                     static_cast<unsigned int>(width),
+                     static_cast<unsigned int>(height), False);
+        uploadInFlight_ = true;
+    } else {
+        XPutImage(display_, drawable, gc, image_, x, y, x, y,
+                  static_cast<unsigned int>(width),
+                  static_cast<unsigned int>(height));
+    }
+    return true;
+}
+
+bool Image::get(Drawable drawable, int x, int y) {
+    if (!image_ || !drawable) {
+        return false;
+    }
+    waitForServer();
+    if (shared_) {
+        return XShmGetImage(display_, drawable, image_, x, y, AllPlanes) != False;
+    }
+    return XGetSubImage(display_, drawable, x, y,
+                        static_cast<unsigned int>(width_),
+                        static_cast<unsigned int>(height_), AllPlanes, ZPixmap,
+                        image_, 0, 0) != nullptr;
+}
+
+void Image::waitForServer() {
+    if (uploadInFlight_ && display_) {
+        XSync(display_, False);
+    }
+    uploadInFlight_ = false;
+}
+
+}  // namespace electrobun::x11_shm
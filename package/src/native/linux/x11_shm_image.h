@@ -0,0 +1,60 @@
+#pragma once
+
+#include <X11/Xlib.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace electrobun::x11_shm {
+
+// Report whether this connection can share memory with the X server. Remote
+// and some nested servers advertise MIT-SHM but reject attaching a segment, so
+// this also performs (and caches per server) a one-time attach probe.
+bool isAvailable(Display* display);
+
+// A reusable ZPixmap image. Pixels live in a MIT-SHM segment when the server
+// accepts one, so uploads and readbacks move no pixel data through the socket;
+// otherwise a heap-backed XImage is used with XPutImage/XGetSubImage. Storage
+// is only reallocated when the size or visual changes.
+class Image {
+public:
+    Image() = default;
+    ~Image();
+
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    bool ensure(Display* display, Visual* visual, int depth, int width, int height);
+    void release();
+
+    bool valid() const { return image_ != nullptr; }
+    bool usesSharedMemory() const { return shared_; }
+    XImage* image() const { return image_; }
+    std::uint8_t* data() const;
+    std::size_t stride() const;
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // Upload a sub-rectangle of the image to the same position in drawable.
+    // Shared-memory uploads complete asynchronously; call waitForServer()
+    // before writing pixels that a previous upload may still be reading.
+    bool put(Drawable drawable, GC gc, int x, int y, int width, int height);
+
+    // Read width()*height() pixels of drawable starting at (x, y).
+    bool get(Drawable drawable, int x, int y);
+
+    void waitForServer();
+
+private:
+    Display* display_ = nullptr;
+    Visual* visual_ = nullptr;
+    int depth_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    XImage* image_ = nullptr;
+    void* shmInfo_ = nullptr;
+    bool shared_ = false;
+    bool uploadInFlight_ = false;
+};
+
+}  // namespace electrobun::x11_shm
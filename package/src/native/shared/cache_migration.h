@@ -22,6 +22,14 @@
 //   4. If the folder exists but is effectively empty (no contents, or only
 //      our sentinel), refreshes the sentinel without wiping anything.
 //
+// With CacheWipeMode::tombstone, step 2 renames the whole folder to a hidden
+// tombstone next to it and recreates it empty, which takes constant time
+// however large the cache is. The caller deletes tombstones later with
+// findCacheTombstones and deleteCacheTombstone, typically on a background
+// thread. A tombstone is only ever a complete old folder, so a process that
+// dies before or during the delete leaves it to be found and finished on the
+// next launch. If the rename fails the wipe falls back to deleting in place.
+//
 // Safety guards (any failure → no-op, never wipe):
 //   - empty / null / relative paths
 //   - paths whose final component isn't a known Electrobun cache name
@@ -36,6 +44,7 @@
 #ifndef ELECTROBUN_CACHE_MIGRATION_H
 #define ELECTROBUN_CACHE_MIGRATION_H
 
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <exception>
@@ -43,6 +52,7 @@
 #include <fstream>
 #include <string>
 #include <system_error>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -165,9 +175,124 @@ inline bool isCachePathSafeToWipe(const std::filesystem::path& cachePath) {
     return true;
 }
 
+enum class CacheWipeMode {
+    // Delete the stale contents before returning.
+    inPlace,
+    // Rename the stale folder to a tombstone for a later delete.
+    tombstone,
+};
+
+// Tombstones of <parent>/<leaf> are named <parent>/.<leaf>.electrobun-tombstone-<n>.
+inline std::string cacheTombstonePrefix(const std::filesystem::path& cachePath) {
+    return "." + cachePathForLog(cachePath.filename()) + ".electrobun-tombstone-";
+}
+
+// Renames the cache folder to a fresh tombstone beside it. Returns the
+// tombstone, or an empty path when the folder was left in place.
+inline std::filesystem::path moveCacheFolderToTombstone(
+    const std::filesystem::path& cachePath
+) {
+    const std::string prefix = cacheTombstonePrefix(cachePath);
+    const auto stamp = std::chrono::system_clock::now().time_since_epoch().count();
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        const std::filesystem::path tombstone = cachePath.parent_path() /
+            (prefix + std::to_string(stamp) + "-" + std::to_string(attempt));
+        std::error_code ec;
+        if (std::filesystem::exists(tombstone, ec)) continue;
+        std::filesystem::rename(cachePath, tombstone, ec);
+        if (!ec) return tombstone;
+        fprintf(stderr,
+                "[cache_migration] warning: cannot move cache folder to %s (%s)\n",
+                cachePathForLog(tombstone).c_str(), ec.message().c_str());
+        break;
+    }
+    return std::filesystem::path();
+}
+
+// Tombstones waiting beside `cacheFolderPath`, including ones an earlier
+// process started deleting but did not finish.
+inline std::vector<std::filesystem::path> findCacheTombstones(
+    const std::filesystem::path& cacheFolderPath
+) {
+    std::vector<std::filesystem::path> tombstones;
+    if (!isCachePathSafeToWipe(cacheFolderPath)) return tombstones;
+    const std::string prefix = cacheTombstonePrefix(cacheFolderPath);
+    std::error_code ec;
+    std::filesystem::directory_iterator it(cacheFolderPath.parent_path(), ec);
+    if (ec) return tombstones;
+    for (const auto& entry : it) {
+        const std::string name = cachePathForLog(entry.path().filename());
+        std::error_code typeEc;
+        if (name.compare(0, prefix.size(), prefix) == 0 &&
+            entry.is_directory(typeEc) && !entry.is_symlink(typeEc)) {
+            tombstones.push_back(entry.path());
+        }
+    }
+    return tombstones;
+}
+
+struct CacheTombstoneSweep {
+    // Bytes in regular files that were removed.
+    std::uintmax_t bytesReclaimed = 0;
+    // False when something could not be removed; the rest of the tombstone
+    // stays for the next sweep.
+    bool complete = true;
+};
+
+// Deletes one tombstone found by findCacheTombstones in a single walk,
+// counting each file as it goes so a partial delete reports only what was
+// actually removed. Symlinks inside it are removed, never followed.
+inline CacheTombstoneSweep deleteCacheTombstone(const std::filesystem::path& tombstone) {
+    CacheTombstoneSweep sweep;
+    try {
+        std::vector<std::filesystem::path> directories{tombstone};
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator it(tombstone, ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            std::error_code typeEc;
+            const bool symlink = it->is_symlink(typeEc);
+            if (!symlink && it->is_directory(typeEc)) {
+                directories.push_back(it->path());
+                continue;
+            }
+            std::uintmax_t size = 0;
+            if (!symlink && it->is_regular_file(typeEc)) {
+                std::error_code sizeEc;
+                size = it->file_size(sizeEc);
+                if (sizeEc) size = 0;
+            }
+            std::error_code rmEc;
+            if (std::filesystem::remove(it->path(), rmEc)) {
+                sweep.bytesReclaimed += size;
+            } else if (rmEc) {
+                sweep.complete = false;
+            }
+        }
+        if (ec) sweep.complete = false;
+        // Children were walked after their parents, so remove in reverse.
+        for (auto dir = directories.rbegin(); dir != directories.rend(); ++dir) {
+            std::error_code rmEc;
+            std::filesystem::remove(*dir, rmEc);
+            if (rmEc) sweep.complete = false;
+        }
+        if (!sweep.complete) {
+            fprintf(stderr,
+                    "[cache_migration] warning: failed to remove all of %s\n",
+                    cachePathForLog(tombstone).c_str());
+        }
+    } catch (const std::exception& e) {
+        sweep.complete = false;
+        fprintf(stderr,
+                "[cache_migration] warning: tombstone delete aborted: %s\n",
+                e.what());
+    }
+    return sweep;
+}
+
 inline bool migrateCacheFolderIfNeeded(
     const std::filesystem::path& cacheFolderPath,
-    uint32_t targetVersion = CEF_CACHE_FORMAT_VERSION
+    uint32_t targetVersion = CEF_CACHE_FORMAT_VERSION,
+    CacheWipeMode mode = CacheWipeMode::inPlace
 ) {
     try {
         if (cacheFolderPath.empty()) {
@@ -251,6 +376,21 @@ inline bool migrateCacheFolderIfNeeded(
                 existingVersion, targetVersion,
                 cachePathLog.c_str());
 
+        if (mode == CacheWipeMode::tombstone &&
+            !moveCacheFolderToTombstone(cachePath).empty()) {
+            // The old folder, sentinel included, is now the tombstone. Dying
+            // before the sentinel below is written looks like a fresh install.
+            std::error_code mkEc;
+            std::filesystem::create_directories(cachePath, mkEc);
+            if (mkEc) {
+                fprintf(stderr,
+                        "[cache_migration] warning: cannot recreate cache folder %s (%s)\n",
+                        cachePathLog.c_str(), mkEc.message().c_str());
+                return false;
+            }
+            return writeCacheSentinel(sentinelPath, targetVersion);
+        }
+
         // Wipe contents but preserve the folder itself. Never stamp the new
         // version after a partial wipe; the next launch
         // must retry instead of accepting mixed, incompatible layouts.
@@ -300,10 +440,11 @@ inline bool migrateCacheFolderIfNeeded(
 
 inline bool migrateCacheFolderIfNeeded(
     const std::string& cacheFolderPath,
-    uint32_t targetVersion = CEF_CACHE_FORMAT_VERSION
+    uint32_t targetVersion = CEF_CACHE_FORMAT_VERSION,
+    CacheWipeMode mode = CacheWipeMode::inPlace
 ) {
     return migrateCacheFolderIfNeeded(
-        std::filesystem::path(cacheFolderPath), targetVersion);
+        std::filesystem::path(cacheFolderPath), targetVersion, mode);
 }
 
 }  // namespace electrobun
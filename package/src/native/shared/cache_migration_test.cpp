@@ -0,0 +1,107 @@
+#include "cache_migration.h"
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeFile(const fs::path& path, std::size_t bytes) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(bytes, 'x');
+}
+
+}  // namespace
+
+int main() {
+    const fs::path root = fs::temp_directory_path() /
+        ("electrobun-cache-migration-" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+    const fs::path cache = root / "app" / "dev" / "CEF";
+    const fs::path sentinel = cache / electrobun::cacheSentinelFilename();
+
+    {
+        // A stale cache is moved aside whole and the folder comes back empty
+        // with the new sentinel.
+        writeFile(cache / "Default" / "Cache" / "data_0", 4096);
+        writeFile(cache / "profile-a" / "Cookies", 1000);
+        assert(electrobun::writeCacheSentinel(sentinel, 2));
+        assert(electrobun::migrateCacheFolderIfNeeded(
+            cache, 3, electrobun::CacheWipeMode::tombstone));
+        assert(electrobun::readCacheSentinel(sentinel) == 3);
+        assert(!fs::exists(cache / "Default"));
+        assert(!fs::exists(cache / "profile-a"));
+
+        const auto tombstones = electrobun::findCacheTombstones(cache);
+        assert(tombstones.size() == 1);
+        assert(fs::exists(tombstones[0] / "Default" / "Cache" / "data_0"));
+        assert(electrobun::readCacheSentinel(
+            tombstones[0] / electrobun::cacheSentinelFilename()) == 2);
+
+        // Up to date: nothing moves.
+        assert(electrobun::migrateCacheFolderIfNeeded(
+            cache, 3, electrobun::CacheWipeMode::tombstone));
+        assert(electrobun::findCacheTombstones(cache).size() == 1);
+
+        // The delete reports the data it reclaimed; the sentinel is 2 bytes.
+        const electrobun::CacheTombstoneSweep sweep =
+            electrobun::deleteCacheTombstone(tombstones[0]);
+        assert(sweep.complete);
+        assert(sweep.bytesReclaimed == 4096 + 1000 + 2);
+        assert(!fs::exists(tombstones[0]));
+        assert(electrobun::findCacheTombstones(cache).empty());
+    }
+
+    {
+        // A half-deleted tombstone left by a crash is found and finished,
+        // and unrelated siblings are never tombstones.
+        const fs::path leftover = cache.parent_path() /
+            (electrobun::cacheTombstonePrefix(cache) + "1-0");
+        writeFile(leftover / "Default" / "History", 10);
+        writeFile(cache.parent_path() / "CEF-backup" / "keep", 1);
+        writeFile(cache.parent_path() / ".other.electrobun-tombstone-1" / "keep", 1);
+        const auto tombstones = electrobun::findCacheTombstones(cache);
+        assert(tombstones.size() == 1 && tombstones[0] == leftover);
+        // A symlink inside is removed without touching or counting its target.
+        writeFile(root / "outside", 50);
+        fs::create_symlink(root / "outside", leftover / "link");
+        assert(electrobun::deleteCacheTombstone(leftover).bytesReclaimed == 10);
+        assert(!fs::exists(leftover));
+        assert(fs::file_size(root / "outside") == 50);
+        assert(fs::exists(cache.parent_path() / "CEF-backup" / "keep"));
+        assert(fs::exists(cache.parent_path() / ".other.electrobun-tombstone-1" / "keep"));
+    }
+
+    {
+        // A cache folder removed before it was recreated reads as a fresh
+        // install next launch.
+        fs::remove_all(cache);
+        assert(electrobun::migrateCacheFolderIfNeeded(
+            cache, 3, electrobun::CacheWipeMode::tombstone));
+        assert(electrobun::readCacheSentinel(sentinel) == 3);
+        assert(electrobun::findCacheTombstones(cache).empty());
+    }
+
+    {
+        // The default mode still deletes in place and leaves no tombstone.
+        writeFile(cache / "Default" / "Cookies", 10);
+        assert(electrobun::writeCacheSentinel(sentinel, 2));
+        assert(electrobun::migrateCacheFolderIfNeeded(cache, 3));
+        assert(!fs::exists(cache / "Default"));
+        assert(electrobun::findCacheTombstones(cache).empty());
+    }
+
+    {
+        // Unsafe paths are never searched.
+        assert(electrobun::findCacheTombstones(fs::path("/CEF")).empty());
+        assert(electrobun::findCacheTombstones(root / "app" / "dev" / "Other").empty());
+    }
+
+    fs::remove_all(root);
+    return 0;
+}
@@ -37,6 +37,10 @@ typedef void (*MenuHandler)(const char* menuItemId);
 
 // Snapshot callback
 typedef void (*SnapshotCallback)(uint32_t hostId, uint32_t webviewId, const char* dataUrl);
+// Encoded results are fetched separately by requestId once dataUrlLength is known.
+typedef void (*WebviewSnapshotCompletionHandler)(uint32_t requestId, uint32_t webviewId, uint32_t success, uint32_t width, uint32_t height, uint64_t dataUrlLength);
+// A frame stream published a new frame; sequence is truncated to 32 bits.
+typedef void (*WebviewFrameStreamHandler)(uint32_t webviewId, uint32_t sequence);
 
 // URL open handler for deep linking
 typedef void (*URLOpenHandler)(const char* url);
@@ -0,0 +1,87 @@
+#pragma once
+
+namespace electrobun {
+
+// Windowed CEF browsers only place out-of-process iframes after Chromium sees
+// input or a geometry change on the browser's X11 window. A nudge is only
+// owed while such a layout is pending: from browser creation or a subframe
+// attaching until the next delivery. Signals in that window (frame
+// load/attach, MapNotify, ConfigureNotify) are coalesced into one synthetic
+// event per main-loop turn; outside it they cost nothing. The last
+// configured size is cached so a nudge never needs an X round trip.
+struct CefLayoutNudgeSize {
+    bool known;
+    int width;
+    int height;
+};
+
+class CefLayoutNudgeState {
+public:
+    // One-shot fallback for pages whose OOPIFs attach without any signal we
+    // observe. It replaces the old 5 ms interval that ran for a full second.
+    static constexpr unsigned int kFallbackDelayMs = 250;
+
+    // A layout is pending; the next request queues a delivery.
+    void arm() {
+        armed_ = true;
+    }
+
+    // Returns true when the caller must queue a delivery; false when no
+    // layout is pending or one is already queued and this request folds
+    // into it.
+    bool request() {
+        ++requested_;
+        if (!armed_ || pending_) {
+            return false;
+        }
+        pending_ = true;
+        return true;
+    }
+
+    void observeSize(int width, int height) {
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+        size_ = {true, width, height};
+    }
+
+    // Consumes the queued request and the pending layout, and returns the
+    // geometry to nudge with.
+    CefLayoutNudgeSize deliver() {
+        pending_ = false;
+        armed_ = false;
+        ++delivered_;
+        return size_;
+    }
+
+    // Dropping a queued delivery (browser closing, owner detached) must allow
+    // the next signal to queue again while the layout is still pending.
+    void cancel() {
+        pending_ = false;
+    }
+
+    bool pending() const {
+        return pending_;
+    }
+
+    bool armed() const {
+        return armed_;
+    }
+
+    unsigned int requested() const {
+        return requested_;
+    }
+
+    unsigned int delivered() const {
+        return delivered_;
+    }
+
+private:
+    bool armed_ = false;
+    bool pending_ = false;
+    CefLayoutNudgeSize size_ = {false, 0, 0};
+    unsigned int requested_ = 0;
+    unsigned int delivered_ = 0;
+};
+
+} // namespace electrobun
@@ -0,0 +1,65 @@
+#include "cef_layout_nudge.h"
+
+#include <cassert>
+
+using electrobun::CefLayoutNudgeSize;
+using electrobun::CefLayoutNudgeState;
+
+int main() {
+    CefLayoutNudgeState state;
+    assert(!state.pending());
+
+    // Resizes and maps with no layout pending never nudge.
+    state.observeSize(800, 600);
+    assert(!state.request());
+    assert(!state.pending());
+
+    // Until X reports a size, delivery asks the caller to query it once.
+    CefLayoutNudgeState fresh;
+    fresh.arm();
+    assert(fresh.request());
+    assert(fresh.pending());
+    const CefLayoutNudgeSize unknown = fresh.deliver();
+    assert(!unknown.known);
+    assert(!fresh.pending());
+    assert(!fresh.armed());
+
+    // MapNotify, ConfigureNotify and several frame loads in one main-loop
+    // turn collapse into a single delivery, which ends the pending layout.
+    state.observeSize(1280, 720);
+    state.arm();
+    assert(state.request());
+    assert(!state.request());
+    assert(!state.request());
+    state.observeSize(1024, 768);
+    assert(!state.request());
+    const CefLayoutNudgeSize latest = state.deliver();
+    assert(latest.known);
+    assert(latest.width == 1024);
+    assert(latest.height == 768);
+    assert(!state.request());
+    assert(state.requested() == 6);
+    assert(state.delivered() == 1);
+
+    // Degenerate geometry from an unmapped window keeps the last usable size.
+    state.observeSize(0, 0);
+    state.observeSize(-1, 600);
+    state.arm();
+    assert(state.request());
+    const CefLayoutNudgeSize kept = state.deliver();
+    assert(kept.known);
+    assert(kept.width == 1024);
+    assert(kept.height == 768);
+
+    // A cancelled delivery does not swallow the next signal while the layout
+    // is still pending.
+    state.arm();
+    assert(state.request());
+    state.cancel();
+    assert(!state.pending());
+    assert(state.request());
+    state.deliver();
+    assert(state.delivered() == 3);
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "linux_dpi.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace electrobun {
+
+// View-local mask hole in logical pixels, as produced by a tag's
+// getBoundingClientRect() relative to its own origin.
+struct LinuxMaskRect {
+    double x;
+    double y;
+    double width;
+    double height;
+};
+
+// Parse a mask array such as [{"x":10,"y":20,"width":100,"height":50}] in
+// a single pass. Quotes may arrive escaped (\") when the array was embedded
+// in another JSON string; backslashes are skipped rather than copied out.
+inline std::vector<LinuxMaskRect> parseLinuxMaskJson(const char* json) {
+    std::vector<LinuxMaskRect> rects;
+    if (!json) {
+        return rects;
+    }
+
+    LinuxMaskRect rect = {};
+    bool inObject = false;
+    const char* cursor = json;
+    while (*cursor) {
+        const char c = *cursor;
+        if (c == '{') {
+            rect = {};
+            inObject = true;
+            ++cursor;
+            continue;
+        }
+        if (c == '}') {
+            if (inObject) {
+                rects.push_back(rect);
+            }
+            inObject = false;
+            ++cursor;
+            continue;
+        }
+        if (c != '"' || !inObject) {
+            ++cursor;
+            continue;
+        }
+
+        const char* key = ++cursor;
+        while (*cursor && *cursor != '"' && *cursor != '\\') {
+            ++cursor;
+        }
+        const std::size_t keyLength = static_cast<std::size_t>(cursor - key);
+        while (*cursor == '"' || *cursor == '\\' || *cursor == ' ') {
+            ++cursor;
+        }
+        if (*cursor != ':') {
+            continue;
+        }
+        ++cursor;
+
+        double* field = nullptr;
+        if (keyLength == 1 && key[0] == 'x') {
+            field = &rect.x;
+        } else if (keyLength == 1 && key[0] == 'y') {
+            field = &rect.y;
+        } else if (keyLength == 5 && std::strncmp(key, "width", 5) == 0) {
+            field = &rect.width;
+        } else if (keyLength == 6 && std::strncmp(key, "height", 6) == 0) {
+            field = &rect.height;
+        }
+        if (!field) {
+            continue;
+        }
+        char* end = nullptr;
+        const double value = std::strtod(cursor, &end);
+        if (end != cursor) {
+            *field = value;
+            cursor = end;
+        }
+    }
+    return rects;
+}
+
+// Unpack x, y, width, height quadruples from the binary mask channel.
+inline std::vector<LinuxMaskRect> unpackLinuxMaskRects(
+    const float* packed,
+    std::size_t rectCount
+) {
+    std::vector<LinuxMaskRect> rects;
+    if (!packed) {
+        return rects;
+    }
+    rects.reserve(rectCount);
+    for (std::size_t i = 0; i < rectCount; ++i) {
+        const float* values = packed + i * 4;
+        rects.push_back({values[0], values[1], values[2], values[3]});
+    }
+    return rects;
+}
+
+// The visible/input region of a masked view: the window rectangle minus every
+// hole, as YX-banded rectangles. Each band shares one y and height, bands are
+// ordered top to bottom, rectangles within a band left to right, and
+// vertically adjacent bands with identical spans are merged. The result can be
+// handed to XShapeCombineRectangles(..., ShapeSet, YXBanded) in one request.
+inline std::vector<LinuxXRectangleFields> buildLinuxMaskRegion(
+    int width,
+    int height,
+    const std::vector<LinuxPhysicalRect>& holes
+) {
+    std::vector<LinuxXRectangleFields> region;
+    const int maxCoordinate = std::numeric_limits<std::int16_t>::max();
+    width = std::clamp(width, 0, maxCoordinate);
+    height = std::clamp(height, 0, maxCoordinate);
+    if (width == 0 || height == 0) {
+        return region;
+    }
+
+    std::vector<LinuxPhysicalRect> clipped;
+    clipped.reserve(holes.size());
+    std::vector<int> edges = {0, height};
+    for (const auto& hole : holes) {
+        const int left = std::max(0, hole.x);
+        const int top = std::max(0, hole.y);
+        const int right = static_cast<int>(std::min<long long>(
+            width, static_cast<long long>(hole.x) + std::max(0, hole.width)));
+        const int bottom = static_cast<int>(std::min<long long>(
+            height, static_cast<long long>(hole.y) + std::max(0, hole.height)));
+        if (right <= left || bottom <= top) {
+            continue;
+        }
+        clipped.push_back({left, top, right - left, bottom - top});
+        edges.push_back(top);
+        edges.push_back(bottom);
+    }
+    if (clipped.empty()) {
+        region.push_back({0, 0, static_cast<std::uint16_t>(width),
+                          static_cast<std::uint16_t>(height)});
+        return region;
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<std::pair<int, int>> covered;
+    std::vector<std::pair<int, int>> spans;
+    std::vector<std::pair<int, int>> previousSpans;
+    std::size_t previousBandStart = 0;
+    for (std::size_t band = 0; band + 1 < edges.size(); ++band) {
+        const int top = edges[band];
+        const int bottom = edges[band + 1];
+
+        covered.clear();
+        for (const auto& hole : clipped) {
+            if (hole.y <= top && hole.y + hole.height >= bottom) {
+                covered.emplace_back(hole.x, hole.x + hole.width);
+            }
+        }
+        std::sort(covered.begin(), covered.end());
+
+        spans.clear();
+        int cursor = 0;
+        for (const auto& interval : covered) {
+            if (interval.first > cursor) {
+                spans.emplace_back(cursor, interval.first);
+            }
+            cursor = std::max(cursor, interval.second);
+        }
+        if (cursor < width) {
+            spans.emplace_back(cursor, width);
+        }
+
+        if (!spans.empty() && spans == previousSpans) {
+            for (std::size_t i = previousBandStart; i < region.size(); ++i) {
+                region[i].height = static_cast<std::uint16_t>(bottom - region[i].y);
+            }
+        } else if (!spans.empty()) {
+            previousBandStart = region.size();
+            for (const auto& span : spans) {
+                region.push_back({
+                    static_cast<std::int16_t>(span.first),
+                    static_cast<std::int16_t>(top),
+                    static_cast<std::uint16_t>(span.second - span.first),
+                    static_cast<std::uint16_t>(bottom - top),
+                });
+            }
+        }
+        previousSpans.swap(spans);
+    }
+    return region;
+}
+
+inline bool sameLinuxMaskRegion(
+    const std::vector<LinuxXRectangleFields>& a,
+    const std::vector<LinuxXRectangleFields>& b
+) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].x != b[i].x || a[i].y != b[i].y ||
+            a[i].width != b[i].width || a[i].height != b[i].height) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Remembers the region last sent for one shape kind of one window so that
+// resyncs with unchanged geometry cost no X requests. Invalidate whenever the
+// shape is changed by other means (mask reset, passthrough, window rebuilt).
+class LinuxMaskRegionCache {
+public:
+    bool needsUpdate(unsigned long window, const std::vector<LinuxXRectangleFields>& region) {
+        if (valid_ && window == window_ && sameLinuxMaskRegion(region, region_)) {
+            return false;
+        }
+        valid_ = true;
+        window_ = window;
+        region_ = region;
+        return true;
+    }
+
+    // True while the window carries a region sent through this cache.
+    bool valid() const {
+        return valid_;
+    }
+
+    void invalidate() {
+        valid_ = false;
+        window_ = 0;
+        region_.clear();
+    }
+
+private:
+    bool valid_ = false;
+    unsigned long window_ = 0;
+    std::vector<LinuxXRectangleFields> region_;
+};
+
+} // namespace electrobun
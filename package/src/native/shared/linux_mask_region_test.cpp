@@ -0,0 +1,141 @@
+#include "linux_mask_region.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using electrobun::LinuxMaskRect;
+using electrobun::LinuxMaskRegionCache;
+using electrobun::LinuxPhysicalRect;
+using electrobun::LinuxXRectangleFields;
+using electrobun::buildLinuxMaskRegion;
+using electrobun::parseLinuxMaskJson;
+using electrobun::unpackLinuxMaskRects;
+
+namespace {
+
+bool sameRect(const LinuxXRectangleFields& rect, int x, int y, int width, int height) {
+    return rect.x == x && rect.y == y && rect.width == width && rect.height == height;
+}
+
+// Every pixel must be covered by the region exactly when it lies outside all
+// holes, and the list must satisfy the YXBanded ordering X expects.
+void assertRegionMatches(
+    const std::vector<LinuxXRectangleFields>& region,
+    int width,
+    int height,
+    const std::vector<LinuxPhysicalRect>& holes
+) {
+    for (std::size_t i = 1; i < region.size(); ++i) {
+        const auto& previous = region[i - 1];
+        const auto& current = region[i];
+        if (current.y == previous.y) {
+            assert(current.height == previous.height);
+            assert(current.x >= previous.x + previous.width);
+        } else {
+            assert(current.y >= previous.y + previous.height);
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            bool inHole = false;
+            for (const auto& hole : holes) {
+                inHole = inHole || (x >= hole.x && x < hole.x + hole.width &&
+                                    y >= hole.y && y < hole.y + hole.height);
+            }
+            int covering = 0;
+            for (const auto& rect : region) {
+                covering += x >= rect.x && x < rect.x + rect.width &&
+                            y >= rect.y && y < rect.y + rect.height;
+            }
+            assert(covering == (inHole ? 0 : 1));
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    // Plain and escaped JSON parse to the same fractional geometry.
+    const auto plain = parseLinuxMaskJson(
+        "[{\"x\":10.5,\"y\":20,\"width\":100,\"height\":50},"
+        "{\"height\":4, \"width\":3, \"y\":-2, \"x\":1}]");
+    assert(plain.size() == 2);
+    assert(plain[0].x == 10.5 && plain[0].y == 20);
+    assert(plain[0].width == 100 && plain[0].height == 50);
+    assert(plain[1].x == 1 && plain[1].y == -2);
+    assert(plain[1].width == 3 && plain[1].height == 4);
+
+    const auto escaped = parseLinuxMaskJson(
+        "[{\\\"x\\\":10.5,\\\"y\\\":20,\\\"width\\\":100,\\\"height\\\":50}]");
+    assert(escaped.size() == 1);
+    assert(escaped[0].x == 10.5 && escaped[0].height == 50);
+
+    assert(parseLinuxMaskJson(nullptr).empty());
+    assert(parseLinuxMaskJson("[]").empty());
+    assert(parseLinuxMaskJson("[{\"x\":1").empty());
+
+    // Packed floats unpack four to a rectangle.
+    const float packed[] = {0.25f, 1.0f / 3.0f, 640.0f, 48.5f, -4.0f, 0.0f, 8.0f, 9.0f};
+    const auto unpacked = unpackLinuxMaskRects(packed, 2);
+    assert(unpacked.size() == 2);
+    for (std::size_t i = 0; i < unpacked.size(); ++i) {
+        assert(unpacked[i].x == packed[i * 4]);
+        assert(unpacked[i].y == packed[i * 4 + 1]);
+        assert(unpacked[i].width == packed[i * 4 + 2]);
+        assert(unpacked[i].height == packed[i * 4 + 3]);
+    }
+    assert(unpackLinuxMaskRects(nullptr, 2).empty());
+
+    // No holes keeps the whole window.
+    const auto whole = buildLinuxMaskRegion(200, 100, {});
+    assert(whole.size() == 1 && sameRect(whole[0], 0, 0, 200, 100));
+
+    // A centred hole yields top, two side pieces and bottom.
+    const std::vector<LinuxPhysicalRect> centred = {{50, 20, 100, 30}};
+    const auto frame = buildLinuxMaskRegion(200, 100, centred);
+    assert(frame.size() == 4);
+    assert(sameRect(frame[0], 0, 0, 200, 20));
+    assert(sameRect(frame[1], 0, 20, 50, 30));
+    assert(sameRect(frame[2], 150, 20, 50, 30));
+    assert(sameRect(frame[3], 0, 50, 200, 50));
+    assertRegionMatches(frame, 200, 100, centred);
+
+    // Overlapping, touching, offscreen and empty holes.
+    const std::vector<LinuxPhysicalRect> mixed = {
+        {-10, -10, 30, 30},
+        {10, 5, 40, 10},
+        {50, 5, 10, 10},
+        {70, 40, 200, 20},
+        {0, 90, 0, 20},
+        {300, 300, 10, 10},
+        {30, 60, 20, 45},
+    };
+    const auto mixedRegion = buildLinuxMaskRegion(120, 100, mixed);
+    assertRegionMatches(mixedRegion, 120, 100, mixed);
+
+    // Identical bands separated by a hole band do not merge across it.
+    const std::vector<LinuxPhysicalRect> strip = {{0, 10, 40, 5}};
+    const auto stripRegion = buildLinuxMaskRegion(40, 30, strip);
+    assert(stripRegion.size() == 2);
+    assert(sameRect(stripRegion[0], 0, 0, 40, 10));
+    assert(sameRect(stripRegion[1], 0, 15, 40, 15));
+
+    // A hole covering everything leaves an empty region, not a stale base.
+    assert(buildLinuxMaskRegion(40, 30, {{0, 0, 40, 30}}).empty());
+    assert(buildLinuxMaskRegion(0, 30, {}).empty());
+
+    // The cache only reports changes in geometry or target window.
+    LinuxMaskRegionCache cache;
+    assert(!cache.valid());
+    assert(cache.needsUpdate(7, frame));
+    assert(cache.valid());
+    assert(!cache.needsUpdate(7, frame));
+    assert(!cache.needsUpdate(7, buildLinuxMaskRegion(200, 100, centred)));
+    assert(cache.needsUpdate(8, frame));
+    assert(cache.needsUpdate(8, whole));
+    cache.invalidate();
+    assert(!cache.valid());
+    assert(cache.needsUpdate(8, whole));
+    return 0;
+}
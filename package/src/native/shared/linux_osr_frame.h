@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace electrobun {
+
+// CEF windowless rendering hands OnPaint a full premultiplied BGRA frame plus
+// the rectangles that changed. Presenting it through X11 only needs those
+// rectangles, and on the usual little-endian server with a 32-bit TrueColor
+// visual the BGRA bytes are already the XImage pixel layout.
+struct LinuxOsrRect {
+    int x;
+    int y;
+    int width;
+    int height;
+
+    bool empty() const {
+        return width <= 0 || height <= 0;
+    }
+
+    std::uint64_t area() const {
+        return empty() ? 0 :
+            static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height);
+    }
+};
+
+struct LinuxOsrPixelFormat {
+    // True when a BGRA row can be memcpy'd into the image unchanged.
+    bool identity;
+    bool msbFirst;
+    int redShift;
+    int greenShift;
+    int blueShift;
+    // -1 when the visual has no alpha channel.
+    int alphaShift;
+};
+
+namespace linux_osr_detail {
+
+inline int maskShift(unsigned long mask) {
+    if (!mask) {
+        return -1;
+    }
+    int shift = 0;
+    while (!(mask & 1ul)) {
+        mask >>= 1;
+        ++shift;
+    }
+    return shift;
+}
+
+inline bool hostIsLittleEndian() {
+    const std::uint32_t probe = 1;
+    std::uint8_t first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+} // namespace linux_osr_detail
+
+// Derive how to store CEF BGRA pixels into an XImage. Only 32bpp images with
+// 8-bit channel masks are supported; callers fall back to a full XPutImage of
+// converted pixels (or skip presentation) when this returns false.
+inline bool describeLinuxOsrPixelFormat(
+    int bitsPerPixel,
+    int depth,
+    bool imageMsbFirst,
+    unsigned long redMask,
+    unsigned long greenMask,
+    unsigned long blueMask,
+    LinuxOsrPixelFormat* format
+) {
+    if (!format || bitsPerPixel != 32) {
+        return false;
+    }
+    const int redShift = linux_osr_detail::maskShift(redMask);
+    const int greenShift = linux_osr_detail::maskShift(greenMask);
+    const int blueShift = linux_osr_detail::maskShift(blueMask);
+    if (redShift < 0 || greenShift < 0 || blueShift < 0 ||
+        (redMask >> redShift) != 0xff ||
+        (greenMask >> greenShift) != 0xff ||
+        (blueMask >> blueShift) != 0xff) {
+        return false;
+    }
+
+    int alphaShift = -1;
+    if (depth == 32) {
+        const unsigned long rgbMask = redMask | greenMask | blueMask;
+        const unsigned long alphaMask = 0xfffffffful & ~rgbMask;
+        alphaShift = linux_osr_detail::maskShift(alphaMask);
+        if (alphaShift < 0 || (alphaMask >> alphaShift) != 0xff) {
+            return false;
+        }
+    }
+
+    // BGRA in memory equals an LSB-first 0xAARRGGBB pixel. Depth-24 visuals
+    // ignore the top byte, so they match as well.
+    const bool lsbFirst = !imageMsbFirst;
+    format->identity = lsbFirst && redShift == 16 && greenShift == 8 &&
+        blueShift == 0 && (alphaShift == 24 || alphaShift == -1);
+    format->msbFirst = imageMsbFirst;
+    format->redShift = redShift;
+    format->greenShift = greenShift;
+    format->blueShift = blueShift;
+    format->alphaShift = alphaShift;
+    return true;
+}
+
+inline LinuxOsrRect clipLinuxOsrRect(const LinuxOsrRect& rect, int width, int height) {
+    const int left = std::max(0, rect.x);
+    const int top = std::max(0, rect.y);
+    const int right = std::min(width, rect.x + std::max(0, rect.width));
+    const int bottom = std::min(height, rect.y + std::max(0, rect.height));
+    if (right <= left || bottom <= top) {
+        return {0, 0, 0, 0};
+    }
+    return {left, top, right - left, bottom - top};
+}
+
+// Clip CEF's dirty list to the surface and bound the number of X requests.
+// Many small rects, or rects covering most of their bounding box, collapse
+// into one upload; the copy then costs at most the bounding area.
+inline std::vector<LinuxOsrRect> planLinuxOsrUploads(
+    const std::vector<LinuxOsrRect>& dirtyRects,
+    int width,
+    int height,
+    std::size_t maxRects = 16
+) {
+    std::vector<LinuxOsrRect> uploads;
+    uploads.reserve(dirtyRects.size());
+    std::uint64_t dirtyArea = 0;
+    LinuxOsrRect bounds = {0, 0, 0, 0};
+    for (const auto& dirty : dirtyRects) {
+        const LinuxOsrRect clipped = clipLinuxOsrRect(dirty, width, height);
+        if (clipped.empty()) {
+            continue;
+        }
+        if (bounds.empty()) {
+            bounds = clipped;
+        } else {
+            const int left = std::min(bounds.x, clipped.x);
+            const int top = std::min(bounds.y, clipped.y);
+            const int right = std::max(bounds.x + bounds.width, clipped.x + clipped.width);
+            const int bottom = std::max(bounds.y + bounds.height, clipped.y + clipped.height);
+            bounds = {left, top, right - left, bottom - top};
+        }
+        dirtyArea += clipped.area();
+        uploads.push_back(clipped);
+    }
+
+    if (uploads.size() > maxRects ||
+        (uploads.size() > 1 && dirtyArea * 4 >= bounds.area() * 3)) {
+        uploads.assign(1, bounds);
+    }
+    return uploads;
+}
+
+// Copy one rectangle of CEF BGRA pixels into image memory laid out as the
+// same surface with dstStride bytes per row.
+inline void copyLinuxOsrRect(
+    const std::uint8_t* src,
+    std::size_t srcStride,
+    std::uint8_t* dst,
+    std::size_t dstStride,
+    const LinuxOsrRect& rect,
+    const LinuxOsrPixelFormat& format
+) {
+    if (rect.empty()) {
+        return;
+    }
+    const std::size_t rowBytes = static_cast<std::size_t>(rect.width) * 4;
+    const std::size_t offsetX = static_cast<std::size_t>(rect.x) * 4;
+    const bool swapBytes = format.msbFirst == linux_osr_detail::hostIsLittleEndian();
+    const std::uint32_t alphaBits = format.alphaShift >= 0 ? 0xffu : 0u;
+    const int alphaShift = format.alphaShift >= 0 ? format.alphaShift : 0;
+    for (int row = 0; row < rect.height; ++row) {
+        const std::size_t y = static_cast<std::size_t>(rect.y + row);
+        const std::uint8_t* srcRow = src + y * srcStride + offsetX;
+        std::uint8_t* dstRow = dst + y * dstStride + offsetX;
+        if (format.identity) {
+            std::memcpy(dstRow, srcRow, rowBytes);
+            continue;
+        }
+        for (int column = 0; column < rect.width; ++column) {
+            const std::uint8_t* bgra = srcRow + static_cast<std::size_t>(column) * 4;
+            std::uint32_t pixel =
+                (static_cast<std::uint32_t>(bgra[2]) << format.redShift) |
+                (static_cast<std::uint32_t>(bgra[1]) << format.greenShift) |
+                (static_cast<std::uint32_t>(bgra[0]) << format.blueShift) |
+                ((static_cast<std::uint32_t>(bgra[3]) & alphaBits) << alphaShift);
+            if (swapBytes) {
+                pixel = (pixel >> 24) | ((pixel >> 8) & 0xff00u) |
+                    ((pixel << 8) & 0xff0000u) | (pixel << 24);
+            }
+            std::memcpy(dstRow + static_cast<std::size_t>(column) * 4, &pixel, 4);
+        }
+    }
+}
+
+} // namespace electrobun
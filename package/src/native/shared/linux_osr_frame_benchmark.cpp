@@ -0,0 +1,112 @@
+// Measures CPU time and upload volume per OSR frame for the dirty-rect
+// presentation path against the previous full-frame convert-and-upload path.
+// X server transfer time is not included; bytes uploaded is the payload the
+// server has to read per frame (from a socket or a MIT-SHM segment).
+#include "linux_osr_frame.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using electrobun::LinuxOsrPixelFormat;
+using electrobun::LinuxOsrRect;
+using electrobun::copyLinuxOsrRect;
+using electrobun::describeLinuxOsrPixelFormat;
+using electrobun::planLinuxOsrUploads;
+
+namespace {
+
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+constexpr int kFrames = 240;
+
+struct Scenario {
+    const char* name;
+    std::vector<LinuxOsrRect> dirty;
+};
+
+volatile std::uint32_t g_sink = 0;
+
+double legacyFrameMs(const std::vector<std::uint8_t>& frame) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        const auto* src = reinterpret_cast<const std::uint32_t*>(frame.data());
+        std::vector<std::uint32_t> converted(static_cast<std::size_t>(kWidth) * kHeight);
+        for (std::size_t p = 0; p < converted.size(); ++p) {
+            const std::uint32_t bgra = src[p];
+            converted[p] = (((bgra >> 24) & 0xff) << 24) |
+                (((bgra >> 16) & 0xff) << 16) |
+                (((bgra >> 8) & 0xff) << 8) |
+                (bgra & 0xff);
+        }
+        g_sink += converted[static_cast<std::size_t>(i) % converted.size()];
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / kFrames;
+}
+
+double dirtyFrameMs(
+    const std::vector<std::uint8_t>& frame,
+    std::vector<std::uint8_t>& image,
+    const LinuxOsrPixelFormat& format,
+    const std::vector<LinuxOsrRect>& dirty,
+    std::uint64_t* bytesPerFrame
+) {
+    std::uint64_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        const auto uploads = planLinuxOsrUploads(dirty, kWidth, kHeight);
+        bytes = 0;
+        for (const auto& rect : uploads) {
+            copyLinuxOsrRect(frame.data(), kWidth * 4, image.data(), kWidth * 4, rect, format);
+            bytes += rect.area() * 4;
+        }
+        g_sink += image[static_cast<std::size_t>(i) % image.size()];
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    *bytesPerFrame = bytes;
+    return elapsed.count() / kFrames;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<std::uint8_t> frame(static_cast<std::size_t>(kWidth) * kHeight * 4);
+    for (std::size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<std::uint8_t>(i * 31);
+    }
+    std::vector<std::uint8_t> image(frame.size());
+
+    LinuxOsrPixelFormat identity = {};
+    LinuxOsrPixelFormat swizzle = {};
+    describeLinuxOsrPixelFormat(32, 32, false, 0xff0000, 0xff00, 0xff, &identity);
+    describeLinuxOsrPixelFormat(32, 32, false, 0xff, 0xff00, 0xff0000, &swizzle);
+
+    const std::vector<Scenario> scenarios = {
+        {"caret blink", {{640, 320, 2, 20}}},
+        {"spinner", {{900, 500, 48, 48}}},
+        {"scrolling panel", {{0, 80, 1400, 1000}}},
+        {"two widgets", {{10, 10, 300, 40}, {1600, 900, 300, 160}}},
+        {"full repaint", {{0, 0, kWidth, kHeight}}},
+    };
+
+    const double legacyMs = legacyFrameMs(frame);
+    const std::uint64_t legacyBytes = static_cast<std::uint64_t>(kWidth) * kHeight * 4;
+    std::printf("OSR presentation, %dx%d, %d frames per case\n", kWidth, kHeight, kFrames);
+    std::printf("%-18s %-10s %12s %14s\n", "case", "path", "ms/frame", "bytes/frame");
+    std::printf("%-18s %-10s %12.3f %14llu\n", "any", "legacy", legacyMs,
+                static_cast<unsigned long long>(legacyBytes));
+    for (const auto& scenario : scenarios) {
+        std::uint64_t bytes = 0;
+        const double identityMs = dirtyFrameMs(frame, image, identity, scenario.dirty, &bytes);
+        std::printf("%-18s %-10s %12.3f %14llu\n", scenario.name, "memcpy", identityMs,
+                    static_cast<unsigned long long>(bytes));
+        const double swizzleMs = dirtyFrameMs(frame, image, swizzle, scenario.dirty, &bytes);
+        std::printf("%-18s %-10s %12.3f %14llu\n", scenario.name, "swizzle", swizzleMs,
+                    static_cast<unsigned long long>(bytes));
+    }
+    return g_sink == 0xffffffffu ? 1 : 0;
+}
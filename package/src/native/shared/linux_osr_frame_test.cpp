@@ -0,0 +1,104 @@
+#include "linux_osr_frame.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using electrobun::LinuxOsrPixelFormat;
+using electrobun::LinuxOsrRect;
+using electrobun::clipLinuxOsrRect;
+using electrobun::copyLinuxOsrRect;
+using electrobun::describeLinuxOsrPixelFormat;
+using electrobun::planLinuxOsrUploads;
+
+static void expectRect(const LinuxOsrRect& rect, int x, int y, int width, int height) {
+    assert(rect.x == x);
+    assert(rect.y == y);
+    assert(rect.width == width);
+    assert(rect.height == height);
+}
+
+int main() {
+    LinuxOsrPixelFormat format = {};
+
+    // ARGB32 and RGB24 visuals on an LSB-first image take the memcpy path.
+    assert(describeLinuxOsrPixelFormat(32, 32, false, 0xff0000, 0xff00, 0xff, &format));
+    assert(format.identity);
+    assert(format.alphaShift == 24);
+    assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff0000, 0xff00, 0xff, &format));
+    assert(format.identity);
+    assert(format.alphaShift == -1);
+
+    // MSB-first servers and BGR visuals still need per-pixel stores.
+    assert(describeLinuxOsrPixelFormat(32, 32, true, 0xff0000, 0xff00, 0xff, &format));
+    assert(!format.identity);
+    assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff, 0xff00, 0xff0000, &format));
+    assert(!format.identity);
+    assert(format.redShift == 0);
+    assert(format.blueShift == 16);
+
+    // 16bpp and non-8-bit channels are not presentable through this path.
+    assert(!describeLinuxOsrPixelFormat(16, 16, false, 0xf800, 0x7e0, 0x1f, &format));
+    assert(!describeLinuxOsrPixelFormat(32, 30, false, 0x3ff00000, 0xffc00, 0x3ff, &format));
+
+    expectRect(clipLinuxOsrRect({-10, 5, 30, 10}, 100, 50), 0, 5, 20, 10);
+    expectRect(clipLinuxOsrRect({90, 45, 30, 30}, 100, 50), 90, 45, 10, 5);
+    assert(clipLinuxOsrRect({120, 0, 10, 10}, 100, 50).empty());
+    assert(clipLinuxOsrRect({0, 0, -5, 10}, 100, 50).empty());
+
+    // Sparse rects are uploaded individually.
+    const auto sparse = planLinuxOsrUploads({{0, 0, 10, 10}, {500, 300, 20, 20}}, 1920, 1080);
+    assert(sparse.size() == 2);
+    expectRect(sparse[1], 500, 300, 20, 20);
+
+    // Adjacent rects that fill their bounds collapse into one request.
+    const auto dense = planLinuxOsrUploads({{0, 0, 100, 50}, {0, 50, 100, 50}}, 1920, 1080);
+    assert(dense.size() == 1);
+    expectRect(dense[0], 0, 0, 100, 100);
+
+    // Too many rects collapse to the bounding box.
+    std::vector<LinuxOsrRect> many;
+    for (int i = 0; i < 20; ++i) {
+        many.push_back({i * 50, i * 20, 4, 4});
+    }
+    const auto capped = planLinuxOsrUploads(many, 1920, 1080);
+    assert(capped.size() == 1);
+    expectRect(capped[0], 0, 0, 954, 384);
+
+    // Off-surface damage produces no uploads.
+    assert(planLinuxOsrUploads({{2000, 0, 10, 10}}, 1920, 1080).empty());
+
+    // Only the requested rect is written; identity copies bytes unchanged.
+    const int width = 4;
+    const int height = 3;
+    std::vector<std::uint8_t> src(width * height * 4);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<std::uint8_t>(i);
+    }
+    std::vector<std::uint8_t> dst(src.size(), 0xee);
+    describeLinuxOsrPixelFormat(32, 32, false, 0xff0000, 0xff00, 0xff, &format);
+    copyLinuxOsrRect(src.data(), width * 4, dst.data(), width * 4, {1, 1, 2, 1}, format);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const std::size_t offset = (static_cast<std::size_t>(y) * width + x) * 4;
+            const bool inside = y == 1 && (x == 1 || x == 2);
+            for (int c = 0; c < 4; ++c) {
+                assert(dst[offset + c] == (inside ? src[offset + c] : 0xee));
+            }
+        }
+    }
+
+    // A BGR visual receives R in the low byte of an LSB-first pixel.
+    const std::uint8_t bgra[4] = {0x11, 0x22, 0x33, 0x44};
+    std::uint8_t out[4] = {};
+    describeLinuxOsrPixelFormat(32, 32, false, 0xff, 0xff00, 0xff0000, &format);
+    copyLinuxOsrRect(bgra, 4, out, 4, {0, 0, 1, 1}, format);
+    assert(out[0] == 0x33 && out[1] == 0x22 && out[2] == 0x11 && out[3] == 0x44);
+
+    // An MSB-first ARGB image stores alpha first.
+    describeLinuxOsrPixelFormat(32, 32, true, 0xff0000, 0xff00, 0xff, &format);
+    copyLinuxOsrRect(bgra, 4, out, 4, {0, 0, 1, 1}, format);
+    assert(out[0] == 0x44 && out[1] == 0x33 && out[2] == 0x22 && out[3] == 0x11);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+
+namespace electrobun {
+
+// Windowless CEF views keep producing frames until the browser host is told
+// otherwise. Combine X11 map/visibility state with the view's own hidden and
+// throttled flags into the two host controls that matter: WasHidden() and
+// SetWindowlessFrameRate().
+struct LinuxOsrPaintDecision {
+    bool hidden;
+    int frameRate;
+
+    bool operator==(const LinuxOsrPaintDecision& other) const {
+        return hidden == other.hidden && frameRate == other.frameRate;
+    }
+
+    bool operator!=(const LinuxOsrPaintDecision& other) const {
+        return !(*this == other);
+    }
+};
+
+class LinuxOsrPaintPolicy {
+public:
+    // CefBrowserSettings::windowless_frame_rate default and upper bound
+    // without shared-texture rendering.
+    static constexpr int kDefaultFrameRate = 30;
+    static constexpr int kMaximumFrameRate = 60;
+    // Throttled views still present occasional updates (clocks, progress).
+    static constexpr int kBackgroundFrameRate = 1;
+
+    // Mirrors X11 VisibilityNotify states.
+    enum class Visibility {
+        Unobscured,
+        PartiallyObscured,
+        FullyObscured,
+    };
+
+    // Zero restores Chromium's default.
+    void setForegroundFrameRate(int frameRate) {
+        foregroundFrameRate_ = frameRate <= 0 ? 0 :
+            std::min(frameRate, kMaximumFrameRate);
+    }
+
+    void setMapped(bool mapped) {
+        mapped_ = mapped;
+        // A freshly mapped window is visible until X reports otherwise.
+        if (mapped) {
+            visibility_ = Visibility::Unobscured;
+        }
+    }
+
+    void setVisibility(Visibility visibility) {
+        visibility_ = visibility;
+    }
+
+    void setHidden(bool hidden) {
+        hidden_ = hidden;
+    }
+
+    void setThrottled(bool throttled) {
+        throttled_ = throttled;
+    }
+
+    int foregroundFrameRate() const {
+        return foregroundFrameRate_ ? foregroundFrameRate_ : kDefaultFrameRate;
+    }
+
+    LinuxOsrPaintDecision decision() const {
+        const bool hidden = hidden_ || !mapped_ ||
+            visibility_ == Visibility::FullyObscured;
+        const int foreground = foregroundFrameRate();
+        return {
+            hidden,
+            throttled_ ? std::min(foreground, kBackgroundFrameRate) : foreground,
+        };
+    }
+
+private:
+    int foregroundFrameRate_ = 0;
+    bool mapped_ = true;
+    Visibility visibility_ = Visibility::Unobscured;
+    bool hidden_ = false;
+    bool throttled_ = false;
+};
+
+} // namespace electrobun
@@ -0,0 +1,62 @@
+#include "linux_osr_paint_policy.h"
+
+#include <cassert>
+
+using electrobun::LinuxOsrPaintDecision;
+using electrobun::LinuxOsrPaintPolicy;
+
+static void expectDecision(const LinuxOsrPaintPolicy& policy, bool hidden, int frameRate) {
+    const LinuxOsrPaintDecision decision = policy.decision();
+    assert(decision.hidden == hidden);
+    assert(decision.frameRate == frameRate);
+}
+
+int main() {
+    using Visibility = LinuxOsrPaintPolicy::Visibility;
+
+    // A new view paints at Chromium's default rate.
+    LinuxOsrPaintPolicy policy;
+    expectDecision(policy, false, LinuxOsrPaintPolicy::kDefaultFrameRate);
+
+    // Foreground rates are capped, and zero or less restores the default.
+    policy.setForegroundFrameRate(144);
+    assert(policy.foregroundFrameRate() == LinuxOsrPaintPolicy::kMaximumFrameRate);
+    policy.setForegroundFrameRate(24);
+    expectDecision(policy, false, 24);
+    policy.setForegroundFrameRate(-5);
+    assert(policy.foregroundFrameRate() == LinuxOsrPaintPolicy::kDefaultFrameRate);
+    policy.setForegroundFrameRate(24);
+
+    // Only a fully obscured window counts as hidden.
+    policy.setVisibility(Visibility::PartiallyObscured);
+    expectDecision(policy, false, 24);
+    policy.setVisibility(Visibility::FullyObscured);
+    expectDecision(policy, true, 24);
+
+    // Unmapping hides the view; mapping again clears a stale obscured state.
+    policy.setMapped(false);
+    expectDecision(policy, true, 24);
+    policy.setMapped(true);
+    expectDecision(policy, false, 24);
+
+    // The view's own hidden flag wins over X11 state.
+    policy.setHidden(true);
+    expectDecision(policy, true, 24);
+    policy.setHidden(false);
+
+    // Throttling drops to the background rate until it is lifted.
+    policy.setThrottled(true);
+    expectDecision(policy, false, LinuxOsrPaintPolicy::kBackgroundFrameRate);
+    policy.setThrottled(false);
+    expectDecision(policy, false, 24);
+
+    // Decisions compare by both controls, so unchanged ones can be skipped.
+    const LinuxOsrPaintDecision same = {false, 24};
+    const LinuxOsrPaintDecision slower = {false, 1};
+    const LinuxOsrPaintDecision hidden = {true, 24};
+    assert(policy.decision() == same);
+    assert(policy.decision() != slower);
+    assert(policy.decision() != hidden);
+
+    return 0;
+}
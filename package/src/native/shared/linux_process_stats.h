@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace electrobun {
+
+// What a process does for the app, from its name and command line.
+enum class LinuxProcessKind : std::uint32_t {
+    other = 0,
+    // The process hosting the native wrapper.
+    browser = 1,
+    renderer = 2,
+    gpu = 3,
+    utility = 4,
+    zygote = 5,
+    webkitWeb = 6,
+    webkitNetwork = 7,
+};
+
+// One process, copied verbatim to FFI callers as a 48-byte record. A
+// webview's renderer is reported once per webview using it; engine
+// processes that belong to no webview have webviewId 0.
+struct LinuxProcessStats {
+    std::uint32_t webviewId = 0;
+    // 0 when the webview's process is not known yet or cannot be known.
+    std::int32_t pid = 0;
+    std::uint64_t rssBytes = 0;
+    // Proportional set size: shared pages split between their users. 0 when
+    // the kernel does not provide smaps_rollup or it is not readable.
+    std::uint64_t pssBytes = 0;
+    // User plus system time.
+    std::uint64_t cpuTimeUs = 0;
+    std::uint32_t threads = 0;
+    std::uint32_t kind = 0;
+    std::uint64_t reserved = 0;
+};
+
+static_assert(sizeof(LinuxProcessStats) == 48, "process stats layout changed");
+
+// The fields of /proc/<pid>/stat used here.
+struct LinuxProcStat {
+    int pid = 0;
+    int ppid = 0;
+    std::string comm;
+    std::uint64_t cpuTicks = 0;
+    std::uint32_t threads = 0;
+    std::uint64_t rssPages = 0;
+};
+
+// Parses /proc/<pid>/stat. The command name may hold spaces and
+// parentheses, so fields are counted from the last ')'.
+inline bool parseLinuxProcStat(const std::string& stat, LinuxProcStat* out) {
+    const std::size_t open = stat.find('(');
+    const std::size_t close = stat.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) {
+        return false;
+    }
+    out->pid = std::atoi(stat.c_str());
+    out->comm = stat.substr(open + 1, close - open - 1);
+
+    // Fields from 3 (state) on, so field n is at index n - 3.
+    std::vector<const char*> fields;
+    const char* cursor = stat.c_str() + close + 1;
+    while (*cursor) {
+        while (*cursor == ' ') ++cursor;
+        if (!*cursor || *cursor == '\n') break;
+        fields.push_back(cursor);
+        while (*cursor && *cursor != ' ') ++cursor;
+    }
+    if (fields.size() < 22) {
+        return false;
+    }
+    out->ppid = std::atoi(fields[1]);
+    out->cpuTicks = std::strtoull(fields[11], nullptr, 10) + std::strtoull(fields[12], nullptr, 10);
+    out->threads = static_cast<std::uint32_t>(std::strtoul(fields[17], nullptr, 10));
+    out->rssPages = std::strtoull(fields[21], nullptr, 10);
+    return true;
+}
+
+// The Pss line of /proc/<pid>/smaps_rollup, in bytes; 0 when absent.
+inline std::uint64_t parseLinuxPssBytes(const std::string& smapsRollup) {
+    std::size_t line = 0;
+    while (line < smapsRollup.size()) {
+        if (smapsRollup.compare(line, 4, "Pss:") == 0) {
+            return std::strtoull(smapsRollup.c_str() + line + 4, nullptr, 10) * 1024;
+        }
+        const std::size_t next = smapsRollup.find('\n', line);
+        if (next == std::string::npos) break;
+        line = next + 1;
+    }
+    return 0;
+}
+
+// Classifies an engine process. `cmdline` is /proc/<pid>/cmdline with its
+// NUL separators; Chromium helpers carry --type=, WebKit's are named. The
+// kernel truncates comm to 15 characters.
+inline LinuxProcessKind classifyLinuxProcess(const std::string& comm, const std::string& cmdline) {
+    if (comm.compare(0, 15, "WebKitWebProces") == 0) {
+        return LinuxProcessKind::webkitWeb;
+    }
+    if (comm.compare(0, 15, "WebKitNetworkPr") == 0) {
+        return LinuxProcessKind::webkitNetwork;
+    }
+    std::size_t arg = 0;
+    while (arg < cmdline.size()) {
+        const char* value = cmdline.c_str() + arg;
+        if (std::strncmp(value, "--type=", 7) == 0) {
+            const std::string type = value + 7;
+            if (type == "renderer") return LinuxProcessKind::renderer;
+            if (type == "gpu-process") return LinuxProcessKind::gpu;
+            if (type == "utility") return LinuxProcessKind::utility;
+            if (type == "zygote") return LinuxProcessKind::zygote;
+            return LinuxProcessKind::other;
+        }
+        arg += std::strlen(value) + 1;
+    }
+    return LinuxProcessKind::other;
+}
+
+inline bool readLinuxProcFile(const std::string& path, std::string* out) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    out->clear();
+    char buffer[4096];
+    std::size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out->append(buffer, read);
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Reads processes from /proc for one stats call. Each process is read once
+// however many webviews share it, so make a new sampler per call.
+class LinuxProcessSampler {
+public:
+    LinuxProcessSampler(long ticksPerSecond, long pageSize, std::string procRoot = "/proc")
+        : ticksPerSecond_(ticksPerSecond > 0 ? ticksPerSecond : 100),
+          pageSize_(pageSize > 0 ? pageSize : 4096),
+          procRoot_(std::move(procRoot)) {}
+
+    // Read only /proc/<pid>/stat from now on: pssBytes stays 0 and kind
+    // comes from the process name alone, so WebKit's processes are told
+    // apart but Chromium's report other. For counting records and for
+    // samples where smaps_rollup, which walks every mapping, costs too much.
+    void setRssOnly(bool rssOnly) { rssOnly_ = rssOnly; }
+
+    // Fills `out` for `pid`, keeping its webviewId. False once the process
+    // has exited.
+    bool sample(int pid, LinuxProcessStats* out) {
+        auto cached = samples_.find(pid);
+        if (cached == samples_.end()) {
+            LinuxProcessStats stats;
+            std::string contents;
+            LinuxProcStat stat;
+            const std::string dir = procRoot_ + "/" + std::to_string(pid);
+            if (!readLinuxProcFile(dir + "/stat", &contents) || !parseLinuxProcStat(contents, &stat)) {
+                return false;
+            }
+            stats.pid = pid;
+            stats.rssBytes = stat.rssPages * static_cast<std::uint64_t>(pageSize_);
+            stats.cpuTimeUs = stat.cpuTicks * 1000000 / static_cast<std::uint64_t>(ticksPerSecond_);
+            stats.threads = stat.threads;
+            std::string cmdline;
+            if (!rssOnly_) {
+                if (readLinuxProcFile(dir + "/smaps_rollup", &contents)) {
+                    stats.pssBytes = parseLinuxPssBytes(contents);
+                }
+                readLinuxProcFile(dir + "/cmdline", &cmdline);
+            }
+            stats.kind = static_cast<std::uint32_t>(classifyLinuxProcess(stat.comm, cmdline));
+            cached = samples_.emplace(pid, stats).first;
+        }
+        const std::uint32_t webviewId = out->webviewId;
+        *out = cached->second;
+        out->webviewId = webviewId;
+        return true;
+    }
+
+    // Every live process descended from `root`, from one scan of /proc.
+    // Chromium renderers are children of its zygote, not of the browser.
+    std::vector<int> descendantsOf(int root) const {
+        std::multimap<int, int> children;
+        if (DIR* proc = opendir(procRoot_.c_str())) {
+            while (dirent* entry = readdir(proc)) {
+                const int pid = std::atoi(entry->d_name);
+                std::string contents;
+                LinuxProcStat stat;
+                if (pid > 0 &&
+                    readLinuxProcFile(procRoot_ + "/" + entry->d_name + "/stat", &contents) &&
+                    parseLinuxProcStat(contents, &stat)) {
+                    children.emplace(stat.ppid, pid);
+                }
+            }
+            closedir(proc);
+        }
+        std::vector<int> descendants;
+        std::vector<int> pending = {root};
+        while (!pending.empty()) {
+            const int parent = pending.back();
+            pending.pop_back();
+            auto range = children.equal_range(parent);
+            for (auto it = range.first; it != range.second; ++it) {
+                descendants.push_back(it->second);
+                pending.push_back(it->second);
+            }
+        }
+        return descendants;
+    }
+
+private:
+    long ticksPerSecond_;
+    long pageSize_;
+    std::string procRoot_;
+    bool rssOnly_ = false;
+    std::map<int, LinuxProcessStats> samples_;
+};
+
+} // namespace electrobun
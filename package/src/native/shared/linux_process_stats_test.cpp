@@ -0,0 +1,101 @@
+#include "linux_process_stats.h"
+
+#include <cassert>
+#include <csignal>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using electrobun::LinuxProcessKind;
+using electrobun::LinuxProcessSampler;
+using electrobun::LinuxProcessStats;
+using electrobun::LinuxProcStat;
+using electrobun::classifyLinuxProcess;
+using electrobun::parseLinuxProcStat;
+using electrobun::parseLinuxPssBytes;
+
+int main() {
+    {
+        // Fields are counted from the last ')', so odd names parse.
+        LinuxProcStat stat;
+        const std::string line =
+            "4242 (Web Content (x)) S 17 4242 4242 0 -1 4194560 100 0 0 0 "
+            "250 50 0 0 20 0 23 0 1000 123456789 2048 18446744073709551615\n";
+        assert(parseLinuxProcStat(line, &stat));
+        assert(stat.pid == 4242);
+        assert(stat.comm == "Web Content (x)");
+        assert(stat.ppid == 17);
+        assert(stat.cpuTicks == 300);
+        assert(stat.threads == 23);
+        assert(stat.rssPages == 2048);
+        assert(!parseLinuxProcStat("4242 (truncated) S 17 4242", &stat));
+        assert(!parseLinuxProcStat("", &stat));
+    }
+
+    {
+        const std::string rollup =
+            "55d0c0000000-7ffd00000000 ---p 00000000 00:00 0 [rollup]\n"
+            "Rss:              123456 kB\n"
+            "Pss:               98765 kB\n"
+            "Pss_Anon:          50000 kB\n";
+        assert(parseLinuxPssBytes(rollup) == 98765ull * 1024);
+        assert(parseLinuxPssBytes("Rss: 1 kB\n") == 0);
+    }
+
+    {
+        const std::string renderer("/app/bun\0--type=renderer\0--lang=en\0", 35);
+        const std::string gpu("/app/bun\0--type=gpu-process\0", 28);
+        const std::string zygote("/app/bun\0--type=zygote\0", 23);
+        const std::string other("/app/bun\0--type=ppapi\0", 22);
+        assert(classifyLinuxProcess("bun", renderer) == LinuxProcessKind::renderer);
+        assert(classifyLinuxProcess("bun", gpu) == LinuxProcessKind::gpu);
+        assert(classifyLinuxProcess("bun", zygote) == LinuxProcessKind::zygote);
+        assert(classifyLinuxProcess("bun", other) == LinuxProcessKind::other);
+        assert(classifyLinuxProcess("WebKitWebProces", "") == LinuxProcessKind::webkitWeb);
+        assert(classifyLinuxProcess("WebKitNetworkPr", "") == LinuxProcessKind::webkitNetwork);
+        assert(classifyLinuxProcess("bun", std::string("/app/bun\0", 9)) == LinuxProcessKind::other);
+    }
+
+    {
+        // The live process reads back with its webview id kept.
+        LinuxProcessSampler sampler(sysconf(_SC_CLK_TCK), sysconf(_SC_PAGESIZE));
+        LinuxProcessStats stats;
+        stats.webviewId = 9;
+        assert(sampler.sample(getpid(), &stats));
+        assert(stats.webviewId == 9);
+        assert(stats.pid == getpid());
+        assert(stats.rssBytes > 0);
+        assert(stats.threads >= 1);
+        assert(!sampler.sample(-1, &stats));
+
+        // RSS only leaves out PSS and the command line.
+        LinuxProcessSampler rssOnly(sysconf(_SC_CLK_TCK), sysconf(_SC_PAGESIZE));
+        rssOnly.setRssOnly(true);
+        LinuxProcessStats light;
+        assert(rssOnly.sample(getpid(), &light));
+        assert(light.rssBytes > 0 && light.pssBytes == 0);
+        assert(light.kind == static_cast<std::uint32_t>(LinuxProcessKind::other));
+    }
+
+    {
+        // A child shows up as a descendant, and a missing /proc finds none.
+        const pid_t child = fork();
+        if (child == 0) {
+            pause();
+            _exit(0);
+        }
+        LinuxProcessSampler sampler(sysconf(_SC_CLK_TCK), sysconf(_SC_PAGESIZE));
+        bool found = false;
+        for (const int pid : sampler.descendantsOf(getpid())) {
+            found = found || pid == child;
+        }
+        assert(found);
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+
+        LinuxProcessSampler missing(100, 4096, "/nonexistent-proc");
+        assert(missing.descendantsOf(1).empty());
+    }
+
+    return 0;
+}
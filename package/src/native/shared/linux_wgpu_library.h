@@ -0,0 +1,37 @@
+#pragma once
+
+#include <dlfcn.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace electrobun {
+
+// Opens the WGPU implementation. ELECTROBUN_WGPU_LIBRARY names an explicit
+// library, e.g. a software or stub Dawn for headless tests, and is the only
+// one tried when set. Otherwise each candidate path is tried in order, then
+// `soname` on the loader's search path. Returns nullptr and logs on failure.
+inline void* openWgpuLibrary(const std::vector<std::string>& candidates, const char* soname) {
+    if (const char* overridePath = std::getenv("ELECTROBUN_WGPU_LIBRARY")) {
+        if (*overridePath) {
+            void* handle = dlopen(overridePath, RTLD_NOW | RTLD_LOCAL);
+            if (!handle) {
+                std::fprintf(stderr, "WGPU: failed to load ELECTROBUN_WGPU_LIBRARY %s: %s\n", overridePath,
+                             dlerror());
+            }
+            return handle;
+        }
+    }
+    for (const std::string& path : candidates) {
+        if (void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)) return handle;
+    }
+    void* handle = dlopen(soname, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        std::fprintf(stderr, "WGPU: failed to load %s: %s\n", soname, dlerror());
+    }
+    return handle;
+}
+
+} // namespace electrobun
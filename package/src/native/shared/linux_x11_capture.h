@@ -0,0 +1,134 @@
+#pragma once
+
+#include "linux_osr_frame.h"
+#include "screen_capture_downscale.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace electrobun {
+
+// Device-pixel rectangle of the X root window that backs one logical
+// captureScreenRegion request.
+struct LinuxX11CaptureRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+// Map a logical request onto root-window device pixels. The root must cover
+// the whole request; XShmGetImage fails with BadMatch otherwise, and the GDK
+// path this replaces rejected clipped regions as well.
+inline bool mapLinuxX11CaptureRect(
+    std::int64_t left,
+    std::int64_t top,
+    std::uint32_t width,
+    std::uint32_t height,
+    int scale,
+    int rootDeviceWidth,
+    int rootDeviceHeight,
+    LinuxX11CaptureRect* rect
+) {
+    if (!rect || scale <= 0 || width == 0 || height == 0 ||
+        rootDeviceWidth <= 0 || rootDeviceHeight <= 0) {
+        return false;
+    }
+    const std::int64_t rootWidth = rootDeviceWidth / scale;
+    const std::int64_t rootHeight = rootDeviceHeight / scale;
+    if (left < 0 || top < 0 || left > rootWidth || top > rootHeight ||
+        static_cast<std::int64_t>(width) > rootWidth - left ||
+        static_cast<std::int64_t>(height) > rootHeight - top) {
+        return false;
+    }
+    rect->x = static_cast<int>(left * scale);
+    rect->y = static_cast<int>(top * scale);
+    rect->width = static_cast<int>(width) * scale;
+    rect->height = static_cast<int>(height) * scale;
+    return true;
+}
+
+namespace linux_x11_capture_detail {
+
+inline std::uint32_t loadPixel(const std::uint8_t* pixel, bool swap) {
+    std::uint32_t value;
+    std::memcpy(&value, pixel, sizeof(value));
+    if (swap) {
+        value = ((value & 0x000000ffu) << 24) | ((value & 0x0000ff00u) << 8) |
+            ((value & 0x00ff0000u) >> 8) | ((value & 0xff000000u) >> 24);
+    }
+    return value;
+}
+
+} // namespace linux_x11_capture_detail
+
+// Convert a 32bpp ZPixmap readback into opaque RGBA, one output pixel per
+// scale x scale block, sampling the block's centre device pixel like the GDK
+// path did. `source` points at the first device pixel of the captured area.
+// The common LSB-first xRGB visual at scale 1 is a straight word swizzle that
+// compilers vectorise; other layouts go through the visual's channel shifts.
+inline void convertLinuxX11CaptureToRgba(
+    const std::uint8_t* source,
+    std::size_t sourceStride,
+    const LinuxOsrPixelFormat& format,
+    int scale,
+    std::uint32_t width,
+    std::uint32_t height,
+    std::uint8_t* rgba
+) {
+    const std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+    const bool littleEndian = linux_osr_detail::hostIsLittleEndian();
+
+    if (format.identity && scale == 1 && littleEndian) {
+        for (std::uint32_t y = 0; y < height; ++y) {
+            const std::uint8_t* in = source + static_cast<std::size_t>(y) * sourceStride;
+            std::uint8_t* out = rgba + static_cast<std::size_t>(y) * rowBytes;
+            for (std::uint32_t x = 0; x < width; ++x) {
+                std::uint32_t pixel;
+                std::memcpy(&pixel, in + static_cast<std::size_t>(x) * 4, sizeof(pixel));
+                const std::uint32_t converted = ((pixel >> 16) & 0xffu) |
+                    (pixel & 0xff00u) | ((pixel & 0xffu) << 16) | 0xff000000u;
+                std::memcpy(out + static_cast<std::size_t>(x) * 4, &converted,
+                            sizeof(converted));
+            }
+        }
+        return;
+    }
+
+    const bool swap = format.msbFirst == littleEndian;
+    const int offset = scale / 2;
+    for (std::uint32_t y = 0; y < height; ++y) {
+        const std::uint8_t* in = source +
+            (static_cast<std::size_t>(y) * scale + offset) * sourceStride;
+        std::uint8_t* out = rgba + static_cast<std::size_t>(y) * rowBytes;
+        for (std::uint32_t x = 0; x < width; ++x, out += 4) {
+            const std::uint32_t pixel = linux_x11_capture_detail::loadPixel(
+                in + (static_cast<std::size_t>(x) * scale + offset) * 4, swap);
+            out[0] = static_cast<std::uint8_t>(pixel >> format.redShift);
+            out[1] = static_cast<std::uint8_t>(pixel >> format.greenShift);
+            out[2] = static_cast<std::uint8_t>(pixel >> format.blueShift);
+            out[3] = 0xff;
+        }
+    }
+}
+
+// Byte positions of a 32bpp visual's channels within the image data, for
+// the box-filtered path. False for channels that are not byte aligned.
+inline bool linuxX11CaptureChannelOrder(
+    const LinuxOsrPixelFormat& format,
+    ScreenCaptureChannelOrder* order
+) {
+    if (!order || format.redShift % 8 || format.greenShift % 8 ||
+        format.blueShift % 8) {
+        return false;
+    }
+    const auto byteIndex = [&format](int shift) {
+        return static_cast<std::uint8_t>(format.msbFirst ? 3 - shift / 8 : shift / 8);
+    };
+    *order = {byteIndex(format.redShift), byteIndex(format.greenShift),
+              byteIndex(format.blueShift)};
+    return true;
+}
+
+} // namespace electrobun
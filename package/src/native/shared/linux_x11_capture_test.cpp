@@ -0,0 +1,112 @@
+#include "linux_x11_capture.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using electrobun::LinuxOsrPixelFormat;
+using electrobun::LinuxX11CaptureRect;
+using electrobun::ScreenCaptureChannelOrder;
+using electrobun::convertLinuxX11CaptureToRgba;
+using electrobun::describeLinuxOsrPixelFormat;
+using electrobun::downscaleScreenCaptureBox;
+using electrobun::linuxX11CaptureChannelOrder;
+using electrobun::mapLinuxX11CaptureRect;
+
+static void storeWord(std::vector<std::uint8_t>& bytes, std::size_t offset,
+                      std::uint32_t value, bool msbFirst) {
+    for (int i = 0; i < 4; ++i) {
+        const int shift = msbFirst ? 24 - i * 8 : i * 8;
+        bytes[offset + i] = static_cast<std::uint8_t>(value >> shift);
+    }
+}
+
+int main() {
+    LinuxX11CaptureRect rect = {};
+
+    // Logical requests scale onto device pixels and must fit the root.
+    assert(mapLinuxX11CaptureRect(10, 20, 30, 40, 2, 1920, 1080, &rect));
+    assert(rect.x == 20 && rect.y == 40 && rect.width == 60 && rect.height == 80);
+    assert(mapLinuxX11CaptureRect(0, 0, 960, 540, 2, 1920, 1080, &rect));
+    assert(!mapLinuxX11CaptureRect(1, 0, 960, 540, 2, 1920, 1080, &rect));
+    assert(!mapLinuxX11CaptureRect(-1, 0, 1, 1, 1, 1920, 1080, &rect));
+    assert(!mapLinuxX11CaptureRect(0, 0, 0, 1, 1, 1920, 1080, &rect));
+    assert(!mapLinuxX11CaptureRect(0, 0, 1, 1, 0, 1920, 1080, &rect));
+    assert(!mapLinuxX11CaptureRect(0, 0, 1, 1, 1, 0, 1080, &rect));
+
+    LinuxOsrPixelFormat format = {};
+    std::uint8_t rgba[16] = {};
+
+    // LSB-first xRGB at scale 1 swizzles to opaque RGBA, ignoring padding.
+    {
+        assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff0000, 0xff00, 0xff, &format));
+        const int stride = 12;
+        std::vector<std::uint8_t> image(stride * 2, 0xee);
+        storeWord(image, 0, 0x00112233, false);
+        storeWord(image, 4, 0x7f445566, false);
+        storeWord(image, stride, 0x00778899, false);
+        storeWord(image, stride + 4, 0x00aabbcc, false);
+        convertLinuxX11CaptureToRgba(image.data(), stride, format, 1, 2, 2, rgba);
+        const std::uint8_t expected[16] = {
+            0x11, 0x22, 0x33, 0xff, 0x44, 0x55, 0x66, 0xff,
+            0x77, 0x88, 0x99, 0xff, 0xaa, 0xbb, 0xcc, 0xff,
+        };
+        for (int i = 0; i < 16; ++i) assert(rgba[i] == expected[i]);
+    }
+
+    // At scale 2 the centre device pixel of each 2x2 block is sampled.
+    {
+        const int stride = 16;
+        std::vector<std::uint8_t> image(stride * 4, 0);
+        storeWord(image, stride + 4, 0x00102030, false);
+        storeWord(image, stride + 12, 0x00405060, false);
+        convertLinuxX11CaptureToRgba(image.data(), stride, format, 2, 2, 1, rgba);
+        const std::uint8_t expected[8] = {0x10, 0x20, 0x30, 0xff, 0x40, 0x50, 0x60, 0xff};
+        for (int i = 0; i < 8; ++i) assert(rgba[i] == expected[i]);
+    }
+
+    // MSB-first servers and BGR visuals go through the channel shifts.
+    {
+        assert(describeLinuxOsrPixelFormat(32, 24, true, 0xff0000, 0xff00, 0xff, &format));
+        std::vector<std::uint8_t> image(4);
+        storeWord(image, 0, 0x00123456, true);
+        convertLinuxX11CaptureToRgba(image.data(), 4, format, 1, 1, 1, rgba);
+        assert(rgba[0] == 0x12 && rgba[1] == 0x34 && rgba[2] == 0x56 && rgba[3] == 0xff);
+
+        assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff, 0xff00, 0xff0000, &format));
+        storeWord(image, 0, 0x00563412, false);
+        convertLinuxX11CaptureToRgba(image.data(), 4, format, 1, 1, 1, rgba);
+        assert(rgba[0] == 0x12 && rgba[1] == 0x34 && rgba[2] == 0x56 && rgba[3] == 0xff);
+    }
+
+    // Thumbnails box-filter device pixels using the visual's byte positions.
+    {
+        ScreenCaptureChannelOrder order = {};
+        assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff0000, 0xff00, 0xff, &format));
+        assert(linuxX11CaptureChannelOrder(format, &order));
+        assert(order.red == 2 && order.green == 1 && order.blue == 0);
+        assert(describeLinuxOsrPixelFormat(32, 24, true, 0xff0000, 0xff00, 0xff, &format));
+        assert(linuxX11CaptureChannelOrder(format, &order));
+        assert(order.red == 1 && order.green == 2 && order.blue == 3);
+
+        // A 3x2 image into 2x1: columns split 0 | 1-2, rows are averaged.
+        assert(describeLinuxOsrPixelFormat(32, 24, false, 0xff0000, 0xff00, 0xff, &format));
+        assert(linuxX11CaptureChannelOrder(format, &order));
+        const int stride = 16;
+        std::vector<std::uint8_t> image(stride * 2, 0);
+        storeWord(image, 0, 0x00100000, false);
+        storeWord(image, stride, 0x00300000, false);
+        storeWord(image, 4, 0x00000010, false);
+        storeWord(image, 8, 0x00000020, false);
+        storeWord(image, stride + 4, 0x00000030, false);
+        storeWord(image, stride + 8, 0x00000041, false);
+        assert(downscaleScreenCaptureBox(image.data(), stride, 3, 2, order, 2, 1, rgba, 8));
+        const std::uint8_t expected[8] = {0x20, 0, 0, 0xff, 0, 0, 0x28, 0xff};
+        for (int i = 0; i < 8; ++i) assert(rgba[i] == expected[i]);
+
+        assert(!downscaleScreenCaptureBox(image.data(), 8, 3, 2, order, 2, 1, rgba, 8));
+        assert(!downscaleScreenCaptureBox(image.data(), stride, 3, 2, order, 0, 1, rgba, 8));
+    }
+
+    return 0;
+}
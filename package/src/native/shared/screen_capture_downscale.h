@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace electrobun {
+
+// Byte offsets of the colour channels inside one 32-bit source pixel. Both
+// capture backends read 4-byte pixels whose fourth byte is padding or alpha
+// that the opaque RGBA output ignores.
+struct ScreenCaptureChannelOrder {
+    std::uint8_t red;
+    std::uint8_t green;
+    std::uint8_t blue;
+};
+
+namespace screen_capture_downscale_detail {
+
+// Source column/row edges for each output column/row. Every output pixel
+// covers at least one source pixel, so this also works when the output is
+// larger along one axis than the source.
+inline void planSpans(
+    std::uint32_t source_extent,
+    std::uint32_t output_extent,
+    std::vector<std::uint32_t>* first,
+    std::vector<std::uint32_t>* last
+) {
+    first->resize(output_extent);
+    last->resize(output_extent);
+    for (std::uint32_t index = 0; index < output_extent; ++index) {
+        const std::uint32_t begin = static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(index) * source_extent / output_extent);
+        std::uint32_t end = static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(index + 1) * source_extent / output_extent);
+        if (end <= begin) {
+            end = begin + 1;
+        }
+        (*first)[index] = begin;
+        (*last)[index] = end;
+    }
+}
+
+} // namespace screen_capture_downscale_detail
+
+// Box-filter a packed 32-bit source into output_width x output_height opaque
+// RGBA pixels. Each output pixel is the rounded mean of the source pixels
+// whose index falls in its share of the source, so thumbnails of HiDPI
+// frames average every device pixel instead of sampling one per block.
+// Source rows are read once and in order; out_row_stride lets several
+// monitor frames fill one stitched output.
+inline bool downscaleScreenCaptureBox(
+    const std::uint8_t* source,
+    std::size_t source_row_stride,
+    std::uint32_t source_width,
+    std::uint32_t source_height,
+    ScreenCaptureChannelOrder order,
+    std::uint32_t output_width,
+    std::uint32_t output_height,
+    std::uint8_t* out_rgba,
+    std::size_t out_row_stride
+) {
+    if (!source || !out_rgba || source_width == 0 || source_height == 0 ||
+        output_width == 0 || output_height == 0 ||
+        source_row_stride < static_cast<std::size_t>(source_width) * 4 ||
+        out_row_stride < static_cast<std::size_t>(output_width) * 4 ||
+        order.red > 3 || order.green > 3 || order.blue > 3) {
+        return false;
+    }
+
+    std::vector<std::uint32_t> column_first;
+    std::vector<std::uint32_t> column_last;
+    std::vector<std::uint32_t> row_first;
+    std::vector<std::uint32_t> row_last;
+    screen_capture_downscale_detail::planSpans(
+        source_width, output_width, &column_first, &column_last);
+    screen_capture_downscale_detail::planSpans(
+        source_height, output_height, &row_first, &row_last);
+
+    std::vector<std::uint64_t> sums(static_cast<std::size_t>(output_width) * 3);
+    for (std::uint32_t output_y = 0; output_y < output_height; ++output_y) {
+        std::fill(sums.begin(), sums.end(), 0);
+        for (std::uint32_t y = row_first[output_y]; y < row_last[output_y]; ++y) {
+            const std::uint8_t* row =
+                source + static_cast<std::size_t>(y) * source_row_stride;
+            std::uint64_t* sum = sums.data();
+            for (std::uint32_t output_x = 0; output_x < output_width;
+                 ++output_x, sum += 3) {
+                std::uint32_t red = 0;
+                std::uint32_t green = 0;
+                std::uint32_t blue = 0;
+                const std::uint8_t* pixel =
+                    row + static_cast<std::size_t>(column_first[output_x]) * 4;
+                const std::uint8_t* end =
+                    row + static_cast<std::size_t>(column_last[output_x]) * 4;
+                for (; pixel < end; pixel += 4) {
+                    red += pixel[order.red];
+                    green += pixel[order.green];
+                    blue += pixel[order.blue];
+                }
+                sum[0] += red;
+                sum[1] += green;
+                sum[2] += blue;
+            }
+        }
+
+        const std::uint64_t rows = row_last[output_y] - row_first[output_y];
+        std::uint8_t* out =
+            out_rgba + static_cast<std::size_t>(output_y) * out_row_stride;
+        const std::uint64_t* sum = sums.data();
+        for (std::uint32_t output_x = 0; output_x < output_width;
+             ++output_x, sum += 3, out += 4) {
+            const std::uint64_t count =
+                rows * (column_last[output_x] - column_first[output_x]);
+            out[0] = static_cast<std::uint8_t>((sum[0] + count / 2) / count);
+            out[1] = static_cast<std::uint8_t>((sum[1] + count / 2) / count);
+            out[2] = static_cast<std::uint8_t>((sum[2] + count / 2) / count);
+            out[3] = 0xff;
+        }
+    }
+    return true;
+}
+
+} // namespace electrobun
@@ -0,0 +1,435 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace electrobun {
+
+// A cookie as the Session API sees it, independent of the engine's type.
+struct SessionCookie {
+    std::string name;
+    std::string value;
+    std::string domain;
+    std::string path;
+    bool secure = false;
+    bool httpOnly = false;
+    // Unix seconds; 0 for a session cookie.
+    std::int64_t expirationDate = 0;
+};
+
+// Readers for the flat objects the Session API sends, which JSON.stringify
+// builds from a known shape. A key is found by its quoted name followed by a
+// colon, so string values that happen to contain `"key":` can confuse them.
+inline bool findSessionJsonValue(const std::string& json, const char* key, std::size_t* valueStart) {
+    const std::string needle = std::string("\"") + key + "\"";
+    std::size_t position = 0;
+    while ((position = json.find(needle, position)) != std::string::npos) {
+        std::size_t cursor = position + needle.size();
+        while (cursor < json.size() && (json[cursor] == ' ' || json[cursor] == '\t' || json[cursor] == '\n')) {
+            ++cursor;
+        }
+        if (cursor < json.size() && json[cursor] == ':') {
+            ++cursor;
+            while (cursor < json.size() && (json[cursor] == ' ' || json[cursor] == '\t' || json[cursor] == '\n')) {
+                ++cursor;
+            }
+            *valueStart = cursor;
+            return true;
+        }
+        position = cursor;
+    }
+    return false;
+}
+
+inline void appendUtf8(std::string& out, std::uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// False when the key is missing or its value is not a string.
+inline bool readSessionJsonString(const std::string& json, const char* key, std::string* value) {
+    std::size_t cursor = 0;
+    if (!findSessionJsonValue(json, key, &cursor) || cursor >= json.size() || json[cursor] != '"') {
+        return false;
+    }
+    std::string result;
+    for (++cursor; cursor < json.size(); ++cursor) {
+        const char c = json[cursor];
+        if (c == '"') {
+            *value = std::move(result);
+            return true;
+        }
+        if (c != '\\') {
+            result += c;
+            continue;
+        }
+        if (++cursor >= json.size()) {
+            break;
+        }
+        switch (json[cursor]) {
+            case 'n': result += '\n'; break;
+            case 't': result += '\t'; break;
+            case 'r': result += '\r'; break;
+            case 'b': result += '\b'; break;
+            case 'f': result += '\f'; break;
+            case 'u': {
+                if (cursor + 4 >= json.size()) {
+                    return false;
+                }
+                std::uint32_t codePoint =
+                    static_cast<std::uint32_t>(std::strtoul(json.substr(cursor + 1, 4).c_str(), nullptr, 16));
+                cursor += 4;
+                // A surrogate pair arrives as two escapes.
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && cursor + 6 < json.size() &&
+                    json[cursor + 1] == '\\' && json[cursor + 2] == 'u') {
+                    const std::uint32_t low =
+                        static_cast<std::uint32_t>(std::strtoul(json.substr(cursor + 3, 4).c_str(), nullptr, 16));
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        cursor += 6;
+                    }
+                }
+                appendUtf8(result, codePoint);
+                break;
+            }
+            default: result += json[cursor]; break;
+        }
+    }
+    return false;
+}
+
+// False when the key is missing or its value is not a boolean.
+inline bool readSessionJsonBool(const std::string& json, const char* key, bool* value) {
+    std::size_t cursor = 0;
+    if (!findSessionJsonValue(json, key, &cursor)) {
+        return false;
+    }
+    if (json.compare(cursor, 4, "true") == 0) {
+        *value = true;
+        return true;
+    }
+    if (json.compare(cursor, 5, "false") == 0) {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+
+// False when the key is missing or its value is not a number.
+inline bool readSessionJsonNumber(const std::string& json, const char* key, double* value) {
+    std::size_t cursor = 0;
+    if (!findSessionJsonValue(json, key, &cursor)) {
+        return false;
+    }
+    const char* start = json.c_str() + cursor;
+    char* end = nullptr;
+    const double parsed = std::strtod(start, &end);
+    if (end == start) {
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+inline void appendSessionJsonString(std::string& out, const std::string& value) {
+    out += '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    static const char kHex[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out += kHex[(c >> 4) & 0xF];
+                    out += kHex[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+inline void appendSessionCookieJson(std::string& json, const SessionCookie& cookie) {
+    json += "{\"name\":";
+    appendSessionJsonString(json, cookie.name);
+    json += ",\"value\":";
+    appendSessionJsonString(json, cookie.value);
+    json += ",\"domain\":";
+    appendSessionJsonString(json, cookie.domain);
+    json += ",\"path\":";
+    appendSessionJsonString(json, cookie.path);
+    json += ",\"secure\":";
+    json += cookie.secure ? "true" : "false";
+    json += ",\"httpOnly\":";
+    json += cookie.httpOnly ? "true" : "false";
+    if (cookie.expirationDate > 0) {
+        json += ",\"expirationDate\":" + std::to_string(cookie.expirationDate);
+    }
+    json += '}';
+}
+
+// Serializes cookies one at a time as they are visited, either as the
+// `Cookie[]` JSON that Session.cookies.get resolves with or as a JSON-lines
+// jar (one object per line) for export and import.
+class SessionCookieWriter {
+public:
+    explicit SessionCookieWriter(bool lines = false) : lines_(lines) {
+        if (!lines_) {
+            json_ = "[";
+        }
+    }
+
+    void add(const SessionCookie& cookie) {
+        if (!lines_ && count_ > 0) {
+            json_ += ',';
+        }
+        appendSessionCookieJson(json_, cookie);
+        if (lines_) {
+            json_ += '\n';
+        }
+        ++count_;
+    }
+
+    std::size_t count() const {
+        return count_;
+    }
+
+    std::string finish() {
+        if (!lines_) {
+            json_ += ']';
+        }
+        return std::move(json_);
+    }
+
+private:
+    bool lines_;
+    std::size_t count_ = 0;
+    std::string json_;
+};
+
+inline std::string serializeSessionCookies(const std::vector<SessionCookie>& cookies) {
+    SessionCookieWriter writer;
+    for (const SessionCookie& cookie : cookies) {
+        writer.add(cookie);
+    }
+    return writer.finish();
+}
+
+// Walks a JSON-lines jar without copying it, skipping blank lines.
+class SessionCookieLineReader {
+public:
+    SessionCookieLineReader(const char* data, std::size_t length) : data_(data), length_(length) {}
+
+    bool next(std::string* line) {
+        while (offset_ < length_) {
+            const void* found = std::memchr(data_ + offset_, '\n', length_ - offset_);
+            const std::size_t end = found
+                ? static_cast<std::size_t>(static_cast<const char*>(found) - data_)
+                : length_;
+            std::size_t start = offset_;
+            offset_ = end + 1;
+            std::size_t stop = end;
+            while (start < stop && (data_[start] == ' ' || data_[start] == '\t' || data_[start] == '\r')) {
+                ++start;
+            }
+            while (stop > start && (data_[stop - 1] == ' ' || data_[stop - 1] == '\t' || data_[stop - 1] == '\r')) {
+                --stop;
+            }
+            if (stop > start) {
+                line->assign(data_ + start, stop - start);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool done() const {
+        return offset_ >= length_;
+    }
+
+private:
+    const char* data_;
+    std::size_t length_;
+    std::size_t offset_ = 0;
+};
+
+// Host part of an http(s) URL, without port or userinfo.
+inline std::string sessionUrlHost(const std::string& url) {
+    std::size_t start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    std::size_t end = url.find_first_of("/?#", start);
+    std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    const std::size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+        authority.erase(0, at + 1);
+    }
+    if (!authority.empty() && authority[0] == '[') {
+        const std::size_t close = authority.find(']');
+        return close == std::string::npos ? authority : authority.substr(0, close + 1);
+    }
+    const std::size_t colon = authority.find(':');
+    return colon == std::string::npos ? authority : authority.substr(0, colon);
+}
+
+// Parse a `Cookie` for set(). The domain falls back to the host of `url` and
+// the path to "/". False without a name or a domain.
+inline bool parseSessionCookie(const std::string& json, SessionCookie* cookie, std::string* url) {
+    SessionCookie parsed;
+    std::string cookieUrl;
+    readSessionJsonString(json, "name", &parsed.name);
+    readSessionJsonString(json, "value", &parsed.value);
+    readSessionJsonString(json, "domain", &parsed.domain);
+    readSessionJsonString(json, "path", &parsed.path);
+    readSessionJsonString(json, "url", &cookieUrl);
+    readSessionJsonBool(json, "secure", &parsed.secure);
+    readSessionJsonBool(json, "httpOnly", &parsed.httpOnly);
+    double expirationDate = 0;
+    if (readSessionJsonNumber(json, "expirationDate", &expirationDate) && expirationDate > 0) {
+        parsed.expirationDate = static_cast<std::int64_t>(expirationDate);
+    }
+    if (parsed.name.empty()) {
+        return false;
+    }
+    if (parsed.domain.empty() && !cookieUrl.empty()) {
+        parsed.domain = sessionUrlHost(cookieUrl);
+    }
+    if (parsed.domain.empty()) {
+        return false;
+    }
+    if (parsed.path.empty()) {
+        parsed.path = "/";
+    }
+    *cookie = std::move(parsed);
+    if (url) {
+        *url = std::move(cookieUrl);
+    }
+    return true;
+}
+
+// A URL that a cookie applies to, for engines whose setters and deleters
+// take one instead of a domain.
+inline std::string sessionCookieUrl(const SessionCookie& cookie) {
+    const std::string host = !cookie.domain.empty() && cookie.domain[0] == '.'
+        ? cookie.domain.substr(1)
+        : cookie.domain;
+    return std::string(cookie.secure ? "https://" : "http://") + host +
+           (cookie.path.empty() ? "/" : cookie.path);
+}
+
+// The `CookieFilter` passed to get(). Empty strings and unset booleans match
+// every cookie.
+struct SessionCookieFilter {
+    std::string url;
+    std::string name;
+    std::string domain;
+    std::string path;
+    bool hasSecure = false;
+    bool secure = false;
+    bool hasSession = false;
+    bool session = false;
+
+    static SessionCookieFilter parse(const std::string& json) {
+        SessionCookieFilter filter;
+        readSessionJsonString(json, "url", &filter.url);
+        readSessionJsonString(json, "name", &filter.name);
+        readSessionJsonString(json, "domain", &filter.domain);
+        readSessionJsonString(json, "path", &filter.path);
+        filter.hasSecure = readSessionJsonBool(json, "secure", &filter.secure);
+        filter.hasSession = readSessionJsonBool(json, "session", &filter.session);
+        return filter;
+    }
+
+    // `url` is left to the engine, which selects cookies for it. A domain
+    // matches itself and its subdomains, ignoring a leading dot on either.
+    bool matches(const SessionCookie& cookie) const {
+        if (!name.empty() && cookie.name != name) {
+            return false;
+        }
+        if (!path.empty() && cookie.path != path) {
+            return false;
+        }
+        if (hasSecure && cookie.secure != secure) {
+            return false;
+        }
+        if (hasSession && (cookie.expirationDate == 0) != session) {
+            return false;
+        }
+        if (!domain.empty()) {
+            const std::string wanted = domain[0] == '.' ? domain.substr(1) : domain;
+            const std::string actual = !cookie.domain.empty() && cookie.domain[0] == '.'
+                ? cookie.domain.substr(1)
+                : cookie.domain;
+            if (actual != wanted &&
+                !(actual.size() > wanted.size() &&
+                  actual.compare(actual.size() - wanted.size(), wanted.size(), wanted) == 0 &&
+                  actual[actual.size() - wanted.size() - 1] == '.')) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Results of asynchronous session calls, held until the JS thread copies
+// them out. Completions signal only an id and a length, because a threadsafe
+// FFI callback runs after the native caller has returned.
+class SessionResultStore {
+public:
+    void put(std::uint32_t requestId, std::string result) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_[requestId] = std::move(result);
+    }
+
+    // Copy a result into `out` and forget it. False when the id is unknown
+    // or `out` is too small; a too-small buffer keeps the result.
+    bool take(std::uint32_t requestId, std::uint8_t* out, std::uint64_t outLength) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = results_.find(requestId);
+        if (it == results_.end() || !out || outLength < it->second.size()) {
+            return false;
+        }
+        std::memcpy(out, it->second.data(), it->second.size());
+        results_.erase(it);
+        return true;
+    }
+
+    void discard(std::uint32_t requestId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.erase(requestId);
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return results_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::uint32_t, std::string> results_;
+};
+
+} // namespace electrobun
@@ -0,0 +1,141 @@
+// Measures the CPU side of Session.cookies.exportAsync and importAsync on
+// synthetic jars, so it runs without WebKit or CEF. "export" serializes a
+// jar to JSON lines the way the cookie visitors do; "import" walks the lines
+// and parses each cookie as the import pump does before handing it to the
+// engine; "get" is the filtered `Cookie[]` path for comparison.
+#include "session_cookies.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using electrobun::SessionCookie;
+using electrobun::SessionCookieFilter;
+using electrobun::SessionCookieLineReader;
+using electrobun::SessionCookieWriter;
+using electrobun::parseSessionCookie;
+
+namespace {
+
+constexpr double kMinimumSeconds = 0.2;
+constexpr int kMinimumCalls = 3;
+const std::size_t kJarSizes[] = {1000, 10000, 50000};
+
+volatile std::size_t g_sink = 0;
+
+struct Result {
+    double millisecondsPerJar;
+    double cookiesPerSecond;
+    double megabytesPerSecond;
+};
+
+template <typename Call>
+bool measure(std::size_t cookies, std::size_t bytes, Call call, Result* result) {
+    if (!call()) {
+        return false;
+    }
+    int calls = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (calls < kMinimumCalls || seconds < kMinimumSeconds) {
+        if (!call()) {
+            return false;
+        }
+        ++calls;
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
+    }
+    result->millisecondsPerJar = seconds * 1e3 / calls;
+    result->cookiesPerSecond = static_cast<double>(cookies) * calls / seconds;
+    result->megabytesPerSecond = static_cast<double>(bytes) * calls / seconds / 1e6;
+    return true;
+}
+
+void printResult(const char* path, std::size_t cookies, const Result& result) {
+    std::printf("%-7s %7zu %10.2f %12.0f %8.1f\n", path, cookies,
+                result.millisecondsPerJar, result.cookiesPerSecond,
+                result.megabytesPerSecond);
+}
+
+// Cookies spread over 100 domains, with values the size of a typical
+// session token and a few characters that need escaping.
+std::vector<SessionCookie> makeJar(std::size_t count) {
+    std::vector<SessionCookie> jar(count);
+    for (std::size_t index = 0; index < count; ++index) {
+        SessionCookie& cookie = jar[index];
+        cookie.name = "cookie_" + std::to_string(index);
+        cookie.value = std::string(48, static_cast<char>('a' + index % 26)) + "\"=/" +
+                       std::to_string(index * 2654435761u);
+        cookie.domain = ".site" + std::to_string(index % 100) + ".example.com";
+        cookie.path = index % 3 == 0 ? "/" : "/app";
+        cookie.secure = index % 2 == 0;
+        cookie.httpOnly = index % 5 == 0;
+        cookie.expirationDate = index % 4 == 0 ? 0 : 1700000000 + static_cast<std::int64_t>(index);
+    }
+    return jar;
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Session cookie jar codec, at least %.0f ms per case\n",
+                kMinimumSeconds * 1000);
+    std::printf("%-7s %7s %10s %12s %8s\n", "path", "cookies", "ms/jar", "cookies/s", "MB/s");
+    for (const std::size_t count : kJarSizes) {
+        const std::vector<SessionCookie> jar = makeJar(count);
+        SessionCookieWriter jarWriter(true);
+        for (const SessionCookie& cookie : jar) {
+            jarWriter.add(cookie);
+        }
+        const std::string lines = jarWriter.finish();
+
+        Result result = {};
+        measure(count, lines.size(), [&] {
+            SessionCookieWriter writer(true);
+            for (const SessionCookie& cookie : jar) {
+                writer.add(cookie);
+            }
+            g_sink += writer.finish().size();
+            return true;
+        }, &result);
+        printResult("export", count, result);
+
+        if (!measure(count, lines.size(), [&] {
+                SessionCookieLineReader reader(lines.data(), lines.size());
+                std::string line;
+                SessionCookie cookie;
+                std::string url;
+                std::size_t parsed = 0;
+                while (reader.next(&line)) {
+                    if (!parseSessionCookie(line, &cookie, &url)) {
+                        return false;
+                    }
+                    ++parsed;
+                }
+                g_sink += parsed;
+                return parsed == count;
+            }, &result)) {
+            std::fprintf(stderr, "Import parse failed for a %zu-cookie jar\n", count);
+            return 1;
+        }
+        printResult("import", count, result);
+
+        const SessionCookieFilter filter = SessionCookieFilter::parse("{\"domain\":\"example.com\"}");
+        measure(count, lines.size(), [&] {
+            SessionCookieWriter writer;
+            for (const SessionCookie& cookie : jar) {
+                if (filter.matches(cookie)) {
+                    writer.add(cookie);
+                }
+            }
+            g_sink += writer.count();
+            return true;
+        }, &result);
+        printResult("get", count, result);
+    }
+    return g_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+#include "session_cookies.h"
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using electrobun::SessionCookie;
+using electrobun::SessionCookieFilter;
+using electrobun::SessionCookieLineReader;
+using electrobun::SessionCookieWriter;
+using electrobun::SessionResultStore;
+using electrobun::parseSessionCookie;
+using electrobun::readSessionJsonString;
+using electrobun::serializeSessionCookies;
+using electrobun::sessionCookieUrl;
+using electrobun::sessionUrlHost;
+
+int main() {
+    {
+        // Escapes survive a round trip, including quotes that the old
+        // find-the-next-quote parsing cut short.
+        SessionCookie cookie;
+        cookie.name = "token";
+        cookie.value = "a\"b\\c\n\x01";
+        cookie.domain = ".example.com";
+        cookie.path = "/";
+        cookie.secure = true;
+        cookie.expirationDate = 1700000000;
+        const std::string json = serializeSessionCookies({cookie});
+        assert(json ==
+               "[{\"name\":\"token\",\"value\":\"a\\\"b\\\\c\\n\\u0001\",\"domain\":\".example.com\","
+               "\"path\":\"/\",\"secure\":true,\"httpOnly\":false,\"expirationDate\":1700000000}]");
+        std::string value;
+        assert(readSessionJsonString(json, "value", &value) && value == cookie.value);
+        assert(serializeSessionCookies({}) == "[]");
+    }
+
+    {
+        // \u escapes decode to UTF-8, surrogate pairs included.
+        std::string value;
+        assert(readSessionJsonString("{\"value\": \"caf\\u00e9 \\ud83c\\udf6a\"}", "value", &value));
+        assert(value == "caf\xc3\xa9 \xf0\x9f\x8d\xaa");
+        assert(!readSessionJsonString("{\"value\":12}", "value", &value));
+        assert(!readSessionJsonString("{\"other\":\"x\"}", "value", &value));
+    }
+
+    {
+        // The domain falls back to the URL's host and the path to "/".
+        SessionCookie cookie;
+        std::string url;
+        assert(parseSessionCookie(
+            "{\"name\":\"sid\",\"value\":\"1\",\"url\":\"https://user@app.example.com:8443/a?b\","
+            "\"httpOnly\":true,\"expirationDate\":1700000000.5}",
+            &cookie, &url));
+        assert(cookie.domain == "app.example.com" && cookie.path == "/");
+        assert(cookie.httpOnly && !cookie.secure && cookie.expirationDate == 1700000000);
+        assert(url == "https://user@app.example.com:8443/a?b");
+        assert(!parseSessionCookie("{\"value\":\"1\",\"domain\":\"example.com\"}", &cookie, nullptr));
+        assert(!parseSessionCookie("{\"name\":\"sid\"}", &cookie, nullptr));
+        assert(sessionUrlHost("http://[::1]:3000/") == "[::1]");
+
+        SessionCookie secure;
+        secure.domain = ".example.com";
+        secure.path = "/api";
+        secure.secure = true;
+        assert(sessionCookieUrl(secure) == "https://example.com/api");
+    }
+
+    {
+        SessionCookie cookie;
+        cookie.name = "sid";
+        cookie.domain = ".app.example.com";
+        cookie.path = "/";
+        assert(SessionCookieFilter::parse("{}").matches(cookie));
+        assert(SessionCookieFilter::parse("{\"domain\":\"example.com\"}").matches(cookie));
+        assert(SessionCookieFilter::parse("{\"domain\":\".app.example.com\"}").matches(cookie));
+        assert(!SessionCookieFilter::parse("{\"domain\":\"ample.com\"}").matches(cookie));
+        assert(!SessionCookieFilter::parse("{\"name\":\"other\"}").matches(cookie));
+        assert(SessionCookieFilter::parse("{\"session\":true}").matches(cookie));
+        cookie.expirationDate = 1;
+        assert(!SessionCookieFilter::parse("{\"session\":true}").matches(cookie));
+        assert(!SessionCookieFilter::parse("{\"secure\":true}").matches(cookie));
+        // The url is left to the engine.
+        assert(SessionCookieFilter::parse("{\"url\":\"https://other.test\"}").matches(cookie));
+    }
+
+    {
+        // A JSON-lines jar holds one cookie per line and reads back through
+        // parseSessionCookie; blank lines and CRLF endings are skipped.
+        SessionCookie first;
+        first.name = "a";
+        first.value = "line\nbreak";
+        first.domain = "example.com";
+        first.path = "/";
+        SessionCookie second = first;
+        second.name = "b";
+        second.httpOnly = true;
+        SessionCookieWriter writer(true);
+        writer.add(first);
+        writer.add(second);
+        assert(writer.count() == 2);
+        std::string jar = writer.finish();
+        assert(jar.back() == '\n' && jar.find("\n") < jar.size() - 1);
+        jar = "\r\n" + jar.substr(0, jar.find('\n')) + "\r\n\n  \n" + jar.substr(jar.find('\n') + 1);
+
+        SessionCookieLineReader reader(jar.data(), jar.size());
+        std::vector<SessionCookie> read;
+        std::string line;
+        while (reader.next(&line)) {
+            SessionCookie cookie;
+            assert(parseSessionCookie(line, &cookie, nullptr));
+            read.push_back(cookie);
+        }
+        assert(reader.done());
+        assert(read.size() == 2);
+        assert(read[0].name == "a" && read[0].value == "line\nbreak" && !read[0].httpOnly);
+        assert(read[1].name == "b" && read[1].httpOnly);
+
+        // A final line without a newline still counts.
+        const std::string tail = "{\"name\":\"c\",\"value\":\"\",\"domain\":\"x.test\"}";
+        SessionCookieLineReader tailReader(tail.data(), tail.size());
+        assert(tailReader.next(&line) && line == tail && !tailReader.next(&line));
+        SessionCookieLineReader empty(nullptr, 0);
+        assert(!empty.next(&line));
+    }
+
+    {
+        SessionResultStore store;
+        store.put(7, "[1,2]");
+        std::uint8_t small[2] = {};
+        assert(!store.take(7, small, sizeof(small)));
+        assert(store.size() == 1);
+        std::uint8_t out[5] = {};
+        assert(store.take(7, out, sizeof(out)));
+        assert(std::string(reinterpret_cast<char*>(out), 5) == "[1,2]");
+        assert(!store.take(7, out, sizeof(out)));
+        store.put(8, "x");
+        store.discard(8);
+        assert(store.size() == 0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace electrobun {
+
+// Points to the file a native wrapper writes its startup trace to. Tracing
+// is off unless it is set. "1" picks electrobun-startup-<pid>.json in the
+// temporary directory.
+constexpr const char* kStartupTraceEnvironment = "ELECTROBUN_STARTUP_TRACE";
+
+inline std::string resolveStartupTracePath(const char* value, const char* tmpDir, long pid) {
+    if (!value || value[0] == '\0') {
+        return std::string();
+    }
+    if (std::string(value) != "1") {
+        return value;
+    }
+    std::string dir = tmpDir && tmpDir[0] ? tmpDir : "/tmp";
+    return dir + "/electrobun-startup-" + std::to_string(pid) + ".json";
+}
+
+// Startup phases in Chrome trace event format, loadable by chrome://tracing
+// and Perfetto. Timestamps are microseconds on the steady clock, so traces
+// from other processes on the same boot line up. Thread ids are small
+// numbers assigned on a thread's first event, named with nameThread.
+// Thread safe.
+class StartupTrace {
+public:
+    static std::int64_t nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // A phase that ran from startUs to endUs on the calling thread.
+    void complete(const char* name, std::int64_t startUs, std::int64_t endUs,
+                  std::string detail = std::string()) {
+        add({'X', name, startUs, endUs - startUs, threadId(), std::move(detail)});
+    }
+
+    // A point in time on the calling thread, such as a first paint.
+    void instant(const char* name, std::string detail = std::string()) {
+        add({'i', name, nowUs(), 0, threadId(), std::move(detail)});
+    }
+
+    void nameThread(const char* name) {
+        add({'M', name, 0, 0, threadId(), std::string()});
+    }
+
+    // True the first time it is called with `name`, so one-off phases like
+    // the first window are recorded once.
+    bool claimFirst(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return claimed_.insert(name).second;
+    }
+
+    std::string toJson(long pid) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (std::size_t index = 0; index < events_.size(); ++index) {
+            const Event& event = events_[index];
+            if (index > 0) json += ',';
+            json += "\n{\"ph\":\"";
+            json += event.phase;
+            json += "\",\"pid\":" + std::to_string(pid);
+            json += ",\"tid\":" + std::to_string(event.tid);
+            if (event.phase == 'M') {
+                json += ",\"name\":\"thread_name\",\"args\":{\"name\":";
+                appendString(json, event.name);
+                json += "}}";
+                continue;
+            }
+            json += ",\"cat\":\"startup\",\"name\":";
+            appendString(json, event.name);
+            json += ",\"ts\":" + std::to_string(event.ts);
+            if (event.phase == 'X') {
+                json += ",\"dur\":" + std::to_string(event.dur);
+            } else {
+                json += ",\"s\":\"p\"";
+            }
+            if (!event.detail.empty()) {
+                json += ",\"args\":{\"detail\":";
+                appendString(json, event.detail);
+                json += '}';
+            }
+            json += '}';
+        }
+        json += "\n]}\n";
+        return json;
+    }
+
+    // Replaces `path` with the events so far. Written through a temporary
+    // file so a reader never sees half a trace.
+    bool write(const std::string& path, long pid) const {
+        const std::string json = toJson(pid);
+        const std::string temporary = path + ".tmp";
+        FILE* file = std::fopen(temporary.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        if (std::fclose(file) != 0 || !written) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    struct Event {
+        char phase;
+        const char* name;
+        std::int64_t ts;
+        std::int64_t dur;
+        std::uint32_t tid;
+        std::string detail;
+    };
+
+    static std::uint32_t threadId() {
+        static std::atomic<std::uint32_t> nextId{0};
+        thread_local std::uint32_t id = 0;
+        if (id == 0) {
+            id = nextId.fetch_add(1) + 1;
+        }
+        return id;
+    }
+
+    void add(Event event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(std::move(event));
+    }
+
+    static void appendString(std::string& json, const std::string& value) {
+        json += '"';
+        for (const char c : value) {
+            switch (c) {
+                case '"': json += "\\\""; break;
+                case '\\': json += "\\\\"; break;
+                case '\n': json += "\\n"; break;
+                case '\r': json += "\\r"; break;
+                case '\t': json += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        json += escaped;
+                    } else {
+                        json += c;
+                    }
+            }
+        }
+        json += '"';
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+    std::set<std::string> claimed_;
+};
+
+// Records the enclosing block as a complete phase. A null trace records
+// nothing, which is how call sites stay cheap while tracing is off.
+class StartupTraceScope {
+public:
+    StartupTraceScope(StartupTrace* trace, const char* name, std::string detail = std::string())
+        : trace_(trace), name_(name), detail_(std::move(detail)),
+          startUs_(trace ? StartupTrace::nowUs() : 0) {}
+
+    ~StartupTraceScope() {
+        if (trace_) {
+            trace_->complete(name_, startUs_, StartupTrace::nowUs(), std::move(detail_));
+        }
+    }
+
+    StartupTraceScope(const StartupTraceScope&) = delete;
+    StartupTraceScope& operator=(const StartupTraceScope&) = delete;
+
+private:
+    StartupTrace* trace_;
+    const char* name_;
+    std::string detail_;
+    std::int64_t startUs_;
+};
+
+} // namespace electrobun
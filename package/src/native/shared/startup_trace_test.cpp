@@ -0,0 +1,86 @@
+#include "startup_trace.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using electrobun::StartupTrace;
+using electrobun::StartupTraceScope;
+using electrobun::resolveStartupTracePath;
+
+int main() {
+    {
+        // Unset or empty disables tracing; "1" picks a per-process file.
+        assert(resolveStartupTracePath(nullptr, "/tmp", 7).empty());
+        assert(resolveStartupTracePath("", "/tmp", 7).empty());
+        assert(resolveStartupTracePath("1", "/var/tmp", 42) == "/var/tmp/electrobun-startup-42.json");
+        assert(resolveStartupTracePath("1", nullptr, 42) == "/tmp/electrobun-startup-42.json");
+        assert(resolveStartupTracePath("/x/trace.json", "/tmp", 42) == "/x/trace.json");
+    }
+
+    {
+        // Complete, instant and thread name events in Chrome's field names.
+        StartupTrace trace;
+        trace.nameThread("main");
+        trace.complete("initializeGTK", 1000, 1250);
+        trace.instant("firstPaint", "webview \"1\"");
+        const std::string json = trace.toJson(99);
+        assert(json.find("\"traceEvents\":[") != std::string::npos);
+        assert(json.find("{\"ph\":\"M\",\"pid\":99,\"tid\":1,\"name\":\"thread_name\",\"args\":{\"name\":\"main\"}}") != std::string::npos);
+        assert(json.find("\"name\":\"initializeGTK\",\"ts\":1000,\"dur\":250}") != std::string::npos);
+        assert(json.find("\"ph\":\"i\"") != std::string::npos);
+        assert(json.find("\"s\":\"p\",\"args\":{\"detail\":\"webview \\\"1\\\"\"}") != std::string::npos);
+        assert(json.compare(json.size() - 4, 4, "\n]}\n") == 0);
+    }
+
+    {
+        // Each thread gets its own id, stable across events.
+        StartupTrace trace;
+        trace.instant("main");
+        std::thread([&] { trace.instant("worker"); trace.instant("worker"); }).join();
+        trace.instant("main");
+        const std::string json = trace.toJson(1);
+        const std::size_t mainTid = json.find("\"tid\":");
+        const std::string firstTid = json.substr(mainTid, json.find(',', mainTid) - mainTid);
+        std::size_t count = 0;
+        for (std::size_t at = json.find(firstTid); at != std::string::npos; at = json.find(firstTid, at + 1)) {
+            ++count;
+        }
+        assert(count == 2);
+    }
+
+    {
+        // One-off phases are claimed once; a null scope records nothing.
+        StartupTrace trace;
+        assert(trace.claimFirst("firstWindow"));
+        assert(!trace.claimFirst("firstWindow"));
+        assert(trace.claimFirst("firstWebview"));
+        { StartupTraceScope ignored(nullptr, "ignored"); }
+        { StartupTraceScope scope(&trace, "scoped", "cef"); }
+        const std::string json = trace.toJson(1);
+        assert(json.find("ignored") == std::string::npos);
+        assert(json.find("\"name\":\"scoped\"") != std::string::npos);
+        assert(json.find("\"detail\":\"cef\"") != std::string::npos);
+    }
+
+    {
+        // write replaces the file in one step.
+        StartupTrace trace;
+        trace.instant("libraryLoad");
+        const std::string path = "startup_trace_test.json";
+        assert(trace.write(path, 5));
+        trace.instant("firstPaint");
+        assert(trace.write(path, 5));
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        assert(contents.str() == trace.toJson(5));
+        std::remove(path.c_str());
+        assert(!trace.write("/nonexistent-directory/trace.json", 5));
+    }
+
+    return 0;
+}
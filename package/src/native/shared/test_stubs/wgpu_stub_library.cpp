@@ -0,0 +1,21 @@
+// Stand-in for libwebgpu_dawn.so, loaded through ELECTROBUN_WGPU_LIBRARY by
+// wgpu_stub_library_test.cpp. Each surface call advances a clock the test
+// reads, so timings come out exact.
+
+#include <cstdint>
+
+extern "C" {
+
+std::uint64_t wgpuStubNowUs = 0;
+std::int32_t wgpuStubPresentStatus = 1;
+
+void wgpuSurfaceGetCurrentTexture(void*, void*) {
+    wgpuStubNowUs += 500;
+}
+
+std::int32_t wgpuSurfacePresent(void*) {
+    wgpuStubNowUs += 1000;
+    return wgpuStubPresentStatus;
+}
+
+}
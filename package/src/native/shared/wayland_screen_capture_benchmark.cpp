@@ -0,0 +1,272 @@
+// Measures the CPU cost of turning a captured screen frame into the RGBA
+// rows captureScreenRegion returns, using synthetic frames so it runs without
+// a compositor or X server. The Wayland rows go through the same view and
+// crop code as the PipeWire cache; the X11 rows use the XShm conversion.
+// "ingest" is the full-damage row copy the PipeWire worker makes per buffer.
+// GB/s counts RGBA bytes written.
+#include "linux_x11_capture.h"
+#include "wayland_screen_capture_frame.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using electrobun::LinuxOsrPixelFormat;
+using electrobun::WaylandScreenCaptureFrameView;
+using electrobun::WaylandScreenCaptureLogicalBounds;
+using electrobun::WaylandScreenCapturePixelLayout;
+using electrobun::WaylandScreenCaptureRegion;
+using electrobun::convertLinuxX11CaptureToRgba;
+using electrobun::copyWaylandScreenCaptureRegion;
+using electrobun::describeLinuxOsrPixelFormat;
+
+namespace {
+
+constexpr double kMinimumSeconds = 0.1;
+constexpr int kMinimumCalls = 3;
+
+struct Resolution {
+    const char* name;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+
+// PipeWire keeps BGRA/RGBA buffers in their negotiated order and treats the
+// alpha byte as padding, so they share the x layouts.
+struct WaylandFormat {
+    const char* name;
+    WaylandScreenCapturePixelLayout layout;
+};
+
+// Output scale in halves, so fractional scaling is covered.
+struct Scale {
+    const char* name;
+    std::uint32_t halves;
+};
+
+// A region edge of 0 means the whole logical frame.
+struct Roi {
+    const char* name;
+    std::uint32_t edge;
+};
+
+const Resolution kResolutions[] = {
+    {"1080p", 1920, 1080},
+    {"1440p", 2560, 1440},
+    {"4K", 3840, 2160},
+    {"5K", 5120, 2880},
+};
+
+const WaylandFormat kWaylandFormats[] = {
+    {"BGRx", WaylandScreenCapturePixelLayout::bgrx},
+    {"BGRA", WaylandScreenCapturePixelLayout::bgrx},
+    {"RGBx", WaylandScreenCapturePixelLayout::rgbx},
+    {"RGBA", WaylandScreenCapturePixelLayout::rgbx},
+};
+
+const Scale kWaylandScales[] = {{"1x", 2}, {"1.5x", 3}, {"2x", 4}};
+const Scale kX11Scales[] = {{"1x", 2}, {"2x", 4}};
+const Roi kRois[] = {{"full", 0}, {"256x256", 256}, {"16x16", 16}};
+
+volatile std::uint32_t g_sink = 0;
+
+struct Result {
+    double microsecondsPerCall;
+    double gigabytesPerSecond;
+};
+
+template <typename Call>
+bool measure(std::uint64_t bytesPerCall, Call call, Result* result) {
+    if (!call()) {
+        return false;
+    }
+    int calls = 0;
+    double seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (calls < kMinimumCalls || seconds < kMinimumSeconds) {
+        if (!call()) {
+            return false;
+        }
+        ++calls;
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
+    }
+    result->microsecondsPerCall = seconds * 1e6 / calls;
+    result->gigabytesPerSecond =
+        static_cast<double>(bytesPerCall) * calls / seconds / 1e9;
+    return true;
+}
+
+void printResult(
+    const char* path,
+    const char* format,
+    const Resolution& resolution,
+    const char* scale,
+    const char* roi,
+    const Result& result
+) {
+    std::printf("%-8s %-6s %-6s %-5s %-8s %12.2f %8.2f\n", path, format,
+                resolution.name, scale, roi, result.microsecondsPerCall,
+                result.gigabytesPerSecond);
+}
+
+// A centred region, or the whole frame when roi.edge is 0 or too large.
+void centredRegion(
+    std::uint32_t width,
+    std::uint32_t height,
+    const Roi& roi,
+    std::uint32_t* x,
+    std::uint32_t* y,
+    std::uint32_t* regionWidth,
+    std::uint32_t* regionHeight
+) {
+    *regionWidth = roi.edge == 0 || roi.edge > width ? width : roi.edge;
+    *regionHeight = roi.edge == 0 || roi.edge > height ? height : roi.edge;
+    *x = (width - *regionWidth) / 2;
+    *y = (height - *regionHeight) / 2;
+}
+
+bool benchWayland(
+    const Resolution& resolution,
+    const std::vector<std::uint8_t>& frame,
+    std::vector<std::uint8_t>& out
+) {
+    for (const auto& format : kWaylandFormats) {
+        for (const auto& scale : kWaylandScales) {
+            // Logical bounds sit off the origin, as a secondary monitor would.
+            const WaylandScreenCaptureFrameView view{
+                frame.data(),
+                frame.size(),
+                resolution.width,
+                resolution.height,
+                static_cast<std::size_t>(resolution.width) * 4,
+                WaylandScreenCaptureLogicalBounds{
+                    1920,
+                    0,
+                    resolution.width * 2 / scale.halves,
+                    resolution.height * 2 / scale.halves,
+                },
+                format.layout,
+            };
+            for (const auto& roi : kRois) {
+                std::uint32_t x = 0;
+                std::uint32_t y = 0;
+                std::uint32_t width = 0;
+                std::uint32_t height = 0;
+                centredRegion(view.logical_bounds.width, view.logical_bounds.height,
+                              roi, &x, &y, &width, &height);
+                const WaylandScreenCaptureRegion region{
+                    view.logical_bounds.x + x,
+                    view.logical_bounds.y + y,
+                    width,
+                    height,
+                };
+                const std::size_t bytes = static_cast<std::size_t>(width) * height * 4;
+                Result result = {};
+                if (!measure(bytes, [&] {
+                        const bool copied =
+                            copyWaylandScreenCaptureRegion(view, region, out.data(), bytes);
+                        g_sink += out[0];
+                        return copied;
+                    }, &result)) {
+                    std::fprintf(stderr, "Wayland copy failed: %s %s %s %s\n",
+                                 format.name, resolution.name, scale.name, roi.name);
+                    return false;
+                }
+                printResult("wayland", format.name, resolution, scale.name, roi.name,
+                            result);
+            }
+        }
+    }
+    return true;
+}
+
+bool benchX11(
+    const Resolution& resolution,
+    const std::vector<std::uint8_t>& frame,
+    std::vector<std::uint8_t>& out
+) {
+    struct X11Format {
+        const char* name;
+        LinuxOsrPixelFormat format;
+    };
+    X11Format formats[] = {{"xRGB", {}}, {"xBGR", {}}};
+    if (!describeLinuxOsrPixelFormat(32, 24, false, 0xff0000, 0xff00, 0xff,
+                                     &formats[0].format) ||
+        !describeLinuxOsrPixelFormat(32, 24, false, 0xff, 0xff00, 0xff0000,
+                                     &formats[1].format)) {
+        std::fprintf(stderr, "X11 pixel formats were rejected\n");
+        return false;
+    }
+
+    const int stride = static_cast<int>(resolution.width) * 4;
+    for (const auto& format : formats) {
+        for (const auto& scale : kX11Scales) {
+            const int deviceScale = static_cast<int>(scale.halves / 2);
+            for (const auto& roi : kRois) {
+                std::uint32_t x = 0;
+                std::uint32_t y = 0;
+                std::uint32_t width = 0;
+                std::uint32_t height = 0;
+                centredRegion(resolution.width / deviceScale,
+                              resolution.height / deviceScale, roi, &x, &y, &width,
+                              &height);
+                // The XShm image holds just the device rectangle, so the
+                // conversion starts at its top-left pixel.
+                const std::uint8_t* source = frame.data() +
+                    static_cast<std::size_t>(y) * deviceScale * stride +
+                    static_cast<std::size_t>(x) * deviceScale * 4;
+                const std::size_t bytes = static_cast<std::size_t>(width) * height * 4;
+                Result result = {};
+                measure(bytes, [&] {
+                    convertLinuxX11CaptureToRgba(source, stride, format.format,
+                                                 deviceScale, width, height, out.data());
+                    g_sink += out[0];
+                    return true;
+                }, &result);
+                printResult("x11", format.name, resolution, scale.name, roi.name, result);
+            }
+        }
+    }
+    return true;
+}
+
+void benchIngest(
+    const Resolution& resolution,
+    const std::vector<std::uint8_t>& frame,
+    std::vector<std::uint8_t>& out
+) {
+    Result result = {};
+    measure(frame.size(), [&] {
+        std::memcpy(out.data(), frame.data(), frame.size());
+        g_sink += out[frame.size() - 1];
+        return true;
+    }, &result);
+    printResult("ingest", "any", resolution, "-", "full", result);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Screen capture conversion, at least %.0f ms per case\n",
+                kMinimumSeconds * 1000);
+    std::printf("%-8s %-6s %-6s %-5s %-8s %12s %8s\n", "path", "format", "frame",
+                "scale", "region", "us/call", "GB/s");
+    for (const auto& resolution : kResolutions) {
+        std::vector<std::uint8_t> frame(
+            static_cast<std::size_t>(resolution.width) * resolution.height * 4);
+        for (std::size_t i = 0; i < frame.size(); ++i) {
+            frame[i] = static_cast<std::uint8_t>(i * 31);
+        }
+        std::vector<std::uint8_t> out(frame.size());
+
+        benchIngest(resolution, frame, out);
+        if (!benchWayland(resolution, frame, out) || !benchX11(resolution, frame, out)) {
+            return 1;
+        }
+    }
+    return g_sink == 0xffffffffu ? 1 : 0;
+}
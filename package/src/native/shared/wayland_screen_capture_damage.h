@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "wayland_screen_capture_frame.h"
+
+namespace electrobun {
+
+// Damage accumulated across PipeWire buffers, including the ones dropped
+// without being copied. Compositors report a handful of rectangles per frame;
+// past kMaxRects they collapse into their bounding box so a copy never issues
+// more than that many row loops.
+class WaylandScreenCaptureDamage {
+public:
+    static constexpr std::size_t kMaxRects = 8;
+
+    void addFull(std::uint32_t frame_width, std::uint32_t frame_height) {
+        rects_.assign(1, {0, 0, frame_width, frame_height});
+        full_ = true;
+    }
+
+    // Add a rectangle given in buffer pixels. Parts outside the crop (origin
+    // crop_x/crop_y, crop_width x crop_height) are dropped.
+    void add(
+        std::int64_t x,
+        std::int64_t y,
+        std::int64_t width,
+        std::int64_t height,
+        std::uint32_t crop_x,
+        std::uint32_t crop_y,
+        std::uint32_t crop_width,
+        std::uint32_t crop_height
+    ) {
+        if (full_ || width <= 0 || height <= 0) {
+            return;
+        }
+        const std::int64_t left = std::max<std::int64_t>(x, crop_x);
+        const std::int64_t top = std::max<std::int64_t>(y, crop_y);
+        const std::int64_t right = std::min<std::int64_t>(
+            x + width, static_cast<std::int64_t>(crop_x) + crop_width);
+        const std::int64_t bottom = std::min<std::int64_t>(
+            y + height, static_cast<std::int64_t>(crop_y) + crop_height);
+        if (right <= left || bottom <= top) {
+            return;
+        }
+        merge({
+            static_cast<std::uint32_t>(left - crop_x),
+            static_cast<std::uint32_t>(top - crop_y),
+            static_cast<std::uint32_t>(right - left),
+            static_cast<std::uint32_t>(bottom - top),
+        });
+    }
+
+    void merge(const WaylandScreenCaptureDamage& other) {
+        if (other.full_) {
+            rects_ = other.rects_;
+            full_ = true;
+            return;
+        }
+        for (const auto& rect : other.rects_) {
+            merge(rect);
+        }
+    }
+
+    void clear() {
+        rects_.clear();
+        full_ = false;
+    }
+
+    bool empty() const {
+        return rects_.empty();
+    }
+
+    bool full() const {
+        return full_;
+    }
+
+    const std::vector<WaylandScreenCapturePixelRect>& rects() const {
+        return rects_;
+    }
+
+private:
+    void merge(const WaylandScreenCapturePixelRect& rect) {
+        if (full_ || rect.empty()) {
+            return;
+        }
+        rects_.push_back(rect);
+        if (rects_.size() <= kMaxRects) {
+            return;
+        }
+        std::uint32_t left = rects_.front().x;
+        std::uint32_t top = rects_.front().y;
+        std::uint32_t right = left;
+        std::uint32_t bottom = top;
+        for (const auto& item : rects_) {
+            left = std::min(left, item.x);
+            top = std::min(top, item.y);
+            right = std::max(right, item.x + item.width);
+            bottom = std::max(bottom, item.y + item.height);
+        }
+        rects_.assign(1, {left, top, right - left, bottom - top});
+    }
+
+    std::vector<WaylandScreenCapturePixelRect> rects_;
+    bool full_ = false;
+};
+
+// Sequence numbers for cache updates, with the damage each one applied, so
+// pollers can ask whether their region changed since the last capture.
+// Sequence 0 means "unknown". Monitor streams draw sequences from one shared
+// counter so a region spanning monitors can compare them directly.
+class WaylandScreenCaptureChangeHistory {
+public:
+    static constexpr std::size_t kMaxEntries = 32;
+
+    // Record damage under `sequence`, which must exceed every earlier one.
+    std::uint64_t record(const WaylandScreenCaptureDamage& damage, std::uint64_t sequence) {
+        if (damage.empty() || sequence <= sequence_) {
+            return sequence_;
+        }
+        sequence_ = sequence;
+        entries_.push_back({sequence_, damage.rects()});
+        if (entries_.size() > kMaxEntries) {
+            floor_ = entries_.front().sequence;
+            entries_.pop_front();
+        }
+        return sequence_;
+    }
+
+    void reset() {
+        entries_.clear();
+        floor_ = sequence_;
+    }
+
+    std::uint64_t sequence() const {
+        return sequence_;
+    }
+
+    // The newest update that touched region. Regions untouched by every
+    // retained entry report the oldest sequence the history can vouch for.
+    std::uint64_t lastChange(const WaylandScreenCapturePixelRect& region) const {
+        for (auto entry = entries_.rbegin(); entry != entries_.rend(); ++entry) {
+            for (const auto& rect : entry->rects) {
+                if (rect.intersects(region)) {
+                    return entry->sequence;
+                }
+            }
+        }
+        return floor_;
+    }
+
+private:
+    struct Entry {
+        std::uint64_t sequence;
+        std::vector<WaylandScreenCapturePixelRect> rects;
+    };
+
+    std::deque<Entry> entries_;
+    std::uint64_t sequence_ = 0;
+    std::uint64_t floor_ = 0;
+};
+
+} // namespace electrobun
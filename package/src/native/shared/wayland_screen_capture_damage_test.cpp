@@ -0,0 +1,105 @@
+#include "wayland_screen_capture_damage.h"
+
+#include <cassert>
+#include <cstdint>
+
+using electrobun::WaylandScreenCaptureChangeHistory;
+using electrobun::WaylandScreenCaptureDamage;
+using electrobun::WaylandScreenCaptureLogicalBounds;
+using electrobun::WaylandScreenCapturePixelRect;
+using electrobun::WaylandScreenCaptureRegion;
+using electrobun::mapWaylandScreenCaptureRegionToPixels;
+
+static void expectRect(
+    const WaylandScreenCapturePixelRect& rect,
+    std::uint32_t x,
+    std::uint32_t y,
+    std::uint32_t width,
+    std::uint32_t height
+) {
+    assert(rect.x == x);
+    assert(rect.y == y);
+    assert(rect.width == width);
+    assert(rect.height == height);
+}
+
+int main() {
+    {
+        // Buffer-space damage is clipped to the crop and made crop-relative.
+        WaylandScreenCaptureDamage damage;
+        damage.add(90, 40, 20, 20, 100, 50, 200, 100);
+        assert(damage.rects().size() == 1);
+        expectRect(damage.rects()[0], 0, 0, 10, 10);
+        damage.add(0, 0, 10, 10, 100, 50, 200, 100);
+        damage.add(120, 60, 0, 10, 100, 50, 200, 100);
+        assert(damage.rects().size() == 1);
+        assert(!damage.full());
+    }
+
+    {
+        // Too many rectangles collapse into their bounds; full damage wins.
+        WaylandScreenCaptureDamage damage;
+        for (int i = 0; i <= static_cast<int>(WaylandScreenCaptureDamage::kMaxRects); ++i) {
+            damage.add(i * 10, i * 5, 2, 2, 0, 0, 1000, 1000);
+        }
+        assert(damage.rects().size() == 1);
+        expectRect(damage.rects()[0], 0, 0, 82, 42);
+
+        WaylandScreenCaptureDamage full;
+        full.addFull(640, 480);
+        damage.merge(full);
+        assert(damage.full());
+        expectRect(damage.rects()[0], 0, 0, 640, 480);
+        damage.add(0, 0, 1, 1, 0, 0, 640, 480);
+        assert(damage.rects().size() == 1);
+        damage.clear();
+        assert(damage.empty() && !damage.full());
+    }
+
+    {
+        // Regions report the newest update that touched them.
+        WaylandScreenCaptureChangeHistory history;
+        assert(history.lastChange({0, 0, 10, 10}) == 0);
+
+        WaylandScreenCaptureDamage damage;
+        damage.addFull(100, 100);
+        assert(history.record(damage, 1) == 1);
+        damage.clear();
+        damage.add(50, 50, 10, 10, 0, 0, 100, 100);
+        assert(history.record(damage, 4) == 4);
+        assert(history.record(damage, 3) == 4);
+        damage.clear();
+        assert(history.record(damage, 5) == 4);
+
+        assert(history.lastChange({0, 0, 10, 10}) == 1);
+        assert(history.lastChange({55, 55, 1, 1}) == 4);
+        assert(history.lastChange({60, 60, 5, 5}) == 1);
+
+        // Once entries age out, untouched regions fall back to the floor.
+        damage.add(0, 0, 1, 1, 0, 0, 100, 100);
+        for (std::size_t i = 0; i < WaylandScreenCaptureChangeHistory::kMaxEntries; ++i) {
+            history.record(damage, 10 + i);
+        }
+        assert(history.lastChange({90, 90, 1, 1}) == 4);
+        history.reset();
+        assert(history.lastChange({0, 0, 1, 1}) == history.sequence());
+    }
+
+    {
+        // Logical regions round outwards onto scaled frame pixels.
+        WaylandScreenCapturePixelRect rect{};
+        const WaylandScreenCaptureLogicalBounds bounds{-100, 0, 100, 50};
+        assert(mapWaylandScreenCaptureRegionToPixels(
+            bounds, 200, 100, WaylandScreenCaptureRegion{-90, 10, 5, 5}, &rect));
+        expectRect(rect, 20, 20, 10, 10);
+        assert(mapWaylandScreenCaptureRegionToPixels(
+            bounds, 150, 75, WaylandScreenCaptureRegion{-99, 1, 1, 1}, &rect));
+        expectRect(rect, 1, 1, 2, 2);
+        assert(!mapWaylandScreenCaptureRegionToPixels(
+            bounds, 200, 100, WaylandScreenCaptureRegion{-101, 0, 5, 5}, &rect));
+        assert(!mapWaylandScreenCaptureRegionToPixels(
+            bounds, 200, 100, WaylandScreenCaptureRegion{-10, 0, 11, 5}, &rect));
+    }
+
+    return 0;
+}
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <vector>
+
+#include "screen_capture_downscale.h"
 
 namespace electrobun {
 
@@ -24,15 +28,43 @@ struct WaylandScreenCaptureRegion {
     std::uint32_t height;
 };
 
-// The frame contains RGBA pixels. row_stride may include padding, but every
-// logical row must contain at least pixel_width * 4 bytes.
+// A rectangle in cached-frame pixels (the stream crop, not the full buffer).
+struct WaylandScreenCapturePixelRect {
+    std::uint32_t x;
+    std::uint32_t y;
+    std::uint32_t width;
+    std::uint32_t height;
+
+    bool empty() const {
+        return width == 0 || height == 0;
+    }
+
+    bool intersects(const WaylandScreenCapturePixelRect& other) const {
+        return !empty() && !other.empty() &&
+            x < other.x + other.width && other.x < x + width &&
+            y < other.y + other.height && other.y < y + height;
+    }
+};
+
+// Byte order of a cached frame. PipeWire buffers are kept in the negotiated
+// order and only the pixels a caller asks for are converted, so the x/A byte
+// of the 32-bit formats is ignored and reported as opaque.
+enum class WaylandScreenCapturePixelLayout {
+    rgba,
+    rgbx,
+    bgrx,
+};
+
+// row_stride may include padding, but every logical row must contain at least
+// pixel_width * 4 bytes.
 struct WaylandScreenCaptureFrameView {
-    const std::uint8_t* rgba;
+    const std::uint8_t* pixels;
     std::size_t byte_length;
     std::uint32_t pixel_width;
     std::uint32_t pixel_height;
     std::size_t row_stride;
     WaylandScreenCaptureLogicalBounds logical_bounds;
+    WaylandScreenCapturePixelLayout layout = WaylandScreenCapturePixelLayout::rgba;
 };
 
 inline bool checkedWaylandScreenCaptureSizeMultiply(
@@ -78,7 +110,7 @@ inline bool validateWaylandScreenCaptureFrame(
     const WaylandScreenCaptureFrameView& frame,
     std::size_t* packed_row_bytes = nullptr
 ) {
-    if (!frame.rgba || frame.pixel_width == 0 || frame.pixel_height == 0 ||
+    if (!frame.pixels || frame.pixel_width == 0 || frame.pixel_height == 0 ||
         frame.logical_bounds.width == 0 || frame.logical_bounds.height == 0) {
         return false;
     }
@@ -238,10 +270,36 @@ inline bool mapWaylandScreenCaptureFramePointToLogical(
     return *logical_x < logical_right && *logical_y < logical_bottom;
 }
 
-inline bool copyWaylandScreenCaptureRegion(
+inline void storeWaylandScreenCapturePixel(
+    WaylandScreenCapturePixelLayout layout,
+    const std::uint8_t* source,
+    std::uint8_t* destination
+) {
+    switch (layout) {
+        case WaylandScreenCapturePixelLayout::rgba:
+            std::memcpy(destination, source, 4);
+            return;
+        case WaylandScreenCapturePixelLayout::rgbx:
+            destination[0] = source[0];
+            destination[1] = source[1];
+            destination[2] = source[2];
+            break;
+        case WaylandScreenCapturePixelLayout::bgrx:
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+            break;
+    }
+    destination[3] = 255;
+}
+
+// Copy a region into rows of out_row_stride bytes, so several monitor frames
+// can fill one stitched output.
+inline bool copyWaylandScreenCaptureRegionWithStride(
     const WaylandScreenCaptureFrameView& frame,
     const WaylandScreenCaptureRegion& region,
     std::uint8_t* out_rgba,
+    std::size_t out_row_stride,
     std::size_t out_length
 ) {
     if (!out_rgba || region.width == 0 || region.height == 0 ||
@@ -249,17 +307,23 @@ inline bool copyWaylandScreenCaptureRegion(
         return false;
     }
 
-    std::size_t output_pixels = 0;
+    std::size_t output_row_bytes = 0;
+    std::size_t last_output_row = 0;
     std::size_t required_output_bytes = 0;
     if (!checkedWaylandScreenCaptureSizeMultiply(
             static_cast<std::size_t>(region.width),
-            static_cast<std::size_t>(region.height),
-            &output_pixels) ||
-        !checkedWaylandScreenCaptureSizeMultiply(
-            output_pixels,
             4,
+            &output_row_bytes) ||
+        out_row_stride < output_row_bytes ||
+        !checkedWaylandScreenCaptureSizeMultiply(
+            static_cast<std::size_t>(region.height - 1),
+            out_row_stride,
+            &last_output_row) ||
+        !checkedWaylandScreenCaptureSizeAdd(
+            last_output_row,
+            output_row_bytes,
             &required_output_bytes) ||
-        out_length != required_output_bytes) {
+        out_length < required_output_bytes) {
         return false;
     }
 
@@ -337,26 +401,232 @@ inline bool copyWaylandScreenCaptureRegion(
                     &source_offset) ||
                 !checkedWaylandScreenCaptureSizeMultiply(
                     static_cast<std::size_t>(destination_y),
-                    static_cast<std::size_t>(region.width),
+                    out_row_stride,
                     &destination_row) ||
-                !checkedWaylandScreenCaptureSizeAdd(
-                    destination_row,
+                !checkedWaylandScreenCaptureSizeMultiply(
                     static_cast<std::size_t>(destination_x),
+                    4,
                     &destination_pixel) ||
-                !checkedWaylandScreenCaptureSizeMultiply(
+                !checkedWaylandScreenCaptureSizeAdd(
+                    destination_row,
                     destination_pixel,
-                    4,
                     &destination_offset) ||
                 source_offset > frame.byte_length - 4 ||
                 destination_offset > out_length - 4) {
                 return false;
             }
 
-            std::memcpy(out_rgba + destination_offset, frame.rgba + source_offset, 4);
+            storeWaylandScreenCapturePixel(
+                frame.layout,
+                frame.pixels + source_offset,
+                out_rgba + destination_offset);
+        }
+    }
+
+    return true;
+}
+
+inline bool copyWaylandScreenCaptureRegion(
+    const WaylandScreenCaptureFrameView& frame,
+    const WaylandScreenCaptureRegion& region,
+    std::uint8_t* out_rgba,
+    std::size_t out_length
+) {
+    std::size_t output_pixels = 0;
+    std::size_t required_output_bytes = 0;
+    if (!checkedWaylandScreenCaptureSizeMultiply(
+            static_cast<std::size_t>(region.width),
+            static_cast<std::size_t>(region.height),
+            &output_pixels) ||
+        !checkedWaylandScreenCaptureSizeMultiply(
+            output_pixels,
+            4,
+            &required_output_bytes) ||
+        out_length != required_output_bytes) {
+        return false;
+    }
+    return copyWaylandScreenCaptureRegionWithStride(
+        frame,
+        region,
+        out_rgba,
+        static_cast<std::size_t>(region.width) * 4,
+        out_length);
+}
+
+// One monitor's share of a region that spans several portal streams.
+struct WaylandScreenCaptureStitchPiece {
+    std::size_t frame_index;
+    WaylandScreenCaptureRegion region;
+};
+
+// Split a logical region across monitor bounds. A region inside one monitor
+// uses that monitor alone (mirrored outputs included); otherwise the pieces
+// must tile the region exactly, so gaps between monitors or overlapping
+// outputs fail rather than return unfilled or doubly-written pixels.
+inline bool planWaylandScreenCaptureStitch(
+    const WaylandScreenCaptureLogicalBounds* bounds,
+    std::size_t count,
+    const WaylandScreenCaptureRegion& region,
+    std::vector<WaylandScreenCaptureStitchPiece>* pieces
+) {
+    if (!pieces || (!bounds && count > 0) || region.width == 0 ||
+        region.height == 0) {
+        return false;
+    }
+    pieces->clear();
+
+    std::int64_t region_right = 0;
+    std::int64_t region_bottom = 0;
+    if (!checkedWaylandScreenCaptureRightEdge(region.x, region.width, &region_right) ||
+        !checkedWaylandScreenCaptureRightEdge(region.y, region.height, &region_bottom)) {
+        return false;
+    }
+
+    std::uint64_t covered = 0;
+    for (std::size_t index = 0; index < count; ++index) {
+        std::int64_t right = 0;
+        std::int64_t bottom = 0;
+        if (bounds[index].width == 0 || bounds[index].height == 0 ||
+            !checkedWaylandScreenCaptureRightEdge(bounds[index].x, bounds[index].width, &right) ||
+            !checkedWaylandScreenCaptureRightEdge(bounds[index].y, bounds[index].height, &bottom)) {
+            continue;
+        }
+        const std::int64_t left = std::max(region.x, bounds[index].x);
+        const std::int64_t top = std::max(region.y, bounds[index].y);
+        const std::int64_t clipped_right = std::min(region_right, right);
+        const std::int64_t clipped_bottom = std::min(region_bottom, bottom);
+        if (clipped_right <= left || clipped_bottom <= top) {
+            continue;
+        }
+        const WaylandScreenCaptureRegion piece{
+            left,
+            top,
+            static_cast<std::uint32_t>(clipped_right - left),
+            static_cast<std::uint32_t>(clipped_bottom - top),
+        };
+        if (piece.x == region.x && piece.y == region.y &&
+            piece.width == region.width && piece.height == region.height) {
+            pieces->assign(1, {index, piece});
+            return true;
+        }
+        for (const auto& existing : *pieces) {
+            if (piece.x < existing.region.x + existing.region.width &&
+                existing.region.x < piece.x + piece.width &&
+                piece.y < existing.region.y + existing.region.height &&
+                existing.region.y < piece.y + piece.height) {
+                pieces->clear();
+                return false;
+            }
         }
+        pieces->push_back({index, piece});
+        covered += static_cast<std::uint64_t>(piece.width) * piece.height;
     }
 
+    if (covered != static_cast<std::uint64_t>(region.width) * region.height) {
+        pieces->clear();
+        return false;
+    }
     return true;
 }
 
+// The frame pixels covering a logical region, rounded outwards. False when
+// the region is not entirely inside the frame's logical bounds.
+inline bool mapWaylandScreenCaptureRegionToPixels(
+    const WaylandScreenCaptureLogicalBounds& logical_bounds,
+    std::uint32_t pixel_width,
+    std::uint32_t pixel_height,
+    const WaylandScreenCaptureRegion& region,
+    WaylandScreenCapturePixelRect* rect
+) {
+    if (!rect || pixel_width == 0 || pixel_height == 0 ||
+        logical_bounds.width == 0 || logical_bounds.height == 0 ||
+        region.width == 0 || region.height == 0 ||
+        region.x < logical_bounds.x || region.y < logical_bounds.y) {
+        return false;
+    }
+    const std::uint64_t relative_x =
+        static_cast<std::uint64_t>(region.x - logical_bounds.x);
+    const std::uint64_t relative_y =
+        static_cast<std::uint64_t>(region.y - logical_bounds.y);
+    if (relative_x + region.width > logical_bounds.width ||
+        relative_y + region.height > logical_bounds.height) {
+        return false;
+    }
+    const std::uint64_t left = relative_x * pixel_width / logical_bounds.width;
+    const std::uint64_t top = relative_y * pixel_height / logical_bounds.height;
+    const std::uint64_t right =
+        ((relative_x + region.width) * pixel_width + logical_bounds.width - 1) /
+        logical_bounds.width;
+    const std::uint64_t bottom =
+        ((relative_y + region.height) * pixel_height + logical_bounds.height - 1) /
+        logical_bounds.height;
+    *rect = {
+        static_cast<std::uint32_t>(left),
+        static_cast<std::uint32_t>(top),
+        static_cast<std::uint32_t>(right - left),
+        static_cast<std::uint32_t>(bottom - top),
+    };
+    return true;
+}
+
+// Byte positions of a layout's colour channels, for the box-filtered path.
+inline ScreenCaptureChannelOrder waylandScreenCaptureChannelOrder(
+    WaylandScreenCapturePixelLayout layout
+) {
+    if (layout == WaylandScreenCapturePixelLayout::bgrx) {
+        return {2, 1, 0};
+    }
+    return {0, 1, 2};
+}
+
+// Box-filter the frame pixels covering a logical region down to
+// output_width x output_height RGBA pixels, written in rows of
+// out_row_stride bytes. Unlike copyWaylandScreenCaptureRegion this averages
+// every device pixel, so a HiDPI monitor's thumbnail is not aliased.
+inline bool downscaleWaylandScreenCaptureRegion(
+    const WaylandScreenCaptureFrameView& frame,
+    const WaylandScreenCaptureRegion& region,
+    std::uint32_t output_width,
+    std::uint32_t output_height,
+    std::uint8_t* out_rgba,
+    std::size_t out_row_stride,
+    std::size_t out_length
+) {
+    WaylandScreenCapturePixelRect rect{};
+    std::size_t last_output_row = 0;
+    std::size_t required_output_bytes = 0;
+    if (!out_rgba || output_width == 0 || output_height == 0 ||
+        !validateWaylandScreenCaptureFrame(frame) ||
+        !mapWaylandScreenCaptureRegionToPixels(
+            frame.logical_bounds,
+            frame.pixel_width,
+            frame.pixel_height,
+            region,
+            &rect) ||
+        out_row_stride < static_cast<std::size_t>(output_width) * 4 ||
+        !checkedWaylandScreenCaptureSizeMultiply(
+            static_cast<std::size_t>(output_height - 1),
+            out_row_stride,
+            &last_output_row) ||
+        !checkedWaylandScreenCaptureSizeAdd(
+            last_output_row,
+            static_cast<std::size_t>(output_width) * 4,
+            &required_output_bytes) ||
+        out_length < required_output_bytes) {
+        return false;
+    }
+    return downscaleScreenCaptureBox(
+        frame.pixels +
+            static_cast<std::size_t>(rect.y) * frame.row_stride +
+            static_cast<std::size_t>(rect.x) * 4,
+        frame.row_stride,
+        rect.width,
+        rect.height,
+        waylandScreenCaptureChannelOrder(frame.layout),
+        output_width,
+        output_height,
+        out_rgba,
+        out_row_stride);
+}
+
 } // namespace electrobun
@@ -9,7 +9,9 @@
 
 using electrobun::WaylandScreenCaptureFrameView;
 using electrobun::WaylandScreenCaptureLogicalBounds;
+using electrobun::WaylandScreenCapturePixelLayout;
 using electrobun::WaylandScreenCaptureRegion;
+using electrobun::WaylandScreenCaptureStitchPiece;
 
 static void setPixel(
     std::vector<std::uint8_t>& pixels,
@@ -103,6 +105,77 @@ int main() {
         expectPixel(output.data() + 12, coordinatePixel(2, 2));
     }
 
+    {
+        // Raw PipeWire layouts are converted only for the requested pixels,
+        // and the ignored x/A byte always reads back as opaque.
+        std::vector<std::uint8_t> pixels = {
+            0x10, 0x20, 0x30, 0x00, 0x40, 0x50, 0x60, 0x7f,
+        };
+        auto frame = makeFrame(
+            pixels, 2, 1, 8, WaylandScreenCaptureLogicalBounds{0, 0, 2, 1});
+        std::array<std::uint8_t, 4> output{};
+
+        frame.layout = WaylandScreenCapturePixelLayout::bgrx;
+        assert(electrobun::copyWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{1, 0, 1, 1}, output.data(), output.size()));
+        expectPixel(output.data(), {0x60, 0x50, 0x40, 0xff});
+
+        frame.layout = WaylandScreenCapturePixelLayout::rgbx;
+        assert(electrobun::copyWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{0, 0, 1, 1}, output.data(), output.size()));
+        expectPixel(output.data(), {0x10, 0x20, 0x30, 0xff});
+    }
+
+    {
+        // A region spanning a 1x and a 2x monitor splits into one piece per
+        // monitor, each written into its columns of the shared output.
+        const WaylandScreenCaptureLogicalBounds monitors[] = {
+            {0, 0, 2, 2},
+            {2, 0, 2, 2},
+        };
+        std::vector<WaylandScreenCaptureStitchPiece> pieces;
+        assert(electrobun::planWaylandScreenCaptureStitch(
+            monitors, 2, WaylandScreenCaptureRegion{1, 0, 2, 2}, &pieces));
+        assert(pieces.size() == 2);
+        assert(pieces[0].frame_index == 0 && pieces[0].region.x == 1 &&
+               pieces[0].region.width == 1 && pieces[0].region.height == 2);
+        assert(pieces[1].frame_index == 1 && pieces[1].region.x == 2 &&
+               pieces[1].region.width == 1);
+
+        std::vector<std::uint8_t> left(2 * 2 * 4);
+        std::vector<std::uint8_t> right(4 * 4 * 4);
+        fillCoordinatePixels(left, 8, 2, 2);
+        fillCoordinatePixels(right, 16, 4, 4);
+        std::array<std::uint8_t, 2 * 2 * 4> output{};
+        assert(electrobun::copyWaylandScreenCaptureRegionWithStride(
+            makeFrame(left, 2, 2, 8, monitors[0]),
+            pieces[0].region, output.data(), 8, output.size()));
+        assert(electrobun::copyWaylandScreenCaptureRegionWithStride(
+            makeFrame(right, 4, 4, 16, monitors[1]),
+            pieces[1].region, output.data() + 4, 8, output.size() - 4));
+        expectPixel(output.data(), coordinatePixel(1, 0));
+        expectPixel(output.data() + 4, coordinatePixel(1, 1));
+        expectPixel(output.data() + 8, coordinatePixel(1, 1));
+        expectPixel(output.data() + 12, coordinatePixel(1, 3));
+
+        // Regions inside one monitor use it alone; gaps and overlaps fail.
+        assert(electrobun::planWaylandScreenCaptureStitch(
+            monitors, 2, WaylandScreenCaptureRegion{2, 1, 2, 1}, &pieces));
+        assert(pieces.size() == 1 && pieces[0].frame_index == 1);
+        assert(!electrobun::planWaylandScreenCaptureStitch(
+            monitors, 2, WaylandScreenCaptureRegion{1, 1, 2, 2}, &pieces));
+        assert(pieces.empty());
+        const WaylandScreenCaptureLogicalBounds overlapping[] = {
+            {0, 0, 3, 2},
+            {2, 0, 2, 2},
+        };
+        assert(!electrobun::planWaylandScreenCaptureStitch(
+            overlapping, 2, WaylandScreenCaptureRegion{0, 0, 4, 2}, &pieces));
+        assert(!electrobun::copyWaylandScreenCaptureRegionWithStride(
+            makeFrame(left, 2, 2, 8, monitors[0]),
+            WaylandScreenCaptureRegion{0, 0, 2, 2}, output.data(), 4, output.size()));
+    }
+
     {
         // A negatively positioned 2x monitor samples the center device pixel
         // for every requested compositor logical pixel.
@@ -415,5 +488,41 @@ int main() {
             larger_output.size()));
     }
 
+    {
+        // Thumbnails average every device pixel of the region, in the
+        // frame's own byte order, and may be written into a wider output.
+        const std::array<std::uint8_t, 32> bgrx{
+            0, 0, 100, 9, 0, 0, 200, 9, 10, 0, 0, 9, 30, 0, 0, 9,
+            0, 0, 100, 9, 0, 0, 200, 9, 20, 0, 0, 9, 40, 0, 0, 9,
+        };
+        const WaylandScreenCaptureFrameView frame{
+            bgrx.data(),
+            bgrx.size(),
+            4,
+            2,
+            16,
+            {10, 0, 2, 1},
+            WaylandScreenCapturePixelLayout::bgrx,
+        };
+        std::array<std::uint8_t, 12> output{};
+        assert(electrobun::downscaleWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{10, 0, 2, 1}, 1, 1, output.data(),
+            12, output.size()));
+        assert(output[0] == 75 && output[1] == 0 && output[2] == 13 && output[3] == 255);
+
+        output.fill(0);
+        assert(electrobun::downscaleWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{11, 0, 1, 1}, 1, 1, output.data() + 4,
+            12, output.size() - 4));
+        assert(output[0] == 0 && output[4] == 0 && output[6] == 25 && output[7] == 255);
+
+        assert(!electrobun::downscaleWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{10, 0, 3, 1}, 1, 1, output.data(),
+            12, output.size()));
+        assert(!electrobun::downscaleWaylandScreenCaptureRegion(
+            frame, WaylandScreenCaptureRegion{10, 0, 2, 1}, 4, 1, output.data(),
+            12, output.size()));
+    }
+
     return 0;
 }
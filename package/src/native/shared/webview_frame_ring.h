@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace electrobun {
+
+// Webview frames streamed into caller-owned memory, so a recorder can read
+// pixels without a per-frame FFI call, allocation or string conversion.
+//
+// All fields are little-endian and naturally aligned:
+//
+//   header, 64 bytes
+//     0   u32 magic "EBFR"         4   u32 version
+//     8   u32 slotCount            12  u32 slotStride
+//     16  u32 pixelCapacity        20  u32 droppedFrames
+//     24  u64 latestSequence (0 until the first frame)
+//   slot i, at 64 + i * slotStride
+//     0   u64 sequence (0 while the slot is being rewritten)
+//     8   u64 timestampUs (monotonic)
+//     16  u32 width   20 u32 height   24 u32 stride   28 u32 dirtyRectCount
+//     64  dirty rects, up to 16 x {i32 x, y, width, height}
+//     320 pixels, premultiplied BGRA rows
+//
+// Frame n lives in slot (n - 1) % slotCount, so the writer always replaces
+// the oldest frame. A reader copies a slot and keeps the copy only if the
+// slot's sequence is unchanged afterwards. droppedFrames counts frames the
+// writer skipped, for the max-FPS limit or because they did not fit a slot.
+constexpr std::uint32_t kWebviewFrameRingMagic = 0x52464245;  // "EBFR"
+constexpr std::uint32_t kWebviewFrameRingVersion = 1;
+constexpr std::size_t kWebviewFrameRingHeaderSize = 64;
+constexpr std::size_t kWebviewFrameSlotHeaderSize = 320;
+constexpr std::size_t kWebviewFrameSlotDirtyOffset = 64;
+constexpr std::uint32_t kWebviewFrameMaxDirtyRects = 16;
+
+struct WebviewFrameDirtyRect {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t width;
+    std::int32_t height;
+};
+
+struct WebviewFrameInfo {
+    std::uint64_t sequence = 0;
+    std::uint64_t timestampUs = 0;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint32_t stride = 0;
+    std::uint32_t dirtyRectCount = 0;
+    WebviewFrameDirtyRect dirtyRects[kWebviewFrameMaxDirtyRects] = {};
+};
+
+// The ring is plain shared memory, not std::atomic objects. Sequence words
+// are accessed as volatile so they are never torn or elided, and fences
+// order them against the frame data.
+inline void storeWebviewFrameRingU32(std::uint8_t* at, std::uint32_t value) {
+    *reinterpret_cast<volatile std::uint32_t*>(at) = value;
+}
+
+inline void storeWebviewFrameRingU64(std::uint8_t* at, std::uint64_t value) {
+    *reinterpret_cast<volatile std::uint64_t*>(at) = value;
+}
+
+inline std::uint32_t loadWebviewFrameRingU32(const std::uint8_t* at) {
+    return *reinterpret_cast<const volatile std::uint32_t*>(at);
+}
+
+inline std::uint64_t loadWebviewFrameRingU64(const std::uint8_t* at) {
+    return *reinterpret_cast<const volatile std::uint64_t*>(at);
+}
+
+enum class WebviewFrameSubmitResult {
+    Published,
+    // Arrived within the max-FPS interval. Its damage carries over to the
+    // next published frame.
+    Throttled,
+    // Larger than a slot. The next published frame is marked fully dirty.
+    Dropped,
+};
+
+class WebviewFrameRingWriter {
+public:
+    // Lays out slotCount slots in memory and clears them. memory must be
+    // 8-byte aligned and stay valid until detach(). maxFps 0 is unlimited.
+    bool attach(std::uint8_t* memory, std::uint64_t length, std::uint32_t slotCount,
+                std::uint32_t maxFps) {
+        detach();
+        if (!memory || slotCount == 0 || (reinterpret_cast<std::uintptr_t>(memory) & 7) != 0 ||
+            length <= kWebviewFrameRingHeaderSize) {
+            return false;
+        }
+        const std::uint64_t perSlot = (length - kWebviewFrameRingHeaderSize) / slotCount;
+        if (perSlot < kWebviewFrameSlotHeaderSize + 64) {
+            return false;
+        }
+        // Slots stay 64-byte aligned relative to the ring start.
+        const std::uint64_t capacity =
+            std::min<std::uint64_t>((perSlot - kWebviewFrameSlotHeaderSize) & ~std::uint64_t(63),
+                                    0xffffffc0u - kWebviewFrameSlotHeaderSize);
+        memory_ = memory;
+        slotCount_ = slotCount;
+        pixelCapacity_ = static_cast<std::uint32_t>(capacity);
+        slotStride_ = static_cast<std::uint32_t>(kWebviewFrameSlotHeaderSize + capacity);
+        minIntervalUs_ = maxFps ? 1000000u / maxFps : 0;
+        sequence_ = 0;
+        dropped_ = 0;
+        lastPublishUs_ = 0;
+        lastWidth_ = 0;
+        lastHeight_ = 0;
+        pendingCount_ = 0;
+        pendingFull_ = true;
+
+        std::memset(memory_, 0, kWebviewFrameRingHeaderSize);
+        for (std::uint32_t slot = 0; slot < slotCount_; ++slot) {
+            storeWebviewFrameRingU64(slotAt(slot), 0);
+        }
+        storeWebviewFrameRingU32(memory_ + 4, kWebviewFrameRingVersion);
+        storeWebviewFrameRingU32(memory_ + 8, slotCount_);
+        storeWebviewFrameRingU32(memory_ + 12, slotStride_);
+        storeWebviewFrameRingU32(memory_ + 16, pixelCapacity_);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWebviewFrameRingU32(memory_, kWebviewFrameRingMagic);
+        return true;
+    }
+
+    void detach() {
+        memory_ = nullptr;
+        slotCount_ = 0;
+    }
+
+    bool attached() const {
+        return memory_ != nullptr;
+    }
+
+    std::uint64_t sequence() const {
+        return sequence_;
+    }
+
+    std::uint32_t pixelCapacity() const {
+        return pixelCapacity_;
+    }
+
+    // Damage from throttled frames that no published frame has carried yet.
+    bool hasPendingFrame() const {
+        return attached() && sequence_ > 0 && (pendingFull_ || pendingCount_ > 0);
+    }
+
+    // Microseconds until a frame submitted now would not be throttled.
+    std::uint64_t throttleDelayUs(std::uint64_t nowUs) const {
+        if (minIntervalUs_ == 0 || sequence_ == 0) return 0;
+        const std::uint64_t elapsed = nowUs - lastPublishUs_;
+        return elapsed >= minIntervalUs_ ? 0 : minIntervalUs_ - elapsed;
+    }
+
+    // dirty == nullptr means the whole frame changed.
+    WebviewFrameSubmitResult submit(
+        const std::uint8_t* bgra,
+        std::size_t stride,
+        int width,
+        int height,
+        const WebviewFrameDirtyRect* dirty,
+        std::size_t dirtyCount,
+        std::uint64_t nowUs
+    ) {
+        if (!attached() || !bgra || width <= 0 || height <= 0) {
+            return WebviewFrameSubmitResult::Dropped;
+        }
+        if (static_cast<std::uint32_t>(width) != lastWidth_ ||
+            static_cast<std::uint32_t>(height) != lastHeight_ || !dirty) {
+            pendingFull_ = true;
+        } else {
+            for (std::size_t i = 0; i < dirtyCount; ++i) {
+                addPendingRect(dirty[i], width, height);
+            }
+        }
+
+        const std::uint64_t rowBytes = static_cast<std::uint64_t>(width) * 4;
+        if (rowBytes * static_cast<std::uint64_t>(height) > pixelCapacity_) {
+            pendingFull_ = true;
+            noteDropped();
+            return WebviewFrameSubmitResult::Dropped;
+        }
+        if (throttleDelayUs(nowUs) > 0) {
+            noteDropped();
+            return WebviewFrameSubmitResult::Throttled;
+        }
+
+        const std::uint64_t next = sequence_ + 1;
+        std::uint8_t* slot = slotAt(static_cast<std::uint32_t>((next - 1) % slotCount_));
+        storeWebviewFrameRingU64(slot, 0);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(slot + 8, &nowUs, sizeof(nowUs));
+        const std::uint32_t fields[4] = {
+            static_cast<std::uint32_t>(width),
+            static_cast<std::uint32_t>(height),
+            static_cast<std::uint32_t>(rowBytes),
+            pendingFull_ ? 1u : pendingCount_,
+        };
+        std::memcpy(slot + 16, fields, sizeof(fields));
+        if (pendingFull_) {
+            const WebviewFrameDirtyRect full = {0, 0, width, height};
+            std::memcpy(slot + kWebviewFrameSlotDirtyOffset, &full, sizeof(full));
+        } else {
+            std::memcpy(slot + kWebviewFrameSlotDirtyOffset, pending_,
+                        sizeof(WebviewFrameDirtyRect) * pendingCount_);
+        }
+        std::uint8_t* pixels = slot + kWebviewFrameSlotHeaderSize;
+        if (stride == rowBytes) {
+            std::memcpy(pixels, bgra, static_cast<std::size_t>(rowBytes) * height);
+        } else {
+            for (int row = 0; row < height; ++row) {
+                std::memcpy(pixels + static_cast<std::size_t>(row) * rowBytes,
+                            bgra + static_cast<std::size_t>(row) * stride,
+                            static_cast<std::size_t>(rowBytes));
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWebviewFrameRingU64(slot, next);
+        storeWebviewFrameRingU64(memory_ + 24, next);
+
+        sequence_ = next;
+        lastPublishUs_ = nowUs;
+        lastWidth_ = static_cast<std::uint32_t>(width);
+        lastHeight_ = static_cast<std::uint32_t>(height);
+        pendingCount_ = 0;
+        pendingFull_ = false;
+        return WebviewFrameSubmitResult::Published;
+    }
+
+private:
+    std::uint8_t* slotAt(std::uint32_t slot) const {
+        return memory_ + kWebviewFrameRingHeaderSize + static_cast<std::size_t>(slot) * slotStride_;
+    }
+
+    void noteDropped() {
+        ++dropped_;
+        storeWebviewFrameRingU32(memory_ + 20, dropped_);
+    }
+
+    // Clip to the frame; past the slot's rect budget, fall back to one
+    // bounding rect.
+    void addPendingRect(const WebviewFrameDirtyRect& rect, int width, int height) {
+        if (pendingFull_) return;
+        const std::int32_t left = std::max<std::int32_t>(rect.x, 0);
+        const std::int32_t top = std::max<std::int32_t>(rect.y, 0);
+        const std::int32_t right = static_cast<std::int32_t>(
+            std::min<std::int64_t>(static_cast<std::int64_t>(rect.x) + rect.width, width));
+        const std::int32_t bottom = static_cast<std::int32_t>(
+            std::min<std::int64_t>(static_cast<std::int64_t>(rect.y) + rect.height, height));
+        if (right <= left || bottom <= top) return;
+        if (pendingCount_ < kWebviewFrameMaxDirtyRects) {
+            pending_[pendingCount_++] = {left, top, right - left, bottom - top};
+            return;
+        }
+        std::int32_t minX = left, minY = top, maxX = right, maxY = bottom;
+        for (std::uint32_t i = 0; i < pendingCount_; ++i) {
+            minX = std::min(minX, pending_[i].x);
+            minY = std::min(minY, pending_[i].y);
+            maxX = std::max(maxX, pending_[i].x + pending_[i].width);
+            maxY = std::max(maxY, pending_[i].y + pending_[i].height);
+        }
+        pending_[0] = {minX, minY, maxX - minX, maxY - minY};
+        pendingCount_ = 1;
+    }
+
+    std::uint8_t* memory_ = nullptr;
+    std::uint32_t slotCount_ = 0;
+    std::uint32_t slotStride_ = 0;
+    std::uint32_t pixelCapacity_ = 0;
+    std::uint64_t minIntervalUs_ = 0;
+    std::uint64_t sequence_ = 0;
+    std::uint32_t dropped_ = 0;
+    std::uint64_t lastPublishUs_ = 0;
+    std::uint32_t lastWidth_ = 0;
+    std::uint32_t lastHeight_ = 0;
+    WebviewFrameDirtyRect pending_[kWebviewFrameMaxDirtyRects] = {};
+    std::uint32_t pendingCount_ = 0;
+    bool pendingFull_ = true;
+};
+
+// Copy the newest frame out of a ring. Returns false when there is no frame
+// yet, pixels is too small, or the writer replaced the slot mid-copy (the
+// caller simply tries again).
+inline bool readLatestWebviewFrame(
+    const std::uint8_t* memory,
+    std::uint64_t length,
+    WebviewFrameInfo* info,
+    std::uint8_t* pixels,
+    std::size_t pixelsLength
+) {
+    if (!memory || !info || length < kWebviewFrameRingHeaderSize ||
+        loadWebviewFrameRingU32(memory) != kWebviewFrameRingMagic) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint32_t slotCount = loadWebviewFrameRingU32(memory + 8);
+    const std::uint32_t slotStride = loadWebviewFrameRingU32(memory + 12);
+    const std::uint64_t sequence = loadWebviewFrameRingU64(memory + 24);
+    if (sequence == 0 || slotCount == 0 ||
+        kWebviewFrameRingHeaderSize + static_cast<std::uint64_t>(slotCount) * slotStride > length) {
+        return false;
+    }
+    const std::uint8_t* slot = memory + kWebviewFrameRingHeaderSize +
+        static_cast<std::size_t>((sequence - 1) % slotCount) * slotStride;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (loadWebviewFrameRingU64(slot) != sequence) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    WebviewFrameInfo copy;
+    copy.sequence = sequence;
+    std::memcpy(&copy.timestampUs, slot + 8, sizeof(copy.timestampUs));
+    std::memcpy(&copy.width, slot + 16, sizeof(std::uint32_t));
+    std::memcpy(&copy.height, slot + 20, sizeof(std::uint32_t));
+    std::memcpy(&copy.stride, slot + 24, sizeof(std::uint32_t));
+    std::memcpy(&copy.dirtyRectCount, slot + 28, sizeof(std::uint32_t));
+    const std::uint64_t frameBytes = static_cast<std::uint64_t>(copy.stride) * copy.height;
+    if (copy.dirtyRectCount > kWebviewFrameMaxDirtyRects ||
+        frameBytes > slotStride - kWebviewFrameSlotHeaderSize ||
+        (pixels && frameBytes > pixelsLength)) {
+        return false;
+    }
+    std::memcpy(copy.dirtyRects, slot + kWebviewFrameSlotDirtyOffset,
+                sizeof(WebviewFrameDirtyRect) * copy.dirtyRectCount);
+    if (pixels) {
+        std::memcpy(pixels, slot + kWebviewFrameSlotHeaderSize, static_cast<std::size_t>(frameBytes));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (loadWebviewFrameRingU64(slot) != sequence) {
+        return false;
+    }
+    *info = copy;
+    return true;
+}
+
+} // namespace electrobun
@@ -0,0 +1,123 @@
+#include "webview_frame_ring.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using electrobun::WebviewFrameDirtyRect;
+using electrobun::WebviewFrameInfo;
+using electrobun::WebviewFrameRingWriter;
+using electrobun::WebviewFrameSubmitResult;
+using electrobun::kWebviewFrameRingHeaderSize;
+using electrobun::kWebviewFrameSlotHeaderSize;
+using electrobun::readLatestWebviewFrame;
+
+namespace {
+
+std::vector<std::uint8_t> solidFrame(int width, int height, std::uint8_t value, std::size_t stride) {
+    std::vector<std::uint8_t> frame(stride * height, 0xee);
+    for (int y = 0; y < height; ++y) {
+        std::memset(frame.data() + y * stride, value, static_cast<std::size_t>(width) * 4);
+    }
+    return frame;
+}
+
+std::uint32_t droppedFrames(const std::vector<std::uint64_t>& ring) {
+    std::uint32_t dropped = 0;
+    std::memcpy(&dropped, reinterpret_cast<const std::uint8_t*>(ring.data()) + 20, sizeof(dropped));
+    return dropped;
+}
+
+}  // namespace
+
+int main() {
+    // u64 storage keeps the ring 8-byte aligned.
+    const std::size_t slotBytes = kWebviewFrameSlotHeaderSize + 4 * 4 * 4;
+    std::vector<std::uint64_t> ring((kWebviewFrameRingHeaderSize + 3 * slotBytes) / 8);
+    auto* memory = reinterpret_cast<std::uint8_t*>(ring.data());
+    const std::uint64_t length = ring.size() * 8;
+
+    WebviewFrameRingWriter writer;
+    assert(!writer.attach(memory + 4, length - 8, 3, 0));
+    assert(!writer.attach(memory, kWebviewFrameRingHeaderSize + 100, 1, 0));
+    assert(writer.attach(memory, length, 3, 10));
+    assert(writer.pixelCapacity() == 64);
+
+    WebviewFrameInfo info;
+    std::vector<std::uint8_t> pixels(64);
+    assert(!readLatestWebviewFrame(memory, length, &info, pixels.data(), pixels.size()));
+
+    // The first frame is fully dirty and strided rows are packed.
+    auto first = solidFrame(4, 4, 1, 20);
+    assert(writer.submit(first.data(), 20, 4, 4, nullptr, 0, 1000000) ==
+           WebviewFrameSubmitResult::Published);
+    assert(readLatestWebviewFrame(memory, length, &info, pixels.data(), pixels.size()));
+    assert(info.sequence == 1 && info.timestampUs == 1000000);
+    assert(info.width == 4 && info.height == 4 && info.stride == 16);
+    assert(info.dirtyRectCount == 1 && info.dirtyRects[0].width == 4 && info.dirtyRects[0].height == 4);
+    assert(pixels[0] == 1 && pixels[63] == 1);
+
+    // Frames inside the 10 FPS interval are throttled; their damage is
+    // carried by the next published frame.
+    auto second = solidFrame(4, 4, 2, 16);
+    const WebviewFrameDirtyRect early[] = {{0, 0, 1, 1}, {3, 3, 5, 5}};
+    assert(writer.submit(second.data(), 16, 4, 4, early, 2, 1050000) ==
+           WebviewFrameSubmitResult::Throttled);
+    assert(writer.hasPendingFrame());
+    assert(writer.throttleDelayUs(1050000) == 50000);
+    assert(droppedFrames(ring) == 1);
+    const WebviewFrameDirtyRect later[] = {{1, 1, 1, 1}};
+    assert(writer.submit(second.data(), 16, 4, 4, later, 1, 1100000) ==
+           WebviewFrameSubmitResult::Published);
+    assert(!writer.hasPendingFrame());
+    assert(readLatestWebviewFrame(memory, length, &info, pixels.data(), pixels.size()));
+    assert(info.sequence == 2 && pixels[0] == 2);
+    assert(info.dirtyRectCount == 3);
+    assert(info.dirtyRects[1].x == 3 && info.dirtyRects[1].width == 1 && info.dirtyRects[1].height == 1);
+
+    // Past the rect budget, damage folds into bounds but stays covered.
+    std::vector<WebviewFrameDirtyRect> many;
+    for (int i = 0; i < 20; ++i) many.push_back({i % 4, i % 3, 1, 1});
+    assert(writer.submit(second.data(), 16, 4, 4, many.data(), many.size(), 1200000) ==
+           WebviewFrameSubmitResult::Published);
+    assert(readLatestWebviewFrame(memory, length, &info, nullptr, 0));
+    assert(info.dirtyRectCount >= 1 && info.dirtyRectCount < 16);
+    for (const auto& rect : many) {
+        bool covered = false;
+        for (std::uint32_t i = 0; i < info.dirtyRectCount; ++i) {
+            const auto& dirty = info.dirtyRects[i];
+            covered = covered || (rect.x >= dirty.x && rect.y >= dirty.y &&
+                                  rect.x + 1 <= dirty.x + dirty.width &&
+                                  rect.y + 1 <= dirty.y + dirty.height);
+        }
+        assert(covered);
+    }
+
+    // Oldest slots are overwritten; the ring keeps the newest sequence.
+    assert(writer.submit(second.data(), 16, 4, 4, nullptr, 0, 1300000) ==
+           WebviewFrameSubmitResult::Published);
+    assert(readLatestWebviewFrame(memory, length, &info, nullptr, 0));
+    assert(info.sequence == 4);
+
+    // Frames bigger than a slot are dropped and force a full frame next.
+    auto large = solidFrame(8, 8, 3, 32);
+    assert(writer.submit(large.data(), 32, 8, 8, nullptr, 0, 1400000) ==
+           WebviewFrameSubmitResult::Dropped);
+    assert(writer.submit(second.data(), 16, 4, 4, later, 1, 1500000) ==
+           WebviewFrameSubmitResult::Published);
+    assert(readLatestWebviewFrame(memory, length, &info, nullptr, 0));
+    assert(info.sequence == 5 && info.dirtyRectCount == 1 && info.dirtyRects[0].width == 4);
+    assert(droppedFrames(ring) == 2);
+
+    // A slot being rewritten is never returned.
+    auto* slot = memory + kWebviewFrameRingHeaderSize + ((5 - 1) % 3) * slotBytes;
+    const std::uint64_t zero = 0;
+    std::memcpy(slot, &zero, sizeof(zero));
+    assert(!readLatestWebviewFrame(memory, length, &info, nullptr, 0));
+
+    // Undersized destinations are rejected.
+    std::memcpy(slot, &info.sequence, sizeof(info.sequence));
+    assert(!readLatestWebviewFrame(memory, length, &info, pixels.data(), 8));
+    return 0;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+
+namespace electrobun {
+
+// How far a hidden webview has been wound down, in order.
+enum class WebviewLifecycleState : std::uint32_t {
+    active = 0,
+    // Timers and painting run at background rates.
+    throttled = 1,
+    // Script, timers and loading are suspended.
+    frozen = 2,
+    // The page is gone; its URL is kept and reloaded when the view is shown.
+    discarded = 3,
+};
+
+// Time a webview must stay hidden before entering each state. 0 skips that
+// state; all 0 turns the policy off.
+struct WebviewLifecyclePolicy {
+    std::uint32_t throttleAfterMs = 0;
+    std::uint32_t freezeAfterMs = 0;
+    std::uint32_t discardAfterMs = 0;
+
+    bool enabled() const {
+        return throttleAfterMs != 0 || freezeAfterMs != 0 || discardAfterMs != 0;
+    }
+
+    std::uint32_t afterMs(WebviewLifecycleState state) const {
+        switch (state) {
+            case WebviewLifecycleState::throttled: return throttleAfterMs;
+            case WebviewLifecycleState::frozen: return freezeAfterMs;
+            case WebviewLifecycleState::discarded: return discardAfterMs;
+            default: return 0;
+        }
+    }
+};
+
+// Counters for BrowserView.getLifecycleStats, copied verbatim to FFI callers.
+struct WebviewLifecycleStats {
+    // Transitions made, and discarded views reloaded on show.
+    std::uint64_t throttled = 0;
+    std::uint64_t frozen = 0;
+    std::uint64_t discarded = 0;
+    std::uint64_t restored = 0;
+    // Resident memory the discarded views' processes gave back.
+    std::uint64_t bytesReclaimed = 0;
+    // Show to load finished for restored views.
+    std::uint64_t lastRestoreUs = 0;
+    std::uint64_t maxRestoreUs = 0;
+    std::uint64_t totalRestoreUs = 0;
+
+    void recordRestore(std::uint64_t us) {
+        ++restored;
+        lastRestoreUs = us;
+        if (us > maxRestoreUs) maxRestoreUs = us;
+        totalRestoreUs += us;
+    }
+};
+
+static_assert(sizeof(WebviewLifecycleStats) == 64, "lifecycle stats layout changed");
+
+// One webview's place in the policy. Not thread safe; the native wrappers
+// keep it on the main thread.
+class WebviewLifecycle {
+public:
+    void hide(std::uint64_t nowMs) {
+        if (hidden_) return;
+        hidden_ = true;
+        hiddenSinceMs_ = nowMs;
+    }
+
+    // Returns the state the view was in, which the caller restores from.
+    WebviewLifecycleState show() {
+        hidden_ = false;
+        const WebviewLifecycleState previous = state_;
+        state_ = WebviewLifecycleState::active;
+        return previous;
+    }
+
+    bool hidden() const { return hidden_; }
+    WebviewLifecycleState state() const { return state_; }
+
+    // The next state the policy moves the view to, or the current one when
+    // it stays put. States the policy skips are stepped over, so callers
+    // loop until this returns state().
+    WebviewLifecycleState next(const WebviewLifecyclePolicy& policy, std::uint64_t nowMs) const {
+        if (!hidden_) return state_;
+        const std::uint64_t hiddenMs = nowMs > hiddenSinceMs_ ? nowMs - hiddenSinceMs_ : 0;
+        for (std::uint32_t step = static_cast<std::uint32_t>(state_) + 1;
+             step <= static_cast<std::uint32_t>(WebviewLifecycleState::discarded); ++step) {
+            const auto candidate = static_cast<WebviewLifecycleState>(step);
+            const std::uint32_t afterMs = policy.afterMs(candidate);
+            if (afterMs != 0 && hiddenMs >= afterMs) {
+                return candidate;
+            }
+        }
+        return state_;
+    }
+
+    void enter(WebviewLifecycleState state) { state_ = state; }
+
+private:
+    bool hidden_ = false;
+    std::uint64_t hiddenSinceMs_ = 0;
+    WebviewLifecycleState state_ = WebviewLifecycleState::active;
+};
+
+// Resident bytes freed by a discard, from pid -> RSS samples taken before
+// and some time after it. Processes that exited count in full and the rest
+// by how far they shrank. When the view's own process is not known, only
+// exits count, since live processes may be serving other views.
+inline std::uint64_t webviewDiscardReclaimedBytes(const std::map<int, std::uint64_t>& before,
+                                                  const std::map<int, std::uint64_t>& after,
+                                                  bool ownProcessKnown) {
+    std::uint64_t reclaimed = 0;
+    for (const auto& [pid, rssBefore] : before) {
+        const auto live = after.find(pid);
+        if (live == after.end()) {
+            reclaimed += rssBefore;
+        } else if (ownProcessKnown && live->second < rssBefore) {
+            reclaimed += rssBefore - live->second;
+        }
+    }
+    return reclaimed;
+}
+
+// Script that navigates the page to `url` in place of its current history
+// entry, so a discard and its restore leave back/forward as they were.
+inline std::string webviewLifecycleReplaceScript(const std::string& url) {
+    std::string script = "location.replace(\"";
+    for (const char c : url) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            script += '\\';
+            script += c;
+        } else if (byte < 0x20 || c == '<') {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\x%02x", byte);
+            script += escaped;
+        } else {
+            script += c;
+        }
+    }
+    script += "\")";
+    return script;
+}
+
+} // namespace electrobun
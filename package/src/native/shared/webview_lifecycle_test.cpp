@@ -0,0 +1,90 @@
+#include "webview_lifecycle.h"
+
+#include <cassert>
+
+using electrobun::WebviewLifecycle;
+using electrobun::WebviewLifecyclePolicy;
+using electrobun::WebviewLifecycleState;
+using electrobun::WebviewLifecycleStats;
+using electrobun::webviewDiscardReclaimedBytes;
+using electrobun::webviewLifecycleReplaceScript;
+
+int main() {
+    {
+        // Off by default; visible views never move.
+        WebviewLifecyclePolicy off;
+        assert(!off.enabled());
+        WebviewLifecycle lifecycle;
+        lifecycle.hide(0);
+        assert(lifecycle.next(off, 1000000) == WebviewLifecycleState::active);
+
+        WebviewLifecyclePolicy policy{1000, 5000, 30000};
+        WebviewLifecycle visible;
+        assert(visible.next(policy, 1000000) == WebviewLifecycleState::active);
+    }
+
+    {
+        // Each state once its time is up, one step at a time.
+        WebviewLifecyclePolicy policy{1000, 5000, 30000};
+        WebviewLifecycle lifecycle;
+        lifecycle.hide(100);
+        lifecycle.hide(900);  // Hiding again keeps the original time.
+        assert(lifecycle.next(policy, 1099) == WebviewLifecycleState::active);
+        assert(lifecycle.next(policy, 1100) == WebviewLifecycleState::throttled);
+        lifecycle.enter(WebviewLifecycleState::throttled);
+        assert(lifecycle.next(policy, 5099) == WebviewLifecycleState::throttled);
+
+        // A late tick still walks through every state in order.
+        assert(lifecycle.next(policy, 40000) == WebviewLifecycleState::frozen);
+        lifecycle.enter(WebviewLifecycleState::frozen);
+        assert(lifecycle.next(policy, 40000) == WebviewLifecycleState::discarded);
+        lifecycle.enter(WebviewLifecycleState::discarded);
+        assert(lifecycle.next(policy, 40000) == WebviewLifecycleState::discarded);
+
+        // Showing reports what to restore from and starts over.
+        assert(lifecycle.show() == WebviewLifecycleState::discarded);
+        assert(lifecycle.state() == WebviewLifecycleState::active);
+        assert(!lifecycle.hidden());
+        lifecycle.hide(50000);
+        assert(lifecycle.next(policy, 50500) == WebviewLifecycleState::active);
+    }
+
+    {
+        // Skipped states are stepped over.
+        WebviewLifecyclePolicy discardOnly{0, 0, 2000};
+        assert(discardOnly.enabled());
+        WebviewLifecycle lifecycle;
+        lifecycle.hide(0);
+        assert(lifecycle.next(discardOnly, 1999) == WebviewLifecycleState::active);
+        assert(lifecycle.next(discardOnly, 2000) == WebviewLifecycleState::discarded);
+    }
+
+    {
+        WebviewLifecycleStats stats;
+        stats.recordRestore(300);
+        stats.recordRestore(100);
+        assert(stats.restored == 2);
+        assert(stats.lastRestoreUs == 100);
+        assert(stats.maxRestoreUs == 300);
+        assert(stats.totalRestoreUs == 400);
+    }
+
+    {
+        // Exited processes count in full; shrinking ones only when the view's
+        // own process was sampled.
+        const std::map<int, std::uint64_t> before = {{10, 1000}, {11, 500}, {12, 200}};
+        const std::map<int, std::uint64_t> after = {{11, 300}, {12, 250}};
+        assert(webviewDiscardReclaimedBytes(before, after, true) == 1000 + 200);
+        assert(webviewDiscardReclaimedBytes(before, after, false) == 1000);
+        assert(webviewDiscardReclaimedBytes({}, after, true) == 0);
+    }
+
+    {
+        // URLs are quoted so they cannot end the string early.
+        assert(webviewLifecycleReplaceScript("about:blank") == "location.replace(\"about:blank\")");
+        assert(webviewLifecycleReplaceScript("https://a.test/?q=\"x\"\\\n</script>") ==
+               "location.replace(\"https://a.test/?q=\\\"x\\\"\\\\\\x0a\\x3c/script>\")");
+    }
+
+    return 0;
+}
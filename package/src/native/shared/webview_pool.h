@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace electrobun {
+
+// Counters for a webview pool, copied verbatim to FFI callers as six u64s.
+struct WebviewPoolStats {
+    // Webviews handed out from the pool, and created because it was empty.
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    // Spares built ahead of time, and built from a removed webview.
+    std::uint64_t precreated = 0;
+    std::uint64_t recycled = 0;
+    // Spares destroyed because their pool shrank.
+    std::uint64_t discarded = 0;
+    // Spares waiting in all pools.
+    std::uint64_t idle = 0;
+};
+
+static_assert(sizeof(WebviewPoolStats) == 48, "webview pool stats layout changed");
+
+// Most spares kept per key. Each is a live engine view, often with its own
+// web process, so larger requests are clamped to this.
+constexpr std::size_t kMaxWebviewPoolSize = 8;
+
+// Spare pre-created webviews, kept per key. A key names everything a spare
+// was built with that cannot change afterwards, such as the partition. Only
+// keys given a capacity are pooled. Not synchronized; the owner serializes
+// access.
+template <typename T>
+class WebviewPool {
+public:
+    // Sets how many spares to keep for `key`, at most kMaxWebviewPoolSize.
+    // Spares over the new capacity are returned for the caller to destroy.
+    std::vector<T> setCapacity(const std::string& key, std::size_t capacity) {
+        if (capacity > kMaxWebviewPoolSize) capacity = kMaxWebviewPoolSize;
+        std::vector<T> evicted;
+        if (capacity == 0) {
+            auto it = pools_.find(key);
+            if (it != pools_.end()) {
+                evicted = std::move(it->second.spares);
+                pools_.erase(it);
+            }
+        } else {
+            Pool& pool = pools_[key];
+            pool.capacity = capacity;
+            while (pool.spares.size() > capacity) {
+                evicted.push_back(std::move(pool.spares.back()));
+                pool.spares.pop_back();
+            }
+        }
+        stats_.discarded += evicted.size();
+        stats_.idle -= evicted.size();
+        return evicted;
+    }
+
+    std::size_t capacity(const std::string& key) const {
+        auto it = pools_.find(key);
+        return it == pools_.end() ? 0 : it->second.capacity;
+    }
+
+    // Takes the oldest spare for `key`. A key without a capacity counts
+    // neither a hit nor a miss.
+    bool take(const std::string& key, T* out) {
+        auto it = pools_.find(key);
+        if (it == pools_.end()) {
+            return false;
+        }
+        std::vector<T>& spares = it->second.spares;
+        if (spares.empty()) {
+            ++stats_.misses;
+            return false;
+        }
+        *out = std::move(spares.front());
+        spares.erase(spares.begin());
+        ++stats_.hits;
+        --stats_.idle;
+        return true;
+    }
+
+    // True when a spare built for `key` would be kept.
+    bool wants(const std::string& key) const {
+        auto it = pools_.find(key);
+        return it != pools_.end() && it->second.spares.size() < it->second.capacity;
+    }
+
+    // Adds a spare if the pool wants one. On false the caller still owns it.
+    bool put(const std::string& key, T spare, bool recycled) {
+        if (!wants(key)) {
+            return false;
+        }
+        pools_[key].spares.push_back(std::move(spare));
+        ++stats_.idle;
+        if (recycled) {
+            ++stats_.recycled;
+        } else {
+            ++stats_.precreated;
+        }
+        return true;
+    }
+
+    // The first key still short of its capacity, for background refills.
+    bool nextRefill(std::string* key) const {
+        for (const auto& entry : pools_) {
+            if (entry.second.spares.size() < entry.second.capacity) {
+                *key = entry.first;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const WebviewPoolStats& stats() const {
+        return stats_;
+    }
+
+private:
+    struct Pool {
+        std::size_t capacity = 0;
+        std::vector<T> spares;
+    };
+
+    std::map<std::string, Pool> pools_;
+    WebviewPoolStats stats_;
+};
+
+} // namespace electrobun
@@ -0,0 +1,76 @@
+#include "webview_pool.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+using electrobun::WebviewPool;
+
+int main() {
+    {
+        // Keys without a capacity are not pooled and are not counted.
+        WebviewPool<int> pool;
+        int spare = 0;
+        assert(!pool.wants("persist:a"));
+        assert(!pool.put("persist:a", 1, false));
+        assert(!pool.take("persist:a", &spare));
+        assert(pool.stats().misses == 0);
+        std::string key;
+        assert(!pool.nextRefill(&key));
+    }
+
+    {
+        // Spares come back oldest first and are counted as hits; an empty
+        // pool counts a miss.
+        WebviewPool<int> pool;
+        assert(pool.setCapacity("persist:a", 2).empty());
+        assert(pool.capacity("persist:a") == 2);
+        std::string key;
+        assert(pool.nextRefill(&key) && key == "persist:a");
+        assert(pool.put("persist:a", 1, false));
+        assert(pool.put("persist:a", 2, true));
+        assert(!pool.put("persist:a", 3, false));
+        assert(!pool.nextRefill(&key));
+        assert(pool.stats().precreated == 1 && pool.stats().recycled == 1);
+        assert(pool.stats().idle == 2);
+
+        int spare = 0;
+        assert(pool.take("persist:a", &spare) && spare == 1);
+        assert(pool.take("persist:a", &spare) && spare == 2);
+        assert(!pool.take("persist:a", &spare));
+        assert(pool.stats().hits == 2 && pool.stats().misses == 1 && pool.stats().idle == 0);
+        assert(pool.nextRefill(&key) && key == "persist:a");
+    }
+
+    {
+        // Shrinking hands the newest spares back; zero forgets the key.
+        WebviewPool<int> pool;
+        pool.setCapacity("persist:a", 3);
+        pool.setCapacity("persist:b", 1);
+        pool.put("persist:a", 1, false);
+        pool.put("persist:a", 2, false);
+        pool.put("persist:a", 3, false);
+        pool.put("persist:b", 4, false);
+        std::vector<int> evicted = pool.setCapacity("persist:a", 1);
+        assert(evicted.size() == 2 && evicted[0] == 3 && evicted[1] == 2);
+        evicted = pool.setCapacity("persist:b", 0);
+        assert(evicted.size() == 1 && evicted[0] == 4);
+        assert(pool.capacity("persist:b") == 0 && !pool.wants("persist:b"));
+        assert(pool.stats().discarded == 3 && pool.stats().idle == 1);
+
+        std::string key;
+        assert(!pool.nextRefill(&key));
+        int spare = 0;
+        assert(pool.take("persist:a", &spare) && spare == 1);
+        assert(pool.nextRefill(&key) && key == "persist:a");
+    }
+
+    {
+        // Oversized requests are clamped.
+        WebviewPool<int> pool;
+        pool.setCapacity("persist:a", 1u << 30);
+        assert(pool.capacity("persist:a") == electrobun::kMaxWebviewPoolSize);
+    }
+
+    return 0;
+}
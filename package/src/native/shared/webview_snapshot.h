@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace electrobun {
+
+// Output of getWebviewSnapshot. Values match the FFI `format` argument.
+enum class WebviewSnapshotFormat : std::uint32_t {
+    Png = 0,
+    Jpeg = 1,
+    // Straight (non-premultiplied) RGBA rows written into a caller buffer.
+    Rgba = 2,
+};
+
+inline bool parseWebviewSnapshotFormat(std::uint32_t value, WebviewSnapshotFormat* format) {
+    if (value > static_cast<std::uint32_t>(WebviewSnapshotFormat::Rgba)) {
+        return false;
+    }
+    *format = static_cast<WebviewSnapshotFormat>(value);
+    return true;
+}
+
+struct WebviewSnapshotSize {
+    int width;
+    int height;
+};
+
+// Aspect-fit a captured size into the caller's bounds. Zero bounds mean
+// unbounded; snapshots are never upscaled and never collapse below 1x1.
+inline WebviewSnapshotSize fitWebviewSnapshotSize(
+    int width,
+    int height,
+    int maxWidth,
+    int maxHeight
+) {
+    if (width <= 0 || height <= 0) {
+        return {0, 0};
+    }
+    double scale = 1.0;
+    if (maxWidth > 0) {
+        scale = std::min(scale, static_cast<double>(maxWidth) / width);
+    }
+    if (maxHeight > 0) {
+        scale = std::min(scale, static_cast<double>(maxHeight) / height);
+    }
+    if (scale >= 1.0) {
+        return {width, height};
+    }
+    return {
+        std::max(1, static_cast<int>(std::floor(width * scale))),
+        std::max(1, static_cast<int>(std::floor(height * scale))),
+    };
+}
+
+struct WebviewSnapshotRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+// Map a view-local logical region onto a captured image of pixelWidth x
+// pixelHeight that shows viewWidth x viewHeight logical pixels. A region with
+// no area selects the whole image; the result is clipped to the image.
+inline WebviewSnapshotRect webviewSnapshotCropRect(
+    double regionX,
+    double regionY,
+    double regionWidth,
+    double regionHeight,
+    double viewWidth,
+    double viewHeight,
+    int pixelWidth,
+    int pixelHeight
+) {
+    if (pixelWidth <= 0 || pixelHeight <= 0) {
+        return {0, 0, 0, 0};
+    }
+    if (!(regionWidth > 0.0) || !(regionHeight > 0.0) ||
+        !(viewWidth > 0.0) || !(viewHeight > 0.0) ||
+        !std::isfinite(regionX) || !std::isfinite(regionY)) {
+        return {0, 0, pixelWidth, pixelHeight};
+    }
+    const double scaleX = pixelWidth / viewWidth;
+    const double scaleY = pixelHeight / viewHeight;
+    const auto clampEdge = [](double value, int limit) {
+        return static_cast<int>(std::clamp(std::round(value), 0.0, static_cast<double>(limit)));
+    };
+    const int left = clampEdge(regionX * scaleX, pixelWidth);
+    const int top = clampEdge(regionY * scaleY, pixelHeight);
+    const int right = clampEdge((regionX + regionWidth) * scaleX, pixelWidth);
+    const int bottom = clampEdge((regionY + regionHeight) * scaleY, pixelHeight);
+    if (right <= left || bottom <= top) {
+        return {0, 0, 0, 0};
+    }
+    return {left, top, right - left, bottom - top};
+}
+
+// Read the dimensions from a PNG's IHDR chunk without decoding it.
+inline bool readWebviewSnapshotPngSize(
+    const std::uint8_t* bytes,
+    std::size_t length,
+    WebviewSnapshotSize* size
+) {
+    static const std::uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    if (!bytes || !size || length < 24 ||
+        !std::equal(kSignature, kSignature + 8, bytes) ||
+        bytes[12] != 'I' || bytes[13] != 'H' || bytes[14] != 'D' || bytes[15] != 'R') {
+        return false;
+    }
+    const auto readU32 = [bytes](std::size_t offset) {
+        return (static_cast<std::uint32_t>(bytes[offset]) << 24) |
+            (static_cast<std::uint32_t>(bytes[offset + 1]) << 16) |
+            (static_cast<std::uint32_t>(bytes[offset + 2]) << 8) |
+            static_cast<std::uint32_t>(bytes[offset + 3]);
+    };
+    const std::uint32_t width = readU32(16);
+    const std::uint32_t height = readU32(20);
+    if (width == 0 || height == 0 || width > 0x7fffffffu || height > 0x7fffffffu) {
+        return false;
+    }
+    size->width = static_cast<int>(width);
+    size->height = static_cast<int>(height);
+    return true;
+}
+
+// Area-average premultiplied BGRA (cairo ARGB32 on little-endian, CEF paint
+// buffers) into straight RGBA of dstWidth x dstHeight. Averaging happens in
+// premultiplied space so transparent pixels do not bleed colour into edges;
+// alpha is divided out once per output pixel. Opaque sources (cairo RGB24)
+// leave the alpha byte undefined, so it is treated as 255.
+inline void resampleWebviewSnapshotBgra(
+    const std::uint8_t* src,
+    std::size_t srcStride,
+    int srcWidth,
+    int srcHeight,
+    std::uint8_t* dst,
+    int dstWidth,
+    int dstHeight,
+    bool opaque = false
+) {
+    if (!src || !dst || srcWidth <= 0 || srcHeight <= 0 ||
+        dstWidth <= 0 || dstHeight <= 0) {
+        return;
+    }
+
+    // Source column span for every output column, computed once.
+    std::vector<int> columnStart(static_cast<std::size_t>(dstWidth) + 1);
+    for (int x = 0; x <= dstWidth; ++x) {
+        columnStart[static_cast<std::size_t>(x)] = static_cast<int>(
+            static_cast<long long>(x) * srcWidth / dstWidth);
+    }
+    std::vector<std::uint64_t> sums(static_cast<std::size_t>(dstWidth) * 4);
+
+    for (int y = 0; y < dstHeight; ++y) {
+        const int rowBegin = static_cast<int>(static_cast<long long>(y) * srcHeight / dstHeight);
+        const int rowEnd = std::max(
+            rowBegin + 1,
+            static_cast<int>(static_cast<long long>(y + 1) * srcHeight / dstHeight));
+        std::fill(sums.begin(), sums.end(), 0ull);
+        for (int row = rowBegin; row < rowEnd; ++row) {
+            const std::uint8_t* srcRow = src + static_cast<std::size_t>(row) * srcStride;
+            for (int x = 0; x < dstWidth; ++x) {
+                const int begin = columnStart[static_cast<std::size_t>(x)];
+                const int end = std::max(begin + 1, columnStart[static_cast<std::size_t>(x) + 1]);
+                std::uint64_t* sum = &sums[static_cast<std::size_t>(x) * 4];
+                for (int column = begin; column < end; ++column) {
+                    const std::uint8_t* bgra = srcRow + static_cast<std::size_t>(column) * 4;
+                    sum[0] += bgra[2];
+                    sum[1] += bgra[1];
+                    sum[2] += bgra[0];
+                    sum[3] += opaque ? 255u : bgra[3];
+                }
+            }
+        }
+
+        std::uint8_t* dstRow = dst + static_cast<std::size_t>(y) * dstWidth * 4;
+        const int rows = rowEnd - rowBegin;
+        for (int x = 0; x < dstWidth; ++x) {
+            const int begin = columnStart[static_cast<std::size_t>(x)];
+            const int end = std::max(begin + 1, columnStart[static_cast<std::size_t>(x) + 1]);
+            const std::uint64_t count =
+                static_cast<std::uint64_t>(rows) * static_cast<std::uint64_t>(end - begin);
+            const std::uint64_t* sum = &sums[static_cast<std::size_t>(x) * 4];
+            std::uint8_t* rgba = dstRow + static_cast<std::size_t>(x) * 4;
+            const std::uint64_t alpha = (sum[3] + count / 2) / count;
+            rgba[3] = static_cast<std::uint8_t>(alpha);
+            for (int channel = 0; channel < 3; ++channel) {
+                if (alpha == 0) {
+                    rgba[channel] = 0;
+                    continue;
+                }
+                // (sum / count) * 255 / alpha, rounded, without losing the
+                // precision of the averaged premultiplied value.
+                const std::uint64_t scaled =
+                    (sum[channel] * 255 + alpha * count / 2) / (alpha * count);
+                rgba[channel] = static_cast<std::uint8_t>(std::min<std::uint64_t>(scaled, 255));
+            }
+        }
+    }
+}
+
+// JPEG has no alpha channel: composite straight RGBA over white into RGB.
+inline void flattenWebviewSnapshotRgba(
+    const std::uint8_t* rgba,
+    std::size_t pixelCount,
+    std::uint8_t* rgb
+) {
+    for (std::size_t i = 0; i < pixelCount; ++i) {
+        const std::uint32_t alpha = rgba[i * 4 + 3];
+        for (int channel = 0; channel < 3; ++channel) {
+            const std::uint32_t value = rgba[i * 4 + channel];
+            rgb[i * 3 + channel] = static_cast<std::uint8_t>(
+                (value * alpha + 255u * (255u - alpha) + 127u) / 255u);
+        }
+    }
+}
+
+inline std::string encodeWebviewSnapshotDataUrl(
+    const char* mimeType,
+    const std::uint8_t* bytes,
+    std::size_t length
+) {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string url = "data:";
+    url += mimeType;
+    url += ";base64,";
+    const std::size_t prefix = url.size();
+    url.resize(prefix + (length + 2) / 3 * 4);
+    char* out = &url[prefix];
+    std::size_t i = 0;
+    for (; i + 2 < length; i += 3) {
+        const std::uint32_t triple = (static_cast<std::uint32_t>(bytes[i]) << 16) |
+            (static_cast<std::uint32_t>(bytes[i + 1]) << 8) | bytes[i + 2];
+        *out++ = kAlphabet[(triple >> 18) & 0x3f];
+        *out++ = kAlphabet[(triple >> 12) & 0x3f];
+        *out++ = kAlphabet[(triple >> 6) & 0x3f];
+        *out++ = kAlphabet[triple & 0x3f];
+    }
+    if (i < length) {
+        const std::uint32_t triple = (static_cast<std::uint32_t>(bytes[i]) << 16) |
+            (i + 1 < length ? static_cast<std::uint32_t>(bytes[i + 1]) << 8 : 0u);
+        *out++ = kAlphabet[(triple >> 18) & 0x3f];
+        *out++ = kAlphabet[(triple >> 12) & 0x3f];
+        *out++ = i + 1 < length ? kAlphabet[(triple >> 6) & 0x3f] : '=';
+        *out++ = '=';
+    }
+    return url;
+}
+
+// Pull the base64 payload out of a DevTools Page.captureScreenshot result,
+// `{"data":"..."}`. JSON may escape '/' as "\/"; base64 has no other
+// characters that need escaping, so backslashes are simply dropped.
+inline std::string extractDevToolsScreenshotData(const char* json, std::size_t length) {
+    static const char kKey[] = "\"data\"";
+    const std::string_view text(json ? json : "", json ? length : 0);
+    std::size_t pos = text.find(kKey);
+    if (pos == std::string_view::npos) {
+        return {};
+    }
+    pos = text.find_first_not_of(" \t\r\n", pos + sizeof(kKey) - 1);
+    if (pos == std::string_view::npos || text[pos] != ':') {
+        return {};
+    }
+    pos = text.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string_view::npos || text[pos] != '"') {
+        return {};
+    }
+    std::string data;
+    for (++pos; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        if (c == '"') {
+            return data;
+        }
+        if (c != '\\') {
+            data.push_back(c);
+        }
+    }
+    return {};
+}
+
+} // namespace electrobun
@@ -0,0 +1,127 @@
+#include "webview_snapshot.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using electrobun::WebviewSnapshotFormat;
+using electrobun::WebviewSnapshotRect;
+using electrobun::WebviewSnapshotSize;
+using electrobun::encodeWebviewSnapshotDataUrl;
+using electrobun::extractDevToolsScreenshotData;
+using electrobun::fitWebviewSnapshotSize;
+using electrobun::flattenWebviewSnapshotRgba;
+using electrobun::parseWebviewSnapshotFormat;
+using electrobun::readWebviewSnapshotPngSize;
+using electrobun::resampleWebviewSnapshotBgra;
+using electrobun::webviewSnapshotCropRect;
+
+namespace {
+
+bool sameRect(const WebviewSnapshotRect& rect, int x, int y, int width, int height) {
+    return rect.x == x && rect.y == y && rect.width == width && rect.height == height;
+}
+
+}  // namespace
+
+int main() {
+    WebviewSnapshotFormat format = WebviewSnapshotFormat::Png;
+    assert(parseWebviewSnapshotFormat(1, &format) && format == WebviewSnapshotFormat::Jpeg);
+    assert(parseWebviewSnapshotFormat(2, &format) && format == WebviewSnapshotFormat::Rgba);
+    assert(!parseWebviewSnapshotFormat(3, &format));
+
+    // Thumbnails keep the aspect ratio and never upscale.
+    WebviewSnapshotSize fitted = fitWebviewSnapshotSize(1920, 1080, 320, 320);
+    assert(fitted.width == 320 && fitted.height == 180);
+    fitted = fitWebviewSnapshotSize(1920, 1080, 0, 90);
+    assert(fitted.width == 160 && fitted.height == 90);
+    fitted = fitWebviewSnapshotSize(200, 100, 400, 400);
+    assert(fitted.width == 200 && fitted.height == 100);
+    fitted = fitWebviewSnapshotSize(4000, 2, 100, 0);
+    assert(fitted.width == 100 && fitted.height == 1);
+    fitted = fitWebviewSnapshotSize(0, 100, 10, 10);
+    assert(fitted.width == 0 && fitted.height == 0);
+
+    // Logical regions map onto HiDPI captures and clip to the image.
+    assert(sameRect(webviewSnapshotCropRect(0, 0, 0, 0, 800, 600, 1600, 1200),
+                    0, 0, 1600, 1200));
+    assert(sameRect(webviewSnapshotCropRect(10, 20, 100, 50, 800, 600, 1600, 1200),
+                    20, 40, 200, 100));
+    assert(sameRect(webviewSnapshotCropRect(-10, 590, 100, 50, 800, 600, 800, 600),
+                    0, 590, 90, 10));
+    assert(sameRect(webviewSnapshotCropRect(900, 0, 10, 10, 800, 600, 800, 600),
+                    0, 0, 0, 0));
+
+    // IHDR dimensions are read without decoding.
+    const std::uint8_t png[24] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+        0, 0, 0, 13, 'I', 'H', 'D', 'R',
+        0, 0, 0x05, 0x00, 0, 0, 0x02, 0xd0,
+    };
+    WebviewSnapshotSize pngSize = {};
+    assert(readWebviewSnapshotPngSize(png, sizeof(png), &pngSize));
+    assert(pngSize.width == 1280 && pngSize.height == 720);
+    assert(!readWebviewSnapshotPngSize(png, 20, &pngSize));
+    std::uint8_t notPng[24];
+    std::memcpy(notPng, png, sizeof(png));
+    notPng[1] = 'J';
+    assert(!readWebviewSnapshotPngSize(notPng, sizeof(notPng), &pngSize));
+
+    // 1:1 resampling is a BGRA -> RGBA swizzle that honours the stride.
+    const std::uint8_t bgra[] = {
+        10, 20, 30, 255,  40, 50, 60, 255,  0xee, 0xee,
+        70, 80, 90, 255,  0, 0, 0, 0,       0xee, 0xee,
+    };
+    std::uint8_t rgba[16] = {};
+    resampleWebviewSnapshotBgra(bgra, 10, 2, 2, rgba, 2, 2);
+    const std::uint8_t expected[16] = {
+        30, 20, 10, 255,  60, 50, 40, 255,
+        90, 80, 70, 255,  0, 0, 0, 0,
+    };
+    assert(std::memcmp(rgba, expected, sizeof(expected)) == 0);
+
+    // Downscaling averages premultiplied values: a transparent neighbour
+    // lowers alpha but does not darken the colour.
+    const std::uint8_t halfRed[] = {
+        0, 0, 200, 200,  0, 0, 0, 0,
+        0, 0, 200, 200,  0, 0, 0, 0,
+    };
+    std::uint8_t averaged[4] = {};
+    resampleWebviewSnapshotBgra(halfRed, 8, 2, 2, averaged, 1, 1);
+    assert(averaged[0] == 255 && averaged[1] == 0 && averaged[2] == 0);
+    assert(averaged[3] == 100);
+
+    // Opaque sources ignore whatever is in the alpha byte.
+    const std::uint8_t rgb24[] = {30, 20, 10, 0};
+    std::uint8_t opaque[4] = {};
+    resampleWebviewSnapshotBgra(rgb24, 4, 1, 1, opaque, 1, 1, true);
+    assert(opaque[0] == 10 && opaque[1] == 20 && opaque[2] == 30 && opaque[3] == 255);
+
+    // Large reductions stay in range.
+    std::vector<std::uint8_t> white(static_cast<std::size_t>(512) * 512 * 4, 255);
+    std::uint8_t single[4] = {};
+    resampleWebviewSnapshotBgra(white.data(), 512 * 4, 512, 512, single, 1, 1);
+    assert(single[0] == 255 && single[3] == 255);
+
+    // JPEG output composites over white.
+    const std::uint8_t straight[] = {255, 0, 0, 255,  0, 0, 0, 0,  0, 0, 0, 128};
+    std::uint8_t flattened[9] = {};
+    flattenWebviewSnapshotRgba(straight, 3, flattened);
+    assert(flattened[0] == 255 && flattened[1] == 0 && flattened[2] == 0);
+    assert(flattened[3] == 255 && flattened[4] == 255 && flattened[5] == 255);
+    assert(flattened[6] == 127 && flattened[7] == 127 && flattened[8] == 127);
+
+    const std::uint8_t text[] = {'M', 'a', 'n'};
+    assert(encodeWebviewSnapshotDataUrl("image/png", text, 3) == "data:image/png;base64,TWFu");
+    assert(encodeWebviewSnapshotDataUrl("image/png", text, 2) == "data:image/png;base64,TWE=");
+    assert(encodeWebviewSnapshotDataUrl("image/jpeg", text, 1) == "data:image/jpeg;base64,TQ==");
+    assert(encodeWebviewSnapshotDataUrl("image/png", text, 0) == "data:image/png;base64,");
+
+    const char result[] = "{\"data\": \"iVBO\\/Rw0=\"}";
+    assert(extractDevToolsScreenshotData(result, sizeof(result) - 1) == "iVBO/Rw0=");
+    assert(extractDevToolsScreenshotData("{\"data\":\"abc", 11).empty());
+    assert(extractDevToolsScreenshotData("{\"error\":1}", 11).empty());
+    assert(extractDevToolsScreenshotData(nullptr, 0).empty());
+    return 0;
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace electrobun {
+
+// Per-view timings for WGPU surface work, in microseconds. Acquire and
+// present cover the whole call as the caller sees it, including any hop to
+// the thread that owns the surface, so a busy UI thread shows up here.
+// Averages are exponential with a 1/16 weight.
+struct WgpuFrameStats {
+    std::uint64_t frames = 0;
+    std::uint64_t failedPresents = 0;
+    // Present-to-present interval.
+    std::uint32_t lastFrameUs = 0;
+    std::uint32_t avgFrameUs = 0;
+    std::uint32_t maxFrameUs = 0;
+    std::uint32_t lastAcquireUs = 0;
+    std::uint32_t avgAcquireUs = 0;
+    std::uint32_t lastPresentUs = 0;
+    std::uint32_t avgPresentUs = 0;
+    // 1 when the surface is owned by a dedicated render thread.
+    std::uint32_t renderThread = 0;
+    // Refresh period of the view's monitor; 0 when unknown, in which case
+    // the pacing fields below assume 60 Hz.
+    std::uint32_t refreshPeriodUs = 0;
+    // Refreshes that passed without a new frame, summed over all intervals.
+    std::uint32_t droppedFrames = 0;
+    // Frame intervals by length in refreshes: 1, 2, 3, 4, 5 or more.
+    std::uint32_t intervalHistogram[5] = {};
+    // Acquire start to present end: the frame's CPU-side work.
+    std::uint32_t avgWorkUs = 0;
+    // Presents that blocked for over half a refresh because the swapchain
+    // queue was full.
+    std::uint32_t blockedPresents = 0;
+    std::uint32_t reserved = 0;
+};
+
+// Copied verbatim to FFI callers, which read it as an 88-byte struct.
+static_assert(sizeof(WgpuFrameStats) == 88, "WGPU frame stats layout changed");
+
+// One frame on the steady clock, in microseconds. The caller submits its
+// command buffers between acquireEndUs and presentStartUs.
+struct WgpuFrameTiming {
+    std::uint64_t acquireStartUs = 0;
+    std::uint64_t acquireEndUs = 0;
+    std::uint64_t presentStartUs = 0;
+    std::uint64_t presentEndUs = 0;
+};
+
+static_assert(sizeof(WgpuFrameTiming) == 32, "WGPU frame timing layout changed");
+
+// Not synchronized; the owner serializes access.
+class WgpuFrameStatsRecorder {
+public:
+    // Intervals longer than this are pauses, not frames, and are left out of
+    // the interval statistics.
+    static constexpr std::uint64_t kMaxFrameIntervalUs = 1000000;
+    static constexpr std::uint32_t kDefaultRefreshPeriodUs = 16667;
+    static constexpr std::size_t kTimelineFrames = 64;
+
+    explicit WgpuFrameStatsRecorder(bool renderThread = false) {
+        stats_.renderThread = renderThread ? 1 : 0;
+    }
+
+    void setRefreshPeriod(std::uint32_t periodUs) {
+        stats_.refreshPeriodUs = periodUs;
+    }
+
+    std::uint32_t refreshPeriod() const {
+        return stats_.refreshPeriodUs ? stats_.refreshPeriodUs : kDefaultRefreshPeriodUs;
+    }
+
+    void recordAcquire(std::uint64_t startUs, std::uint64_t endUs) {
+        const std::uint32_t duration = clamp(endUs > startUs ? endUs - startUs : 0);
+        stats_.lastAcquireUs = duration;
+        stats_.avgAcquireUs = average(stats_.avgAcquireUs, duration, stats_.frames == 0);
+        pending_ = WgpuFrameTiming{startUs, endUs, 0, 0};
+    }
+
+    void recordPresent(std::uint64_t startUs, std::uint64_t endUs, bool presented) {
+        const std::uint32_t duration = clamp(endUs > startUs ? endUs - startUs : 0);
+        stats_.lastPresentUs = duration;
+        stats_.avgPresentUs = average(stats_.avgPresentUs, duration, stats_.frames == 0);
+        if (!presented) {
+            ++stats_.failedPresents;
+            pending_ = WgpuFrameTiming{};
+            return;
+        }
+
+        const std::uint32_t period = refreshPeriod();
+        if (duration > period / 2) {
+            ++stats_.blockedPresents;
+        }
+        if (pending_.acquireStartUs != 0 && endUs > pending_.acquireStartUs) {
+            const std::uint32_t work = clamp(endUs - pending_.acquireStartUs);
+            stats_.avgWorkUs = average(stats_.avgWorkUs, work, timelineCount_ == 0);
+        }
+        pending_.presentStartUs = startUs;
+        pending_.presentEndUs = endUs;
+        timeline_[timelineCount_ % kTimelineFrames] = pending_;
+        ++timelineCount_;
+        pending_ = WgpuFrameTiming{};
+
+        if (lastPresentUs_ != 0 && endUs > lastPresentUs_) {
+            const std::uint64_t interval = endUs - lastPresentUs_;
+            if (interval <= kMaxFrameIntervalUs) {
+                recordInterval(static_cast<std::uint32_t>(interval), period);
+            }
+        }
+        lastPresentUs_ = endUs;
+        ++stats_.frames;
+    }
+
+    const WgpuFrameStats& stats() const {
+        return stats_;
+    }
+
+    std::uint64_t lastPresentUs() const {
+        return lastPresentUs_;
+    }
+
+    // Copy up to maxFrames of the most recent frames, oldest first. Returns
+    // how many were copied.
+    std::size_t copyTimeline(WgpuFrameTiming* out, std::size_t maxFrames) const {
+        if (!out) {
+            return 0;
+        }
+        const std::size_t available =
+            static_cast<std::size_t>(std::min<std::uint64_t>(timelineCount_, kTimelineFrames));
+        const std::size_t count = std::min(available, maxFrames);
+        const std::uint64_t first = timelineCount_ - count;
+        for (std::size_t index = 0; index < count; ++index) {
+            out[index] = timeline_[(first + index) % kTimelineFrames];
+        }
+        return count;
+    }
+
+private:
+    void recordInterval(std::uint32_t interval, std::uint32_t period) {
+        stats_.lastFrameUs = interval;
+        stats_.avgFrameUs = average(stats_.avgFrameUs, interval, intervals_ == 0);
+        stats_.maxFrameUs = std::max(stats_.maxFrameUs, interval);
+        ++intervals_;
+
+        // Round to whole refreshes so jitter around a vblank is not counted
+        // as a drop.
+        const std::uint32_t refreshes = std::max<std::uint32_t>(1, (interval + period / 2) / period);
+        ++stats_.intervalHistogram[std::min<std::uint32_t>(refreshes, 5) - 1];
+        stats_.droppedFrames += refreshes - 1;
+    }
+
+    static std::uint32_t clamp(std::uint64_t value) {
+        return static_cast<std::uint32_t>(std::min<std::uint64_t>(value, UINT32_MAX));
+    }
+
+    static std::uint32_t average(std::uint32_t current, std::uint32_t sample, bool first) {
+        if (first) {
+            return sample;
+        }
+        const std::int64_t delta =
+            static_cast<std::int64_t>(sample) - static_cast<std::int64_t>(current);
+        return static_cast<std::uint32_t>(static_cast<std::int64_t>(current) + delta / 16);
+    }
+
+    WgpuFrameStats stats_;
+    WgpuFrameTiming pending_;
+    std::array<WgpuFrameTiming, kTimelineFrames> timeline_ = {};
+    std::uint64_t timelineCount_ = 0;
+    std::uint64_t lastPresentUs_ = 0;
+    std::uint64_t intervals_ = 0;
+};
+
+// How long to wait before starting the next frame so it reaches present
+// just ahead of a refresh, instead of rendering on a fixed timer that drifts
+// against the display. Presents that complete under FIFO back-pressure land
+// on vblank, so the last present is the phase reference. workUs is the
+// expected acquire-to-present time; a margin of an eighth of a refresh
+// absorbs jitter. Returns 0 to render now.
+inline std::uint64_t wgpuFramePacingDelayUs(
+    std::uint64_t nowUs,
+    std::uint64_t lastPresentUs,
+    std::uint32_t periodUs,
+    std::uint32_t workUs
+) {
+    if (lastPresentUs == 0 || periodUs == 0 || nowUs < lastPresentUs) {
+        return 0;
+    }
+    const std::uint64_t lead = static_cast<std::uint64_t>(workUs) + periodUs / 8;
+    // Work longer than a refresh cannot be paced; start immediately.
+    if (lead >= periodUs) {
+        return 0;
+    }
+    // The first refresh after now whose start-by time has not passed.
+    std::uint64_t refreshes = (nowUs - lastPresentUs) / periodUs + 1;
+    while (lastPresentUs + refreshes * periodUs < nowUs + lead) {
+        ++refreshes;
+    }
+    return lastPresentUs + refreshes * periodUs - lead - nowUs;
+}
+
+// A surface's recorder behind a lock, timing the acquire and present calls
+// it is handed. The surface exports run those on the JS thread while frame
+// stats, the timeline and the pacer are read from others.
+class WgpuSurfaceFrameTimer {
+public:
+    using Clock = std::uint64_t (*)();
+
+    WgpuSurfaceFrameTimer(bool renderThread, Clock now) : now_(now), recorder_(renderThread) {}
+
+    void setRefreshPeriod(std::uint32_t periodUs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recorder_.setRefreshPeriod(periodUs);
+    }
+
+    template <typename Fn>
+    void acquire(Fn&& fn) {
+        const std::uint64_t start = now_();
+        fn();
+        const std::uint64_t end = now_();
+        std::lock_guard<std::mutex> lock(mutex_);
+        recorder_.recordAcquire(start, end);
+    }
+
+    // fn presents and returns whether the frame reached the surface.
+    template <typename Fn>
+    void present(Fn&& fn) {
+        const std::uint64_t start = now_();
+        const bool presented = fn();
+        const std::uint64_t end = now_();
+        std::lock_guard<std::mutex> lock(mutex_);
+        recorder_.recordPresent(start, end, presented);
+    }
+
+    WgpuFrameStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return recorder_.stats();
+    }
+
+    std::size_t copyTimeline(WgpuFrameTiming* out, std::size_t maxFrames) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return recorder_.copyTimeline(out, maxFrames);
+    }
+
+    // wgpuFramePacingDelayUs from now, for the surface's last present.
+    std::uint64_t pacingDelayUs() const {
+        const std::uint64_t now = now_();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wgpuFramePacingDelayUs(now, recorder_.lastPresentUs(), recorder_.refreshPeriod(),
+                                      recorder_.stats().avgWorkUs);
+    }
+
+private:
+    Clock now_;
+    mutable std::mutex mutex_;
+    WgpuFrameStatsRecorder recorder_;
+};
+
+} // namespace electrobun
@@ -0,0 +1,127 @@
+#include "wgpu_frame_stats.h"
+
+#include <cassert>
+#include <cstdint>
+
+using electrobun::WgpuFrameStats;
+using electrobun::WgpuFrameStatsRecorder;
+using electrobun::WgpuFrameTiming;
+using electrobun::wgpuFramePacingDelayUs;
+
+namespace {
+
+// A frame whose acquire starts at `start` and takes `acquire` us, followed by
+// `work` us of encoding and a present of `present` us.
+void recordFrame(
+    WgpuFrameStatsRecorder& recorder,
+    std::uint64_t start,
+    std::uint64_t acquire,
+    std::uint64_t work,
+    std::uint64_t present,
+    bool presented = true
+) {
+    recorder.recordAcquire(start, start + acquire);
+    const std::uint64_t presentStart = start + acquire + work;
+    recorder.recordPresent(presentStart, presentStart + present, presented);
+}
+
+}  // namespace
+
+int main() {
+    {
+        // The first samples seed the averages; later ones move them by 1/16.
+        WgpuFrameStatsRecorder recorder(true);
+        assert(recorder.stats().renderThread == 1);
+        recordFrame(recorder, 1000000, 400, 0, 200);
+        WgpuFrameStats stats = recorder.stats();
+        assert(stats.frames == 1 && stats.avgAcquireUs == 400 && stats.avgPresentUs == 200);
+        assert(stats.avgWorkUs == 600);
+        assert(stats.lastFrameUs == 0 && stats.avgFrameUs == 0);
+
+        recordFrame(recorder, 1014200, 2000, 0, 1800);
+        stats = recorder.stats();
+        assert(stats.frames == 2 && stats.lastAcquireUs == 2000 && stats.avgAcquireUs == 500);
+        assert(stats.avgPresentUs == 300 && stats.avgWorkUs == 800);
+        assert(stats.lastFrameUs == 17400 && stats.avgFrameUs == 17400 && stats.maxFrameUs == 17400);
+        assert(stats.blockedPresents == 0);
+    }
+
+    {
+        // Intervals are binned by whole refreshes; extra refreshes count as
+        // dropped frames, and long presents as back-pressure.
+        WgpuFrameStatsRecorder recorder;
+        recorder.setRefreshPeriod(10000);
+        recordFrame(recorder, 0, 100, 100, 100);       // presents at 300
+        recordFrame(recorder, 10000, 100, 100, 100);   // 1 refresh
+        recordFrame(recorder, 30500, 100, 100, 100);   // 2 refreshes
+        recordFrame(recorder, 34500, 100, 100, 6000);  // 1 refresh, blocked
+        recordFrame(recorder, 100000, 100, 100, 100);  // 5+ refreshes
+        const WgpuFrameStats stats = recorder.stats();
+        assert(stats.refreshPeriodUs == 10000);
+        assert(stats.intervalHistogram[0] == 2 && stats.intervalHistogram[1] == 1);
+        assert(stats.intervalHistogram[2] == 0 && stats.intervalHistogram[4] == 1);
+        assert(stats.droppedFrames == 1 + 5);
+        assert(stats.blockedPresents == 1);
+
+        // The timeline keeps acquire and present times, oldest first.
+        WgpuFrameTiming timeline[3];
+        assert(recorder.copyTimeline(timeline, 3) == 3);
+        assert(timeline[0].acquireStartUs == 30500 && timeline[0].acquireEndUs == 30600);
+        assert(timeline[0].presentStartUs == 30700 && timeline[0].presentEndUs == 30800);
+        assert(timeline[2].presentEndUs == 100300);
+        assert(recorder.lastPresentUs() == 100300);
+    }
+
+    {
+        // Failed presents are counted but do not end a frame, and pauses are
+        // left out of the interval statistics.
+        WgpuFrameStatsRecorder recorder;
+        assert(recorder.stats().renderThread == 0);
+        assert(recorder.refreshPeriod() == WgpuFrameStatsRecorder::kDefaultRefreshPeriodUs);
+        recorder.recordPresent(0, 10, true);
+        recorder.recordPresent(10, 20, false);
+        assert(recorder.stats().failedPresents == 1 && recorder.stats().frames == 1);
+        recorder.recordPresent(0, 11 + WgpuFrameStatsRecorder::kMaxFrameIntervalUs, true);
+        assert(recorder.stats().frames == 2 && recorder.stats().lastFrameUs == 0);
+        recorder.recordPresent(0, 11 + WgpuFrameStatsRecorder::kMaxFrameIntervalUs + 16000, true);
+        assert(recorder.stats().avgFrameUs == 16000 && recorder.stats().maxFrameUs == 16000);
+        WgpuFrameTiming timeline[WgpuFrameStatsRecorder::kTimelineFrames];
+        assert(recorder.copyTimeline(timeline, WgpuFrameStatsRecorder::kTimelineFrames) == 3);
+        assert(timeline[0].acquireStartUs == 0);
+    }
+
+    {
+        // The timeline keeps only the newest frames.
+        WgpuFrameStatsRecorder recorder;
+        for (std::uint64_t frame = 1; frame <= 100; ++frame) {
+            recordFrame(recorder, frame * 16000, 10, 10, 10);
+        }
+        WgpuFrameTiming timeline[WgpuFrameStatsRecorder::kTimelineFrames];
+        assert(recorder.copyTimeline(timeline, 1000) == WgpuFrameStatsRecorder::kTimelineFrames);
+        assert(timeline[0].acquireStartUs == 37 * 16000);
+        assert(timeline[WgpuFrameStatsRecorder::kTimelineFrames - 1].acquireStartUs == 100 * 16000);
+    }
+
+    {
+        // Durations saturate instead of wrapping.
+        WgpuFrameStatsRecorder recorder;
+        recorder.recordAcquire(0, UINT64_MAX);
+        assert(recorder.stats().lastAcquireUs == UINT32_MAX);
+    }
+
+    {
+        // Pacing starts the next frame `work` plus an eighth of a refresh
+        // before the refresh it targets.
+        assert(wgpuFramePacingDelayUs(5000, 0, 16000, 4000) == 0);
+        assert(wgpuFramePacingDelayUs(3000, 1000, 16000, 4000) == 8000);
+        // Too late for the next refresh: aim for the one after.
+        assert(wgpuFramePacingDelayUs(12000, 1000, 16000, 4000) == 15000);
+        // Several refreshes idle: still phase-locked to the last present.
+        assert(wgpuFramePacingDelayUs(100000, 1000, 16000, 4000) == 7000);
+        // Work longer than a refresh cannot be paced.
+        assert(wgpuFramePacingDelayUs(3000, 1000, 16000, 15000) == 0);
+        assert(wgpuFramePacingDelayUs(3000, 1000, 0, 0) == 0);
+    }
+
+    return 0;
+}
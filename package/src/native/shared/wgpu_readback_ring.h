@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace electrobun {
+
+// Bookkeeping for a pool of WGPU readback slots. Each slot pairs a MAP_READ
+// staging buffer (owned by the platform wrapper) with a host slab owned here,
+// so a readback every frame reuses the same GPU and host memory instead of
+// allocating both. Map callbacks may run on a Dawn thread, hence the lock.
+//
+// A readback is identified by a non-zero id. Ids grow monotonically and are
+// never reused, so a stale id reports Unknown instead of another readback's
+// data.
+enum class WgpuReadbackStatus : std::int32_t {
+    Pending = 0,
+    Ready = 1,
+    MapFailed = 2,
+    RangeFailed = 3,
+    Unknown = 4,
+};
+
+struct WgpuReadbackRingStats {
+    std::uint32_t slotCount = 0;
+    std::uint32_t inUse = 0;
+    std::uint64_t slotSize = 0;
+    std::uint32_t peakInUse = 0;
+    // Completions that found the notification queue full. Their readbacks
+    // are still visible through status().
+    std::uint32_t completionsDropped = 0;
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    // Submissions turned away because every slot was still in flight or
+    // unconsumed. A growing count means the pool is too small for the
+    // caller's pipelining depth.
+    std::uint64_t stalls = 0;
+};
+
+// Copied verbatim to FFI callers, which read it as a 56-byte struct.
+static_assert(sizeof(WgpuReadbackRingStats) == 56, "readback stats layout changed");
+
+class WgpuReadbackRing {
+public:
+    static constexpr std::uint32_t kMaxSlots = 64;
+    // Upper bound on the CPU slab, all slots together.
+    static constexpr std::uint64_t kMaxSlabBytes = 1ull << 30;
+
+    // Whether a ring of this shape is within kMaxSlabBytes.
+    static bool fits(std::uint32_t slotCount, std::uint64_t slotSize) {
+        const std::uint64_t slots = std::min(slotCount, kMaxSlots);
+        return slots > 0 && slotSize > 0 && slotSize <= kMaxSlabBytes / slots;
+    }
+
+    WgpuReadbackRing(std::uint32_t slotCount, std::uint64_t slotSize)
+        : slots_(std::min(slotCount, kMaxSlots)),
+          slotSize_(static_cast<std::size_t>(slotSize)),
+          slab_(slots_.size() * static_cast<std::size_t>(slotSize)) {}
+
+    std::uint32_t slotCount() const {
+        return static_cast<std::uint32_t>(slots_.size());
+    }
+
+    std::uint64_t slotSize() const {
+        return slotSize_;
+    }
+
+    // Claim a free slot for a readback of `size` bytes. False, counting a
+    // stall, when none is free; false without a stall when size is 0 or
+    // larger than a slot.
+    bool acquire(std::uint64_t size, std::uint64_t* id, std::uint32_t* slot) {
+        if (!id || !slot || size == 0 || size > slotSize_) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t index = 0; index < slots_.size(); ++index) {
+            Slot& candidate = slots_[index];
+            if (candidate.id != 0) {
+                continue;
+            }
+            candidate.id = ++lastId_;
+            candidate.size = size;
+            candidate.status = WgpuReadbackStatus::Pending;
+            ++inUse_;
+            ++stats_.submitted;
+            stats_.peakInUse = std::max(stats_.peakInUse, inUse_);
+            *id = candidate.id;
+            *slot = static_cast<std::uint32_t>(index);
+            return true;
+        }
+        ++stats_.stalls;
+        return false;
+    }
+
+    // Record the outcome of a slot's map and return the readback's id, or 0
+    // when the slot was not pending. Ready slots keep their data until
+    // released.
+    std::uint64_t complete(std::uint32_t slot, WgpuReadbackStatus status) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot >= slots_.size() || slots_[slot].id == 0 ||
+            slots_[slot].status != WgpuReadbackStatus::Pending) {
+            return 0;
+        }
+        slots_[slot].status = status;
+        if (status == WgpuReadbackStatus::Ready) {
+            ++stats_.completed;
+        } else {
+            ++stats_.failed;
+        }
+        return slots_[slot].id;
+    }
+
+    WgpuReadbackStatus status(std::uint64_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Slot* slot = find(id);
+        return slot ? slot->status : WgpuReadbackStatus::Unknown;
+    }
+
+    // The slab holding a Ready readback, valid until release(id).
+    std::uint8_t* data(std::uint64_t id, std::uint64_t* size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Slot* slot = find(id);
+        if (!slot || slot->status != WgpuReadbackStatus::Ready) {
+            return nullptr;
+        }
+        if (size) {
+            *size = slot->size;
+        }
+        return slab(static_cast<std::uint32_t>(slot - slots_.data()));
+    }
+
+    // Host memory for a slot; map callbacks copy into it.
+    std::uint8_t* slab(std::uint32_t slot) {
+        return slot < slots_.size()
+            ? slab_.data() + static_cast<std::size_t>(slot) * slotSize_
+            : nullptr;
+    }
+
+    std::uint64_t size(std::uint32_t slot) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slot < slots_.size() ? slots_[slot].size : 0;
+    }
+
+    // Return a finished slot to the pool. Pending readbacks cannot be
+    // released; their staging buffer is still mapping.
+    bool release(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot* slot = find(id);
+        if (!slot || slot->status == WgpuReadbackStatus::Pending) {
+            return false;
+        }
+        *slot = Slot{};
+        --inUse_;
+        return true;
+    }
+
+    WgpuReadbackRingStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        WgpuReadbackRingStats result = stats_;
+        result.slotCount = static_cast<std::uint32_t>(slots_.size());
+        result.slotSize = slotSize_;
+        result.inUse = inUse_;
+        return result;
+    }
+
+private:
+    struct Slot {
+        std::uint64_t id = 0;
+        std::uint64_t size = 0;
+        WgpuReadbackStatus status = WgpuReadbackStatus::Pending;
+    };
+
+    const Slot* find(std::uint64_t id) const {
+        if (id == 0) {
+            return nullptr;
+        }
+        for (const Slot& slot : slots_) {
+            if (slot.id == id) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    Slot* find(std::uint64_t id) {
+        return const_cast<Slot*>(static_cast<const WgpuReadbackRing*>(this)->find(id));
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Slot> slots_;
+    std::size_t slotSize_;
+    std::vector<std::uint8_t> slab_;
+    std::uint64_t lastId_ = 0;
+    std::uint32_t inUse_ = 0;
+    WgpuReadbackRingStats stats_;
+};
+
+// Finished readbacks waiting for the host, filled by map callbacks on
+// whichever thread Dawn runs them and drained by the JS thread after an fd
+// wakeup. A bounded multi-producer queue (Vyukov's sequence-per-cell ring),
+// so a map callback never blocks on the consumer.
+class WgpuReadbackCompletionQueue {
+public:
+    struct Entry {
+        std::uint64_t id = 0;
+        WgpuReadbackStatus status = WgpuReadbackStatus::Unknown;
+    };
+
+    // Capacity is rounded up to a power of two.
+    explicit WgpuReadbackCompletionQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (std::size_t index = 0; index < size; ++index) {
+            cells_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    // False, counting a drop, when the consumer has fallen a full queue
+    // behind.
+    bool push(std::uint64_t id, WgpuReadbackStatus status) {
+        std::size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) -
+                                       static_cast<std::ptrdiff_t>(position);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+                    cell.entry = Entry{id, status};
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(Entry* out) {
+        std::size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) -
+                                       static_cast<std::ptrdiff_t>(position + 1);
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+                    if (out) {
+                        *out = cell.entry;
+                    }
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::uint32_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        Entry entry;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::atomic<std::uint32_t> dropped_{0};
+};
+
+} // namespace electrobun
@@ -0,0 +1,135 @@
+#include "wgpu_readback_ring.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using electrobun::WgpuReadbackCompletionQueue;
+using electrobun::WgpuReadbackRing;
+using electrobun::WgpuReadbackRingStats;
+using electrobun::WgpuReadbackStatus;
+
+int main() {
+    {
+        // Slots are handed out until the pool is full; then submissions stall.
+        WgpuReadbackRing ring(2, 16);
+        std::uint64_t first = 0;
+        std::uint64_t second = 0;
+        std::uint64_t third = 0;
+        std::uint32_t firstSlot = 0;
+        std::uint32_t secondSlot = 0;
+        std::uint32_t slot = 0;
+        assert(!ring.acquire(0, &first, &slot));
+        assert(!ring.acquire(17, &first, &slot));
+        assert(ring.acquire(16, &first, &firstSlot));
+        assert(ring.acquire(4, &second, &secondSlot));
+        assert(first != 0 && second != first && firstSlot != secondSlot);
+        assert(!ring.acquire(4, &third, &slot));
+        assert(ring.status(first) == WgpuReadbackStatus::Pending);
+        assert(ring.data(first, nullptr) == nullptr);
+        assert(!ring.release(first));
+
+        // Completed slots expose their slab in place until released.
+        std::memset(ring.slab(secondSlot), 0xab, 4);
+        assert(ring.complete(secondSlot, WgpuReadbackStatus::Ready) == second);
+        assert(ring.complete(secondSlot, WgpuReadbackStatus::MapFailed) == 0);
+        std::uint64_t size = 0;
+        const std::uint8_t* bytes = ring.data(second, &size);
+        assert(bytes == ring.slab(secondSlot) && size == 4 && bytes[3] == 0xab);
+        assert(ring.complete(firstSlot, WgpuReadbackStatus::MapFailed) == first);
+        assert(ring.status(first) == WgpuReadbackStatus::MapFailed);
+        assert(ring.data(first, nullptr) == nullptr);
+
+        const WgpuReadbackRingStats busy = ring.stats();
+        assert(busy.slotCount == 2 && busy.slotSize == 16 && busy.inUse == 2);
+        assert(busy.peakInUse == 2 && busy.submitted == 2 && busy.stalls == 1);
+        assert(busy.completed == 1 && busy.failed == 1);
+
+        // Released ids are never reused.
+        assert(ring.release(second));
+        assert(!ring.release(second));
+        assert(ring.status(second) == WgpuReadbackStatus::Unknown);
+        assert(ring.acquire(8, &third, &slot));
+        assert(slot == secondSlot && third > second);
+        assert(ring.release(first));
+        assert(ring.stats().inUse == 1);
+    }
+
+    {
+        // The slot count is capped so id lookups stay a short scan.
+        WgpuReadbackRing ring(1000, 1);
+        assert(ring.slotCount() == WgpuReadbackRing::kMaxSlots);
+        assert(ring.slab(WgpuReadbackRing::kMaxSlots) == nullptr);
+    }
+
+    {
+        // Shapes beyond the slab limit are rejected before allocating.
+        assert(WgpuReadbackRing::fits(4, 4096));
+        assert(WgpuReadbackRing::fits(1000, WgpuReadbackRing::kMaxSlabBytes / WgpuReadbackRing::kMaxSlots));
+        assert(!WgpuReadbackRing::fits(2, WgpuReadbackRing::kMaxSlabBytes));
+        assert(!WgpuReadbackRing::fits(1, ~0ull));
+        assert(!WgpuReadbackRing::fits(0, 4096));
+        assert(!WgpuReadbackRing::fits(4, 0));
+    }
+
+    {
+        // Completions come out in order; a full queue drops and counts.
+        WgpuReadbackCompletionQueue queue(3);
+        assert(queue.capacity() == 4);
+        WgpuReadbackCompletionQueue::Entry entry;
+        assert(!queue.pop(&entry));
+        for (std::uint64_t id = 1; id <= 4; ++id) {
+            assert(queue.push(id, WgpuReadbackStatus::Ready));
+        }
+        assert(!queue.push(5, WgpuReadbackStatus::MapFailed));
+        assert(queue.dropped() == 1);
+        assert(queue.pop(&entry) && entry.id == 1 &&
+               entry.status == WgpuReadbackStatus::Ready);
+        assert(queue.push(6, WgpuReadbackStatus::MapFailed));
+        for (std::uint64_t id : {2, 3, 4, 6}) {
+            assert(queue.pop(&entry) && entry.id == id);
+        }
+        assert(entry.status == WgpuReadbackStatus::MapFailed);
+        assert(!queue.pop(&entry));
+    }
+
+    {
+        // Map callbacks may complete on several threads at once while the
+        // host drains.
+        constexpr std::uint64_t kPerProducer = 20000;
+        constexpr int kProducers = 4;
+        WgpuReadbackCompletionQueue queue(64);
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < kProducers; ++producer) {
+            producers.emplace_back([&queue, producer] {
+                for (std::uint64_t index = 0; index < kPerProducer; ++index) {
+                    const std::uint64_t id = producer * kPerProducer + index + 1;
+                    while (!queue.push(id, WgpuReadbackStatus::Ready)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        std::vector<std::uint64_t> lastSeen(kProducers, 0);
+        std::uint64_t received = 0;
+        while (received < kPerProducer * kProducers) {
+            WgpuReadbackCompletionQueue::Entry entry;
+            if (!queue.pop(&entry)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const std::uint64_t producer = (entry.id - 1) / kPerProducer;
+            assert(producer < kProducers && entry.id > lastSeen[producer]);
+            lastSeen[producer] = entry.id;
+            ++received;
+        }
+        for (auto& thread : producers) {
+            thread.join();
+        }
+        assert(!queue.pop(nullptr));
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "linux_wgpu_library.h"
+#include "wgpu_frame_stats.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+using electrobun::WgpuFrameStats;
+using electrobun::WgpuFrameTiming;
+using electrobun::WgpuSurfaceFrameTimer;
+using electrobun::openWgpuLibrary;
+
+namespace {
+
+using GetCurrentTexture = void (*)(void*, void*);
+using Present = std::int32_t (*)(void*);
+
+std::uint64_t* g_stubNowUs = nullptr;
+
+std::uint64_t stubNowUs() {
+    return *g_stubNowUs;
+}
+
+} // namespace
+
+// argv[1] is the stub library built from test_stubs/wgpu_stub_library.cpp.
+int main(int argc, char** argv) {
+    assert(argc == 2);
+
+    // The override is the only library tried, even when it cannot load.
+    setenv("ELECTROBUN_WGPU_LIBRARY", "/nonexistent/libwebgpu_dawn.so", 1);
+    assert(openWgpuLibrary({argv[1]}, argv[1]) == nullptr);
+
+    setenv("ELECTROBUN_WGPU_LIBRARY", argv[1], 1);
+    void* library = openWgpuLibrary({}, "libwebgpu_dawn-missing.so");
+    assert(library);
+    auto getCurrentTexture = reinterpret_cast<GetCurrentTexture>(dlsym(library, "wgpuSurfaceGetCurrentTexture"));
+    auto present = reinterpret_cast<Present>(dlsym(library, "wgpuSurfacePresent"));
+    g_stubNowUs = static_cast<std::uint64_t*>(dlsym(library, "wgpuStubNowUs"));
+    auto* presentStatus = static_cast<std::int32_t*>(dlsym(library, "wgpuStubPresentStatus"));
+    assert(getCurrentTexture && present && g_stubNowUs && presentStatus);
+
+    // Frames as wgpuSurfaceGetCurrentTextureMainThread and
+    // wgpuSurfacePresentMainThread run them: 500 us acquire, 2 ms of
+    // encoding, 1 ms present, one per refresh.
+    WgpuSurfaceFrameTimer timer(true, stubNowUs);
+    timer.setRefreshPeriod(16667);
+    assert(timer.pacingDelayUs() == 0);
+    auto frame = [&](std::uint64_t startUs) {
+        *g_stubNowUs = startUs;
+        timer.acquire([&]() { getCurrentTexture(nullptr, nullptr); });
+        *g_stubNowUs += 2000;
+        timer.present([&]() { return present(nullptr) == 1; });
+    };
+    for (std::uint64_t index = 0; index < 4; ++index) {
+        frame(100000 + index * 16667);
+    }
+
+    const WgpuFrameStats stats = timer.stats();
+    assert(stats.frames == 4);
+    assert(stats.renderThread == 1);
+    assert(stats.lastAcquireUs == 500);
+    assert(stats.lastPresentUs == 1000);
+    assert(stats.lastFrameUs == 16667);
+    assert(stats.avgWorkUs == 3500);
+    assert(stats.droppedFrames == 0);
+
+    // wgpuViewGetFrameTimeline: the most recent frames, oldest first.
+    WgpuFrameTiming timeline[8];
+    assert(timer.copyTimeline(timeline, 8) == 4);
+    assert(timer.copyTimeline(timeline, 2) == 2);
+    assert(timeline[1].acquireStartUs == 100000 + 3 * 16667);
+    assert(timeline[1].acquireEndUs - timeline[1].acquireStartUs == 500);
+    assert(timeline[1].presentStartUs - timeline[1].acquireEndUs == 2000);
+    assert(timeline[1].presentEndUs - timeline[1].presentStartUs == 1000);
+    assert(timeline[0].presentEndUs + 16667 == timeline[1].presentEndUs);
+
+    // wgpuViewGetFramePacingDelay, 1 ms after the last present: start so
+    // the 3.5 ms of work plus an eighth of a refresh ends at the next one.
+    const std::uint64_t lastPresentUs = timeline[1].presentEndUs;
+    *g_stubNowUs = lastPresentUs + 1000;
+    assert(timer.pacingDelayUs() == 16667 - (3500 + 16667 / 8) - 1000);
+
+    // A failed present is counted and leaves the timeline alone.
+    *presentStatus = 0;
+    frame(lastPresentUs + 16667);
+    assert(timer.stats().failedPresents == 1);
+    assert(timer.stats().frames == 4);
+    assert(timer.copyTimeline(timeline, 8) == 4);
+
+    dlclose(library);
+    return 0;
+}
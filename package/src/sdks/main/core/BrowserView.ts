@@ -1,4 +1,9 @@
-import { ffi } from "../proc/native";
+import {
+	ffi,
+	type WebviewLifecyclePolicy,
+	type WebviewSnapshot,
+	type WebviewSnapshotFormat,
+} from "../proc/native";
 import electrobunEventEmitter from "../events/eventEmitter";
 import {
 	type ElectrobunRPCSchema,
@@ -11,6 +16,11 @@ import {
 	sendMessageToWebviewViaSocket,
 	removeSocketForWebview,
 } from "./Socket";
+import {
+	readLatestWebviewFrame,
+	webviewFrameRingByteLength,
+	type WebviewFrame,
+} from "./webviewFrameRing";
 import { randomBytes } from "crypto";
 import { type Pointer } from "bun:ffi";
 
@@ -28,6 +38,8 @@ type QueuedWebviewMessage = {
 const HOST_MESSAGE_SEND_BATCH_SIZE = 32;
 const HOST_MESSAGE_SOCKET_AVAILABLE = process.platform !== "win32";
 const HOST_MESSAGE_RESPONSE_PRIORITY = process.platform === "linux";
+// Matches electrobun::kMaxWebviewPoolSize.
+const MAX_WEBVIEW_POOL_SIZE = 8;
 
 function isRpcResponsePacket(message: unknown): boolean {
 	return (
@@ -130,6 +142,7 @@ export class BrowserView<T extends RPCWithTransport = RPCWithTransport> {
 	startPassthrough: boolean = false;
 	spellCheck: boolean = false;
 	isRemoved: boolean = false;
+	private frameStreamRing: Uint8Array | null = null;
 
 	get ptr(): Pointer | null {
 		if (this.isRemoved) {
@@ -297,6 +310,99 @@ export class BrowserView<T extends RPCWithTransport = RPCWithTransport> {
 		return ffi.request.webviewSetSpellCheck({ id: this.id, enabled });
 	}
 
+	/**
+	 * Sets the paint rate for a windowless CEF view (a webview in a transparent
+	 * Linux window). 0 restores Chromium's default of 30; values above 60 are
+	 * clamped. Returns false for views that render into their own native window.
+	 */
+	setWindowlessFrameRate(frameRate: number): boolean {
+		return ffi.request.webviewSetWindowlessFrameRate({ id: this.id, frameRate });
+	}
+
+	/**
+	 * Drops a windowless CEF view to 1 frame per second while it stays on
+	 * screen, e.g. for overlays in the background. Views that are unmapped or
+	 * fully covered stop painting without this. Returns false when unsupported.
+	 */
+	setBackgroundThrottled(throttled: boolean): boolean {
+		return ffi.request.webviewSetBackgroundThrottled({ id: this.id, throttled });
+	}
+
+	/**
+	 * Where BrowserView.setLifecyclePolicy has taken this hidden webview, or
+	 * null where unsupported.
+	 */
+	getLifecycleState() {
+		return ffi.request.getWebviewLifecycleState({ id: this.id });
+	}
+
+	/**
+	 * Captures the visible page, optionally cropped to a view-local region and
+	 * scaled down to fit maxWidth x maxHeight. Encoding and scaling run off the
+	 * UI thread. "png"/"jpeg" resolve with a data URL; "rgba" resolves with
+	 * straight RGBA pixels, written into `buffer` when given (otherwise both
+	 * max bounds are required). Resolves null on failure. Linux only for now.
+	 */
+	getSnapshot(options?: {
+		region?: { x: number; y: number; width: number; height: number };
+		maxWidth?: number;
+		maxHeight?: number;
+		format?: WebviewSnapshotFormat;
+		quality?: number;
+		buffer?: Uint8Array;
+	}): Promise<WebviewSnapshot | null> {
+		return ffi.request.getWebviewSnapshot({ id: this.id, ...options });
+	}
+
+	/**
+	 * Streams frames into a shared ring so a recorder can read pixels without
+	 * per-frame FFI calls or allocations. `width` and `height` bound the frame
+	 * size in device pixels; larger frames are skipped. When all `slots` are
+	 * filled the oldest frame is replaced. Windowless CEF views publish every
+	 * paint; WebKitGTK views are sampled at `maxFps` (default 30). Linux only;
+	 * returns null when unsupported. Starting a new stream stops the previous one.
+	 */
+	startFrameStream(options: {
+		width: number;
+		height: number;
+		slots?: number;
+		maxFps?: number;
+		onFrame?: (sequence: number) => void;
+	}): {
+		ring: Uint8Array;
+		readLatest: (read?: { after?: number; target?: Uint8Array }) => WebviewFrame | null;
+		stop: () => void;
+	} | null {
+		this.stopFrameStream();
+		const slots = Math.max(1, Math.floor(options.slots ?? 3));
+		const ring = new Uint8Array(
+			webviewFrameRingByteLength(slots, options.width, options.height),
+		);
+		const started = ffi.request.webviewStartFrameStream({
+			id: this.id,
+			ring,
+			slots,
+			maxFps: options.maxFps ?? 0,
+			onFrame: options.onFrame,
+		});
+		if (!started) return null;
+		// Held here so the ring outlives every native write.
+		this.frameStreamRing = ring;
+		return {
+			ring,
+			readLatest: (read) => readLatestWebviewFrame(ring, read),
+			stop: () => {
+				if (this.frameStreamRing === ring) this.stopFrameStream();
+			},
+		};
+	}
+
+	stopFrameStream() {
+		if (!this.frameStreamRing) return;
+		this.frameStreamRing = null;
+		ffi.request.webviewStopFrameStream({ id: this.id });
+	}
+
 	findInPage(
 		searchText: string,
 		options?: { forward?: boolean; matchCase?: boolean },
@@ -514,6 +620,7 @@ export class BrowserView<T extends RPCWithTransport = RPCWithTransport> {
 			unregisterHandler() {},
 		});
 		this.rpcHandler = undefined;
+		this.stopFrameStream();
 		try {
 			ffi.request.webviewRemove({ id: this.id });
 		} catch (error) {
@@ -585,6 +692,57 @@ export class BrowserView<T extends RPCWithTransport = RPCWithTransport> {
 		return Object.values(BrowserViewMap);
 	}
 
+	/**
+	 * Keep `size` hidden webviews ready for a persistent partition, so new
+	 * BrowserViews there skip building their engine view. Spares are built
+	 * in the background at low priority; removed views showing views://
+	 * content refill the pool with their web process. Pools are separate for
+	 * autoResize and positioned views. 0 empties the pool, and sizes above 8
+	 * are clamped to 8. Returns false where pooling is unsupported (CEF,
+	 * ephemeral partitions, non-Linux).
+	 */
+	static setPoolSize(
+		size: number,
+		options: { partition?: string; autoResize?: boolean } = {},
+	): boolean {
+		return ffi.request.setWebviewPoolSize({
+			partition: options.partition ?? "persist:default",
+			autoResize: options.autoResize !== false,
+			size: Math.min(MAX_WEBVIEW_POOL_SIZE, Math.max(0, Math.floor(size))),
+		});
+	}
+
+	/** Pool counters across all partitions, or null where unsupported. */
+	static getPoolStats() {
+		return ffi.request.getWebviewPoolStats();
+	}
+
+	/**
+	 * Memory and CPU of each webview's renderer, followed by this process
+	 * and the other engine processes it started (GPU, network, zygote...).
+	 * Sampled from /proc off the main thread, so it is cheap enough to poll.
+	 * Null where unsupported (non-Linux).
+	 */
+	static getProcessStats() {
+		return ffi.request.getWebviewProcessStats();
+	}
+
+	/**
+	 * Winds down hidden webviews, such as <electrobun-webview> tags toggled
+	 * hidden, once they have stayed hidden for the given times: throttled,
+	 * then frozen, then discarded. A discarded webview keeps its URL and
+	 * reloads it when shown again. Applies to every webview; omit every time
+	 * to turn it off. Returns false where unsupported (non-Linux).
+	 */
+	static setLifecyclePolicy(policy: WebviewLifecyclePolicy): boolean {
+		return ffi.request.setWebviewLifecyclePolicy(policy);
+	}
+
+	/** Lifecycle counters across all webviews, or null where unsupported. */
+	static getLifecycleStats() {
+		return ffi.request.getWebviewLifecycleStats();
+	}
+
 	/**
 	 * Listen for BrowserViews created by <electrobun-webview> tags.
 	 * The handler runs before the tag's initialization request resolves.
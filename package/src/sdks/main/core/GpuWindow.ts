@@ -20,6 +20,8 @@ export type GpuWindowOptionsType = {
 	styleMask?: {};
 	titleBarStyle: "hidden" | "hiddenInset" | "default";
 	transparent: boolean;
+	// See WGPUViewOptions.renderThread.
+	renderThread?: boolean;
 };
 
 const defaultOptions: GpuWindowOptionsType = {
@@ -99,7 +101,13 @@ export class GpuWindow {
 	}
 
 	init(
-		{ styleMask, titleBarStyle, transparent, activate }: Partial<GpuWindowOptionsType>,
+		{
+			styleMask,
+			titleBarStyle,
+			transparent,
+			activate,
+			renderThread,
+		}: Partial<GpuWindowOptionsType>,
 		centered: boolean,
 	) {
 		const windowId = ffi.request.createWindow({
@@ -169,6 +177,7 @@ export class GpuWindow {
 			autoResize: true,
 			startTransparent: false,
 			startPassthrough: false,
+			renderThread: renderThread ?? false,
 		});
 
 		// A transparent window needs its full-window view to alpha-composite
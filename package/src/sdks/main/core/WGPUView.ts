@@ -19,6 +19,13 @@ export type WGPUViewOptions = {
 	windowId: number;
 	startTransparent: boolean;
 	startPassthrough: boolean;
+	/**
+	 * Linux: configure, acquire and present this view's WebGPU surface on a
+	 * dedicated render thread with its own X connection instead of the UI
+	 * thread, so a busy UI no longer lowers the frame rate. Falls back to the
+	 * UI thread when the render thread cannot be started.
+	 */
+	renderThread: boolean;
 };
 
 const defaultOptions: Partial<WGPUViewOptions> = {
@@ -31,6 +38,7 @@ const defaultOptions: Partial<WGPUViewOptions> = {
 	autoResize: true,
 	startTransparent: false,
 	startPassthrough: false,
+	renderThread: false,
 };
 
 export class WGPUView {
@@ -50,6 +58,7 @@ export class WGPUView {
 	};
 	startTransparent: boolean = false;
 	startPassthrough: boolean = false;
+	renderThread: boolean = false;
 	isRemoved: boolean = false;
 	private beforeRemoveHooks = new BeforeRemoveHooks();
 
@@ -71,9 +80,13 @@ export class WGPUView {
 		this.autoResize = options.autoResize === false ? false : true;
 		this.startTransparent = options.startTransparent ?? false;
 		this.startPassthrough = options.startPassthrough ?? false;
+		this.renderThread = options.renderThread ?? false;
 
 		this.id = this.init() as number;
 		WGPUViewMap[this.id] = this;
+		if (this.renderThread) {
+			ffi.request.wgpuViewSetRenderThread({ id: this.id, enabled: true });
+		}
 	}
 
 	init() {
@@ -117,6 +130,35 @@ export class WGPUView {
 		ffi.request.wgpuViewSetHidden({ id: this.id, hidden });
 	}
 
+	/**
+	 * Surface timings for this view's WebGPU context, or null before a
+	 * context exists or on platforms without per-view statistics.
+	 */
+	getFrameStats() {
+		return ffi.request.wgpuViewGetFrameStats({ id: this.id });
+	}
+
+	/**
+	 * Acquire and present times of the most recent frames (up to 64),
+	 * oldest first. Empty where per-view statistics are unavailable.
+	 */
+	getFrameTimeline() {
+		return ffi.request.wgpuViewGetFrameTimeline({ id: this.id });
+	}
+
+	/**
+	 * Run `callback` when the next frame should start so that its present
+	 * lands just ahead of a display refresh, based on this view's recent
+	 * present times. Falls back to a 16 ms timer where pacing is unavailable.
+	 * Returns a function that cancels the request.
+	 */
+	requestFrame(callback: () => void): () => void {
+		const delayUs = ffi.request.wgpuViewGetFramePacingDelay({ id: this.id });
+		const delayMs = delayUs === null ? 16 : Math.round(delayUs / 1000);
+		const timer = setTimeout(callback, delayMs);
+		return () => clearTimeout(timer);
+	}
+
 	on(name: "frame-updated", handler: (event: unknown) => void) {
 		const specificName = `${name}-${this.id}`;
 		electrobunEventEmitter.on(specificName, handler);
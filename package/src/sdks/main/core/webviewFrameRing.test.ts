@@ -0,0 +1,64 @@
+import { describe, expect, test } from "bun:test";
+import {
+	readLatestWebviewFrame,
+	webviewFrameRingByteLength,
+	webviewFrameRingDroppedFrames,
+} from "./webviewFrameRing";
+
+// Mirrors what WebviewFrameRingWriter lays out for one 2x1 frame.
+function ringWithFrame(slots: number, sequence: number) {
+	const slotStride = 320 + 64;
+	const ring = new Uint8Array(webviewFrameRingByteLength(slots, 2, 1));
+	const view = new DataView(ring.buffer);
+	view.setUint32(0, 0x52464245, true);
+	view.setUint32(4, 1, true);
+	view.setUint32(8, slots, true);
+	view.setUint32(12, slotStride, true);
+	view.setUint32(16, 64, true);
+	view.setUint32(20, 3, true);
+	view.setBigUint64(24, BigInt(sequence), true);
+	const slot = 64 + ((sequence - 1) % slots) * slotStride;
+	view.setBigUint64(slot, BigInt(sequence), true);
+	view.setBigUint64(slot + 8, 1234n, true);
+	view.setUint32(slot + 16, 2, true);
+	view.setUint32(slot + 20, 1, true);
+	view.setUint32(slot + 24, 8, true);
+	view.setUint32(slot + 28, 1, true);
+	view.setInt32(slot + 64, 1, true);
+	view.setInt32(slot + 68, 0, true);
+	view.setInt32(slot + 72, 1, true);
+	view.setInt32(slot + 76, 1, true);
+	ring.set([1, 2, 3, 4, 5, 6, 7, 8], slot + 320);
+	return { ring, slot, view };
+}
+
+describe("readLatestWebviewFrame", () => {
+	test("reads the newest slot", () => {
+		const { ring } = ringWithFrame(3, 5);
+		const frame = readLatestWebviewFrame(ring);
+		expect(frame).not.toBeNull();
+		expect(frame!.sequence).toBe(5);
+		expect(frame!.timestampUs).toBe(1234);
+		expect(frame!.width).toBe(2);
+		expect(frame!.stride).toBe(8);
+		expect(frame!.dirtyRects).toEqual([{ x: 1, y: 0, width: 1, height: 1 }]);
+		expect([...frame!.pixels]).toEqual([1, 2, 3, 4, 5, 6, 7, 8]);
+		expect(webviewFrameRingDroppedFrames(ring)).toBe(3);
+	});
+
+	test("reuses a target and skips frames already seen", () => {
+		const { ring } = ringWithFrame(2, 2);
+		const target = new Uint8Array(16);
+		const frame = readLatestWebviewFrame(ring, { target });
+		expect(frame!.pixels.buffer).toBe(target.buffer);
+		expect(readLatestWebviewFrame(ring, { after: 2 })).toBeNull();
+		expect(readLatestWebviewFrame(ring, { target: new Uint8Array(4) })).toBeNull();
+	});
+
+	test("rejects empty rings and slots being rewritten", () => {
+		expect(readLatestWebviewFrame(new Uint8Array(128))).toBeNull();
+		const { ring, slot, view } = ringWithFrame(2, 1);
+		view.setBigUint64(slot, 0n, true);
+		expect(readLatestWebviewFrame(ring)).toBeNull();
+	});
+});
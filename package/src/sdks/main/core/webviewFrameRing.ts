@@ -0,0 +1,111 @@
+// Reader for the frame ring written by native webview frame streams. The
+// layout is documented in src/native/shared/webview_frame_ring.h.
+
+const MAGIC = 0x52464245; // "EBFR"
+const HEADER_SIZE = 64;
+const SLOT_HEADER_SIZE = 320;
+const SLOT_DIRTY_OFFSET = 64;
+const MAX_DIRTY_RECTS = 16;
+
+export type WebviewFrameRect = {
+	x: number;
+	y: number;
+	width: number;
+	height: number;
+};
+
+export type WebviewFrame = {
+	sequence: number;
+	/** Monotonic capture time in microseconds. */
+	timestampUs: number;
+	width: number;
+	height: number;
+	/** Bytes per row in `pixels`; always width * 4. */
+	stride: number;
+	/** Regions changed since the previous published frame. */
+	dirtyRects: WebviewFrameRect[];
+	/** Premultiplied BGRA rows. */
+	pixels: Uint8Array;
+};
+
+/**
+ * Bytes needed for a ring of `slots` frames of up to width x height pixels.
+ */
+export function webviewFrameRingByteLength(
+	slots: number,
+	width: number,
+	height: number,
+): number {
+	const pixels = Math.ceil((Math.max(1, width) * Math.max(1, height) * 4) / 64) * 64;
+	return HEADER_SIZE + Math.max(1, Math.floor(slots)) * (SLOT_HEADER_SIZE + pixels);
+}
+
+/** Total frames the native writer skipped for rate limiting or size. */
+export function webviewFrameRingDroppedFrames(ring: Uint8Array): number {
+	const view = new DataView(ring.buffer, ring.byteOffset, ring.byteLength);
+	return ring.byteLength >= HEADER_SIZE ? view.getUint32(20, true) : 0;
+}
+
+/**
+ * Copies the newest frame out of the ring, optionally into `target` to avoid
+ * allocating. Returns null when there is no frame newer than `after`, the
+ * target is too small, or the writer replaced the frame mid-copy; callers
+ * simply try again on the next notification.
+ */
+export function readLatestWebviewFrame(
+	ring: Uint8Array,
+	options: { after?: number; target?: Uint8Array } = {},
+): WebviewFrame | null {
+	if (ring.byteLength < HEADER_SIZE) return null;
+	const view = new DataView(ring.buffer, ring.byteOffset, ring.byteLength);
+	if (view.getUint32(0, true) !== MAGIC) return null;
+	const slotCount = view.getUint32(8, true);
+	const slotStride = view.getUint32(12, true);
+	const sequence = Number(view.getBigUint64(24, true));
+	if (
+		sequence === 0 ||
+		sequence <= (options.after ?? 0) ||
+		slotCount === 0 ||
+		HEADER_SIZE + slotCount * slotStride > ring.byteLength
+	) {
+		return null;
+	}
+
+	const slot = HEADER_SIZE + ((sequence - 1) % slotCount) * slotStride;
+	if (Number(view.getBigUint64(slot, true)) !== sequence) return null;
+	const timestampUs = Number(view.getBigUint64(slot + 8, true));
+	const width = view.getUint32(slot + 16, true);
+	const height = view.getUint32(slot + 20, true);
+	const stride = view.getUint32(slot + 24, true);
+	const dirtyCount = view.getUint32(slot + 28, true);
+	const frameBytes = stride * height;
+	if (
+		dirtyCount > MAX_DIRTY_RECTS ||
+		frameBytes > slotStride - SLOT_HEADER_SIZE ||
+		(options.target && options.target.byteLength < frameBytes)
+	) {
+		return null;
+	}
+
+	const dirtyRects: WebviewFrameRect[] = [];
+	for (let i = 0; i < dirtyCount; i++) {
+		const at = slot + SLOT_DIRTY_OFFSET + i * 16;
+		dirtyRects.push({
+			x: view.getInt32(at, true),
+			y: view.getInt32(at + 4, true),
+			width: view.getInt32(at + 8, true),
+			height: view.getInt32(at + 12, true),
+		});
+	}
+	const source = ring.subarray(
+		slot + SLOT_HEADER_SIZE,
+		slot + SLOT_HEADER_SIZE + frameBytes,
+	);
+	const pixels = options.target
+		? options.target.subarray(0, frameBytes)
+		: new Uint8Array(frameBytes);
+	pixels.set(source);
+
+	if (Number(view.getBigUint64(slot, true)) !== sequence) return null;
+	return { sequence, timestampUs, width, height, stride, dirtyRects, pixels };
+}
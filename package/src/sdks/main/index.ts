@@ -40,9 +40,18 @@ import { GlobalShortcut, Screen, Session, WGPUBridge } from "./proc/native";
 import type {
 	Display,
 	Rectangle,
+	CaptureSize,
 	Point,
+	WGPUViewFrameStats,
+	WGPUViewFrameTiming,
+	WebviewPoolStats,
+	WebviewProcessStats,
+	WebviewLifecyclePolicy,
+	WebviewLifecycleState,
+	WebviewLifecycleStats,
 	Cookie,
 	CookieFilter,
+	CookieImportResult,
 	StorageType,
 	MenuItemConfig,
 	ApplicationMenuItemConfig,
@@ -240,9 +249,18 @@ export {
 	type ApplicationMenuItemConfig,
 	type Display,
 	type Rectangle,
+	type CaptureSize,
 	type Point,
+	type WGPUViewFrameStats,
+	type WGPUViewFrameTiming,
+	type WebviewPoolStats,
+	type WebviewProcessStats,
+	type WebviewLifecyclePolicy,
+	type WebviewLifecycleState,
+	type WebviewLifecycleStats,
 	type Cookie,
 	type CookieFilter,
+	type CookieImportResult,
 	type StorageType,
 	type UpdateStatusType,
 	type UpdateStatusEntry,
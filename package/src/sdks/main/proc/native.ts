@@ -368,6 +368,18 @@ const core = (() => {
 				],
 				returns: FFIType.void,
 			},
+			resizeWebviewWithMaskRects: {
+				args: [
+					FFIType.u32,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.ptr,
+					FFIType.u32,
+				],
+				returns: FFIType.bool,
+			},
 			loadURLInWebView: {
 				args: [FFIType.u32, FFIType.cstring],
 				returns: FFIType.void,
@@ -424,6 +436,51 @@ const core = (() => {
 				args: [FFIType.u32, FFIType.bool],
 				returns: FFIType.bool,
 			},
+			webviewSetWindowlessFrameRate: {
+				args: [FFIType.u32, FFIType.i32],
+				returns: FFIType.bool,
+			},
+			webviewSetBackgroundThrottled: {
+				args: [FFIType.u32, FFIType.bool],
+				returns: FFIType.bool,
+			},
+			getWebviewSnapshotWithOptions: {
+				args: [
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.ptr,
+					FFIType.u64,
+					FFIType.function,
+				],
+				returns: FFIType.bool,
+			},
+			takeWebviewSnapshotDataUrl: {
+				args: [FFIType.u32, FFIType.ptr, FFIType.u64],
+				returns: FFIType.bool,
+			},
+			webviewStartFrameStream: {
+				args: [
+					FFIType.u32,
+					FFIType.ptr,
+					FFIType.u64,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.function,
+				],
+				returns: FFIType.bool,
+			},
+			webviewStopFrameStream: {
+				args: [FFIType.u32],
+				returns: FFIType.void,
+			},
 			setWebviewNavigationRules: {
 				args: [FFIType.u32, FFIType.cstring],
 				returns: FFIType.void,
@@ -648,6 +705,23 @@ const core = (() => {
 				],
 				returns: FFIType.bool,
 			},
+			captureScreenRegionScaled: {
+				args: [
+					FFIType.f64,
+					FFIType.f64,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.u32,
+					FFIType.ptr,
+					FFIType.u64,
+				],
+				returns: FFIType.bool,
+			},
+			getScreenRegionChangeSequence: {
+				args: [FFIType.f64, FFIType.f64, FFIType.u32, FFIType.u32],
+				returns: FFIType.u64,
+			},
 			getMouseButtons: {
 				args: [],
 				returns: FFIType.u64,
@@ -861,6 +935,155 @@ export const native = (() => {
 					},
 				}
 				: {}),
+			// The pooled WGPU readback ring is implemented by the Linux wrapper.
+			...(process.platform === "linux"
+				? {
+					wgpuReadbackPoolCreate: {
+						args: [FFIType.ptr, FFIType.ptr, FFIType.u32, FFIType.u64],
+						returns: FFIType.ptr,
+					},
+					wgpuReadbackPoolSubmit: {
+						args: [FFIType.ptr, FFIType.ptr, FFIType.u64, FFIType.u64],
+						returns: FFIType.u64,
+					},
+					wgpuReadbackPoolStatus: {
+						args: [FFIType.ptr, FFIType.u64],
+						returns: FFIType.i32,
+					},
+					wgpuReadbackPoolData: {
+						args: [FFIType.ptr, FFIType.u64, FFIType.ptr],
+						returns: FFIType.ptr,
+					},
+					wgpuReadbackPoolRelease: {
+						args: [FFIType.ptr, FFIType.u64],
+						returns: FFIType.bool,
+					},
+					wgpuReadbackPoolGetStats: {
+						args: [FFIType.ptr, FFIType.ptr],
+						returns: FFIType.void,
+					},
+					wgpuReadbackPoolDestroy: {
+						args: [FFIType.ptr],
+						returns: FFIType.void,
+					},
+					wgpuReadbackPoolEnableNotify: {
+						args: [FFIType.ptr, FFIType.ptr],
+						returns: FFIType.i32,
+					},
+					wgpuReadbackPoolPopCompleted: {
+						args: [FFIType.ptr, FFIType.ptr],
+						returns: FFIType.u64,
+					},
+					wgpuViewSetRenderThread: {
+						args: [FFIType.ptr, FFIType.bool],
+						returns: FFIType.void,
+					},
+					wgpuViewGetFrameStats: {
+						args: [FFIType.ptr, FFIType.ptr],
+						returns: FFIType.bool,
+					},
+					wgpuViewGetFrameTimeline: {
+						args: [FFIType.ptr, FFIType.ptr, FFIType.u32],
+						returns: FFIType.u32,
+					},
+					wgpuViewGetFramePacingDelay: {
+						args: [FFIType.ptr],
+						returns: FFIType.u64,
+					},
+					sessionGetCookiesAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionSetCookieAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionRemoveCookieAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionClearCookiesAsync: {
+						args: [FFIType.cstring, FFIType.u32, FFIType.function],
+						returns: FFIType.bool,
+					},
+					sessionClearStorageDataAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionImportCookiesAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.ptr,
+							FFIType.u64,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionExportCookiesAsync: {
+						args: [
+							FFIType.cstring,
+							FFIType.cstring,
+							FFIType.u32,
+							FFIType.function,
+						],
+						returns: FFIType.bool,
+					},
+					sessionPrewarmPartitionAsync: {
+						args: [FFIType.cstring, FFIType.u32, FFIType.function],
+						returns: FFIType.bool,
+					},
+					sessionTakeResult: {
+						args: [FFIType.u32, FFIType.ptr, FFIType.u64],
+						returns: FFIType.bool,
+					},
+					setWebviewPoolSize: {
+						args: [FFIType.cstring, FFIType.bool, FFIType.u32],
+						returns: FFIType.bool,
+					},
+					getWebviewPoolStats: {
+						args: [FFIType.ptr],
+						returns: FFIType.void,
+					},
+					getWebviewProcessStats: {
+						args: [FFIType.ptr, FFIType.u32],
+						returns: FFIType.u32,
+					},
+					setWebviewLifecyclePolicy: {
+						args: [FFIType.u32, FFIType.u32, FFIType.u32],
+						returns: FFIType.void,
+					},
+					getWebviewLifecycleStats: {
+						args: [FFIType.ptr],
+						returns: FFIType.void,
+					},
+					getWebviewLifecycleState: {
+						args: [FFIType.u32],
+						returns: FFIType.u32,
+					},
+				}
+				: {}),
 
 			loadURLInWebView: {
 				args: [FFIType.ptr, FFIType.cstring],
@@ -1301,6 +1524,110 @@ type WindowsNativeWrapperSymbols = {
 	setWindowTextHandler: (handler: Pointer | null) => void;
 };
 
+type LinuxNativeWrapperSymbols = {
+	wgpuReadbackPoolCreate: (
+		device: Pointer,
+		queue: Pointer,
+		slotCount: number,
+		slotSize: bigint,
+	) => Pointer | null;
+	wgpuReadbackPoolSubmit: (
+		pool: Pointer,
+		buffer: Pointer,
+		offset: bigint,
+		size: bigint,
+	) => bigint;
+	wgpuReadbackPoolStatus: (pool: Pointer, id: bigint) => number;
+	wgpuReadbackPoolData: (
+		pool: Pointer,
+		id: bigint,
+		outSize: Pointer,
+	) => Pointer | null;
+	wgpuReadbackPoolRelease: (pool: Pointer, id: bigint) => boolean;
+	wgpuReadbackPoolGetStats: (pool: Pointer, outStats: Pointer) => void;
+	wgpuReadbackPoolDestroy: (pool: Pointer) => void;
+	wgpuReadbackPoolEnableNotify: (pool: Pointer, instance: Pointer) => number;
+	wgpuReadbackPoolPopCompleted: (pool: Pointer, outStatus: Pointer) => bigint;
+	wgpuViewSetRenderThread: (view: Pointer, enabled: boolean) => void;
+	wgpuViewGetFrameStats: (view: Pointer, outStats: Pointer) => boolean;
+	wgpuViewGetFrameTimeline: (
+		view: Pointer,
+		outTimings: Pointer,
+		maxFrames: number,
+	) => number;
+	wgpuViewGetFramePacingDelay: (view: Pointer) => bigint;
+	sessionGetCookiesAsync: (
+		partition: CString,
+		filterJson: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionSetCookieAsync: (
+		partition: CString,
+		cookieJson: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionRemoveCookieAsync: (
+		partition: CString,
+		url: CString,
+		name: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionClearCookiesAsync: (
+		partition: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionClearStorageDataAsync: (
+		partition: CString,
+		storageTypesJson: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionImportCookiesAsync: (
+		partition: CString,
+		jar: Pointer,
+		jarLength: bigint,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionExportCookiesAsync: (
+		partition: CString,
+		filterJson: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionPrewarmPartitionAsync: (
+		partition: CString,
+		requestId: number,
+		callback: JSCallback,
+	) => boolean;
+	sessionTakeResult: (
+		requestId: number,
+		out: Pointer,
+		outLength: bigint,
+	) => boolean;
+	setWebviewPoolSize: (
+		partition: CString,
+		autoResize: boolean,
+		size: number,
+	) => boolean;
+	getWebviewPoolStats: (outStats: Pointer) => void;
+	getWebviewProcessStats: (
+		outRecords: Pointer | null,
+		maxRecords: number,
+	) => number;
+	setWebviewLifecyclePolicy: (
+		throttleAfterMs: number,
+		freezeAfterMs: number,
+		discardAfterMs: number,
+	) => void;
+	getWebviewLifecycleStats: (outStats: Pointer) => void;
+	getWebviewLifecycleState: (webviewId: number) => number;
+};
+
 // Conditional descriptor spreads become optional zero-argument functions in
 // Bun's mapped FFI types. Restore the callable shape while keeping absence
 // explicit on platforms that do not register these symbols.
@@ -1312,6 +1639,10 @@ function getWindowsNativeWrapperSymbols(): Partial<WindowsNativeWrapperSymbols>
 	return native_.symbols as unknown as Partial<WindowsNativeWrapperSymbols>;
 }
 
+function getLinuxNativeWrapperSymbols(): Partial<LinuxNativeWrapperSymbols> {
+	return native_.symbols as unknown as Partial<LinuxNativeWrapperSymbols>;
+}
+
 core?.symbols.setRuntimeCallbacksAsync(true);
 const queuedHostMessageWebviewIdBuf = new Uint32Array(1);
 
@@ -1978,6 +2309,25 @@ const _ffiImpl = {
 			const { id, frame: { x, y, width, height }, masks = "[]" } = params;
 			core_.symbols.resizeWebview(id, x, y, width, height, toCString(masks));
 		},
+		// Masks as packed x, y, width, height floats. Returns false where the
+		// platform only accepts mask JSON (use resizeWebview there).
+		resizeWebviewWithMaskRects: (params: {
+			id: number;
+			frame: { x: number; y: number; width: number; height: number };
+			rects: Float32Array;
+		}) => {
+			const { id, frame: { x, y, width, height }, rects } = params;
+			const count = Math.floor(rects.length / 4);
+			return core_.symbols.resizeWebviewWithMaskRects(
+				id,
+				x,
+				y,
+				width,
+				height,
+				count > 0 ? ptr(rects) : null,
+				count,
+			);
+		},
 		loadURLInWebView: (params: { id: number; url: string }) => {
 			core_.symbols.loadURLInWebView(params.id, toCString(params.url));
 		},
@@ -2030,6 +2380,107 @@ const _ffiImpl = {
 		webviewSetSpellCheck: (params: { id: number; enabled: boolean }) => {
 			return core_.symbols.webviewSetSpellCheck(params.id, params.enabled);
 		},
+		webviewSetWindowlessFrameRate: (params: { id: number; frameRate: number }) => {
+			return core_.symbols.webviewSetWindowlessFrameRate(
+				params.id,
+				params.frameRate,
+			);
+		},
+		webviewSetBackgroundThrottled: (params: { id: number; throttled: boolean }) => {
+			return core_.symbols.webviewSetBackgroundThrottled(
+				params.id,
+				params.throttled,
+			);
+		},
+		// Resolves null when capture fails or the platform has no snapshot
+		// support. "rgba" needs either a caller buffer or both max bounds,
+		// which cap the output at maxWidth * maxHeight pixels.
+		getWebviewSnapshot: (params: {
+			id: number;
+			region?: { x: number; y: number; width: number; height: number };
+			maxWidth?: number;
+			maxHeight?: number;
+			format?: WebviewSnapshotFormat;
+			quality?: number;
+			buffer?: Uint8Array;
+		}): Promise<WebviewSnapshot | null> => {
+			const {
+				id,
+				region = { x: 0, y: 0, width: 0, height: 0 },
+				maxWidth = 0,
+				maxHeight = 0,
+				format = "png",
+				quality = 90,
+			} = params;
+			const formatCode = webviewSnapshotFormats[format];
+			if (formatCode === undefined) return Promise.resolve(null);
+
+			let pixels: Uint8Array | null = null;
+			if (format === "rgba") {
+				pixels =
+					params.buffer ??
+					(maxWidth >= 1 && maxHeight >= 1
+						? new Uint8Array(Math.floor(maxWidth) * Math.floor(maxHeight) * 4)
+						: null);
+				if (!pixels || pixels.byteLength === 0) return Promise.resolve(null);
+			}
+
+			const requestId = nextWebviewSnapshotRequestId;
+			nextWebviewSnapshotRequestId =
+				nextWebviewSnapshotRequestId >= 0xffffffff ? 1 : nextWebviewSnapshotRequestId + 1;
+
+			return new Promise((resolve) => {
+				// The pending entry keeps `pixels` reachable until native code is
+				// done writing into it.
+				pendingWebviewSnapshots.set(requestId, { pixels, resolve });
+				const started = core_.symbols.getWebviewSnapshotWithOptions(
+					id,
+					requestId,
+					region.x,
+					region.y,
+					region.width,
+					region.height,
+					Math.max(0, Math.floor(maxWidth)),
+					Math.max(0, Math.floor(maxHeight)),
+					formatCode,
+					Math.min(100, Math.max(1, Math.round(quality))),
+					pixels ? ptr(pixels) : null,
+					BigInt(pixels ? pixels.byteLength : 0),
+					webviewSnapshotCallback,
+				);
+				if (!started) {
+					pendingWebviewSnapshots.delete(requestId);
+					resolve(null);
+				}
+			});
+		},
+		// The ring must stay referenced until webviewStopFrameStream returns;
+		// onFrame runs on the JS thread after each published frame.
+		webviewStartFrameStream: (params: {
+			id: number;
+			ring: Uint8Array;
+			slots: number;
+			maxFps: number;
+			onFrame?: (sequence: number) => void;
+		}) => {
+			const { id, ring, slots, maxFps, onFrame } = params;
+			webviewFrameStreamListeners.delete(id);
+			if (onFrame) webviewFrameStreamListeners.set(id, onFrame);
+			const started = core_.symbols.webviewStartFrameStream(
+				id,
+				ptr(ring),
+				BigInt(ring.byteLength),
+				Math.max(1, Math.floor(slots)),
+				Math.max(0, Math.floor(maxFps)),
+				onFrame ? webviewFrameStreamCallback : null,
+			);
+			if (!started) webviewFrameStreamListeners.delete(id);
+			return started;
+		},
+		webviewStopFrameStream: (params: { id: number }) => {
+			core_.symbols.webviewStopFrameStream(params.id);
+			webviewFrameStreamListeners.delete(params.id);
+		},
 		setWebviewNavigationRules: (params: { id: number; rulesJson: string }) => {
 			core_.symbols.setWebviewNavigationRules(params.id, toCString(params.rulesJson));
 		},
@@ -2151,6 +2602,184 @@ const _ffiImpl = {
 		wgpuViewRemove: (params: { id: number }) => {
 			core_.symbols.removeWGPUView(params.id);
 		},
+		wgpuViewSetRenderThread: (params: { id: number; enabled: boolean }) => {
+			const setRenderThread =
+				getLinuxNativeWrapperSymbols().wgpuViewSetRenderThread;
+			if (typeof setRenderThread !== "function") return;
+			const viewPointer = normalizeFFIPointer(
+				core_.symbols.getWGPUViewPointer(params.id),
+			);
+			if (!viewPointer) return;
+			setRenderThread(viewPointer, params.enabled);
+		},
+		wgpuViewGetFrameStats: (params: { id: number }): WGPUViewFrameStats | null => {
+			const getFrameStats = getLinuxNativeWrapperSymbols().wgpuViewGetFrameStats;
+			if (typeof getFrameStats !== "function") return null;
+			const viewPointer = normalizeFFIPointer(
+				core_.symbols.getWGPUViewPointer(params.id),
+			);
+			if (!viewPointer) return null;
+			const out = new ArrayBuffer(88);
+			if (!getFrameStats(viewPointer, ptr(out))) return null;
+			const view = new DataView(out);
+			const intervalHistogram: number[] = [];
+			for (let index = 0; index < 5; index++) {
+				intervalHistogram.push(view.getUint32(56 + index * 4, true));
+			}
+			return {
+				frames: Number(view.getBigUint64(0, true)),
+				failedPresents: Number(view.getBigUint64(8, true)),
+				lastFrameUs: view.getUint32(16, true),
+				avgFrameUs: view.getUint32(20, true),
+				maxFrameUs: view.getUint32(24, true),
+				lastAcquireUs: view.getUint32(28, true),
+				avgAcquireUs: view.getUint32(32, true),
+				lastPresentUs: view.getUint32(36, true),
+				avgPresentUs: view.getUint32(40, true),
+				renderThread: view.getUint32(44, true) !== 0,
+				refreshPeriodUs: view.getUint32(48, true),
+				droppedFrames: view.getUint32(52, true),
+				intervalHistogram,
+				avgWorkUs: view.getUint32(76, true),
+				blockedPresents: view.getUint32(80, true),
+			};
+		},
+		wgpuViewGetFrameTimeline: (params: {
+			id: number;
+		}): WGPUViewFrameTiming[] => {
+			const getFrameTimeline =
+				getLinuxNativeWrapperSymbols().wgpuViewGetFrameTimeline;
+			if (typeof getFrameTimeline !== "function") return [];
+			const viewPointer = normalizeFFIPointer(
+				core_.symbols.getWGPUViewPointer(params.id),
+			);
+			if (!viewPointer) return [];
+			// Matches WgpuFrameStatsRecorder::kTimelineFrames.
+			const maxFrames = 64;
+			const out = new ArrayBuffer(maxFrames * 32);
+			const count = getFrameTimeline(viewPointer, ptr(out), maxFrames);
+			const view = new DataView(out);
+			const timeline: WGPUViewFrameTiming[] = [];
+			for (let index = 0; index < count; index++) {
+				const offset = index * 32;
+				timeline.push({
+					acquireStartUs: Number(view.getBigUint64(offset, true)),
+					acquireEndUs: Number(view.getBigUint64(offset + 8, true)),
+					presentStartUs: Number(view.getBigUint64(offset + 16, true)),
+					presentEndUs: Number(view.getBigUint64(offset + 24, true)),
+				});
+			}
+			return timeline;
+		},
+		wgpuViewGetFramePacingDelay: (params: { id: number }): number | null => {
+			const getFramePacingDelay =
+				getLinuxNativeWrapperSymbols().wgpuViewGetFramePacingDelay;
+			if (typeof getFramePacingDelay !== "function") return null;
+			const viewPointer = normalizeFFIPointer(
+				core_.symbols.getWGPUViewPointer(params.id),
+			);
+			if (!viewPointer) return null;
+			return Number(getFramePacingDelay(viewPointer));
+		},
+		setWebviewPoolSize: (params: {
+			partition: string;
+			autoResize: boolean;
+			size: number;
+		}): boolean => {
+			return (
+				getLinuxNativeWrapperSymbols().setWebviewPoolSize?.(
+					toCString(params.partition),
+					params.autoResize,
+					params.size,
+				) ?? false
+			);
+		},
+		getWebviewPoolStats: (): WebviewPoolStats | null => {
+			const getPoolStats = getLinuxNativeWrapperSymbols().getWebviewPoolStats;
+			if (typeof getPoolStats !== "function") return null;
+			// Matches electrobun::WebviewPoolStats.
+			const out = new BigUint64Array(6);
+			getPoolStats(ptr(out));
+			return {
+				hits: Number(out[0]),
+				misses: Number(out[1]),
+				precreated: Number(out[2]),
+				recycled: Number(out[3]),
+				discarded: Number(out[4]),
+				idle: Number(out[5]),
+			};
+		},
+		getWebviewProcessStats: (): WebviewProcessStats[] | null => {
+			const getProcessStats =
+				getLinuxNativeWrapperSymbols().getWebviewProcessStats;
+			if (typeof getProcessStats !== "function") return null;
+			// Matches electrobun::LinuxProcessStats. Each call walks /proc,
+			// so start from the size that last fit and sample again only
+			// when more processes turned up than it holds.
+			const recordSize = 48;
+			let capacity = webviewProcessStatsCapacity;
+			let buffer = new Uint8Array(recordSize * capacity);
+			let count = getProcessStats(ptr(buffer), capacity);
+			while (count > capacity) {
+				capacity = count + 8;
+				buffer = new Uint8Array(recordSize * capacity);
+				count = getProcessStats(ptr(buffer), capacity);
+			}
+			webviewProcessStatsCapacity = capacity;
+			const view = new DataView(buffer.buffer);
+			const stats: WebviewProcessStats[] = [];
+			for (let index = 0; index < count; index += 1) {
+				const offset = index * recordSize;
+				const webviewId = view.getUint32(offset, true);
+				stats.push({
+					webviewId: webviewId || null,
+					pid: view.getInt32(offset + 4, true) || null,
+					kind:
+						webviewProcessKinds[view.getUint32(offset + 36, true)] ?? "other",
+					rssBytes: Number(view.getBigUint64(offset + 8, true)),
+					pssBytes: Number(view.getBigUint64(offset + 16, true)),
+					cpuTimeUs: Number(view.getBigUint64(offset + 24, true)),
+					threads: view.getUint32(offset + 32, true),
+				});
+			}
+			return stats;
+		},
+		setWebviewLifecyclePolicy: (policy: WebviewLifecyclePolicy): boolean => {
+			const setPolicy = getLinuxNativeWrapperSymbols().setWebviewLifecyclePolicy;
+			if (typeof setPolicy !== "function") return false;
+			const toMs = (value: number | undefined) =>
+				Math.min(0xffffffff, Math.max(0, Math.floor(value ?? 0)));
+			setPolicy(
+				toMs(policy.throttleAfterMs),
+				toMs(policy.freezeAfterMs),
+				toMs(policy.discardAfterMs),
+			);
+			return true;
+		},
+		getWebviewLifecycleStats: (): WebviewLifecycleStats | null => {
+			const getStats = getLinuxNativeWrapperSymbols().getWebviewLifecycleStats;
+			if (typeof getStats !== "function") return null;
+			// Matches electrobun::WebviewLifecycleStats.
+			const out = new BigUint64Array(8);
+			getStats(ptr(out));
+			return {
+				throttled: Number(out[0]),
+				frozen: Number(out[1]),
+				discarded: Number(out[2]),
+				restored: Number(out[3]),
+				bytesReclaimed: Number(out[4]),
+				lastRestoreUs: Number(out[5]),
+				maxRestoreUs: Number(out[6]),
+				totalRestoreUs: Number(out[7]),
+			};
+		},
+		getWebviewLifecycleState: (params: {
+			id: number;
+		}): WebviewLifecycleState | null => {
+			const getState = getLinuxNativeWrapperSymbols().getWebviewLifecycleState;
+			if (typeof getState !== "function") return null;
+			return webviewLifecycleStates[getState(params.id)] ?? "active";
+		},
 		wgpuViewGetNativeHandle: (params: { id: number }): Pointer | null => {
 			return normalizeFFIPointer(
 				core_.symbols.getWGPUViewNativeHandle(params.id),
@@ -2550,6 +3179,64 @@ export const WGPUBridge = {
 		native_.symbols.wgpuBufferReadbackStatusShim(jobPtr as any),
 	bufferReadbackFree: (jobPtr: Pointer) =>
 		native_.symbols.wgpuBufferReadbackFreeShim(jobPtr as any),
+	// Pooled readbacks (Linux only). Each returns null/0/false where the
+	// wrapper does not provide the pool.
+	readbackPoolCreate: (
+		devicePtr: Pointer,
+		queuePtr: Pointer,
+		slotCount: number,
+		slotSize: bigint,
+	): Pointer | null =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolCreate?.(
+			devicePtr,
+			queuePtr,
+			slotCount,
+			slotSize,
+		) ?? null,
+	readbackPoolSubmit: (
+		poolPtr: Pointer,
+		bufferPtr: Pointer,
+		offset: bigint,
+		size: bigint,
+	): bigint =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolSubmit?.(
+			poolPtr,
+			bufferPtr,
+			offset,
+			size,
+		) ?? 0n,
+	readbackPoolStatus: (poolPtr: Pointer, id: bigint): number =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolStatus?.(poolPtr, id) ?? 4,
+	readbackPoolData: (
+		poolPtr: Pointer,
+		id: bigint,
+		outSizePtr: Pointer,
+	): Pointer | null =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolData?.(
+			poolPtr,
+			id,
+			outSizePtr,
+		) ?? null,
+	readbackPoolRelease: (poolPtr: Pointer, id: bigint): boolean =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolRelease?.(poolPtr, id) ??
+		false,
+	readbackPoolGetStats: (poolPtr: Pointer, outStatsPtr: Pointer) =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolGetStats?.(
+			poolPtr,
+			outStatsPtr,
+		),
+	readbackPoolDestroy: (poolPtr: Pointer) =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolDestroy?.(poolPtr),
+	readbackPoolEnableNotify: (poolPtr: Pointer, instancePtr: Pointer): number =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolEnableNotify?.(
+			poolPtr,
+			instancePtr,
+		) ?? -1,
+	readbackPoolPopCompleted: (poolPtr: Pointer, outStatusPtr: Pointer): bigint =>
+		getLinuxNativeWrapperSymbols().wgpuReadbackPoolPopCompleted?.(
+			poolPtr,
+			outStatusPtr,
+		) ?? 0n,
 	runTest: (viewId: number) => {
 		const view = WGPUView.getById(viewId);
 		if (!view?.ptr) {
@@ -3075,6 +3762,12 @@ export interface Rectangle {
 	height: number;
 }
 
+// Output dimensions for a downscaled Screen.captureRegion() capture.
+export interface CaptureSize {
+	width: number;
+	height: number;
+}
+
 export interface Display {
 	id: number;
 	bounds: Rectangle;
@@ -3088,6 +3781,175 @@ export interface Point {
 	y: number;
 }
 
+// Surface timings for a WGPUView, in microseconds. Averages are exponential.
+// Linux only.
+export interface WGPUViewFrameStats {
+	frames: number;
+	failedPresents: number;
+	// Present-to-present interval.
+	lastFrameUs: number;
+	avgFrameUs: number;
+	maxFrameUs: number;
+	lastAcquireUs: number;
+	avgAcquireUs: number;
+	lastPresentUs: number;
+	avgPresentUs: number;
+	// True when the surface is owned by a dedicated render thread.
+	renderThread: boolean;
+	// Refresh period of the view's monitor; 0 when unknown (60 Hz assumed).
+	refreshPeriodUs: number;
+	// Refreshes that passed without a new frame.
+	droppedFrames: number;
+	// Frame intervals by length in refreshes: 1, 2, 3, 4, 5 or more.
+	intervalHistogram: number[];
+	// Acquire start to present end.
+	avgWorkUs: number;
+	// Presents that blocked for over half a refresh on a full swapchain.
+	blockedPresents: number;
+}
+
+// Counters for the spare webviews kept by BrowserView.setPoolSize, across
+// all partitions. Linux only.
+export interface WebviewPoolStats {
+	// Webviews created from a spare, and built from scratch because the
+	// partition's pool was empty.
+	hits: number;
+	misses: number;
+	// Spares built in the background, and kept from a removed webview.
+	precreated: number;
+	recycled: number;
+	// Spares destroyed because their pool shrank.
+	discarded: number;
+	// Spares currently waiting.
+	idle: number;
+}
+
+// Indexed by electrobun::LinuxProcessKind.
+const webviewProcessKinds = [
+	"other",
+	"browser",
+	"renderer",
+	"gpu",
+	"utility",
+	"zygote",
+	"webkit-web",
+	"webkit-network",
+] as const;
+
+// Records getWebviewProcessStats makes room for; grows to the largest
+// sample seen.
+let webviewProcessStatsCapacity = 32;
+
+// Memory and CPU of one process, from BrowserView.getProcessStats. Linux
+// only.
+export interface WebviewProcessStats {
+	// The webview this process renders, or null for shared processes. A
+	// renderer shared by several webviews is listed once per webview.
+	webviewId: number | null;
+	// null when the webview's process is not known: WebKitGTK does not say
+	// which web process renders a view, and a CEF view reports its renderer
+	// once its first page has a script context.
+	pid: number | null;
+	kind: (typeof webviewProcessKinds)[number];
+	rssBytes: number;
+	// Proportional set size, which splits shared pages between processes;
+	// 0 where the kernel does not report it.
+	pssBytes: number;
+	// User plus system time since the process started.
+	cpuTimeUs: number;
+	threads: number;
+}
+
+// Indexed by electrobun::WebviewLifecycleState.
+const webviewLifecycleStates = [
+	"active",
+	"throttled",
+	"frozen",
+	"discarded",
+] as const;
+
+export type WebviewLifecycleState = (typeof webviewLifecycleStates)[number];
+
+// How long a webview must stay hidden before BrowserView.setLifecyclePolicy
+// winds it down further. Omitted or 0 skips that step. Linux only.
+export interface WebviewLifecyclePolicy {
+	// Timers and painting drop to background rates.
+	throttleAfterMs?: number;
+	// Script, timers and loading stop (CEF only).
+	freezeAfterMs?: number;
+	// The page is unloaded and reloaded from its URL when shown.
+	discardAfterMs?: number;
+}
+
+// Counters for BrowserView.setLifecyclePolicy across all webviews. Linux
+// only.
+export interface WebviewLifecycleStats {
+	// Transitions made, and discarded webviews reloaded when shown.
+	throttled: number;
+	frozen: number;
+	discarded: number;
+	restored: number;
+	// Resident memory the discarded pages' processes gave back.
+	bytesReclaimed: number;
+	// Show to load finished for restored webviews.
+	lastRestoreUs: number;
+	maxRestoreUs: number;
+	totalRestoreUs: number;
+}
+
+// One presented frame on the native steady clock, in microseconds. Command
+// buffers are submitted between acquireEndUs and presentStartUs.
+export interface WGPUViewFrameTiming {
+	acquireStartUs: number;
+	acquireEndUs: number;
+	presentStartUs: number;
+	presentEndUs: number;
+}
+
+// Box filter matching the native screen_capture_downscale.h: each output
+// pixel is the rounded mean of its share of the source pixels.
+function downscaleRgba(
+	source: Uint8Array,
+	sourceWidth: number,
+	sourceHeight: number,
+	outputWidth: number,
+	outputHeight: number,
+): Uint8Array {
+	const output = new Uint8Array(outputWidth * outputHeight * 4);
+	for (let outputY = 0; outputY < outputHeight; outputY++) {
+		const top = Math.floor((outputY * sourceHeight) / outputHeight);
+		const bottom = Math.max(
+			top + 1,
+			Math.floor(((outputY + 1) * sourceHeight) / outputHeight),
+		);
+		for (let outputX = 0; outputX < outputWidth; outputX++) {
+			const left = Math.floor((outputX * sourceWidth) / outputWidth);
+			const right = Math.max(
+				left + 1,
+				Math.floor(((outputX + 1) * sourceWidth) / outputWidth),
+			);
+			let red = 0;
+			let green = 0;
+			let blue = 0;
+			for (let y = top; y < bottom; y++) {
+				for (let x = left; x < right; x++) {
+					const offset = (y * sourceWidth + x) * 4;
+					red += source[offset]!;
+					green += source[offset + 1]!;
+					blue += source[offset + 2]!;
+				}
+			}
+			const count = (bottom - top) * (right - left);
+			const offset = (outputY * outputWidth + outputX) * 4;
+			output[offset] = Math.floor((red + count / 2) / count);
+			output[offset + 1] = Math.floor((green + count / 2) / count);
+			output[offset + 2] = Math.floor((blue + count / 2) / count);
+			output[offset + 3] = 255;
+		}
+	}
+	return output;
+}
+
 // Screen module for display and cursor information
 export const Screen = {
 	/**
@@ -3157,8 +4019,17 @@ export const Screen = {
 	 * On Wayland, the first call starts the desktop's monitor-sharing portal and
 	 * returns null until the user approves a monitor and its first frame arrives.
 	 * Returns null when capture is unavailable or the rectangle is invalid.
+	 *
+	 * Pass `outputSize` (no larger than the rectangle) for a box-filtered
+	 * thumbnail of `outputSize.width * outputSize.height` pixels. On Linux the
+	 * capture backend filters every device pixel natively, so only the small
+	 * buffer is written and transferred; other platforms capture at full size
+	 * and filter here.
 	 */
-	captureRegion: (rectangle: Rectangle): Uint8Array | null => {
+	captureRegion: (
+		rectangle: Rectangle,
+		outputSize?: CaptureSize,
+	): Uint8Array | null => {
 		const { x, y, width, height } = rectangle;
 		if (
 			!hasFFI ||
@@ -3179,6 +4050,46 @@ export const Screen = {
 		const originX = Math.floor(x);
 		const originY = Math.floor(y);
 
+		if (
+			outputSize &&
+			(outputSize.width !== width || outputSize.height !== height)
+		) {
+			const { width: outputWidth, height: outputHeight } = outputSize;
+			if (
+				!Number.isSafeInteger(outputWidth) ||
+				!Number.isSafeInteger(outputHeight) ||
+				outputWidth <= 0 ||
+				outputHeight <= 0 ||
+				outputWidth > width ||
+				outputHeight > height
+			) {
+				return null;
+			}
+			if (process.platform !== "linux") {
+				const full = Screen.captureRegion(rectangle);
+				return full
+					? downscaleRgba(full, width, height, outputWidth, outputHeight)
+					: null;
+			}
+			try {
+				const outputLength = outputWidth * outputHeight * 4;
+				const pixels = new Uint8Array(outputLength);
+				const captured = core_.symbols.captureScreenRegionScaled(
+					originX,
+					originY,
+					width,
+					height,
+					outputWidth,
+					outputHeight,
+					ptr(pixels),
+					BigInt(outputLength),
+				);
+				return captured ? pixels : null;
+			} catch {
+				return null;
+			}
+		}
+
 		try {
 			const pixels = new Uint8Array(byteLength);
 			const captured = core_.symbols.captureScreenRegion(
@@ -3195,6 +4106,41 @@ export const Screen = {
 		}
 	},
 
+	/**
+	 * Returns a number that changes whenever pixels inside `rectangle` change,
+	 * so a poller can skip captureRegion() while it stays the same. Backed by
+	 * compositor damage on Wayland; returns null where changes are not tracked
+	 * (X11, macOS, Windows, or before the first Wayland frame), in which case
+	 * callers should capture every time.
+	 */
+	getRegionChangeSequence: (rectangle: Rectangle): number | null => {
+		const { x, y, width, height } = rectangle;
+		if (
+			!hasFFI ||
+			!Number.isFinite(x) ||
+			!Number.isFinite(y) ||
+			!Number.isSafeInteger(width) ||
+			!Number.isSafeInteger(height) ||
+			width <= 0 ||
+			height <= 0 ||
+			width > 0xffffffff ||
+			height > 0xffffffff
+		) {
+			return null;
+		}
+		try {
+			const sequence = core_.symbols.getScreenRegionChangeSequence(
+				Math.floor(x),
+				Math.floor(y),
+				width,
+				height,
+			);
+			return sequence ? Number(sequence) : null;
+		} catch {
+			return null;
+		}
+	},
+
 	/**
 	 * Get current mouse button bitmask (bit 0 = left, bit 1 = right, bit 2 = middle)
 	 */
@@ -3228,6 +4174,12 @@ export interface CookieFilter {
 	session?: boolean;
 }
 
+export interface CookieImportResult {
+	imported: number;
+	// Lines that did not parse or that the engine rejected.
+	failed: number;
+}
+
 export type StorageType =
 	| "cookies"
 	| "localStorage"
@@ -3237,6 +4189,67 @@ export type StorageType =
 	| "cache"
 	| "all";
 
+const pendingSessionCalls = new Map<
+	number,
+	(success: boolean, result: string) => void
+>();
+let nextSessionRequestId = 1;
+
+// Runs once per started session*Async call, after the engine finishes. A
+// non-empty result stays native-side until it is copied out here.
+const sessionCompletionCallback = new JSCallback(
+	(requestId, success, resultLength) => {
+		const resolve = pendingSessionCalls.get(requestId);
+		if (!resolve) return;
+		pendingSessionCalls.delete(requestId);
+		const length = Number(resultLength);
+		if (length <= 0) {
+			resolve(Boolean(success), "");
+			return;
+		}
+		const bytes = new Uint8Array(length);
+		const taken = getLinuxNativeWrapperSymbols().sessionTakeResult?.(
+			requestId,
+			ptr(bytes),
+			BigInt(length),
+		);
+		resolve(Boolean(success), taken ? new TextDecoder().decode(bytes) : "");
+	},
+	{
+		args: [FFIType.u32, FFIType.bool, FFIType.u64],
+		returns: FFIType.void,
+		threadsafe: true,
+	},
+);
+
+// Start a native session*Async call and resolve with its outcome, or with
+// null when the platform has no asynchronous variant.
+function startSessionCall(
+	start: (requestId: number, callback: JSCallback) => boolean | undefined,
+): Promise<{ success: boolean; result: string }> | null {
+	const requestId = nextSessionRequestId;
+	nextSessionRequestId =
+		nextSessionRequestId >= 0xffffffff ? 1 : nextSessionRequestId + 1;
+	let started: boolean | undefined;
+	const promise = new Promise<{ success: boolean; result: string }>(
+		(resolve) => {
+			pendingSessionCalls.set(requestId, (success, result) =>
+				resolve({ success, result }),
+			);
+			started = start(requestId, sessionCompletionCallback);
+		},
+	);
+	if (started === undefined) {
+		pendingSessionCalls.delete(requestId);
+		return null;
+	}
+	if (!started) {
+		pendingSessionCalls.delete(requestId);
+		return Promise.resolve({ success: false, result: "" });
+	}
+	return promise;
+}
+
 // Cookies API for a session
 class SessionCookies {
 	private partitionId: string;
@@ -3297,6 +4310,155 @@ class SessionCookies {
 	clear(): void {
 		native_.symbols.sessionClearCookies(toCString(this.partitionId));
 	}
+
+	/**
+	 * Like get(), without blocking. Concurrent calls run in parallel on
+	 * Linux; elsewhere this wraps the synchronous call.
+	 */
+	async getAsync(filter?: CookieFilter): Promise<Cookie[]> {
+		const filterJson = JSON.stringify(filter || {});
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionGetCookiesAsync?.(
+				toCString(this.partitionId),
+				toCString(filterJson),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) return this.get(filter);
+		const { result } = await call;
+		try {
+			return result ? JSON.parse(result) : [];
+		} catch {
+			return [];
+		}
+	}
+
+	/**
+	 * Like set(), without blocking.
+	 */
+	async setAsync(cookie: Cookie): Promise<boolean> {
+		const cookieJson = JSON.stringify(cookie);
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionSetCookieAsync?.(
+				toCString(this.partitionId),
+				toCString(cookieJson),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) return this.set(cookie);
+		return (await call).success;
+	}
+
+	/**
+	 * Like remove(), without blocking.
+	 */
+	async removeAsync(url: string, name: string): Promise<boolean> {
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionRemoveCookieAsync?.(
+				toCString(this.partitionId),
+				toCString(url),
+				toCString(name),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) return this.remove(url, name);
+		return (await call).success;
+	}
+
+	/**
+	 * Like clear(), without blocking. Resolves with false if the cookies
+	 * could not be cleared.
+	 */
+	async clearAsync(): Promise<boolean> {
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionClearCookiesAsync?.(
+				toCString(this.partitionId),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) {
+			this.clear();
+			return true;
+		}
+		return (await call).success;
+	}
+
+	/**
+	 * Export the cookie jar as JSON lines, one Cookie object per line, in a
+	 * single native call. The result can be passed to importAsync() on any
+	 * session.
+	 * @param filter - Optional filter to match cookies
+	 */
+	async exportAsync(filter?: CookieFilter): Promise<string> {
+		const filterJson = JSON.stringify(filter || {});
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionExportCookiesAsync?.(
+				toCString(this.partitionId),
+				toCString(filterJson),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) {
+			return this.get(filter)
+				.map((cookie) => `${JSON.stringify(cookie)}\n`)
+				.join("");
+		}
+		return (await call).result;
+	}
+
+	/**
+	 * Write many cookies in a single native call. On Linux the jar is
+	 * streamed into the engine's cookie store with a bounded number of
+	 * writes in flight; elsewhere each cookie is set in turn.
+	 * @param jar - JSON lines as returned by exportAsync(), or an array of cookies
+	 */
+	async importAsync(jar: string | Cookie[]): Promise<CookieImportResult> {
+		const lines =
+			typeof jar === "string"
+				? jar
+				: jar.map((cookie) => `${JSON.stringify(cookie)}\n`).join("");
+		const bytes = new TextEncoder().encode(lines);
+		if (bytes.length === 0) return { imported: 0, failed: 0 };
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionImportCookiesAsync?.(
+				toCString(this.partitionId),
+				ptr(bytes),
+				BigInt(bytes.length),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) {
+			const counts = { imported: 0, failed: 0 };
+			for (const line of lines.split("\n")) {
+				if (!line.trim()) continue;
+				let cookie: Cookie | undefined;
+				try {
+					cookie = JSON.parse(line);
+				} catch {}
+				if (cookie && this.set(cookie)) {
+					counts.imported += 1;
+				} else {
+					counts.failed += 1;
+				}
+			}
+			return counts;
+		}
+		const { success, result } = await call;
+		if (success && result) {
+			try {
+				return JSON.parse(result);
+			} catch {}
+		}
+		// The partition had no cookie store to write to.
+		const failed = lines.split("\n").filter((line) => line.trim()).length;
+		return { imported: 0, failed };
+	}
 }
 
 // Session class representing a storage partition
@@ -3320,6 +4482,48 @@ class SessionInstance {
 			toCString(JSON.stringify(typesArray)),
 		);
 	}
+
+	/**
+	 * Like clearStorageData(), without blocking. Resolves with false if the
+	 * data could not be cleared.
+	 */
+	async clearStorageDataAsync(
+		types: StorageType[] | "all" = "all",
+	): Promise<boolean> {
+		const typesJson = JSON.stringify(types === "all" ? ["all"] : types);
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionClearStorageDataAsync?.(
+				toCString(this.partition),
+				toCString(typesJson),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) {
+			this.clearStorageData(types);
+			return true;
+		}
+		return (await call).success;
+	}
+
+	/**
+	 * Build this partition's storage context before its first webview, when
+	 * the main thread is otherwise idle, so creating that webview is faster.
+	 * Resolves with true once the context is ready, and with false for
+	 * partitions whose context is created per webview (anything other than
+	 * persist:*) or on platforms without prewarming.
+	 */
+	async prewarm(): Promise<boolean> {
+		const call = startSessionCall((requestId, callback) =>
+			getLinuxNativeWrapperSymbols().sessionPrewarmPartitionAsync?.(
+				toCString(this.partition),
+				requestId,
+				callback,
+			),
+		);
+		if (!call) return false;
+		return (await call).success;
+	}
 }
 
 // Cache of session instances
@@ -3347,6 +4551,17 @@ export const Session = {
 	get defaultSession(): SessionInstance {
 		return Session.fromPartition("persist:default");
 	},
+
+	/**
+	 * Declare the partitions the app will open webviews in and prewarm them
+	 * in the background, in order. Call after startup; see
+	 * SessionInstance.prewarm().
+	 */
+	prewarm: (partitions: string[]): Promise<boolean[]> => {
+		return Promise.all(
+			partitions.map((partition) => Session.fromPartition(partition).prewarm()),
+		);
+	},
 };
 
 // DEPRECATED: This callback is no longer used for navigation decisions.
@@ -3464,6 +4679,89 @@ const webviewEventJSCallback = new JSCallback(
 	},
 );
 
+export type WebviewSnapshotFormat = "png" | "jpeg" | "rgba";
+
+export type WebviewSnapshot =
+	| { width: number; height: number; dataUrl: string }
+	| { width: number; height: number; pixels: Uint8Array };
+
+// Values match the native `format` argument.
+const webviewSnapshotFormats: Record<WebviewSnapshotFormat, number> = {
+	png: 0,
+	jpeg: 1,
+	rgba: 2,
+};
+
+const pendingWebviewSnapshots = new Map<
+	number,
+	{
+		pixels: Uint8Array | null;
+		resolve: (snapshot: WebviewSnapshot | null) => void;
+	}
+>();
+let nextWebviewSnapshotRequestId = 1;
+
+// Runs once per started snapshot, from the native encoder thread. Encoded
+// results stay native-side until they are copied out here.
+const webviewSnapshotCallback = new JSCallback(
+	(requestId, _webviewId, success, width, height, dataUrlLength) => {
+		const pending = pendingWebviewSnapshots.get(requestId);
+		if (!pending) return;
+		pendingWebviewSnapshots.delete(requestId);
+		if (!success) {
+			pending.resolve(null);
+			return;
+		}
+		if (pending.pixels) {
+			pending.resolve({
+				width,
+				height,
+				pixels: pending.pixels.subarray(0, width * height * 4),
+			});
+			return;
+		}
+		const length = Number(dataUrlLength);
+		if (length <= 0) {
+			pending.resolve(null);
+			return;
+		}
+		const bytes = new Uint8Array(length);
+		const taken = core_.symbols.takeWebviewSnapshotDataUrl(
+			requestId,
+			ptr(bytes),
+			BigInt(length),
+		);
+		pending.resolve(
+			taken ? { width, height, dataUrl: new TextDecoder().decode(bytes) } : null,
+		);
+	},
+	{
+		args: [
+			FFIType.u32,
+			FFIType.u32,
+			FFIType.u32,
+			FFIType.u32,
+			FFIType.u32,
+			FFIType.u64,
+		],
+		returns: FFIType.void,
+		threadsafe: true,
+	},
+);
+
+const webviewFrameStreamListeners = new Map<number, (sequence: number) => void>();
+
+const webviewFrameStreamCallback = new JSCallback(
+	(webviewId, sequence) => {
+		webviewFrameStreamListeners.get(webviewId)?.(sequence);
+	},
+	{
+		args: [FFIType.u32, FFIType.u32],
+		returns: FFIType.void,
+		threadsafe: true,
+	},
+);
+
 const hostBridgePostmessageHandler = new JSCallback(
 	(id, msg) => {
 		try {
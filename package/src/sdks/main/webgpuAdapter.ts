@@ -5,6 +5,7 @@ import WGPU from "./webGPU";
 import { WGPUBridge } from "./proc/native";
 import { ptr, toArrayBuffer, type Pointer, JSCallback } from "bun:ffi";
 import { inflateSync } from "zlib";
+import { createReadStream, type ReadStream } from "node:fs";
 import {
 	mapLoadOp,
 	mapStoreOp,
@@ -1727,6 +1728,20 @@ class GPUDevice {
 		void ffiKeepalive;
 		return new GPUComputePipeline(pipelinePtr);
 	}
+	// A pool of persistent staging buffers for per-frame readbacks (Linux).
+	// Returns null where the native pool is unavailable; callers fall back to
+	// GPUBuffer.readbackAsync.
+	createReadbackRing(descriptor: { slotCount: number; slotSize: number }) {
+		this._assertLive();
+		const poolPtr = WGPUBridge.readbackPoolCreate(
+			this.ptr as any,
+			this.queue.ptr as any,
+			descriptor.slotCount,
+			BigInt(descriptor.slotSize),
+		);
+		if (!poolPtr) return null;
+		return new GPUReadbackRing(poolPtr as unknown as number, this);
+	}
 	createCommandEncoder() {
 		this._assertLive();
 		const desc = makeCommandEncoderDescriptor();
@@ -1936,6 +1951,189 @@ class GPUBuffer {
 	}
 }
 
+type GPUReadbackRingStats = {
+	slotCount: number;
+	inUse: number;
+	slotSize: number;
+	peakInUse: number;
+	submitted: number;
+	completed: number;
+	failed: number;
+	stalls: number;
+	completionsDropped: number;
+};
+
+// Readbacks through a fixed set of staging buffers and host slabs. submit()
+// returns an id (0n when every slot is busy); once status(id) reports 1 the
+// bytes can be read in place with view(id) until release(id) hands the slot
+// back. Statuses match readbackAsync: 0 pending, 1 ready, 2 map failed,
+// 3 range unavailable, 4 unknown id.
+class GPUReadbackRing {
+	ptr: number;
+	_device: GPUDevice;
+	private _sizeOut = new BigUint64Array(1);
+	private _statsOut = new ArrayBuffer(56);
+	private _statusOut = new Int32Array(1);
+	private _completeHandler: ((id: bigint, status: number) => void) | null = null;
+	private _wakeupStream: ReadStream | null = null;
+	// Set when completions are drained on a timer rather than a stream; the
+	// timer only runs while readbacks are in flight.
+	private _pollCompletions = false;
+	private _wakeupTimer: ReturnType<typeof setInterval> | null = null;
+	constructor(ptr: number, device: GPUDevice) {
+		this.ptr = ptr;
+		this._device = device;
+	}
+	private _assertLive() {
+		if (!this.ptr || !this._device.ptr) {
+			throw new Error("WebGPU readback ring has been destroyed");
+		}
+	}
+	submit(buffer: GPUBuffer, offset = 0, size?: number) {
+		this._assertLive();
+		const readSize = Math.max(0, size ?? buffer.size - offset);
+		const id = WGPUBridge.readbackPoolSubmit(
+			this.ptr as any,
+			buffer.ptr as any,
+			BigInt(offset),
+			BigInt(readSize),
+		);
+		if (id && this._pollCompletions) this._armWakeupTimer();
+		return id;
+	}
+	// Deliver each finished readback to handler instead of polling status().
+	// A native waiter thread completes maps as the GPU finishes them and wakes
+	// the JS thread through an eventfd. Returns false where notifications are
+	// unavailable; callers then keep using poll() and status().
+	onComplete(handler: (id: bigint, status: number) => void) {
+		this._assertLive();
+		if (!this._device.instancePtr) return false;
+		const fd = WGPUBridge.readbackPoolEnableNotify(
+			this.ptr as any,
+			this._device.instancePtr as any,
+		);
+		if (fd < 0) return false;
+		this._completeHandler = handler;
+		if (this._wakeupStream || this._pollCompletions) return true;
+
+		// Same fallback as the host message wakeup: Bun's streams cannot
+		// watch a raw fd, so drain on a short timer there, armed by submit()
+		// and stopped once nothing is left in flight.
+		const startPolling = () => {
+			if (this._pollCompletions || !this.ptr) return;
+			this._pollCompletions = true;
+			if (this._inFlight()) this._armWakeupTimer();
+		};
+		if (typeof process.versions?.bun === "string") {
+			startPolling();
+		} else {
+			try {
+				const stream = createReadStream("/dev/null", { fd, autoClose: false });
+				stream.on("data", () => this._drainCompleted());
+				stream.on("error", () => {
+					stream.destroy();
+					if (this._wakeupStream === stream) this._wakeupStream = null;
+					startPolling();
+				});
+				this._wakeupStream = stream;
+			} catch {
+				startPolling();
+			}
+		}
+		this._drainCompleted();
+		return true;
+	}
+	private _armWakeupTimer() {
+		if (this._wakeupTimer || !this.ptr) return;
+		this._wakeupTimer = setInterval(() => {
+			this._drainCompleted();
+			if (!this._inFlight() && this._wakeupTimer) {
+				clearInterval(this._wakeupTimer);
+				this._wakeupTimer = null;
+			}
+		}, 5);
+	}
+	// Counted natively, so completions dropped from a full queue still end it.
+	private _inFlight() {
+		const stats = this.stats();
+		return !!stats && stats.submitted > stats.completed + stats.failed;
+	}
+	private _drainCompleted() {
+		if (!this.ptr) return;
+		for (;;) {
+			const id = WGPUBridge.readbackPoolPopCompleted(
+				this.ptr as any,
+				ptr(this._statusOut) as any,
+			);
+			if (!id) return;
+			try {
+				this._completeHandler?.(id, this._statusOut[0]);
+			} catch (error) {
+				console.error("WebGPU readback completion handler failed:", error);
+			}
+		}
+	}
+	// Drive Dawn so map callbacks run; call once per frame before status().
+	poll() {
+		this._assertLive();
+		try {
+			if (this._device.instancePtr) {
+				WGPUNative.symbols.wgpuInstanceProcessEvents(this._device.instancePtr);
+			}
+			WGPUNative.symbols.wgpuDeviceTick(this._device.ptr);
+		} catch {}
+	}
+	status(id: bigint) {
+		if (!this.ptr) return 4;
+		return WGPUBridge.readbackPoolStatus(this.ptr as any, id);
+	}
+	// The pooled bytes of a ready readback. The view aliases native memory and
+	// must not be used after release(id) or destroy().
+	view(id: bigint) {
+		if (!this.ptr) return null;
+		const data = WGPUBridge.readbackPoolData(
+			this.ptr as any,
+			id,
+			ptr(this._sizeOut) as any,
+		);
+		if (!data) return null;
+		const size = Number(this._sizeOut[0]);
+		return new Uint8Array(toArrayBuffer(data as any, 0, size));
+	}
+	release(id: bigint) {
+		if (!this.ptr) return false;
+		return WGPUBridge.readbackPoolRelease(this.ptr as any, id);
+	}
+	stats(): GPUReadbackRingStats | null {
+		if (!this.ptr) return null;
+		WGPUBridge.readbackPoolGetStats(this.ptr as any, ptr(this._statsOut) as any);
+		const view = new DataView(this._statsOut);
+		return {
+			slotCount: view.getUint32(0, true),
+			inUse: view.getUint32(4, true),
+			slotSize: readU64(view, 8),
+			peakInUse: view.getUint32(16, true),
+			submitted: readU64(view, 24),
+			completed: readU64(view, 32),
+			failed: readU64(view, 40),
+			stalls: readU64(view, 48),
+			completionsDropped: view.getUint32(20, true),
+		};
+	}
+	destroy() {
+		if (!this.ptr) return;
+		const poolPtr = this.ptr;
+		this.ptr = 0;
+		this._completeHandler = null;
+		this._wakeupStream?.destroy();
+		this._wakeupStream = null;
+		this._pollCompletions = false;
+		if (this._wakeupTimer) clearInterval(this._wakeupTimer);
+		this._wakeupTimer = null;
+		WGPUBridge.readbackPoolDestroy(poolPtr as any);
+	}
+}
+
 class GPUSampler {
 	ptr: number;
 	constructor(ptr: number) {
@@ -3559,6 +3757,7 @@ export {
 	GPUTexture,
 	GPUTextureView,
 	GPUBuffer,
+	GPUReadbackRing,
 	GPUSampler,
 	GPUBindGroupLayout,
 	GPUBindGroup,
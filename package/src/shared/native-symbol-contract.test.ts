@@ -106,6 +106,12 @@ const windowsDescriptorBlock = sourceSection(
 	"\n\t\t\t\t: {}),",
 	"Windows NativeWrapper descriptor block",
 );
+const linuxDescriptorBlock = sourceSection(
+	typescriptNativeTable,
+	'\t\t\t...(process.platform === "linux"',
+	"\n\t\t\t\t: {}),",
+	"Linux NativeWrapper descriptor block",
+);
 
 const directWrapperCommonSymbols = requireContract(
 	"TypeScript NativeWrapper descriptor table",
@@ -120,6 +126,10 @@ const directWrapperWindowsSymbols = descriptorNamesAtIndent(
 	windowsDescriptorBlock,
 	5,
 );
+const directWrapperLinuxSymbols = descriptorNamesAtIndent(
+	linuxDescriptorBlock,
+	5,
+);
 const expectedDirectWrapperDarwinSymbols = [
 	"setWGPUKeyHandler",
 	"setWGPUPointerHandler",
@@ -132,6 +142,36 @@ const expectedDirectWrapperWindowsSymbols = [
 	"getWindowContentSize",
 	"setWindowTextHandler",
 ].sort();
+const expectedDirectWrapperLinuxSymbols = [
+	"getWebviewLifecycleState",
+	"getWebviewLifecycleStats",
+	"getWebviewPoolStats",
+	"getWebviewProcessStats",
+	"sessionClearCookiesAsync",
+	"sessionClearStorageDataAsync",
+	"sessionExportCookiesAsync",
+	"sessionGetCookiesAsync",
+	"sessionImportCookiesAsync",
+	"sessionPrewarmPartitionAsync",
+	"sessionRemoveCookieAsync",
+	"sessionSetCookieAsync",
+	"sessionTakeResult",
+	"setWebviewLifecyclePolicy",
+	"setWebviewPoolSize",
+	"wgpuReadbackPoolCreate",
+	"wgpuReadbackPoolData",
+	"wgpuReadbackPoolDestroy",
+	"wgpuReadbackPoolEnableNotify",
+	"wgpuReadbackPoolGetStats",
+	"wgpuReadbackPoolPopCompleted",
+	"wgpuReadbackPoolRelease",
+	"wgpuReadbackPoolStatus",
+	"wgpuReadbackPoolSubmit",
+	"wgpuViewGetFrameStats",
+	"wgpuViewGetFramePacingDelay",
+	"wgpuViewGetFrameTimeline",
+	"wgpuViewSetRenderThread",
+].sort();
 
 const coreBootstrapWrapperSymbols = requireContract(
 	"ElectrobunCore NativeWrapper bootstrap",
@@ -266,11 +306,21 @@ describe("TypeScript to NativeWrapper ABI", () => {
 			expect(definesNativeFunction(sources.wrappers.linux, symbol)).toBe(false);
 			expect(definesNativeFunction(sources.wrappers.win32, symbol)).toBe(true);
 		}
+
+		expect(uniqueSorted(directWrapperLinuxSymbols)).toEqual(
+			expectedDirectWrapperLinuxSymbols,
+		);
+		for (const symbol of expectedDirectWrapperLinuxSymbols) {
+			expect(directWrapperCommonSymbols).not.toContain(symbol);
+			expect(definesNativeFunction(sources.wrappers.darwin, symbol)).toBe(false);
+			expect(definesNativeFunction(sources.wrappers.linux, symbol)).toBe(true);
+			expect(definesNativeFunction(sources.wrappers.win32, symbol)).toBe(false);
+		}
 	});
 
 	test.each([
 		["darwin", uniqueSorted([...directWrapperCommonSymbols, ...directWrapperDarwinSymbols])],
-		["linux", directWrapperCommonSymbols],
+		["linux", uniqueSorted([...directWrapperCommonSymbols, ...directWrapperLinuxSymbols])],
 		["win32", uniqueSorted([...directWrapperCommonSymbols, ...directWrapperWindowsSymbols])],
 	] as const)("every %s descriptor has a wrapper definition", (platform, symbols) => {
 		const missing = symbols.filter(
@@ -299,7 +349,7 @@ describe("ElectrobunCore to NativeWrapper ABI", () => {
 });
 
 describe("WGPU surface release ABI", () => {
-	test("keeps the Windows cleanup hook optional behind ElectrobunCore", () => {
+	test("keeps the Windows and Linux cleanup hook optional behind ElectrobunCore", () => {
 		expect(eagerCoreDemands.typescript).toContain("wgpuReleaseSurfaceForView");
 		expect(coreExports).toContain("wgpuReleaseSurfaceForView");
 		expect(directWrapperCommonSymbols).not.toContain(
@@ -325,7 +375,10 @@ describe("WGPU surface release ABI", () => {
 			false,
 		);
 		expect(definesNativeFunction(sources.wrappers.linux, "wgpuReleaseSurfaceForView")).toBe(
-			false,
+			true,
+		);
+		expect(sources.wrappers.linux).toMatch(
+			/ELECTROBUN_EXPORT\s+void\s+wgpuReleaseSurfaceForView\s*\(/,
 		);
 	});
 });